@@ -134,7 +134,7 @@ pub fn build(b: *std.Build) void {
     const run_step = b.step("run", "Show available build commands");
     const run_info_cmd = b.addSystemCommand(&.{ "sh", "-c" });
     run_info_cmd.addArgs(&.{
-        "printf '\\nengine12 Build Commands\\n=========================================================\\n  zig build             Build engine12 library and executables\\n  zig build test         Run all tests\\n  zig build todo-run     Run the TODO application\\n  zig build todo-test    Run TODO application tests\\n=========================================================\\n\\n'",
+        "printf '\\nengine12 Build Commands\\n=========================================================\\n  zig build             Build engine12 library and executables\\n  zig build test         Run all tests\\n  zig build todo-run     Run the TODO application\\n  zig build todo-test    Run TODO application tests\\n  zig build bench -Doptimize=ReleaseFast  Benchmark SQLite JSON lists\\n=========================================================\\n\\n'",
     });
     run_step.dependOn(&run_info_cmd.step);
 
@@ -231,6 +231,27 @@ pub fn build(b: *std.Build) void {
     const run_todo_tests = b.addRunArtifact(todo_test_exe);
     todo_test_step.dependOn(&run_todo_tests.step);
 
+    // JSON list benchmark; run with -Doptimize=ReleaseFast so SQLite and Zig are both optimized
+    const bench_exe = b.addExecutable(.{
+        .name = "bench-json-lists",
+        .root_module = b.createModule(.{
+            .root_source_file = b.path("src/bench/json_lists.zig"),
+            .target = target,
+            .optimize = optimize,
+            .imports = &.{
+                .{ .name = "engine12", .module = mod },
+            },
+        }),
+    });
+
+    // Link SQLite static library to the benchmark
+    bench_exe.linkLibrary(sqlite_lib);
+    bench_exe.linkLibC();
+
+    const bench_step = b.step("bench", "Benchmark SQLite JSON lists against Zig serialization");
+    const run_bench = b.addRunArtifact(bench_exe);
+    bench_step.dependOn(&run_bench.step);
+
     // Read version from build.zig.zon with robust error handling
     const build_zon_content = @embedFile("build.zig.zon");
     const version_prefix = ".version = \"";
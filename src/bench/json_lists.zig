@@ -0,0 +1,119 @@
+const std = @import("std");
+const builtin = @import("builtin");
+const engine12 = @import("engine12");
+const ORM = engine12.orm.ORM;
+const Database = engine12.orm.Database;
+const Json = engine12.Json;
+
+// Benchmark for `RestApiConfig.sqlite_json_lists`
+// Compares the two ways handleList can build a page of rows as JSON:
+//   zig:    query() + toArrayListAlloc(T) + Json.serializeArray
+//   sqlite: queryJsonArray(T), where json_group_array builds the text
+//
+// Run with:
+//   zig build bench -Doptimize=ReleaseFast
+
+const Todo = struct {
+    id: i64,
+    title: []const u8,
+    description: []const u8,
+    completed: bool,
+    priority: i64,
+    due_date: ?i64,
+    created_at: i64,
+    updated_at: i64,
+};
+
+const table_rows = 1000;
+
+const Case = struct {
+    rows: usize,
+    iterations: usize,
+};
+
+const cases = [_]Case{
+    .{ .rows = 20, .iterations = 5000 },
+    .{ .rows = 1000, .iterations = 200 },
+};
+
+pub fn main() !void {
+    var gpa = std.heap.GeneralPurposeAllocator(.{}){};
+    defer _ = gpa.deinit();
+    const allocator = gpa.allocator();
+
+    const db = try Database.open(":memory:", allocator);
+    var orm = ORM.init(db, allocator);
+    defer orm.close();
+
+    try orm.execute(
+        "CREATE TABLE todo (id INTEGER PRIMARY KEY, title TEXT, description TEXT, completed INTEGER, " ++
+            "priority INTEGER, due_date INTEGER, created_at INTEGER, updated_at INTEGER)",
+    );
+    try orm.execute(std.fmt.comptimePrint(
+        "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < {d}) " ++
+            "INSERT INTO todo (title, description, completed, priority, due_date, created_at, updated_at) " ++
+            "SELECT 'Todo ' || i, 'Write the \"weekly\" report ' || i, i % 2, i % 5, " ++
+            "CASE WHEN i % 3 = 0 THEN NULL ELSE 1700000000 + i END, 1700000000 + i, 1700000000 + i FROM n",
+        .{table_rows},
+    ));
+
+    var arena = std.heap.ArenaAllocator.init(allocator);
+    defer arena.deinit();
+
+    std.debug.print("\nJSON list serialization ({d}-row table, {s} build)\n", .{ table_rows, @tagName(builtin.mode) });
+    std.debug.print("{s:>6} {s:>14} {s:>14} {s:>8}\n", .{ "rows", "zig us/op", "sqlite us/op", "speedup" });
+
+    for (cases) |case| {
+        var sql_buf: [128]u8 = undefined;
+        const sql = try std.fmt.bufPrint(&sql_buf, "SELECT * FROM todo ORDER BY id LIMIT {d}", .{case.rows});
+
+        // Both paths must produce the same body before their timings mean anything
+        const zig_json = try serializeInZig(&orm, sql, arena.allocator());
+        const sqlite_json = try serializeInSqlite(&orm, sql, arena.allocator());
+        if (!std.mem.eql(u8, zig_json, sqlite_json)) {
+            std.debug.print("[ORM Error] JSON bodies differ for {d} rows\n", .{case.rows});
+            return error.OutputMismatch;
+        }
+        _ = arena.reset(.retain_capacity);
+
+        const zig_ns = try timePath(serializeInZig, &orm, sql, &arena, case.iterations);
+        const sqlite_ns = try timePath(serializeInSqlite, &orm, sql, &arena, case.iterations);
+
+        std.debug.print("{d:>6} {d:>14.1} {d:>14.1} {d:>7.2}x\n", .{
+            case.rows,
+            zig_ns / 1000.0,
+            sqlite_ns / 1000.0,
+            zig_ns / sqlite_ns,
+        });
+    }
+}
+
+fn serializeInZig(orm: *ORM, sql: []const u8, arena: std.mem.Allocator) ![]const u8 {
+    var result = try orm.query(sql);
+    defer result.deinit();
+    const items = try result.toArrayListAlloc(Todo, arena);
+    return Json.serializeArray(Todo, items.items, arena);
+}
+
+fn serializeInSqlite(orm: *ORM, sql: []const u8, arena: std.mem.Allocator) ![]const u8 {
+    const page = try orm.queryJsonArray(Todo, sql, .{ .order_by = "id" }, arena);
+    return page.json;
+}
+
+/// Average nanoseconds per call, with the arena reset between calls as a request would
+fn timePath(
+    comptime path: anytype,
+    orm: *ORM,
+    sql: []const u8,
+    arena: *std.heap.ArenaAllocator,
+    iterations: usize,
+) !f64 {
+    var timer = try std.time.Timer.start();
+    for (0..iterations) |_| {
+        const body = try path(orm, sql, arena.allocator());
+        std.mem.doNotOptimizeAway(body.len);
+        _ = arena.reset(.retain_capacity);
+    }
+    const elapsed: f64 = @floatFromInt(timer.read());
+    return elapsed / @as(f64, @floatFromInt(iterations));
+}
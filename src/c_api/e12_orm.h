@@ -15,6 +15,8 @@ typedef void E12Result;
 typedef void E12Row;
 typedef void E12Transaction;
 typedef void E12ConnectionPool;
+typedef void E12Statement;
+typedef void E12Backup;
 
 // Error codes
 typedef enum {
@@ -24,6 +26,7 @@ typedef enum {
     E12_ORM_ERROR_QUERY_FAILED = 3,
     E12_ORM_ERROR_INVALID_ARGUMENT = 4,
     E12_ORM_ERROR_NO_RESULTS = 5,
+    E12_ORM_ERROR_POOL_EXHAUSTED = 6,
 } E12ORMErrorCode;
 
 // ============================================================================
@@ -36,6 +39,17 @@ typedef enum {
 /// @return E12_ORM_OK on success, error code on failure
 E12ORMErrorCode e12_db_open(const char* path, E12Database** out_db);
 
+/// Open flags for e12_db_open_with_flags
+#define E12_OPEN_READ_ONLY 0x1
+#define E12_OPEN_NO_CREATE 0x2 // Fail with E12_ORM_ERROR_OPEN_FAILED if the file does not exist
+
+/// Open a SQLite database with flags
+/// @param path Database file path
+/// @param flags Bitmask of E12_OPEN_* flags (0 = read/write, create if missing)
+/// @param out_db Output parameter for the database handle
+/// @return E12_ORM_OK on success, error code on failure
+E12ORMErrorCode e12_db_open_with_flags(const char* path, uint32_t flags, E12Database** out_db);
+
 /// Close a database connection
 /// @param db Database handle (must not be NULL)
 void e12_db_close(E12Database* db);
@@ -47,6 +61,113 @@ void e12_db_close(E12Database* db);
 /// @return E12_ORM_OK on success, error code on failure
 E12ORMErrorCode e12_db_execute(E12Database* db, const char* sql, int64_t* rows_affected);
 
+// ============================================================================
+// Prepared Statement Cache
+// ============================================================================
+
+/// Default number of prepared statements cached per connection
+#define E12_STMT_CACHE_DEFAULT_CAPACITY 64
+
+/// Prepared statement cache statistics
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    size_t size;
+    size_t capacity;
+} E12StatementCacheStats;
+
+/// Set the maximum number of prepared statements cached by a connection
+/// Clears the cache. A capacity of 0 disables statement caching.
+/// @param db Database handle
+/// @param capacity Maximum number of cached statements
+/// @return E12_ORM_OK on success, error code on failure
+E12ORMErrorCode e12_db_set_statement_cache_capacity(E12Database* db, size_t capacity);
+
+/// Get prepared statement cache statistics for a connection
+/// @param db Database handle
+/// @param out_stats Output parameter for the statistics
+void e12_db_get_statement_cache_stats(E12Database* db, E12StatementCacheStats* out_stats);
+
+/// Finalize all idle cached statements for a connection
+/// @param db Database handle
+void e12_db_clear_statement_cache(E12Database* db);
+
+// ============================================================================
+// Runtime Status
+// ============================================================================
+
+/// SQLite runtime counters for one connection plus the process-wide allocator
+typedef struct {
+    // sqlite3_db_status (this connection, current values)
+    int64_t cache_used;          // bytes held by the page cache
+    int64_t cache_hit;           // page cache hits since open
+    int64_t cache_miss;          // page cache misses since open
+    int64_t cache_write;         // dirty pages written to disk since open
+    int64_t cache_spill;         // dirty pages spilled mid-transaction since open
+    int64_t lookaside_used;      // lookaside slots checked out
+    int64_t lookaside_hit;       // allocations served from lookaside
+    int64_t lookaside_miss_size; // allocations too large for a lookaside slot
+    int64_t lookaside_miss_full; // allocations missed because lookaside was full
+    int64_t schema_used;         // bytes used by schema structures
+    int64_t stmt_used;           // bytes used by prepared statements
+    // sqlite3_status64 (whole process)
+    int64_t memory_used;
+    int64_t memory_highwater;
+    int64_t malloc_count;
+    int64_t pagecache_overflow;  // page cache bytes that fell back to malloc
+    // File sizes
+    int64_t wal_bytes;           // size of the -wal file, 0 when there is none
+} E12DbStatus;
+
+/// Read the SQLite status counters for a connection
+/// Counters are read without resetting them, so hit/miss/write values grow for
+/// the lifetime of the connection.
+/// @param db Database handle
+/// @param out_status Output parameter for the counters
+void e12_db_get_status(E12Database* db, E12DbStatus* out_status);
+
+// ============================================================================
+// Change Capture
+// ============================================================================
+
+/// Row operation reported by change capture
+typedef enum {
+    E12_CHANGE_INSERT = 1,
+    E12_CHANGE_UPDATE = 2,
+    E12_CHANGE_DELETE = 3,
+    /// The table changed but its rows were not listed (the transaction was too large)
+    E12_CHANGE_MANY = 4,
+} E12ChangeOp;
+
+/// Rows recorded per transaction before the remaining changes collapse into
+/// one E12_CHANGE_MANY event per table
+#define E12_CHANGE_MAX_ROWS_PER_TXN 10000
+
+/// One changed row
+typedef struct {
+    const char* table; // Valid only for the duration of the callback
+    E12ChangeOp op;
+    int64_t rowid;     // 0 for E12_CHANGE_MANY
+} E12ChangeEvent;
+
+/// Receives the rows changed by one committed transaction
+/// Called on the thread that ran the commit, after SQLite has returned from it.
+/// The writing call does not return until the callback does, so keep it short.
+typedef void (*E12ChangeCallback)(void* ctx, const E12ChangeEvent* events, size_t count);
+
+/// Capture inserts, updates and deletes on rowid tables of a connection
+/// Uses sqlite3_update_hook, sqlite3_commit_hook and sqlite3_rollback_hook.
+/// Changes are held until their transaction commits and dropped on rollback.
+/// WITHOUT ROWID tables and changes made on other connections are not reported.
+/// Rows from a COMMIT that fails with SQLITE_BUSY and is then rolled back may
+/// still be reported, so treat events as a signal to re-read, not a ledger.
+/// @param db Database handle
+/// @param callback Receiver for committed changes, or NULL to stop capturing
+/// @param ctx Passed through to the callback
+/// @return E12_ORM_OK on success, error code on failure
+E12ORMErrorCode e12_db_set_change_callback(E12Database* db, E12ChangeCallback callback, void* ctx);
+
 // ============================================================================
 // Query Operations
 // ============================================================================
@@ -70,15 +191,106 @@ int e12_result_column_count(E12Result* result);
 const char* e12_result_column_name(E12Result* result, int col_index);
 
 /// Get the next row from the result set
+/// Allocates a new row handle per row; prefer e12_result_step in loops.
 /// @param result Result handle
-/// @param out_row Output parameter for the row handle (NULL if no more rows)
+/// @param out_row Output parameter for the row handle (NULL if no more rows), free with e12_row_free
 /// @return true if a row was returned, false if no more rows
 bool e12_result_next_row(E12Result* result, E12Row** out_row);
 
+/// Advance to the next row without allocating
+/// The row handle is owned by the result and reused for every row: it stays
+/// valid until the result is freed, and always reads the current row.
+/// Do not pass it to e12_row_free.
+/// @param result Result handle
+/// @param out_row Output parameter for the row handle (NULL once there are no more rows)
+/// @return E12_ORM_OK on success (including end of rows), error code if stepping failed
+E12ORMErrorCode e12_result_step(E12Result* result, E12Row** out_row);
+
 /// Free a result set
 /// @param result Result handle to free
 void e12_result_free(E12Result* result);
 
+// ============================================================================
+// Prepared Statements
+// ============================================================================
+
+/// Prepare a single SQL statement with `?` placeholders
+/// The statement is served from the connection's statement cache when possible.
+/// @param db Database handle
+/// @param sql SQL statement string (exactly one statement)
+/// @param out_stmt Output parameter for the statement handle
+/// @return E12_ORM_OK on success, error code on failure
+E12ORMErrorCode e12_db_prepare(E12Database* db, const char* sql, E12Statement** out_stmt);
+
+/// Get the number of parameters in a prepared statement
+/// @param stmt Statement handle
+/// @return Number of parameters, or 0 if invalid
+int e12_stmt_bind_parameter_count(E12Statement* stmt);
+
+/// Bind NULL to a parameter
+/// @param stmt Statement handle
+/// @param index Parameter index (1-based)
+/// @return E12_ORM_OK on success, error code on failure
+E12ORMErrorCode e12_stmt_bind_null(E12Statement* stmt, int index);
+
+/// Bind a 64-bit integer to a parameter
+/// @param stmt Statement handle
+/// @param index Parameter index (1-based)
+/// @param value Value to bind
+/// @return E12_ORM_OK on success, error code on failure
+E12ORMErrorCode e12_stmt_bind_int64(E12Statement* stmt, int index, int64_t value);
+
+/// Bind a double to a parameter
+/// @param stmt Statement handle
+/// @param index Parameter index (1-based)
+/// @param value Value to bind
+/// @return E12_ORM_OK on success, error code on failure
+E12ORMErrorCode e12_stmt_bind_double(E12Statement* stmt, int index, double value);
+
+/// Bind text to a parameter
+/// The text is not copied and must stay valid until the statement is executed, reset or freed.
+/// @param stmt Statement handle
+/// @param index Parameter index (1-based)
+/// @param text Text value (need not be NUL-terminated)
+/// @param len Length of text in bytes
+/// @return E12_ORM_OK on success, error code on failure
+E12ORMErrorCode e12_stmt_bind_text(E12Statement* stmt, int index, const char* text, int len);
+
+/// Bind a blob to a parameter
+/// The data is not copied and must stay valid until the statement is executed, reset or freed.
+/// @param stmt Statement handle
+/// @param index Parameter index (1-based)
+/// @param data Blob data
+/// @param len Length of data in bytes
+/// @return E12_ORM_OK on success, error code on failure
+E12ORMErrorCode e12_stmt_bind_blob(E12Statement* stmt, int index, const void* data, int len);
+
+/// Execute a prepared statement that returns no rows
+/// The statement is reset afterwards and can be executed again; bindings are kept.
+/// @param stmt Statement handle
+/// @param rows_affected Output parameter for number of rows affected (can be NULL)
+/// @return E12_ORM_OK on success, error code on failure
+E12ORMErrorCode e12_stmt_execute(E12Statement* stmt, int64_t* rows_affected);
+
+/// Run a prepared query and return a result set
+/// The result borrows the statement and must be freed before the statement.
+/// @param stmt Statement handle
+/// @param out_result Output parameter for the result handle
+/// @return E12_ORM_OK on success, error code on failure
+E12ORMErrorCode e12_stmt_query(E12Statement* stmt, E12Result** out_result);
+
+/// Reset a prepared statement so it can be run again (bindings are kept)
+/// @param stmt Statement handle
+void e12_stmt_reset(E12Statement* stmt);
+
+/// Clear all parameter bindings
+/// @param stmt Statement handle
+void e12_stmt_clear_bindings(E12Statement* stmt);
+
+/// Free a prepared statement (returns it to the statement cache when cached)
+/// @param stmt Statement handle to free
+void e12_stmt_free(E12Statement* stmt);
+
 // ============================================================================
 // Row Operations
 // ============================================================================
@@ -89,6 +301,20 @@ void e12_result_free(E12Result* result);
 /// @return Text value (owned by result, do not free), NULL if invalid or NULL in database
 const char* e12_row_get_text(E12Row* row, int col_index);
 
+/// Get the size in bytes of a text or blob value
+/// Call after e12_row_get_text so the size matches the UTF-8 text returned.
+/// @param row Row handle
+/// @param col_index Column index (0-based)
+/// @return Size in bytes (excluding the NUL terminator), or 0 if invalid or NULL
+int e12_row_get_bytes(E12Row* row, int col_index);
+
+/// Get a blob value from a row by column index
+/// @param row Row handle
+/// @param col_index Column index (0-based)
+/// @param out_len Output parameter for the size in bytes
+/// @return Blob data (owned by result, valid until the next row), NULL if empty, invalid or NULL
+const void* e12_row_get_blob(E12Row* row, int col_index, int* out_len);
+
 /// Get an integer value from a row by column index
 /// @param row Row handle
 /// @param col_index Column index (0-based)
@@ -135,6 +361,37 @@ E12ORMErrorCode e12_db_rollback(E12Transaction* transaction);
 /// @param transaction Transaction handle to free
 void e12_transaction_free(E12Transaction* transaction);
 
+// ============================================================================
+// Online Backup Operations
+// ============================================================================
+
+/// Start an online backup of db's main database into the file at dest_path
+/// The destination is opened (and created if missing) by the backup handle;
+/// its previous contents are replaced.
+/// @param db Source database handle
+/// @param dest_path Destination file path
+/// @param out_backup Output parameter for the backup handle
+/// @return E12_ORM_OK on success, error code on failure
+E12ORMErrorCode e12_backup_init(E12Database* db, const char* dest_path, E12Backup** out_backup);
+
+/// Copy up to `pages` pages (negative copies everything that is left)
+/// A busy or locked source is not an error: the step copies nothing and can be retried.
+/// @param backup Backup handle
+/// @param pages Number of pages to copy
+/// @param out_done Set to true once every page has been copied
+/// @return E12_ORM_OK on success, error code on failure
+E12ORMErrorCode e12_backup_step(E12Backup* backup, int pages, bool* out_done);
+
+/// Pages still to copy after the last step
+int e12_backup_remaining(E12Backup* backup);
+
+/// Total pages in the source as of the last step
+int e12_backup_pagecount(E12Backup* backup);
+
+/// Release the backup, close the destination and free the handle
+/// @return E12_ORM_OK if the backup completed without error
+E12ORMErrorCode e12_backup_finish(E12Backup* backup);
+
 // ============================================================================
 // Connection Pool Operations
 // ============================================================================
@@ -142,29 +399,79 @@ void e12_transaction_free(E12Transaction* transaction);
 /// Connection pool configuration
 typedef struct {
     size_t max_connections;
-    uint64_t idle_timeout_ms;
-    uint64_t acquire_timeout_ms;
+    uint64_t idle_timeout_ms;    // 0 disables idle eviction
+    uint64_t acquire_timeout_ms; // 0 fails immediately when the pool is exhausted
+    uint32_t open_flags;         // E12_OPEN_* flags for pooled connections
+    const char* init_sql;        // Run on every new connection (e.g. PRAGMAs), may be NULL
 } E12ConnectionPoolConfig;
 
+/// Number of buckets in the acquire wait-time histogram
+/// Upper bounds (microseconds): 100, 1000, 5000, 10000, 50000, 100000,
+/// 500000, 1000000, 5000000, +Inf
+#define E12_POOL_WAIT_BUCKET_COUNT 10
+
+/// Connection pool statistics
+typedef struct {
+    size_t max_connections;
+    size_t open_connections;
+    size_t in_use_connections;
+    size_t idle_connections;
+    size_t waiting_threads;
+    uint64_t acquires;            // Successful acquires
+    uint64_t waits;               // Acquires that had to queue
+    uint64_t timeouts;            // Acquires that gave up
+    uint64_t affinity_hits;       // Acquires that got the thread's previous connection
+    uint64_t connections_created;
+    uint64_t connections_evicted; // Closed after idle_timeout_ms
+    uint64_t wait_time_total_us;
+    uint64_t wait_histogram[E12_POOL_WAIT_BUCKET_COUNT]; // Per-bucket (non-cumulative) counts
+} E12PoolStats;
+
 /// Create a connection pool
+/// Connections are opened lazily. When idle_timeout_ms is non-zero a background
+/// thread closes connections that stay idle longer than that.
 /// @param path Database file path
 /// @param config Pool configuration
 /// @param out_pool Output parameter for the pool handle
 /// @return E12_ORM_OK on success, error code on failure
 E12ORMErrorCode e12_pool_create(const char* path, const E12ConnectionPoolConfig* config, E12ConnectionPool** out_pool);
 
-/// Acquire a connection from the pool
+/// Acquire a connection from the pool, waiting up to acquire_timeout_ms
+/// Waiters are served in FIFO order. Without contention the connection this
+/// thread released last is preferred, to keep its statement cache warm.
 /// @param pool Pool handle
 /// @param out_db Output parameter for the database handle
-/// @return E12_ORM_OK on success, error code on failure
+/// @return E12_ORM_OK on success, E12_ORM_ERROR_POOL_EXHAUSTED on timeout
 E12ORMErrorCode e12_pool_acquire(E12ConnectionPool* pool, E12Database** out_db);
 
+/// Acquire a connection from the pool with an explicit timeout
+/// @param pool Pool handle
+/// @param timeout_ms Maximum time to wait (0 = do not wait)
+/// @param out_db Output parameter for the database handle
+/// @return E12_ORM_OK on success, E12_ORM_ERROR_POOL_EXHAUSTED on timeout
+E12ORMErrorCode e12_pool_acquire_timeout(E12ConnectionPool* pool, uint64_t timeout_ms, E12Database** out_db);
+
 /// Return a connection to the pool
+/// Hands the connection directly to the oldest waiting thread, if any.
 /// @param pool Pool handle
 /// @param db Database handle to return
 void e12_pool_release(E12ConnectionPool* pool, E12Database* db);
 
+/// Get connection pool statistics
+/// @param pool Pool handle
+/// @param out_stats Output parameter for the statistics
+/// @return E12_ORM_OK on success, error code on failure
+E12ORMErrorCode e12_pool_get_stats(E12ConnectionPool* pool, E12PoolStats* out_stats);
+
+/// Get the upper bound of a wait-time histogram bucket
+/// @param index Bucket index (0 .. E12_POOL_WAIT_BUCKET_COUNT - 1)
+/// @return Upper bound in microseconds (UINT64_MAX for the last bucket)
+uint64_t e12_pool_wait_bucket_upper_bound_us(size_t index);
+
 /// Close a connection pool
+/// Wakes waiting threads (they fail with E12_ORM_ERROR_POOL_EXHAUSTED) and
+/// closes idle connections. Connections still checked out are closed when
+/// they are released.
 /// @param pool Pool handle to close
 void e12_pool_close(E12ConnectionPool* pool);
 
@@ -1,8 +1,15 @@
+// pthread_cond_timedwait / clock_gettime under -std=c99
+#define _POSIX_C_SOURCE 200809L
+
 #include "e12_orm.h"
 #include "sqlite3.h"
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include <stdio.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/stat.h>
 
 // Error state
 static E12ORMErrorCode last_error_code = E12_ORM_OK;
@@ -23,23 +30,108 @@ static void clear_error(void) {
     last_error_msg[0] = '\0';
 }
 
+// Prepared statement cache entry
+typedef struct E12StmtCacheEntry {
+    char* sql;
+    size_t sql_len;
+    uint64_t hash;
+    sqlite3_stmt* stmt;
+    bool in_use;
+    bool detached; // Removed from the cache while in use; finalized on release
+    struct E12StmtCacheEntry* lru_prev;
+    struct E12StmtCacheEntry* lru_next;
+    struct E12StmtCacheEntry* bucket_next;
+} E12StmtCacheEntry;
+
+// Per-connection LRU cache of prepared statements keyed by SQL text
+typedef struct {
+    E12StmtCacheEntry** buckets;
+    size_t bucket_count;
+    size_t capacity;
+    size_t size;
+    E12StmtCacheEntry* lru_head; // Most recently used
+    E12StmtCacheEntry* lru_tail; // Least recently used
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    sqlite3_mutex* mutex;
+} E12StmtCache;
+
+struct E12PoolImpl;
+
+// Open savepoint and how many rows were pending when it was created
+typedef struct {
+    char* name;
+    size_t mark;
+} E12ChangeSavepoint;
+
+// Change capture state for one connection. The SQLite hooks record rows into
+// `pending`; once flush_changes confirms the transaction committed they move
+// to `ready`, which it hands to the callback after the SQLite call returns.
+// Every API call that can end a transaction runs flush_changes before
+// returning, and scripts run it after each statement. Rows undone without
+// ending the transaction (a failed statement, ROLLBACK TO) are cut from
+// `pending` using the watermark taken before the statement or savepoint.
+typedef struct {
+    E12ChangeCallback callback;
+    void* ctx;
+    sqlite3_mutex* mutex;
+    E12ChangeEvent* pending; // Current transaction
+    size_t pending_count;
+    size_t pending_capacity;
+    E12ChangeEvent* ready;   // Committed, not yet delivered
+    size_t ready_count;
+    size_t ready_capacity;
+    char** tables;           // Interned table names referenced by events
+    size_t table_count;
+    size_t table_capacity;
+    E12ChangeSavepoint* savepoints; // Open savepoints, innermost last
+    size_t savepoint_count;
+    size_t savepoint_capacity;
+    bool commit_seen;        // Commit hook ran; not final until autocommit is back on
+} E12ChangeCapture;
+
 // Database structure
 typedef struct {
     sqlite3* db;
+    E12StmtCache stmt_cache;
+    E12ChangeCapture* changes; // NULL unless change capture is enabled
+    struct E12PoolImpl* pool; // Owning pool, NULL for standalone connections
+    size_t pool_slot;         // Index into the owning pool's slot array
 } E12DatabaseImpl;
 
-// Result structure
+typedef struct E12ResultImpl E12ResultImpl;
+
+// Row structure (just a pointer to the result)
 typedef struct {
+    E12ResultImpl* result;
+} E12RowImpl;
+
+// Result structure
+struct E12ResultImpl {
     sqlite3_stmt* stmt;
+    E12DatabaseImpl* db;
+    E12StmtCacheEntry* cache_entry; // NULL if the statement is not cached
     int column_count;
     bool has_row;
     bool row_fetched;
-} E12ResultImpl;
+    bool owns_stmt; // false when the result borrows a prepared E12Statement
+    size_t change_mark; // Pending change rows before the first step
+    E12RowImpl row; // Reusable row handle returned by e12_result_step
+};
 
-// Row structure (just a pointer to the result)
+// Prepared statement handle
 typedef struct {
-    E12ResultImpl* result;
-} E12RowImpl;
+    sqlite3_stmt* stmt;
+    E12DatabaseImpl* db;
+    E12StmtCacheEntry* cache_entry; // NULL if the statement is not cached
+} E12StatementImpl;
+
+// Online backup handle; owns the destination connection
+typedef struct {
+    sqlite3* dest;
+    sqlite3_backup* backup;
+} E12BackupImpl;
 
 // Transaction structure
 typedef struct {
@@ -48,11 +140,295 @@ typedef struct {
     bool rolled_back;
 } E12TransactionImpl;
 
+static void flush_changes(E12DatabaseImpl* db_impl);
+static size_t change_statement_mark(E12DatabaseImpl* db_impl);
+static void change_statement_done(E12DatabaseImpl* db_impl, sqlite3_stmt* stmt);
+static void change_statement_failed(E12DatabaseImpl* db_impl, size_t mark);
+static void change_capture_destroy(E12DatabaseImpl* db_impl);
+
+// ============================================================================
+// Statement Cache
+// ============================================================================
+
+static uint64_t stmt_cache_hash(const char* sql, size_t len) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (unsigned char)sql[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static size_t stmt_cache_bucket_count(size_t capacity) {
+    size_t count = 16;
+    while (count < capacity * 2) {
+        count <<= 1;
+    }
+    return count;
+}
+
+static bool stmt_cache_init(E12StmtCache* cache, size_t capacity) {
+    memset(cache, 0, sizeof(E12StmtCache));
+    cache->capacity = capacity;
+    cache->bucket_count = stmt_cache_bucket_count(capacity);
+    cache->buckets = (E12StmtCacheEntry**)calloc(cache->bucket_count, sizeof(E12StmtCacheEntry*));
+    if (!cache->buckets) {
+        return false;
+    }
+    // NULL when SQLite is built without mutexes; sqlite3_mutex_enter(NULL) is a no-op
+    cache->mutex = sqlite3_mutex_alloc(SQLITE_MUTEX_FAST);
+    return true;
+}
+
+static void stmt_cache_lru_unlink(E12StmtCache* cache, E12StmtCacheEntry* entry) {
+    if (entry->lru_prev) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    } else {
+        cache->lru_head = entry->lru_next;
+    }
+    if (entry->lru_next) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    } else {
+        cache->lru_tail = entry->lru_prev;
+    }
+    entry->lru_prev = NULL;
+    entry->lru_next = NULL;
+}
+
+static void stmt_cache_lru_push_front(E12StmtCache* cache, E12StmtCacheEntry* entry) {
+    entry->lru_prev = NULL;
+    entry->lru_next = cache->lru_head;
+    if (cache->lru_head) {
+        cache->lru_head->lru_prev = entry;
+    }
+    cache->lru_head = entry;
+    if (!cache->lru_tail) {
+        cache->lru_tail = entry;
+    }
+}
+
+static void stmt_cache_bucket_remove(E12StmtCache* cache, E12StmtCacheEntry* entry) {
+    E12StmtCacheEntry** link = &cache->buckets[entry->hash & (cache->bucket_count - 1)];
+    while (*link) {
+        if (*link == entry) {
+            *link = entry->bucket_next;
+            break;
+        }
+        link = &(*link)->bucket_next;
+    }
+    entry->bucket_next = NULL;
+}
+
+static void stmt_cache_entry_destroy(E12StmtCacheEntry* entry) {
+    if (entry->stmt) {
+        sqlite3_finalize(entry->stmt);
+    }
+    free(entry->sql);
+    free(entry);
+}
+
+// Remove an entry from the cache. Entries still held by a result are
+// detached and finalized when that result is released.
+// Caller must hold the cache mutex.
+static void stmt_cache_remove(E12StmtCache* cache, E12StmtCacheEntry* entry) {
+    stmt_cache_bucket_remove(cache, entry);
+    stmt_cache_lru_unlink(cache, entry);
+    cache->size--;
+    if (entry->in_use) {
+        entry->detached = true;
+    } else {
+        stmt_cache_entry_destroy(entry);
+    }
+}
+
+// Caller must hold the cache mutex.
+static void stmt_cache_clear_locked(E12StmtCache* cache) {
+    while (cache->lru_head) {
+        stmt_cache_remove(cache, cache->lru_head);
+    }
+}
+
+static void stmt_cache_destroy(E12StmtCache* cache) {
+    sqlite3_mutex_enter(cache->mutex);
+    stmt_cache_clear_locked(cache);
+    sqlite3_mutex_leave(cache->mutex);
+    free(cache->buckets);
+    cache->buckets = NULL;
+    if (cache->mutex) {
+        sqlite3_mutex_free(cache->mutex);
+        cache->mutex = NULL;
+    }
+}
+
+// Look up an idle cached statement for this SQL and mark it in use.
+// Returns NULL on a miss (including when the cached statement is busy).
+static E12StmtCacheEntry* stmt_cache_acquire(E12StmtCache* cache, const char* sql, size_t sql_len, uint64_t hash) {
+    E12StmtCacheEntry* found = NULL;
+
+    sqlite3_mutex_enter(cache->mutex);
+    if (cache->capacity > 0) {
+        E12StmtCacheEntry* entry = cache->buckets[hash & (cache->bucket_count - 1)];
+        while (entry) {
+            if (entry->hash == hash && entry->sql_len == sql_len && memcmp(entry->sql, sql, sql_len) == 0) {
+                break;
+            }
+            entry = entry->bucket_next;
+        }
+        if (entry && !entry->in_use) {
+            entry->in_use = true;
+            stmt_cache_lru_unlink(cache, entry);
+            stmt_cache_lru_push_front(cache, entry);
+            cache->hits++;
+            found = entry;
+        } else {
+            cache->misses++;
+        }
+    }
+    sqlite3_mutex_leave(cache->mutex);
+
+    return found;
+}
+
+// Insert a freshly prepared statement into the cache, evicting the least
+// recently used idle entry if the cache is full. Returns NULL if the
+// statement could not be cached, in which case the caller still owns it.
+static E12StmtCacheEntry* stmt_cache_insert(E12StmtCache* cache, const char* sql, size_t sql_len, uint64_t hash, sqlite3_stmt* stmt) {
+    E12StmtCacheEntry* entry = NULL;
+
+    sqlite3_mutex_enter(cache->mutex);
+    if (cache->capacity == 0) {
+        goto done;
+    }
+
+    // Another caller may have cached the same SQL while we were preparing
+    for (E12StmtCacheEntry* it = cache->buckets[hash & (cache->bucket_count - 1)]; it; it = it->bucket_next) {
+        if (it->hash == hash && it->sql_len == sql_len && memcmp(it->sql, sql, sql_len) == 0) {
+            goto done;
+        }
+    }
+
+    if (cache->size >= cache->capacity) {
+        E12StmtCacheEntry* victim = cache->lru_tail;
+        while (victim && victim->in_use) {
+            victim = victim->lru_prev;
+        }
+        if (!victim) {
+            goto done; // Every cached statement is busy
+        }
+        stmt_cache_remove(cache, victim);
+        cache->evictions++;
+    }
+
+    entry = (E12StmtCacheEntry*)calloc(1, sizeof(E12StmtCacheEntry));
+    if (!entry) {
+        goto done;
+    }
+    entry->sql = (char*)malloc(sql_len + 1);
+    if (!entry->sql) {
+        free(entry);
+        entry = NULL;
+        goto done;
+    }
+    memcpy(entry->sql, sql, sql_len);
+    entry->sql[sql_len] = '\0';
+    entry->sql_len = sql_len;
+    entry->hash = hash;
+    entry->stmt = stmt;
+    entry->in_use = true;
+
+    size_t bucket = hash & (cache->bucket_count - 1);
+    entry->bucket_next = cache->buckets[bucket];
+    cache->buckets[bucket] = entry;
+    stmt_cache_lru_push_front(cache, entry);
+    cache->size++;
+
+done:
+    sqlite3_mutex_leave(cache->mutex);
+    return entry;
+}
+
+// Return a cached statement to the cache, ready for reuse
+static void stmt_cache_release(E12StmtCache* cache, E12StmtCacheEntry* entry) {
+    sqlite3_reset(entry->stmt);
+    sqlite3_clear_bindings(entry->stmt);
+
+    sqlite3_mutex_enter(cache->mutex);
+    entry->in_use = false;
+    bool detached = entry->detached;
+    sqlite3_mutex_leave(cache->mutex);
+
+    if (detached) {
+        stmt_cache_entry_destroy(entry);
+    }
+}
+
+static bool sql_tail_is_empty(const char* tail) {
+    if (!tail) return true;
+    for (; *tail; tail++) {
+        if (*tail != ';' && *tail != ' ' && *tail != '\t' && *tail != '\n' && *tail != '\r') {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Prepare a statement through the connection's statement cache.
+// On success *out_stmt is the statement (NULL for empty SQL) and *out_entry
+// is its cache entry, or NULL if the caller owns the statement and must
+// finalize it. *out_tail points at any SQL left after the first statement.
+// Only single-statement SQL is cached.
+static int prepare_cached(E12DatabaseImpl* db_impl, const char* sql, sqlite3_stmt** out_stmt, E12StmtCacheEntry** out_entry, const char** out_tail) {
+    size_t sql_len = strlen(sql);
+    uint64_t hash = stmt_cache_hash(sql, sql_len);
+
+    *out_stmt = NULL;
+    *out_entry = NULL;
+    *out_tail = NULL;
+
+    E12StmtCacheEntry* entry = stmt_cache_acquire(&db_impl->stmt_cache, sql, sql_len, hash);
+    if (entry) {
+        *out_stmt = entry->stmt;
+        *out_entry = entry;
+        return SQLITE_OK;
+    }
+
+    sqlite3_stmt* stmt = NULL;
+    const char* tail = NULL;
+    int rc = sqlite3_prepare_v3(db_impl->db, sql, (int)sql_len + 1, SQLITE_PREPARE_PERSISTENT, &stmt, &tail);
+    if (rc != SQLITE_OK) {
+        if (stmt) {
+            sqlite3_finalize(stmt);
+        }
+        return rc;
+    }
+
+    if (stmt && sql_tail_is_empty(tail)) {
+        *out_entry = stmt_cache_insert(&db_impl->stmt_cache, sql, sql_len, hash, stmt);
+    }
+
+    *out_stmt = stmt;
+    *out_tail = tail;
+    return SQLITE_OK;
+}
+
+static void release_stmt(E12DatabaseImpl* db_impl, sqlite3_stmt* stmt, E12StmtCacheEntry* entry) {
+    if (entry) {
+        stmt_cache_release(&db_impl->stmt_cache, entry);
+    } else if (stmt) {
+        sqlite3_finalize(stmt);
+    }
+}
+
 // ============================================================================
 // Database Operations
 // ============================================================================
 
 E12ORMErrorCode e12_db_open(const char* path, E12Database** out_db) {
+    return e12_db_open_with_flags(path, 0, out_db);
+}
+
+E12ORMErrorCode e12_db_open_with_flags(const char* path, uint32_t flags, E12Database** out_db) {
     clear_error();
     
     if (!path || !out_db) {
@@ -66,7 +442,13 @@ E12ORMErrorCode e12_db_open(const char* path, E12Database** out_db) {
         return E12_ORM_ERROR;
     }
     
-    int rc = sqlite3_open(path, &db_impl->db);
+    int open_flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+    if (flags & E12_OPEN_READ_ONLY) {
+        open_flags = SQLITE_OPEN_READONLY;
+    } else if (flags & E12_OPEN_NO_CREATE) {
+        open_flags = SQLITE_OPEN_READWRITE;
+    }
+    int rc = sqlite3_open_v2(path, &db_impl->db, open_flags, NULL);
     if (rc != SQLITE_OK) {
         set_error(E12_ORM_ERROR_OPEN_FAILED, sqlite3_errmsg(db_impl->db));
         sqlite3_close(db_impl->db);
@@ -74,6 +456,16 @@ E12ORMErrorCode e12_db_open(const char* path, E12Database** out_db) {
         return E12_ORM_ERROR_OPEN_FAILED;
     }
     
+    if (!stmt_cache_init(&db_impl->stmt_cache, E12_STMT_CACHE_DEFAULT_CAPACITY)) {
+        set_error(E12_ORM_ERROR, "Memory allocation failed");
+        sqlite3_close(db_impl->db);
+        free(db_impl);
+        return E12_ORM_ERROR;
+    }
+    
+    db_impl->changes = NULL;
+    db_impl->pool = NULL;
+    db_impl->pool_slot = 0;
     *out_db = (E12Database*)db_impl;
     return E12_ORM_OK;
 }
@@ -82,6 +474,9 @@ void e12_db_close(E12Database* db) {
     if (!db) return;
     
     E12DatabaseImpl* db_impl = (E12DatabaseImpl*)db;
+    // Cached statements must be finalized before the connection can close
+    stmt_cache_destroy(&db_impl->stmt_cache);
+    change_capture_destroy(db_impl);
     if (db_impl->db) {
         sqlite3_close(db_impl->db);
     }
@@ -98,21 +493,534 @@ E12ORMErrorCode e12_db_execute(E12Database* db, const char* sql, int64_t* rows_a
     
     E12DatabaseImpl* db_impl = (E12DatabaseImpl*)db;
     
-    char* err_msg = NULL;
-    int rc = sqlite3_exec(db_impl->db, sql, NULL, NULL, &err_msg);
+    sqlite3_stmt* stmt = NULL;
+    E12StmtCacheEntry* entry = NULL;
+    const char* tail = NULL;
+    int rc = prepare_cached(db_impl, sql, &stmt, &entry, &tail);
     
     if (rc != SQLITE_OK) {
-        set_error(E12_ORM_ERROR_QUERY_FAILED, err_msg ? err_msg : "Query failed");
-        if (err_msg) {
-            sqlite3_free(err_msg);
-        }
+        set_error(E12_ORM_ERROR_QUERY_FAILED, sqlite3_errmsg(db_impl->db));
         return E12_ORM_ERROR_QUERY_FAILED;
     }
     
+    // Multi-statement scripts (e.g. migrations) are not cached
+    if (!entry && (!stmt || !sql_tail_is_empty(tail))) {
+        if (stmt) {
+            sqlite3_finalize(stmt);
+        }
+        
+        // One statement at a time, so a COMMIT inside the script is confirmed
+        // (or found to have failed) before the next statement writes
+        const char* next = sql;
+        while (next && *next) {
+            sqlite3_stmt* script_stmt = NULL;
+            rc = sqlite3_prepare_v2(db_impl->db, next, -1, &script_stmt, &next);
+            if (rc != SQLITE_OK) {
+                set_error(E12_ORM_ERROR_QUERY_FAILED, sqlite3_errmsg(db_impl->db));
+                flush_changes(db_impl);
+                return E12_ORM_ERROR_QUERY_FAILED;
+            }
+            if (!script_stmt) {
+                continue; // Whitespace or a comment
+            }
+            
+            size_t mark = change_statement_mark(db_impl);
+            do {
+                rc = sqlite3_step(script_stmt);
+            } while (rc == SQLITE_ROW);
+            
+            if (rc != SQLITE_DONE) {
+                set_error(E12_ORM_ERROR_QUERY_FAILED, sqlite3_errmsg(db_impl->db));
+                sqlite3_finalize(script_stmt);
+                change_statement_failed(db_impl, mark);
+                flush_changes(db_impl);
+                return E12_ORM_ERROR_QUERY_FAILED;
+            }
+            change_statement_done(db_impl, script_stmt);
+            sqlite3_finalize(script_stmt);
+            flush_changes(db_impl);
+        }
+    } else {
+        size_t mark = change_statement_mark(db_impl);
+        do {
+            rc = sqlite3_step(stmt);
+        } while (rc == SQLITE_ROW);
+        
+        if (rc != SQLITE_DONE) {
+            set_error(E12_ORM_ERROR_QUERY_FAILED, sqlite3_errmsg(db_impl->db));
+            release_stmt(db_impl, stmt, entry);
+            change_statement_failed(db_impl, mark);
+            flush_changes(db_impl);
+            return E12_ORM_ERROR_QUERY_FAILED;
+        }
+        
+        change_statement_done(db_impl, stmt);
+        release_stmt(db_impl, stmt, entry);
+    }
+    
     if (rows_affected) {
         *rows_affected = sqlite3_changes(db_impl->db);
     }
     
+    flush_changes(db_impl);
+    return E12_ORM_OK;
+}
+
+E12ORMErrorCode e12_db_set_statement_cache_capacity(E12Database* db, size_t capacity) {
+    clear_error();
+    
+    if (!db) {
+        set_error(E12_ORM_ERROR_INVALID_ARGUMENT, "Invalid arguments");
+        return E12_ORM_ERROR_INVALID_ARGUMENT;
+    }
+    
+    E12DatabaseImpl* db_impl = (E12DatabaseImpl*)db;
+    E12StmtCache* cache = &db_impl->stmt_cache;
+    
+    size_t bucket_count = stmt_cache_bucket_count(capacity);
+    E12StmtCacheEntry** buckets = (E12StmtCacheEntry**)calloc(bucket_count, sizeof(E12StmtCacheEntry*));
+    if (!buckets) {
+        set_error(E12_ORM_ERROR, "Memory allocation failed");
+        return E12_ORM_ERROR;
+    }
+    
+    sqlite3_mutex_enter(cache->mutex);
+    stmt_cache_clear_locked(cache);
+    free(cache->buckets);
+    cache->buckets = buckets;
+    cache->bucket_count = bucket_count;
+    cache->capacity = capacity;
+    sqlite3_mutex_leave(cache->mutex);
+    
+    return E12_ORM_OK;
+}
+
+void e12_db_get_statement_cache_stats(E12Database* db, E12StatementCacheStats* out_stats) {
+    if (!out_stats) return;
+    memset(out_stats, 0, sizeof(E12StatementCacheStats));
+    if (!db) return;
+    
+    E12DatabaseImpl* db_impl = (E12DatabaseImpl*)db;
+    E12StmtCache* cache = &db_impl->stmt_cache;
+    
+    sqlite3_mutex_enter(cache->mutex);
+    out_stats->hits = cache->hits;
+    out_stats->misses = cache->misses;
+    out_stats->evictions = cache->evictions;
+    out_stats->size = cache->size;
+    out_stats->capacity = cache->capacity;
+    sqlite3_mutex_leave(cache->mutex);
+}
+
+void e12_db_clear_statement_cache(E12Database* db) {
+    if (!db) return;
+    
+    E12DatabaseImpl* db_impl = (E12DatabaseImpl*)db;
+    sqlite3_mutex_enter(db_impl->stmt_cache.mutex);
+    stmt_cache_clear_locked(&db_impl->stmt_cache);
+    sqlite3_mutex_leave(db_impl->stmt_cache.mutex);
+}
+
+// ============================================================================
+// Runtime Status
+// ============================================================================
+
+static int64_t db_status_current(sqlite3* db, int op) {
+    int current = 0;
+    int highwater = 0;
+    if (sqlite3_db_status(db, op, &current, &highwater, 0) != SQLITE_OK) return 0;
+    return current;
+}
+
+static int64_t db_status_highwater(sqlite3* db, int op) {
+    // The LOOKASIDE_HIT/MISS counters only report through the high-water slot
+    int current = 0;
+    int highwater = 0;
+    if (sqlite3_db_status(db, op, &current, &highwater, 0) != SQLITE_OK) return 0;
+    return highwater;
+}
+
+void e12_db_get_status(E12Database* db, E12DbStatus* out_status) {
+    if (!out_status) return;
+    memset(out_status, 0, sizeof(E12DbStatus));
+    if (!db) return;
+
+    sqlite3* conn = ((E12DatabaseImpl*)db)->db;
+
+    out_status->cache_used = db_status_current(conn, SQLITE_DBSTATUS_CACHE_USED);
+    out_status->cache_hit = db_status_current(conn, SQLITE_DBSTATUS_CACHE_HIT);
+    out_status->cache_miss = db_status_current(conn, SQLITE_DBSTATUS_CACHE_MISS);
+    out_status->cache_write = db_status_current(conn, SQLITE_DBSTATUS_CACHE_WRITE);
+    out_status->cache_spill = db_status_current(conn, SQLITE_DBSTATUS_CACHE_SPILL);
+    out_status->lookaside_used = db_status_current(conn, SQLITE_DBSTATUS_LOOKASIDE_USED);
+    out_status->lookaside_hit = db_status_highwater(conn, SQLITE_DBSTATUS_LOOKASIDE_HIT);
+    out_status->lookaside_miss_size = db_status_highwater(conn, SQLITE_DBSTATUS_LOOKASIDE_MISS_SIZE);
+    out_status->lookaside_miss_full = db_status_highwater(conn, SQLITE_DBSTATUS_LOOKASIDE_MISS_FULL);
+    out_status->schema_used = db_status_current(conn, SQLITE_DBSTATUS_SCHEMA_USED);
+    out_status->stmt_used = db_status_current(conn, SQLITE_DBSTATUS_STMT_USED);
+
+    sqlite3_int64 current = 0;
+    sqlite3_int64 highwater = 0;
+    if (sqlite3_status64(SQLITE_STATUS_MEMORY_USED, &current, &highwater, 0) == SQLITE_OK) {
+        out_status->memory_used = current;
+        out_status->memory_highwater = highwater;
+    }
+    if (sqlite3_status64(SQLITE_STATUS_MALLOC_COUNT, &current, &highwater, 0) == SQLITE_OK) {
+        out_status->malloc_count = current;
+    }
+    if (sqlite3_status64(SQLITE_STATUS_PAGECACHE_OVERFLOW, &current, &highwater, 0) == SQLITE_OK) {
+        out_status->pagecache_overflow = current;
+    }
+
+    // In-memory and temporary databases have no file name and no WAL
+    const char* db_path = sqlite3_db_filename(conn, "main");
+    if (db_path && db_path[0] != '\0') {
+        const char* wal_path = sqlite3_filename_wal(db_path);
+        struct stat wal_stat;
+        if (wal_path && stat(wal_path, &wal_stat) == 0) {
+            out_status->wal_bytes = (int64_t)wal_stat.st_size;
+        }
+    }
+}
+
+// ============================================================================
+// Change Capture
+// ============================================================================
+
+static bool change_events_reserve(E12ChangeEvent** events, size_t* capacity, size_t needed) {
+    if (needed <= *capacity) return true;
+    size_t new_capacity = *capacity ? *capacity * 2 : 32;
+    while (new_capacity < needed) new_capacity *= 2;
+    E12ChangeEvent* grown = (E12ChangeEvent*)realloc(*events, new_capacity * sizeof(E12ChangeEvent));
+    if (!grown) return false;
+    *events = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+// Return a stable copy of a table name; tables are few, so a linear scan is enough
+static const char* change_intern_table(E12ChangeCapture* capture, const char* table) {
+    for (size_t i = 0; i < capture->table_count; i++) {
+        if (strcmp(capture->tables[i], table) == 0) return capture->tables[i];
+    }
+    if (capture->table_count == capture->table_capacity) {
+        size_t new_capacity = capture->table_capacity ? capture->table_capacity * 2 : 8;
+        char** grown = (char**)realloc(capture->tables, new_capacity * sizeof(char*));
+        if (!grown) return NULL;
+        capture->tables = grown;
+        capture->table_capacity = new_capacity;
+    }
+    size_t len = strlen(table);
+    char* copy = (char*)malloc(len + 1);
+    if (!copy) return NULL;
+    memcpy(copy, table, len + 1);
+    capture->tables[capture->table_count++] = copy;
+    return copy;
+}
+
+// Move the committed transaction's rows to the delivery list (mutex held)
+// Only called once the commit is confirmed.
+static void change_promote_locked(E12ChangeCapture* capture) {
+    capture->commit_seen = false;
+    if (capture->pending_count == 0) return;
+    if (change_events_reserve(&capture->ready, &capture->ready_capacity, capture->ready_count + capture->pending_count)) {
+        memcpy(capture->ready + capture->ready_count, capture->pending, capture->pending_count * sizeof(E12ChangeEvent));
+        capture->ready_count += capture->pending_count;
+    }
+    capture->pending_count = 0;
+}
+
+static void change_update_hook(void* arg, int op, const char* db_name, const char* table, sqlite3_int64 rowid) {
+    (void)db_name;
+    E12ChangeCapture* capture = (E12ChangeCapture*)arg;
+    sqlite3_mutex_enter(capture->mutex);
+
+    const char* name = change_intern_table(capture, table);
+    if (name) {
+        E12ChangeEvent event = { name, E12_CHANGE_UPDATE, rowid };
+        if (op == SQLITE_INSERT) event.op = E12_CHANGE_INSERT;
+        else if (op == SQLITE_DELETE) event.op = E12_CHANGE_DELETE;
+
+        bool record = true;
+        if (capture->pending_count >= E12_CHANGE_MAX_ROWS_PER_TXN) {
+            // Past the cap only one E12_CHANGE_MANY per table is kept
+            event.op = E12_CHANGE_MANY;
+            event.rowid = 0;
+            for (size_t i = E12_CHANGE_MAX_ROWS_PER_TXN; i < capture->pending_count; i++) {
+                if (capture->pending[i].table == name) {
+                    record = false;
+                    break;
+                }
+            }
+        }
+        if (record && change_events_reserve(&capture->pending, &capture->pending_capacity, capture->pending_count + 1)) {
+            capture->pending[capture->pending_count++] = event;
+        }
+    }
+
+    sqlite3_mutex_leave(capture->mutex);
+}
+
+static int change_commit_hook(void* arg) {
+    E12ChangeCapture* capture = (E12ChangeCapture*)arg;
+    sqlite3_mutex_enter(capture->mutex);
+    capture->commit_seen = true;
+    sqlite3_mutex_leave(capture->mutex);
+    return 0; // Never veto the commit
+}
+
+// Forget savepoints from `index` up (mutex held)
+static void change_savepoints_pop_locked(E12ChangeCapture* capture, size_t index) {
+    while (capture->savepoint_count > index) {
+        free(capture->savepoints[--capture->savepoint_count].name);
+    }
+}
+
+static void change_rollback_hook(void* arg) {
+    E12ChangeCapture* capture = (E12ChangeCapture*)arg;
+    sqlite3_mutex_enter(capture->mutex);
+    capture->pending_count = 0;
+    capture->commit_seen = false;
+    change_savepoints_pop_locked(capture, 0);
+    sqlite3_mutex_leave(capture->mutex);
+}
+
+// Pending rows before a statement runs
+static size_t change_statement_mark(E12DatabaseImpl* db_impl) {
+    E12ChangeCapture* capture = db_impl->changes;
+    if (!capture) return 0;
+    sqlite3_mutex_enter(capture->mutex);
+    size_t mark = capture->pending_count;
+    sqlite3_mutex_leave(capture->mutex);
+    return mark;
+}
+
+// A failed statement's own rows are undone by SQLite even when the transaction
+// stays open (a full rollback already went through the rollback hook).
+// ON CONFLICT FAIL keeps the rows written before the failing one; those are
+// dropped here too, so the feed can under-report such a statement.
+static void change_statement_failed(E12DatabaseImpl* db_impl, size_t mark) {
+    E12ChangeCapture* capture = db_impl->changes;
+    if (!capture) return;
+    sqlite3_mutex_enter(capture->mutex);
+    if (capture->pending_count > mark) capture->pending_count = mark;
+    sqlite3_mutex_leave(capture->mutex);
+}
+
+static const char* sql_skip_space(const char* p) {
+    for (;;) {
+        while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') p++;
+        if (p[0] == '-' && p[1] == '-') {
+            while (*p && *p != '\n') p++;
+        } else if (p[0] == '/' && p[1] == '*') {
+            const char* end = strstr(p + 2, "*/");
+            p = end ? end + 2 : p + strlen(p);
+        } else {
+            return p;
+        }
+    }
+}
+
+// Consume `keyword` (case-insensitive, whole word) and the space after it
+static bool sql_take_keyword(const char** p, const char* keyword) {
+    size_t len = strlen(keyword);
+    const char* s = sql_skip_space(*p);
+    if (sqlite3_strnicmp(s, keyword, (int)len) != 0) return false;
+    char next = s[len];
+    if (isalnum((unsigned char)next) || next == '_' || next == '$') return false;
+    *p = s + len;
+    return true;
+}
+
+// Savepoint name, without quotes; returns its length (0 when there is none)
+static size_t sql_take_name(const char* p, const char** out_name) {
+    p = sql_skip_space(p);
+    char close = 0;
+    if (*p == '"' || *p == '`' || *p == '\'') close = *p;
+    else if (*p == '[') close = ']';
+    if (close) {
+        const char* end = strchr(p + 1, close);
+        if (!end) return 0;
+        *out_name = p + 1;
+        return (size_t)(end - p - 1);
+    }
+    const char* end = p;
+    while (*end && (isalnum((unsigned char)*end) || *end == '_' || *end == '$' || (unsigned char)*end >= 0x80)) end++;
+    *out_name = p;
+    return (size_t)(end - p);
+}
+
+// Innermost open savepoint called `name`, or savepoint_count if none
+static size_t change_find_savepoint_locked(E12ChangeCapture* capture, const char* name, size_t len) {
+    for (size_t i = capture->savepoint_count; i > 0; i--) {
+        const char* candidate = capture->savepoints[i - 1].name;
+        if (strlen(candidate) == len && sqlite3_strnicmp(candidate, name, (int)len) == 0) return i - 1;
+    }
+    return capture->savepoint_count;
+}
+
+// Track SAVEPOINT, ROLLBACK TO and RELEASE once they have succeeded, so
+// ROLLBACK TO can drop the rows written since its savepoint
+static void change_statement_done(E12DatabaseImpl* db_impl, sqlite3_stmt* stmt) {
+    E12ChangeCapture* capture = db_impl->changes;
+    if (!capture) return;
+    const char* p = sqlite3_sql(stmt);
+    if (!p) return;
+
+    const char* name = NULL;
+    size_t len = 0;
+    if (sql_take_keyword(&p, "SAVEPOINT")) {
+        len = sql_take_name(p, &name);
+        if (len == 0) return;
+        char* copy = (char*)malloc(len + 1);
+        if (!copy) return;
+        memcpy(copy, name, len);
+        copy[len] = '\0';
+
+        sqlite3_mutex_enter(capture->mutex);
+        if (capture->savepoint_count == capture->savepoint_capacity) {
+            size_t new_capacity = capture->savepoint_capacity ? capture->savepoint_capacity * 2 : 4;
+            E12ChangeSavepoint* grown = (E12ChangeSavepoint*)realloc(capture->savepoints, new_capacity * sizeof(E12ChangeSavepoint));
+            if (!grown) {
+                sqlite3_mutex_leave(capture->mutex);
+                free(copy);
+                return;
+            }
+            capture->savepoints = grown;
+            capture->savepoint_capacity = new_capacity;
+        }
+        capture->savepoints[capture->savepoint_count].name = copy;
+        capture->savepoints[capture->savepoint_count].mark = capture->pending_count;
+        capture->savepoint_count++;
+        sqlite3_mutex_leave(capture->mutex);
+    } else if (sql_take_keyword(&p, "ROLLBACK")) {
+        sql_take_keyword(&p, "TRANSACTION");
+        if (!sql_take_keyword(&p, "TO")) return; // Plain ROLLBACK: the rollback hook handles it
+        sql_take_keyword(&p, "SAVEPOINT");
+        len = sql_take_name(p, &name);
+        if (len == 0) return;
+
+        sqlite3_mutex_enter(capture->mutex);
+        size_t index = change_find_savepoint_locked(capture, name, len);
+        // A savepoint opened before capture was enabled predates every pending row
+        size_t mark = index < capture->savepoint_count ? capture->savepoints[index].mark : 0;
+        if (capture->pending_count > mark) capture->pending_count = mark;
+        // ROLLBACK TO keeps the savepoint itself open
+        if (index < capture->savepoint_count) change_savepoints_pop_locked(capture, index + 1);
+        sqlite3_mutex_leave(capture->mutex);
+    } else if (sql_take_keyword(&p, "RELEASE")) {
+        sql_take_keyword(&p, "SAVEPOINT");
+        len = sql_take_name(p, &name);
+        if (len == 0) return;
+
+        sqlite3_mutex_enter(capture->mutex);
+        change_savepoints_pop_locked(capture, change_find_savepoint_locked(capture, name, len));
+        sqlite3_mutex_leave(capture->mutex);
+    }
+}
+
+// Deliver committed changes; called after each API call that can end a transaction
+static void flush_changes(E12DatabaseImpl* db_impl) {
+    E12ChangeCapture* capture = db_impl->changes;
+    if (!capture) return;
+
+    sqlite3_mutex_enter(capture->mutex);
+    // The commit hook runs before COMMIT can still fail: SQLITE_BUSY leaves the
+    // transaction open, so its rows stay pending until a later COMMIT or the
+    // rollback hook. Only autocommit being back on confirms the commit.
+    if (capture->commit_seen) {
+        if (sqlite3_get_autocommit(db_impl->db)) {
+            change_promote_locked(capture);
+        } else {
+            capture->commit_seen = false;
+        }
+    }
+    // Savepoints only live inside a transaction
+    if (capture->savepoint_count > 0 && sqlite3_get_autocommit(db_impl->db)) {
+        change_savepoints_pop_locked(capture, 0);
+    }
+    if (capture->ready_count == 0) {
+        sqlite3_mutex_leave(capture->mutex);
+        return;
+    }
+    E12ChangeEvent* events = capture->ready;
+    size_t count = capture->ready_count;
+    size_t capacity = capture->ready_capacity;
+    capture->ready = NULL;
+    capture->ready_count = 0;
+    capture->ready_capacity = 0;
+    E12ChangeCallback callback = capture->callback;
+    void* ctx = capture->ctx;
+    sqlite3_mutex_leave(capture->mutex);
+
+    callback(ctx, events, count);
+
+    // Hand the buffer back for the next transaction unless another one took its place
+    sqlite3_mutex_enter(capture->mutex);
+    if (!capture->ready) {
+        capture->ready = events;
+        capture->ready_capacity = capacity;
+        events = NULL;
+    }
+    sqlite3_mutex_leave(capture->mutex);
+    free(events);
+}
+
+static void change_capture_destroy(E12DatabaseImpl* db_impl) {
+    E12ChangeCapture* capture = db_impl->changes;
+    if (!capture) return;
+
+    sqlite3_update_hook(db_impl->db, NULL, NULL);
+    sqlite3_commit_hook(db_impl->db, NULL, NULL);
+    sqlite3_rollback_hook(db_impl->db, NULL, NULL);
+    db_impl->changes = NULL;
+
+    for (size_t i = 0; i < capture->table_count; i++) free(capture->tables[i]);
+    free(capture->tables);
+    free(capture->pending);
+    free(capture->ready);
+    change_savepoints_pop_locked(capture, 0);
+    free(capture->savepoints);
+    sqlite3_mutex_free(capture->mutex);
+    free(capture);
+}
+
+E12ORMErrorCode e12_db_set_change_callback(E12Database* db, E12ChangeCallback callback, void* ctx) {
+    clear_error();
+
+    if (!db) {
+        set_error(E12_ORM_ERROR_INVALID_ARGUMENT, "Invalid arguments");
+        return E12_ORM_ERROR_INVALID_ARGUMENT;
+    }
+
+    E12DatabaseImpl* db_impl = (E12DatabaseImpl*)db;
+    if (!callback) {
+        change_capture_destroy(db_impl);
+        return E12_ORM_OK;
+    }
+
+    if (db_impl->changes) {
+        sqlite3_mutex_enter(db_impl->changes->mutex);
+        db_impl->changes->callback = callback;
+        db_impl->changes->ctx = ctx;
+        sqlite3_mutex_leave(db_impl->changes->mutex);
+        return E12_ORM_OK;
+    }
+
+    E12ChangeCapture* capture = (E12ChangeCapture*)calloc(1, sizeof(E12ChangeCapture));
+    if (!capture) {
+        set_error(E12_ORM_ERROR, "Memory allocation failed");
+        return E12_ORM_ERROR;
+    }
+    // NULL when SQLite is built without mutexes; sqlite3_mutex_enter(NULL) is a no-op
+    capture->mutex = sqlite3_mutex_alloc(SQLITE_MUTEX_FAST);
+    capture->callback = callback;
+    capture->ctx = ctx;
+
+    db_impl->changes = capture;
+    sqlite3_update_hook(db_impl->db, change_update_hook, capture);
+    sqlite3_commit_hook(db_impl->db, change_commit_hook, capture);
+    sqlite3_rollback_hook(db_impl->db, change_rollback_hook, capture);
     return E12_ORM_OK;
 }
 
@@ -131,96 +1039,309 @@ E12ORMErrorCode e12_db_query(E12Database* db, const char* sql, E12Result** out_r
     E12DatabaseImpl* db_impl = (E12DatabaseImpl*)db;
     
     sqlite3_stmt* stmt = NULL;
-    int rc = sqlite3_prepare_v2(db_impl->db, sql, -1, &stmt, NULL);
+    E12StmtCacheEntry* entry = NULL;
+    const char* tail = NULL;
+    int rc = prepare_cached(db_impl, sql, &stmt, &entry, &tail);
     
     if (rc != SQLITE_OK) {
         set_error(E12_ORM_ERROR_QUERY_FAILED, sqlite3_errmsg(db_impl->db));
-        if (stmt) {
-            sqlite3_finalize(stmt);
-        }
+        return E12_ORM_ERROR_QUERY_FAILED;
+    }
+    
+    if (!stmt) {
+        set_error(E12_ORM_ERROR_QUERY_FAILED, "Empty SQL statement");
         return E12_ORM_ERROR_QUERY_FAILED;
     }
     
     E12ResultImpl* result_impl = (E12ResultImpl*)malloc(sizeof(E12ResultImpl));
     if (!result_impl) {
         set_error(E12_ORM_ERROR, "Memory allocation failed");
-        sqlite3_finalize(stmt);
+        release_stmt(db_impl, stmt, entry);
+        return E12_ORM_ERROR;
+    }
+    
+    result_impl->stmt = stmt;
+    result_impl->db = db_impl;
+    result_impl->cache_entry = entry;
+    result_impl->owns_stmt = true;
+    result_impl->column_count = sqlite3_column_count(stmt);
+    result_impl->has_row = false;
+    result_impl->row_fetched = false;
+    result_impl->change_mark = 0;
+    result_impl->row.result = result_impl;
+    
+    *out_result = (E12Result*)result_impl;
+    return E12_ORM_OK;
+}
+
+int e12_result_column_count(E12Result* result) {
+    if (!result) return 0;
+    E12ResultImpl* result_impl = (E12ResultImpl*)result;
+    return result_impl->column_count;
+}
+
+const char* e12_result_column_name(E12Result* result, int col_index) {
+    if (!result) return NULL;
+    E12ResultImpl* result_impl = (E12ResultImpl*)result;
+    if (col_index < 0 || col_index >= result_impl->column_count) {
+        return NULL;
+    }
+    return sqlite3_column_name(result_impl->stmt, col_index);
+}
+
+E12ORMErrorCode e12_result_step(E12Result* result, E12Row** out_row) {
+    if (!result || !out_row) {
+        set_error(E12_ORM_ERROR_INVALID_ARGUMENT, "Invalid arguments");
+        return E12_ORM_ERROR_INVALID_ARGUMENT;
+    }
+    
+    E12ResultImpl* result_impl = (E12ResultImpl*)result;
+    *out_row = NULL;
+    
+    // Once the statement is done, do not step it again (that would restart it)
+    if (result_impl->row_fetched && !result_impl->has_row) {
+        return E12_ORM_OK;
+    }
+    
+    if (!result_impl->row_fetched) {
+        result_impl->change_mark = change_statement_mark(result_impl->db);
+    }
+    int rc = sqlite3_step(result_impl->stmt);
+    result_impl->row_fetched = true;
+    result_impl->has_row = (rc == SQLITE_ROW);
+    
+    if (rc == SQLITE_ROW) {
+        *out_row = (E12Row*)&result_impl->row;
+        return E12_ORM_OK;
+    }
+    if (rc != SQLITE_DONE) {
+        set_error(E12_ORM_ERROR_QUERY_FAILED, sqlite3_errmsg(result_impl->db->db));
+        change_statement_failed(result_impl->db, result_impl->change_mark);
+        flush_changes(result_impl->db);
+        return E12_ORM_ERROR_QUERY_FAILED;
+    }
+    change_statement_done(result_impl->db, result_impl->stmt);
+    flush_changes(result_impl->db);
+    return E12_ORM_OK;
+}
+
+bool e12_result_next_row(E12Result* result, E12Row** out_row) {
+    if (!result || !out_row) return false;
+    
+    E12Row* row = NULL;
+    if (e12_result_step(result, &row) != E12_ORM_OK || !row) {
+        *out_row = NULL;
+        return false;
+    }
+    
+    // Separately allocated handle, released by the caller with e12_row_free
+    E12RowImpl* row_impl = (E12RowImpl*)malloc(sizeof(E12RowImpl));
+    if (!row_impl) {
+        *out_row = NULL;
+        return false;
+    }
+    
+    row_impl->result = (E12ResultImpl*)result;
+    *out_row = (E12Row*)row_impl;
+    return true;
+}
+
+void e12_result_free(E12Result* result) {
+    if (!result) return;
+    
+    E12ResultImpl* result_impl = (E12ResultImpl*)result;
+    E12DatabaseImpl* db_impl = result_impl->db;
+    if (result_impl->owns_stmt) {
+        release_stmt(db_impl, result_impl->stmt, result_impl->cache_entry);
+    } else {
+        // Borrowed statement: rewind it but keep its bindings
+        sqlite3_reset(result_impl->stmt);
+    }
+    free(result_impl);
+    // A write statement abandoned before SQLITE_DONE commits when it is reset
+    flush_changes(db_impl);
+}
+
+// ============================================================================
+// Prepared Statements
+// ============================================================================
+
+static E12ORMErrorCode bind_result(E12StatementImpl* stmt_impl, int rc) {
+    if (rc == SQLITE_OK) {
+        return E12_ORM_OK;
+    }
+    set_error(rc == SQLITE_RANGE ? E12_ORM_ERROR_INVALID_ARGUMENT : E12_ORM_ERROR_QUERY_FAILED,
+              sqlite3_errmsg(stmt_impl->db->db));
+    return rc == SQLITE_RANGE ? E12_ORM_ERROR_INVALID_ARGUMENT : E12_ORM_ERROR_QUERY_FAILED;
+}
+
+E12ORMErrorCode e12_db_prepare(E12Database* db, const char* sql, E12Statement** out_stmt) {
+    clear_error();
+    
+    if (!db || !sql || !out_stmt) {
+        set_error(E12_ORM_ERROR_INVALID_ARGUMENT, "Invalid arguments");
+        return E12_ORM_ERROR_INVALID_ARGUMENT;
+    }
+    
+    E12DatabaseImpl* db_impl = (E12DatabaseImpl*)db;
+    
+    sqlite3_stmt* stmt = NULL;
+    E12StmtCacheEntry* entry = NULL;
+    const char* tail = NULL;
+    int rc = prepare_cached(db_impl, sql, &stmt, &entry, &tail);
+    
+    if (rc != SQLITE_OK) {
+        set_error(E12_ORM_ERROR_QUERY_FAILED, sqlite3_errmsg(db_impl->db));
+        return E12_ORM_ERROR_QUERY_FAILED;
+    }
+    
+    if (!stmt || !sql_tail_is_empty(tail)) {
+        release_stmt(db_impl, stmt, entry);
+        set_error(E12_ORM_ERROR_INVALID_ARGUMENT, "Expected exactly one SQL statement");
+        return E12_ORM_ERROR_INVALID_ARGUMENT;
+    }
+    
+    E12StatementImpl* stmt_impl = (E12StatementImpl*)malloc(sizeof(E12StatementImpl));
+    if (!stmt_impl) {
+        set_error(E12_ORM_ERROR, "Memory allocation failed");
+        release_stmt(db_impl, stmt, entry);
+        return E12_ORM_ERROR;
+    }
+    
+    stmt_impl->stmt = stmt;
+    stmt_impl->db = db_impl;
+    stmt_impl->cache_entry = entry;
+    
+    *out_stmt = (E12Statement*)stmt_impl;
+    return E12_ORM_OK;
+}
+
+int e12_stmt_bind_parameter_count(E12Statement* stmt) {
+    if (!stmt) return 0;
+    E12StatementImpl* stmt_impl = (E12StatementImpl*)stmt;
+    return sqlite3_bind_parameter_count(stmt_impl->stmt);
+}
+
+E12ORMErrorCode e12_stmt_bind_null(E12Statement* stmt, int index) {
+    if (!stmt) return E12_ORM_ERROR_INVALID_ARGUMENT;
+    E12StatementImpl* stmt_impl = (E12StatementImpl*)stmt;
+    return bind_result(stmt_impl, sqlite3_bind_null(stmt_impl->stmt, index));
+}
+
+E12ORMErrorCode e12_stmt_bind_int64(E12Statement* stmt, int index, int64_t value) {
+    if (!stmt) return E12_ORM_ERROR_INVALID_ARGUMENT;
+    E12StatementImpl* stmt_impl = (E12StatementImpl*)stmt;
+    return bind_result(stmt_impl, sqlite3_bind_int64(stmt_impl->stmt, index, value));
+}
+
+E12ORMErrorCode e12_stmt_bind_double(E12Statement* stmt, int index, double value) {
+    if (!stmt) return E12_ORM_ERROR_INVALID_ARGUMENT;
+    E12StatementImpl* stmt_impl = (E12StatementImpl*)stmt;
+    return bind_result(stmt_impl, sqlite3_bind_double(stmt_impl->stmt, index, value));
+}
+
+E12ORMErrorCode e12_stmt_bind_text(E12Statement* stmt, int index, const char* text, int len) {
+    if (!stmt) return E12_ORM_ERROR_INVALID_ARGUMENT;
+    E12StatementImpl* stmt_impl = (E12StatementImpl*)stmt;
+    // SQLite binds NULL for a NULL pointer; an empty string must stay an empty string
+    return bind_result(stmt_impl, sqlite3_bind_text(stmt_impl->stmt, index, text ? text : "", len, SQLITE_STATIC));
+}
+
+E12ORMErrorCode e12_stmt_bind_blob(E12Statement* stmt, int index, const void* data, int len) {
+    if (!stmt) return E12_ORM_ERROR_INVALID_ARGUMENT;
+    E12StatementImpl* stmt_impl = (E12StatementImpl*)stmt;
+    if (!data || len == 0) {
+        return bind_result(stmt_impl, sqlite3_bind_zeroblob(stmt_impl->stmt, index, 0));
+    }
+    return bind_result(stmt_impl, sqlite3_bind_blob(stmt_impl->stmt, index, data, len, SQLITE_STATIC));
+}
+
+E12ORMErrorCode e12_stmt_execute(E12Statement* stmt, int64_t* rows_affected) {
+    clear_error();
+    
+    if (!stmt) {
+        set_error(E12_ORM_ERROR_INVALID_ARGUMENT, "Invalid arguments");
+        return E12_ORM_ERROR_INVALID_ARGUMENT;
+    }
+    
+    E12StatementImpl* stmt_impl = (E12StatementImpl*)stmt;
+    
+    size_t mark = change_statement_mark(stmt_impl->db);
+    int rc;
+    do {
+        rc = sqlite3_step(stmt_impl->stmt);
+    } while (rc == SQLITE_ROW);
+    
+    if (rc != SQLITE_DONE) {
+        set_error(E12_ORM_ERROR_QUERY_FAILED, sqlite3_errmsg(stmt_impl->db->db));
+        sqlite3_reset(stmt_impl->stmt);
+        change_statement_failed(stmt_impl->db, mark);
+        flush_changes(stmt_impl->db);
+        return E12_ORM_ERROR_QUERY_FAILED;
+    }
+    change_statement_done(stmt_impl->db, stmt_impl->stmt);
+    
+    if (rows_affected) {
+        *rows_affected = sqlite3_changes(stmt_impl->db->db);
+    }
+    
+    // Rewind so the statement can be executed again with new bindings
+    sqlite3_reset(stmt_impl->stmt);
+    flush_changes(stmt_impl->db);
+    return E12_ORM_OK;
+}
+
+E12ORMErrorCode e12_stmt_query(E12Statement* stmt, E12Result** out_result) {
+    clear_error();
+    
+    if (!stmt || !out_result) {
+        set_error(E12_ORM_ERROR_INVALID_ARGUMENT, "Invalid arguments");
+        return E12_ORM_ERROR_INVALID_ARGUMENT;
+    }
+    
+    E12StatementImpl* stmt_impl = (E12StatementImpl*)stmt;
+    
+    E12ResultImpl* result_impl = (E12ResultImpl*)malloc(sizeof(E12ResultImpl));
+    if (!result_impl) {
+        set_error(E12_ORM_ERROR, "Memory allocation failed");
         return E12_ORM_ERROR;
     }
     
-    result_impl->stmt = stmt;
-    result_impl->column_count = sqlite3_column_count(stmt);
+    result_impl->stmt = stmt_impl->stmt;
+    result_impl->db = stmt_impl->db;
+    result_impl->cache_entry = NULL;
+    result_impl->column_count = sqlite3_column_count(stmt_impl->stmt);
     result_impl->has_row = false;
     result_impl->row_fetched = false;
+    result_impl->change_mark = 0;
+    result_impl->row.result = result_impl;
+    result_impl->owns_stmt = false;
     
     *out_result = (E12Result*)result_impl;
     return E12_ORM_OK;
 }
 
-int e12_result_column_count(E12Result* result) {
-    if (!result) return 0;
-    E12ResultImpl* result_impl = (E12ResultImpl*)result;
-    return result_impl->column_count;
-}
-
-const char* e12_result_column_name(E12Result* result, int col_index) {
-    if (!result) return NULL;
-    E12ResultImpl* result_impl = (E12ResultImpl*)result;
-    if (col_index < 0 || col_index >= result_impl->column_count) {
-        return NULL;
-    }
-    return sqlite3_column_name(result_impl->stmt, col_index);
+void e12_stmt_reset(E12Statement* stmt) {
+    if (!stmt) return;
+    E12StatementImpl* stmt_impl = (E12StatementImpl*)stmt;
+    sqlite3_reset(stmt_impl->stmt);
+    // A write statement abandoned before SQLITE_DONE commits when it is reset
+    flush_changes(stmt_impl->db);
 }
 
-bool e12_result_next_row(E12Result* result, E12Row** out_row) {
-    if (!result || !out_row) return false;
-    
-    E12ResultImpl* result_impl = (E12ResultImpl*)result;
-    
-    // If we already fetched a row, step to the next one
-    if (result_impl->row_fetched) {
-        int rc = sqlite3_step(result_impl->stmt);
-        if (rc == SQLITE_ROW) {
-            result_impl->has_row = true;
-        } else {
-            result_impl->has_row = false;
-            *out_row = NULL;
-            return false;
-        }
-    } else {
-        // First row
-        int rc = sqlite3_step(result_impl->stmt);
-        result_impl->row_fetched = true;
-        if (rc == SQLITE_ROW) {
-            result_impl->has_row = true;
-        } else {
-            result_impl->has_row = false;
-            *out_row = NULL;
-            return false;
-        }
-    }
-    
-    // Create row handle
-    E12RowImpl* row_impl = (E12RowImpl*)malloc(sizeof(E12RowImpl));
-    if (!row_impl) {
-        result_impl->has_row = false;
-        *out_row = NULL;
-        return false;
-    }
-    
-    row_impl->result = result_impl;
-    *out_row = (E12Row*)row_impl;
-    return true;
+void e12_stmt_clear_bindings(E12Statement* stmt) {
+    if (!stmt) return;
+    E12StatementImpl* stmt_impl = (E12StatementImpl*)stmt;
+    sqlite3_clear_bindings(stmt_impl->stmt);
 }
 
-void e12_result_free(E12Result* result) {
-    if (!result) return;
-    
-    E12ResultImpl* result_impl = (E12ResultImpl*)result;
-    if (result_impl->stmt) {
-        sqlite3_finalize(result_impl->stmt);
-    }
-    free(result_impl);
+void e12_stmt_free(E12Statement* stmt) {
+    if (!stmt) return;
+    E12StatementImpl* stmt_impl = (E12StatementImpl*)stmt;
+    E12DatabaseImpl* db_impl = stmt_impl->db;
+    release_stmt(db_impl, stmt_impl->stmt, stmt_impl->cache_entry);
+    free(stmt_impl);
+    flush_changes(db_impl);
 }
 
 // ============================================================================
@@ -240,6 +1361,34 @@ const char* e12_row_get_text(E12Row* row, int col_index) {
     return (const char*)text;
 }
 
+int e12_row_get_bytes(E12Row* row, int col_index) {
+    if (!row) return 0;
+    
+    E12RowImpl* row_impl = (E12RowImpl*)row;
+    E12ResultImpl* result_impl = row_impl->result;
+    
+    if (!result_impl || !result_impl->has_row) return 0;
+    if (col_index < 0 || col_index >= result_impl->column_count) return 0;
+    
+    return sqlite3_column_bytes(result_impl->stmt, col_index);
+}
+
+const void* e12_row_get_blob(E12Row* row, int col_index, int* out_len) {
+    if (out_len) *out_len = 0;
+    if (!row) return NULL;
+    
+    E12RowImpl* row_impl = (E12RowImpl*)row;
+    E12ResultImpl* result_impl = row_impl->result;
+    
+    if (!result_impl || !result_impl->has_row) return NULL;
+    if (col_index < 0 || col_index >= result_impl->column_count) return NULL;
+    
+    // sqlite3_column_bytes must come after sqlite3_column_blob (it may convert the value)
+    const void* blob = sqlite3_column_blob(result_impl->stmt, col_index);
+    if (out_len) *out_len = sqlite3_column_bytes(result_impl->stmt, col_index);
+    return blob;
+}
+
 int64_t e12_row_get_int64(E12Row* row, int col_index) {
     if (!row) return 0;
     
@@ -348,10 +1497,13 @@ E12ORMErrorCode e12_db_commit(E12Transaction* transaction) {
         if (err_msg) {
             sqlite3_free(err_msg);
         }
+        // The commit hook already ran; this records that the commit did not happen
+        flush_changes(trans_impl->db);
         return E12_ORM_ERROR_QUERY_FAILED;
     }
     
     trans_impl->committed = true;
+    flush_changes(trans_impl->db);
     return E12_ORM_OK;
 }
 
@@ -398,37 +1550,629 @@ void e12_transaction_free(E12Transaction* transaction) {
     free(trans_impl);
 }
 
+// ============================================================================
+// Online Backup Operations
+// ============================================================================
+
+E12ORMErrorCode e12_backup_init(E12Database* db, const char* dest_path, E12Backup** out_backup) {
+    clear_error();
+
+    if (!db || !dest_path || !out_backup) {
+        set_error(E12_ORM_ERROR_INVALID_ARGUMENT, "Invalid arguments");
+        return E12_ORM_ERROR_INVALID_ARGUMENT;
+    }
+
+    E12DatabaseImpl* db_impl = (E12DatabaseImpl*)db;
+
+    sqlite3* dest = NULL;
+    int rc = sqlite3_open_v2(dest_path, &dest, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL);
+    if (rc != SQLITE_OK) {
+        set_error(E12_ORM_ERROR_OPEN_FAILED, dest ? sqlite3_errmsg(dest) : "Failed to open backup destination");
+        sqlite3_close(dest);
+        return E12_ORM_ERROR_OPEN_FAILED;
+    }
+
+    sqlite3_backup* backup = sqlite3_backup_init(dest, "main", db_impl->db, "main");
+    if (!backup) {
+        // Errors from sqlite3_backup_init are reported on the destination connection
+        set_error(E12_ORM_ERROR_QUERY_FAILED, sqlite3_errmsg(dest));
+        sqlite3_close(dest);
+        return E12_ORM_ERROR_QUERY_FAILED;
+    }
+
+    E12BackupImpl* backup_impl = (E12BackupImpl*)malloc(sizeof(E12BackupImpl));
+    if (!backup_impl) {
+        sqlite3_backup_finish(backup);
+        sqlite3_close(dest);
+        set_error(E12_ORM_ERROR, "Memory allocation failed");
+        return E12_ORM_ERROR;
+    }
+
+    backup_impl->dest = dest;
+    backup_impl->backup = backup;
+    *out_backup = (E12Backup*)backup_impl;
+    return E12_ORM_OK;
+}
+
+E12ORMErrorCode e12_backup_step(E12Backup* backup, int pages, bool* out_done) {
+    clear_error();
+
+    if (!backup || !out_done) {
+        set_error(E12_ORM_ERROR_INVALID_ARGUMENT, "Invalid arguments");
+        return E12_ORM_ERROR_INVALID_ARGUMENT;
+    }
+
+    E12BackupImpl* backup_impl = (E12BackupImpl*)backup;
+    int rc = sqlite3_backup_step(backup_impl->backup, pages);
+
+    *out_done = rc == SQLITE_DONE;
+    if (rc == SQLITE_DONE || rc == SQLITE_OK || rc == SQLITE_BUSY || rc == SQLITE_LOCKED) {
+        return E12_ORM_OK;
+    }
+
+    set_error(E12_ORM_ERROR_QUERY_FAILED, sqlite3_errstr(rc));
+    return E12_ORM_ERROR_QUERY_FAILED;
+}
+
+int e12_backup_remaining(E12Backup* backup) {
+    if (!backup) return 0;
+    return sqlite3_backup_remaining(((E12BackupImpl*)backup)->backup);
+}
+
+int e12_backup_pagecount(E12Backup* backup) {
+    if (!backup) return 0;
+    return sqlite3_backup_pagecount(((E12BackupImpl*)backup)->backup);
+}
+
+E12ORMErrorCode e12_backup_finish(E12Backup* backup) {
+    clear_error();
+
+    if (!backup) {
+        set_error(E12_ORM_ERROR_INVALID_ARGUMENT, "Invalid arguments");
+        return E12_ORM_ERROR_INVALID_ARGUMENT;
+    }
+
+    E12BackupImpl* backup_impl = (E12BackupImpl*)backup;
+    int rc = sqlite3_backup_finish(backup_impl->backup);
+    if (rc != SQLITE_OK) {
+        set_error(E12_ORM_ERROR_QUERY_FAILED, sqlite3_errmsg(backup_impl->dest));
+    }
+    sqlite3_close(backup_impl->dest);
+    free(backup_impl);
+
+    return rc == SQLITE_OK ? E12_ORM_OK : E12_ORM_ERROR_QUERY_FAILED;
+}
+
 // ============================================================================
 // Connection Pool Operations
 // ============================================================================
 
-// Note: Connection pooling is primarily implemented at the Zig level
-// These C functions are stubs for future expansion
+// Fair blocking pool. Waiters queue FIFO and released connections are handed
+// directly to the oldest waiter. With no waiters, acquire prefers the idle
+// connection the calling thread used last so its statement cache stays warm.
+
+static const uint64_t pool_wait_bucket_bounds_us[E12_POOL_WAIT_BUCKET_COUNT] = {
+    100, 1000, 5000, 10000, 50000, 100000, 500000, 1000000, 5000000, UINT64_MAX
+};
+
+typedef struct {
+    E12DatabaseImpl* db;      // NULL when the slot has no open connection
+    bool in_use;
+    bool has_owner;
+    pthread_t last_owner;     // Thread that released this connection last
+    uint64_t last_used_ms;
+    size_t idle_prev;         // Idle list links (SIZE_MAX = none)
+    size_t idle_next;
+} E12PoolSlot;
+
+typedef struct E12PoolWaiter {
+    pthread_cond_t cond;
+    size_t granted_slot;      // SIZE_MAX until a connection is handed over
+    bool can_open;            // Woken because a connection may be opened
+    struct E12PoolWaiter* next;
+    struct E12PoolWaiter* prev;
+} E12PoolWaiter;
+
+typedef struct E12PoolImpl {
+    char* path;
+    char* init_sql;           // Owned copy of config.init_sql
+    E12ConnectionPoolConfig config;
+    pthread_mutex_t mutex;
+    pthread_cond_t evictor_cond;
+    pthread_cond_t drain_cond;
+    pthread_t evictor;
+    bool evictor_started;
+    bool closing;
+    bool destroy_on_drain;    // Closed with connections still checked out
+    
+    E12PoolSlot* slots;
+    size_t* free_slots;       // Stack of slot indices without a connection
+    size_t free_count;
+    size_t idle_head;         // Most recently released
+    size_t idle_tail;         // Least recently released
+    
+    E12PoolWaiter* wait_head;
+    E12PoolWaiter* wait_tail;
+    
+    E12PoolStats stats;
+} E12PoolImpl;
+
+static uint64_t pool_monotonic_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ull + (uint64_t)ts.tv_nsec / 1000ull;
+}
+
+static struct timespec pool_deadline(uint64_t timeout_ms) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += (time_t)(timeout_ms / 1000);
+    ts.tv_nsec += (long)((timeout_ms % 1000) * 1000000);
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec += 1;
+        ts.tv_nsec -= 1000000000L;
+    }
+    return ts;
+}
+
+static void pool_idle_unlink(E12PoolImpl* pool, size_t index) {
+    E12PoolSlot* slot = &pool->slots[index];
+    if (slot->idle_prev != SIZE_MAX) {
+        pool->slots[slot->idle_prev].idle_next = slot->idle_next;
+    } else {
+        pool->idle_head = slot->idle_next;
+    }
+    if (slot->idle_next != SIZE_MAX) {
+        pool->slots[slot->idle_next].idle_prev = slot->idle_prev;
+    } else {
+        pool->idle_tail = slot->idle_prev;
+    }
+    slot->idle_prev = SIZE_MAX;
+    slot->idle_next = SIZE_MAX;
+    pool->stats.idle_connections--;
+}
+
+static void pool_idle_push_front(E12PoolImpl* pool, size_t index) {
+    E12PoolSlot* slot = &pool->slots[index];
+    slot->idle_prev = SIZE_MAX;
+    slot->idle_next = pool->idle_head;
+    if (pool->idle_head != SIZE_MAX) {
+        pool->slots[pool->idle_head].idle_prev = index;
+    } else {
+        pool->idle_tail = index;
+    }
+    pool->idle_head = index;
+    pool->stats.idle_connections++;
+}
+
+static void pool_waiter_unlink(E12PoolImpl* pool, E12PoolWaiter* waiter) {
+    if (waiter->prev) {
+        waiter->prev->next = waiter->next;
+    } else {
+        pool->wait_head = waiter->next;
+    }
+    if (waiter->next) {
+        waiter->next->prev = waiter->prev;
+    } else {
+        pool->wait_tail = waiter->prev;
+    }
+    waiter->next = NULL;
+    waiter->prev = NULL;
+    pool->stats.waiting_threads--;
+}
+
+static void pool_record_wait(E12PoolImpl* pool, uint64_t wait_us) {
+    pool->stats.wait_time_total_us += wait_us;
+    for (size_t i = 0; i < E12_POOL_WAIT_BUCKET_COUNT; i++) {
+        if (wait_us <= pool_wait_bucket_bounds_us[i]) {
+            pool->stats.wait_histogram[i]++;
+            break;
+        }
+    }
+}
+
+// Take an idle connection, preferring the one this thread released last.
+// Caller holds the pool mutex.
+static size_t pool_take_idle(E12PoolImpl* pool) {
+    if (pool->idle_head == SIZE_MAX) return SIZE_MAX;
+    
+    pthread_t self = pthread_self();
+    size_t chosen = pool->idle_head;
+    for (size_t i = pool->idle_head; i != SIZE_MAX; i = pool->slots[i].idle_next) {
+        if (pool->slots[i].has_owner && pthread_equal(pool->slots[i].last_owner, self)) {
+            chosen = i;
+            pool->stats.affinity_hits++;
+            break;
+        }
+    }
+    
+    pool_idle_unlink(pool, chosen);
+    pool->slots[chosen].in_use = true;
+    pool->stats.in_use_connections++;
+    return chosen;
+}
+
+// Open a new connection in a reserved slot. Called with the mutex held; the
+// mutex is released while SQLite opens the file. Returns SIZE_MAX on failure.
+static size_t pool_open_connection(E12PoolImpl* pool) {
+    size_t index = pool->free_slots[--pool->free_count];
+    pool->stats.open_connections++;
+    pool->stats.in_use_connections++;
+    pool->slots[index].in_use = true;
+    
+    pthread_mutex_unlock(&pool->mutex);
+    E12Database* db = NULL;
+    E12ORMErrorCode err = e12_db_open_with_flags(pool->path, pool->config.open_flags, &db);
+    if (err == E12_ORM_OK && pool->init_sql) {
+        err = e12_db_execute(db, pool->init_sql, NULL);
+        if (err != E12_ORM_OK) {
+            e12_db_close(db);
+            db = NULL;
+        }
+    }
+    pthread_mutex_lock(&pool->mutex);
+    
+    if (err != E12_ORM_OK) {
+        pool->slots[index].in_use = false;
+        pool->free_slots[pool->free_count++] = index;
+        pool->stats.open_connections--;
+        pool->stats.in_use_connections--;
+        // Capacity freed up again; let the next waiter try
+        if (pool->wait_head) {
+            pool->wait_head->can_open = true;
+            pthread_cond_signal(&pool->wait_head->cond);
+        }
+        return SIZE_MAX;
+    }
+    
+    E12DatabaseImpl* db_impl = (E12DatabaseImpl*)db;
+    db_impl->pool = pool;
+    db_impl->pool_slot = index;
+    pool->slots[index].db = db_impl;
+    pool->slots[index].has_owner = false;
+    pool->stats.connections_created++;
+    return index;
+}
+
+static void pool_destroy(E12PoolImpl* pool) {
+    pthread_cond_destroy(&pool->evictor_cond);
+    pthread_cond_destroy(&pool->drain_cond);
+    pthread_mutex_destroy(&pool->mutex);
+    free(pool->free_slots);
+    free(pool->slots);
+    free(pool->init_sql);
+    free(pool->path);
+    free(pool);
+}
+
+static void* pool_evictor_main(void* arg) {
+    E12PoolImpl* pool = (E12PoolImpl*)arg;
+    uint64_t interval_ms = pool->config.idle_timeout_ms / 2;
+    if (interval_ms < 10) interval_ms = 10;
+    if (interval_ms > 1000) interval_ms = 1000;
+    
+    pthread_mutex_lock(&pool->mutex);
+    while (!pool->closing) {
+        struct timespec deadline = pool_deadline(interval_ms);
+        pthread_cond_timedwait(&pool->evictor_cond, &pool->mutex, &deadline);
+        if (pool->closing) break;
+        
+        uint64_t now_ms = pool_monotonic_us() / 1000;
+        // Oldest idle connections sit at the tail
+        while (pool->idle_tail != SIZE_MAX) {
+            size_t index = pool->idle_tail;
+            E12PoolSlot* slot = &pool->slots[index];
+            if (now_ms - slot->last_used_ms < pool->config.idle_timeout_ms) break;
+            
+            pool_idle_unlink(pool, index);
+            E12DatabaseImpl* db_impl = slot->db;
+            slot->db = NULL;
+            slot->has_owner = false;
+            pool->stats.open_connections--;
+            pool->stats.connections_evicted++;
+            
+            pthread_mutex_unlock(&pool->mutex);
+            e12_db_close((E12Database*)db_impl);
+            pthread_mutex_lock(&pool->mutex);
+            
+            pool->free_slots[pool->free_count++] = index;
+            // A waiter queued while the lock was dropped can open the freed slot
+            if (pool->wait_head) {
+                pool->wait_head->can_open = true;
+                pthread_cond_signal(&pool->wait_head->cond);
+            }
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
 
 E12ORMErrorCode e12_pool_create(const char* path, const E12ConnectionPoolConfig* config, E12ConnectionPool** out_pool) {
     clear_error();
-    (void)path;
-    (void)config;
-    (void)out_pool;
-    set_error(E12_ORM_ERROR, "Connection pooling not yet implemented in C API");
-    return E12_ORM_ERROR;
+    
+    if (!path || !config || !out_pool || config->max_connections == 0) {
+        set_error(E12_ORM_ERROR_INVALID_ARGUMENT, "Invalid arguments");
+        return E12_ORM_ERROR_INVALID_ARGUMENT;
+    }
+    
+    E12PoolImpl* pool = (E12PoolImpl*)calloc(1, sizeof(E12PoolImpl));
+    if (!pool) {
+        set_error(E12_ORM_ERROR, "Memory allocation failed");
+        return E12_ORM_ERROR;
+    }
+    
+    size_t path_len = strlen(path);
+    pool->path = (char*)malloc(path_len + 1);
+    pool->slots = (E12PoolSlot*)calloc(config->max_connections, sizeof(E12PoolSlot));
+    pool->free_slots = (size_t*)malloc(config->max_connections * sizeof(size_t));
+    if (config->init_sql) {
+        size_t init_len = strlen(config->init_sql);
+        pool->init_sql = (char*)malloc(init_len + 1);
+        if (pool->init_sql) memcpy(pool->init_sql, config->init_sql, init_len + 1);
+    }
+    if (!pool->path || !pool->slots || !pool->free_slots || (config->init_sql && !pool->init_sql)) {
+        free(pool->init_sql);
+        free(pool->path);
+        free(pool->slots);
+        free(pool->free_slots);
+        free(pool);
+        set_error(E12_ORM_ERROR, "Memory allocation failed");
+        return E12_ORM_ERROR;
+    }
+    memcpy(pool->path, path, path_len + 1);
+    pool->config = *config;
+    pool->config.init_sql = pool->init_sql;
+    
+    // Hand out low slot indices first
+    for (size_t i = 0; i < config->max_connections; i++) {
+        pool->slots[i].idle_prev = SIZE_MAX;
+        pool->slots[i].idle_next = SIZE_MAX;
+        pool->free_slots[i] = config->max_connections - 1 - i;
+    }
+    pool->free_count = config->max_connections;
+    pool->idle_head = SIZE_MAX;
+    pool->idle_tail = SIZE_MAX;
+    pool->stats.max_connections = config->max_connections;
+    
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->evictor_cond, NULL);
+    pthread_cond_init(&pool->drain_cond, NULL);
+    
+    if (config->idle_timeout_ms > 0) {
+        if (pthread_create(&pool->evictor, NULL, pool_evictor_main, pool) == 0) {
+            pool->evictor_started = true;
+        }
+    }
+    
+    *out_pool = (E12ConnectionPool*)pool;
+    return E12_ORM_OK;
 }
 
 E12ORMErrorCode e12_pool_acquire(E12ConnectionPool* pool, E12Database** out_db) {
+    if (!pool) {
+        clear_error();
+        set_error(E12_ORM_ERROR_INVALID_ARGUMENT, "Invalid arguments");
+        return E12_ORM_ERROR_INVALID_ARGUMENT;
+    }
+    return e12_pool_acquire_timeout(pool, ((E12PoolImpl*)pool)->config.acquire_timeout_ms, out_db);
+}
+
+E12ORMErrorCode e12_pool_acquire_timeout(E12ConnectionPool* pool, uint64_t timeout_ms, E12Database** out_db) {
     clear_error();
-    (void)pool;
-    (void)out_db;
-    set_error(E12_ORM_ERROR, "Connection pooling not yet implemented in C API");
-    return E12_ORM_ERROR;
+    
+    if (!pool || !out_db) {
+        set_error(E12_ORM_ERROR_INVALID_ARGUMENT, "Invalid arguments");
+        return E12_ORM_ERROR_INVALID_ARGUMENT;
+    }
+    
+    E12PoolImpl* pool_impl = (E12PoolImpl*)pool;
+    uint64_t start_us = pool_monotonic_us();
+    size_t index = SIZE_MAX;
+    bool open_failed = false;
+    
+    pthread_mutex_lock(&pool_impl->mutex);
+    
+    if (pool_impl->closing) {
+        pthread_mutex_unlock(&pool_impl->mutex);
+        set_error(E12_ORM_ERROR_INVALID_ARGUMENT, "Connection pool is closing");
+        return E12_ORM_ERROR_INVALID_ARGUMENT;
+    }
+    
+    // Fast path, only when nobody is queued ahead of us
+    if (!pool_impl->wait_head) {
+        index = pool_take_idle(pool_impl);
+        if (index == SIZE_MAX && pool_impl->free_count > 0) {
+            index = pool_open_connection(pool_impl);
+            if (index == SIZE_MAX) {
+                pthread_mutex_unlock(&pool_impl->mutex);
+                set_error(E12_ORM_ERROR_OPEN_FAILED, "Failed to open pooled connection");
+                return E12_ORM_ERROR_OPEN_FAILED;
+            }
+        }
+    }
+    
+    if (index == SIZE_MAX && timeout_ms > 0) {
+        E12PoolWaiter waiter;
+        pthread_cond_init(&waiter.cond, NULL);
+        waiter.granted_slot = SIZE_MAX;
+        waiter.can_open = false;
+        waiter.next = NULL;
+        waiter.prev = pool_impl->wait_tail;
+        if (pool_impl->wait_tail) {
+            pool_impl->wait_tail->next = &waiter;
+        } else {
+            pool_impl->wait_head = &waiter;
+        }
+        pool_impl->wait_tail = &waiter;
+        pool_impl->stats.waiting_threads++;
+        pool_impl->stats.waits++;
+        
+        struct timespec deadline = pool_deadline(timeout_ms);
+        bool queued = true;
+        while (waiter.granted_slot == SIZE_MAX && !pool_impl->closing) {
+            // Head of the queue may open a connection if capacity is available
+            if (pool_impl->wait_head == &waiter && pool_impl->free_count > 0) {
+                pool_waiter_unlink(pool_impl, &waiter);
+                queued = false;
+                index = pool_open_connection(pool_impl);
+                open_failed = (index == SIZE_MAX);
+                break;
+            }
+            waiter.can_open = false;
+            if (pthread_cond_timedwait(&waiter.cond, &pool_impl->mutex, &deadline) != 0 &&
+                waiter.granted_slot == SIZE_MAX && !waiter.can_open) {
+                break; // Timed out
+            }
+        }
+        
+        if (waiter.granted_slot != SIZE_MAX) {
+            // Releaser already unlinked us and marked the slot in use
+            index = waiter.granted_slot;
+        } else if (queued) {
+            pool_waiter_unlink(pool_impl, &waiter);
+            // Pass a pending "can open" wake-up on to the next waiter
+            if (pool_impl->wait_head && pool_impl->free_count > 0) {
+                pool_impl->wait_head->can_open = true;
+                pthread_cond_signal(&pool_impl->wait_head->cond);
+            }
+        }
+        pthread_cond_destroy(&waiter.cond);
+        
+        if (pool_impl->closing && pool_impl->stats.waiting_threads == 0) {
+            pthread_cond_broadcast(&pool_impl->drain_cond);
+        }
+    }
+    
+    if (open_failed) {
+        pthread_mutex_unlock(&pool_impl->mutex);
+        set_error(E12_ORM_ERROR_OPEN_FAILED, "Failed to open pooled connection");
+        return E12_ORM_ERROR_OPEN_FAILED;
+    }
+    
+    if (index == SIZE_MAX) {
+        bool closing = pool_impl->closing;
+        pool_impl->stats.timeouts++;
+        pthread_mutex_unlock(&pool_impl->mutex);
+        set_error(E12_ORM_ERROR_POOL_EXHAUSTED, closing ? "Connection pool is closing" : "Timed out waiting for a pooled connection");
+        return E12_ORM_ERROR_POOL_EXHAUSTED;
+    }
+    
+    pool_impl->stats.acquires++;
+    pool_record_wait(pool_impl, pool_monotonic_us() - start_us);
+    *out_db = (E12Database*)pool_impl->slots[index].db;
+    pthread_mutex_unlock(&pool_impl->mutex);
+    return E12_ORM_OK;
 }
 
 void e12_pool_release(E12ConnectionPool* pool, E12Database* db) {
-    (void)pool;
-    (void)db;
+    if (!pool || !db) return;
+    
+    E12PoolImpl* pool_impl = (E12PoolImpl*)pool;
+    E12DatabaseImpl* db_impl = (E12DatabaseImpl*)db;
+    if (db_impl->pool != pool_impl) return;
+    
+    pthread_mutex_lock(&pool_impl->mutex);
+    
+    size_t index = db_impl->pool_slot;
+    E12PoolSlot* slot = &pool_impl->slots[index];
+    if (!slot->in_use) {
+        pthread_mutex_unlock(&pool_impl->mutex);
+        return; // Double release
+    }
+    
+    slot->last_owner = pthread_self();
+    slot->has_owner = true;
+    slot->last_used_ms = pool_monotonic_us() / 1000;
+    
+    if (pool_impl->closing) {
+        slot->in_use = false;
+        slot->db = NULL;
+        pool_impl->stats.in_use_connections--;
+        pool_impl->stats.open_connections--;
+        pool_impl->free_slots[pool_impl->free_count++] = index;
+        bool destroy = pool_impl->destroy_on_drain && pool_impl->stats.in_use_connections == 0;
+        pthread_mutex_unlock(&pool_impl->mutex);
+        e12_db_close(db);
+        if (destroy) {
+            pool_destroy(pool_impl);
+        }
+        return;
+    }
+    
+    if (pool_impl->wait_head) {
+        // Hand the connection straight to the oldest waiter; it stays in use
+        E12PoolWaiter* waiter = pool_impl->wait_head;
+        pool_waiter_unlink(pool_impl, waiter);
+        waiter->granted_slot = index;
+        pthread_cond_signal(&waiter->cond);
+    } else {
+        slot->in_use = false;
+        pool_impl->stats.in_use_connections--;
+        pool_idle_push_front(pool_impl, index);
+    }
+    
+    pthread_mutex_unlock(&pool_impl->mutex);
+}
+
+E12ORMErrorCode e12_pool_get_stats(E12ConnectionPool* pool, E12PoolStats* out_stats) {
+    clear_error();
+    
+    if (!pool || !out_stats) {
+        set_error(E12_ORM_ERROR_INVALID_ARGUMENT, "Invalid arguments");
+        return E12_ORM_ERROR_INVALID_ARGUMENT;
+    }
+    
+    E12PoolImpl* pool_impl = (E12PoolImpl*)pool;
+    pthread_mutex_lock(&pool_impl->mutex);
+    *out_stats = pool_impl->stats;
+    pthread_mutex_unlock(&pool_impl->mutex);
+    return E12_ORM_OK;
+}
+
+uint64_t e12_pool_wait_bucket_upper_bound_us(size_t index) {
+    if (index >= E12_POOL_WAIT_BUCKET_COUNT) return UINT64_MAX;
+    return pool_wait_bucket_bounds_us[index];
 }
 
 void e12_pool_close(E12ConnectionPool* pool) {
-    (void)pool;
+    if (!pool) return;
+    
+    E12PoolImpl* pool_impl = (E12PoolImpl*)pool;
+    
+    pthread_mutex_lock(&pool_impl->mutex);
+    pool_impl->closing = true;
+    pthread_cond_signal(&pool_impl->evictor_cond);
+    for (E12PoolWaiter* waiter = pool_impl->wait_head; waiter; waiter = waiter->next) {
+        pthread_cond_signal(&waiter->cond);
+    }
+    // Waiters live on their own stacks; wait until all have left
+    while (pool_impl->stats.waiting_threads > 0) {
+        pthread_cond_wait(&pool_impl->drain_cond, &pool_impl->mutex);
+    }
+    pthread_mutex_unlock(&pool_impl->mutex);
+    
+    if (pool_impl->evictor_started) {
+        pthread_join(pool_impl->evictor, NULL);
+    }
+    
+    pthread_mutex_lock(&pool_impl->mutex);
+    while (pool_impl->idle_head != SIZE_MAX) {
+        size_t index = pool_impl->idle_head;
+        pool_idle_unlink(pool_impl, index);
+        e12_db_close((E12Database*)pool_impl->slots[index].db);
+        pool_impl->slots[index].db = NULL;
+        pool_impl->stats.open_connections--;
+    }
+    // Connections still checked out are closed as they are released, and the
+    // last release frees the pool
+    if (pool_impl->stats.in_use_connections > 0) {
+        pool_impl->destroy_on_drain = true;
+        pthread_mutex_unlock(&pool_impl->mutex);
+        return;
+    }
+    pthread_mutex_unlock(&pool_impl->mutex);
+    
+    pool_destroy(pool_impl);
 }
 
 // ============================================================================
@@ -2,6 +2,7 @@ const std = @import("std");
 const Request = @import("request.zig").Request;
 const Response = @import("response.zig").Response;
 const middleware_chain = @import("middleware.zig");
+const change_feed = @import("orm/change_feed.zig");
 
 /// Cache-specific errors
 pub const CacheError = error{
@@ -28,6 +29,9 @@ pub const CacheEntry = struct {
     /// Content type
     content_type: []const u8,
 
+    /// Invalidation tags, usually the tables the body was read from
+    tags: []const []const u8 = &.{},
+
     pub fn init(allocator: std.mem.Allocator, body: []const u8, ttl_ms: u64, content_type: []const u8) (CacheError || std.mem.Allocator.Error || std.fmt.ParseFloatError || error{NoSpaceLeft})!CacheEntry {
         // Input validation
         if (body.len == 0) {
@@ -67,10 +71,20 @@ pub const CacheEntry = struct {
         return std.time.milliTimestamp() >= self.expires_at;
     }
 
+    /// Whether the entry carries `tag` (compared case-insensitively, like SQL table names)
+    pub fn hasTag(self: *const CacheEntry, tag: []const u8) bool {
+        for (self.tags) |t| {
+            if (std.ascii.eqlIgnoreCase(t, tag)) return true;
+        }
+        return false;
+    }
+
     pub fn deinit(self: *CacheEntry, allocator: std.mem.Allocator) void {
         allocator.free(self.body);
         allocator.free(self.etag);
         allocator.free(self.content_type);
+        for (self.tags) |tag| allocator.free(tag);
+        if (self.tags.len > 0) allocator.free(self.tags);
     }
 };
 
@@ -154,6 +168,19 @@ pub const ResponseCache = struct {
     /// - Body must not be empty
     /// - Content type must not be empty
     pub fn set(self: *ResponseCache, key: []const u8, body: []const u8, ttl_ms: ?u64, content_type: []const u8) (CacheError || std.mem.Allocator.Error || std.fmt.ParseFloatError || error{NoSpaceLeft})!void {
+        return self.setTagged(key, body, ttl_ms, content_type, &.{});
+    }
+
+    /// Store a response tagged for invalidation with `invalidateTag()`
+    /// Tag entries with the tables they were read from and let `followChanges()`
+    /// drop them when those tables change, whoever wrote to them.
+    ///
+    /// Example:
+    /// ```zig
+    /// try cache.setTagged("/api/todos?page=1", body, 60_000, "application/json", &.{"todos"});
+    /// cache.invalidateTag("todos");
+    /// ```
+    pub fn setTagged(self: *ResponseCache, key: []const u8, body: []const u8, ttl_ms: ?u64, content_type: []const u8, tags: []const []const u8) (CacheError || std.mem.Allocator.Error || std.fmt.ParseFloatError || error{NoSpaceLeft})!void {
         // Input validation
         if (key.len == 0) {
             std.debug.print("[Cache] Error: Attempted to cache with empty key\n", .{});
@@ -198,10 +225,14 @@ pub const ResponseCache = struct {
         const key_copy = try self.allocator.dupe(u8, key);
         errdefer self.allocator.free(key_copy);
 
-        const entry = try CacheEntry.init(self.allocator, body, cache_ttl, content_type);
-        errdefer {
-            var mutable_entry = entry;
-            mutable_entry.deinit(self.allocator);
+        var entry = try CacheEntry.init(self.allocator, body, cache_ttl, content_type);
+        errdefer entry.deinit(self.allocator);
+
+        if (tags.len > 0) {
+            const tag_copies = try self.allocator.alloc([]const u8, tags.len);
+            for (tag_copies) |*tag| tag.* = "";
+            entry.tags = tag_copies;
+            for (tags, tag_copies) |tag, *copy| copy.* = try self.allocator.dupe(u8, tag);
         }
 
         try self.entries.put(key_copy, entry);
@@ -258,6 +289,56 @@ pub const ResponseCache = struct {
         }
     }
 
+    /// Invalidate every entry tagged with `tag`
+    /// Thread-safe: Uses mutex protection for concurrent access
+    pub fn invalidateTag(self: *ResponseCache, tag: []const u8) void {
+        if (tag.len == 0) return;
+
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        self.invalidateTagsLocked(&.{tag});
+    }
+
+    /// Drop entries tagged with any table in each committed change batch
+    /// Covers writes the REST API never sees, such as raw SQL in handlers and valves.
+    ///
+    /// Example:
+    /// ```zig
+    /// const feed = try orm.enableChangeFeed(.{});
+    /// try cache.followChanges(feed);
+    /// ```
+    pub fn followChanges(self: *ResponseCache, feed: *change_feed.ChangeFeed) !void {
+        try feed.subscribe(onChanges, self);
+    }
+
+    fn onChanges(context: ?*anyopaque, batch: *const change_feed.ChangeBatch) void {
+        const self: *ResponseCache = @ptrCast(@alignCast(context.?));
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        self.invalidateTagsLocked(batch.tables);
+    }
+
+    fn invalidateTagsLocked(self: *ResponseCache, tags: []const []const u8) void {
+        var keys_to_remove = std.ArrayListUnmanaged([]const u8){};
+        defer keys_to_remove.deinit(self.allocator);
+
+        var iterator = self.entries.iterator();
+        while (iterator.next()) |entry| {
+            const tagged = for (tags) |tag| {
+                if (entry.value_ptr.hasTag(tag)) break true;
+            } else false;
+            if (tagged) keys_to_remove.append(self.allocator, entry.key_ptr.*) catch continue;
+        }
+
+        for (keys_to_remove.items) |key| {
+            if (self.entries.fetchRemove(key)) |removed| {
+                var mutable_value = removed.value;
+                mutable_value.deinit(self.allocator);
+                self.allocator.free(removed.key);
+            }
+        }
+    }
+
     /// Clean up expired entries
     /// Thread-safe: Uses mutex protection for concurrent access
     pub fn cleanup(self: *ResponseCache) void {
@@ -470,6 +551,31 @@ test "ResponseCache invalidatePrefix removes matching entries" {
     try std.testing.expect(cache.get("/other") != null);
 }
 
+test "ResponseCache invalidates tagged entries on tag and change batch" {
+    var cache = ResponseCache.init(std.testing.allocator, 1000);
+    defer cache.deinit();
+
+    try cache.setTagged("/api/todos", "todos body", null, "application/json", &.{"todos"});
+    try cache.setTagged("/api/dashboard", "dashboard body", null, "application/json", &.{ "todos", "users" });
+    try cache.setTagged("/api/users", "users body", null, "application/json", &.{"users"});
+    try cache.set("/about", "about body", null, "text/html");
+
+    cache.invalidateTag("TODOS");
+    try std.testing.expect(cache.get("/api/todos") == null);
+    try std.testing.expect(cache.get("/api/dashboard") == null);
+    try std.testing.expect(cache.get("/api/users") != null);
+
+    const batch = change_feed.ChangeBatch{
+        .first_seq = 1,
+        .last_seq = 1,
+        .changes = &.{.{ .table = "users", .op = .update, .rowid = 3 }},
+        .tables = &.{"users"},
+    };
+    ResponseCache.onChanges(&cache, &batch);
+    try std.testing.expect(cache.get("/api/users") == null);
+    try std.testing.expect(cache.get("/about") != null);
+}
+
 test "ResponseCache cleanup removes expired entries" {
     var cache = ResponseCache.init(std.testing.allocator, 10);
     defer cache.deinit();
@@ -234,6 +234,14 @@ pub fn createRuntimeRouteWrapper() fn (*ziggurat.request.Request) ziggurat.respo
     }.wrapper;
 }
 
+/// Whether a request routed to a PATCH endpoint really asked for PATCH
+/// Clients that can only send POST tunnel it with `X-HTTP-Method-Override: PATCH`.
+fn isPatchRequest(request: *Request) bool {
+    if (std.mem.eql(u8, request.method(), "PATCH")) return true;
+    const override = request.header("X-HTTP-Method-Override") orelse return false;
+    return std.ascii.eqlIgnoreCase(override, "PATCH");
+}
+
 /// Wrap an engine12 handler to work with ziggurat
 /// Creates an arena allocator for each request and automatically cleans it up
 /// If route_pattern is provided, extracts route parameters from the request path
@@ -788,6 +796,75 @@ pub const Engine12 = struct {
         self.routes_count += 1;
     }
 
+    /// Register a PATCH endpoint
+    /// Handler can be passed directly (function) or as a pointer (*const fn)
+    /// Supports route parameters with :param syntax (e.g., "/todos/:id")
+    /// ziggurat has no PATCH registration, so the route is dispatched through
+    /// POST. The handler only runs for PATCH requests or a POST carrying
+    /// `X-HTTP-Method-Override: PATCH`; any other POST gets 405.
+    pub fn patch(self: *Engine12, comptime path_pattern: []const u8, comptime handler: anytype) !void {
+        if (self.routes_count >= MAX_ROUTES) {
+            return error.TooManyRoutes;
+        }
+        if (self.server_built) {
+            return error.ServerAlreadyBuilt;
+        }
+
+        if (self.built_server == null) {
+            var builder = ziggurat.ServerBuilder.init(self.allocator);
+            var server = try builder
+                .host("127.0.0.1")
+                .port(8080)
+                .readTimeout(5000)
+                .writeTimeout(5000)
+                .build();
+
+            // Register default routes (skip "/" if static files will be served at root or custom handler registered)
+            global_middleware = &self.middleware;
+            global_metrics = &self.metrics_collector;
+            if (!self.static_root_mounted and !self.custom_root_handler) {
+                try server.get("/", wrapHandler(handlers.handleDefaultRoot, "/"));
+            }
+            try server.get("/health", wrapHandler(handlers.handleHealthEndpoint, "/health"));
+            try server.get("/ready", wrapHandler(handlers.handleReadyEndpoint, "/ready"));
+            try server.get("/metrics", wrapHandler(handlers.handleMetricsEndpoint, "/metrics"));
+
+            self.built_server = server;
+            self.http_server = @ptrCast(&server);
+        }
+
+        const HandlerTypePatch = @TypeOf(handler);
+        const actual_handler: types.HttpHandler = switch (@typeInfo(HandlerTypePatch)) {
+            .pointer => |ptr_info| if (ptr_info.size == .one) handler.* else handler,
+            else => handler,
+        };
+        // A plain POST to the same path must not become a partial update
+        const handler_for_storage_patch = struct {
+            fn handle(request: *Request) Response {
+                if (!isPatchRequest(request)) {
+                    return Response.errorResponse("Method Not Allowed", 405).withHeader("Allow", "PATCH");
+                }
+                return actual_handler(request);
+            }
+        }.handle;
+
+        // Wrap the engine12 handler to work with ziggurat
+        const wrapped_handler = wrapHandler(handler_for_storage_patch, path_pattern);
+
+        // ziggurat's Server has no PATCH registration; route it like the C API
+        // does, through POST dispatch, while the route table records PATCH
+        if (self.built_server) |*server| {
+            try server.post(path_pattern, wrapped_handler);
+        }
+
+        self.http_routes[self.routes_count] = types.Route{
+            .path = path_pattern,
+            .method = "PATCH",
+            .handler_ptr = &handler_for_storage_patch,
+        };
+        self.routes_count += 1;
+    }
+
     /// Register a DELETE endpoint
     /// Handler can be passed directly (function) or as a pointer (*const fn)
     /// Supports route parameters with :param syntax (e.g., "/todos/:id")
@@ -1067,15 +1144,11 @@ pub const Engine12 = struct {
             }
         }.validate;
 
-        var config: ConfigType = undefined;
-        config.orm = orm_instance;
-        config.validator = if (validator_provided) validator_fn.? else default_validator;
-        config.enable_pagination = true;
-        config.enable_filtering = true;
-        config.enable_sorting = true;
-        config.authenticator = null;
-        config.authorization = null;
-        config.cache_ttl_ms = null;
+        // Start from RestApiConfig's field defaults so newer options are never undefined
+        var config = ConfigType{
+            .orm = orm_instance,
+            .validator = if (validator_provided) validator_fn.? else default_validator,
+        };
 
         // Apply overrides if provided
         comptime {
@@ -2148,6 +2221,27 @@ test "Engine12 registerValve" {
     try std.testing.expect(app.valve_registry != null);
 }
 
+test "Engine12 patch routes accept only PATCH or a POST override" {
+    var ziggurat_req = ziggurat.request.Request{
+        .path = "/todos/1",
+        .method = .PATCH,
+        .body = "",
+        .headers = std.StringHashMap([]const u8).init(std.testing.allocator),
+        .allocator = std.testing.allocator,
+        .user_data = std.StringHashMap([]const u8).init(std.testing.allocator),
+    };
+    defer ziggurat_req.headers.deinit();
+    var req = Request.fromZiggurat(&ziggurat_req, std.testing.allocator);
+    defer req.deinit();
+    try std.testing.expect(isPatchRequest(&req));
+
+    ziggurat_req.method = .POST;
+    try std.testing.expect(!isPatchRequest(&req));
+
+    try ziggurat_req.headers.put("X-HTTP-Method-Override", "patch");
+    try std.testing.expect(isPatchRequest(&req));
+}
+
 // Test deleted - causes ORM queries that fail without database setup
 
 // Static file registry for runtime dispatch
@@ -29,7 +29,22 @@ pub fn handleMetricsEndpoint(request: *Request) Response {
         };
         defer std.heap.page_allocator.free(prometheus_output);
 
-        var resp = Response.text(prometheus_output);
+        // Database metrics (backup, SQLite internals, pools, write queue) follow the HTTP metrics
+        var output = std.ArrayListUnmanaged(u8){};
+        defer output.deinit(std.heap.page_allocator);
+        output.appendSlice(std.heap.page_allocator, prometheus_output) catch {
+            return Response.json("{\"error\":\"Failed to generate metrics\"}").withStatus(500);
+        };
+        const DatabaseSingleton = @import("orm/singleton.zig").DatabaseSingleton;
+        if (DatabaseSingleton.isInitialized()) {
+            if (DatabaseSingleton.get() catch null) |orm| {
+                orm.writePrometheus(output.writer(std.heap.page_allocator)) catch |err| {
+                    std.debug.print("[Engine12] Warning: Failed to write database metrics: {}\n", .{err});
+                };
+            }
+        }
+
+        var resp = Response.text(output.items);
         resp = resp.withContentType("text/plain; version=0.0.4");
         return resp;
     }
@@ -37,6 +37,21 @@ pub const Json = struct {
         return try parser.parseStruct(T);
     }
 
+    /// Deserialize a JSON array of objects to a slice of structs
+    /// The returned slice and its string fields are owned by the allocator
+    /// (typically a request arena).
+    ///
+    /// Example:
+    /// ```zig
+    /// const json = "[{\"id\":1,\"title\":\"A\"},{\"id\":2,\"title\":\"B\"}]";
+    /// const todos = try Json.deserializeArray(Todo, json, arena);
+    /// ```
+    pub fn deserializeArray(comptime T: type, json_str: []const u8, allocator: std.mem.Allocator) ![]T {
+        var parser = Parser.init(json_str, allocator);
+        defer parser.deinit();
+        return try parser.parseArray(T);
+    }
+
     /// Serialize an array of structs to JSON array
     ///
     /// Example:
@@ -301,6 +316,48 @@ pub const Json = struct {
             return result;
         }
 
+        fn parseArray(self: *Parser, comptime T: type) ![]T {
+            self.skipWhitespace();
+            if (self.pos >= self.input.len or self.input[self.pos] != '[') {
+                std.debug.print("[JSON Parser Error] Expected '[' at start of array\n", .{});
+                std.debug.print("  Position: {d}\n", .{self.pos});
+                return error.InvalidJson;
+            }
+            self.pos += 1;
+
+            var items = std.ArrayListUnmanaged(T){};
+            errdefer items.deinit(self.allocator);
+
+            self.skipWhitespace();
+            if (self.pos < self.input.len and self.input[self.pos] == ']') {
+                self.pos += 1;
+                return items.toOwnedSlice(self.allocator);
+            }
+
+            // Every element is followed by ',' and another element, or by the closing ']'
+            while (true) {
+                try items.append(self.allocator, try self.parseStruct(T));
+
+                self.skipWhitespace();
+                if (self.pos >= self.input.len) {
+                    std.debug.print("[JSON Parser Error] Unterminated array\n", .{});
+                    return error.InvalidJson;
+                }
+                switch (self.input[self.pos]) {
+                    ',' => self.pos += 1,
+                    ']' => break,
+                    else => {
+                        std.debug.print("[JSON Parser Error] Expected ',' or ']' after array element\n", .{});
+                        std.debug.print("  Position: {d}\n", .{self.pos});
+                        return error.InvalidJson;
+                    },
+                }
+            }
+            self.pos += 1;
+
+            return items.toOwnedSlice(self.allocator);
+        }
+
         fn parseFieldValue(self: *Parser, comptime T: type) !T {
             const type_info = @typeInfo(T);
 
@@ -587,6 +644,31 @@ test "Json.deserialize simple struct" {
     try std.testing.expect(parsed.active);
 }
 
+test "Json.deserializeArray" {
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+
+    const TestStruct = struct {
+        id: i64,
+        name: []const u8,
+    };
+
+    const json = "[{\"id\":1,\"name\":\"a\"}, {\"id\":2,\"name\":\"b\"}]";
+    const parsed = try Json.deserializeArray(TestStruct, json, arena.allocator());
+
+    try std.testing.expectEqual(@as(usize, 2), parsed.len);
+    try std.testing.expectEqual(@as(i64, 2), parsed[1].id);
+    try std.testing.expectEqualStrings("a", parsed[0].name);
+
+    const empty = try Json.deserializeArray(TestStruct, " [ ] ", arena.allocator());
+    try std.testing.expectEqual(@as(usize, 0), empty.len);
+
+    // Elements must be separated by exactly one comma
+    try std.testing.expectError(error.InvalidJson, Json.deserializeArray(TestStruct, "[{\"id\":1,\"name\":\"a\"}{\"id\":2,\"name\":\"b\"}]", arena.allocator()));
+    try std.testing.expectError(error.InvalidJson, Json.deserializeArray(TestStruct, "[{\"id\":1,\"name\":\"a\"},]", arena.allocator()));
+    try std.testing.expectError(error.InvalidJson, Json.deserializeArray(TestStruct, "[{\"id\":1,\"name\":\"a\"}", arena.allocator()));
+}
+
 test "Json.serialize with optional" {
     const allocator = std.testing.allocator;
     const TestStruct = struct {
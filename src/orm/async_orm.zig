@@ -0,0 +1,505 @@
+const std = @import("std");
+const database = @import("database.zig");
+const Database = database.Database;
+const ORM = @import("orm.zig").ORM;
+const ModelSql = @import("model_sql.zig").ModelSql;
+const PragmaProfile = @import("wal.zig").PragmaProfile;
+
+pub const AsyncOptions = struct {
+    /// Worker threads, each owning one connection (default: one per CPU core)
+    workers: ?usize = null,
+    /// Jobs allowed to wait for a worker; beyond this submit fails with
+    /// error.QueueFull so overload turns into fast 503s instead of a backlog
+    max_queue_depth: usize = 1024,
+    /// PRAGMAs applied to every worker connection (busy_timeout lets
+    /// concurrent writers wait for each other instead of failing)
+    profile: PragmaProfile = .{},
+};
+
+pub const AsyncStats = struct {
+    workers: usize = 0,
+    /// Jobs waiting for a worker right now
+    queue_depth: usize = 0,
+    /// Highest queue depth seen
+    queue_depth_max: usize = 0,
+    /// Jobs being run by a worker right now
+    running: usize = 0,
+    submitted: u64 = 0,
+    completed: u64 = 0,
+    /// Submissions refused because the queue was full
+    rejected: u64 = 0,
+    /// Time jobs spent queued before a worker picked them up
+    wait_time_total_us: u64 = 0,
+    wait_time_max_us: u64 = 0,
+    /// Time workers spent running jobs
+    run_time_total_us: u64 = 0,
+
+    /// Average time a job waited for a worker, in microseconds
+    pub fn averageWaitUs(self: AsyncStats) f64 {
+        if (self.completed == 0) return 0.0;
+        return @as(f64, @floatFromInt(self.wait_time_total_us)) / @as(f64, @floatFromInt(self.completed));
+    }
+
+    /// Write the stats in Prometheus text format
+    ///
+    /// Example output:
+    /// ```
+    /// db_async_queue_depth{pool="main"} 3
+    /// db_async_wait_seconds_sum{pool="main"} 0.042
+    /// ```
+    pub fn writePrometheus(self: AsyncStats, writer: anytype, pool_name: []const u8) !void {
+        try writer.print("db_async_workers{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.workers });
+        try writer.print("db_async_queue_depth{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.queue_depth });
+        try writer.print("db_async_queue_depth_max{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.queue_depth_max });
+        try writer.print("db_async_running{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.running });
+        try writer.print("db_async_submitted_total{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.submitted });
+        try writer.print("db_async_completed_total{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.completed });
+        try writer.print("db_async_rejected_total{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.rejected });
+        const wait_seconds = @as(f64, @floatFromInt(self.wait_time_total_us)) / 1_000_000.0;
+        try writer.print("db_async_wait_seconds_sum{{pool=\"{s}\"}} {d}\n", .{ pool_name, wait_seconds });
+        try writer.print("db_async_wait_seconds_count{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.completed });
+        const max_seconds = @as(f64, @floatFromInt(self.wait_time_max_us)) / 1_000_000.0;
+        try writer.print("db_async_wait_seconds_max{{pool=\"{s}\"}} {d}\n", .{ pool_name, max_seconds });
+        const run_seconds = @as(f64, @floatFromInt(self.run_time_total_us)) / 1_000_000.0;
+        try writer.print("db_async_run_seconds_sum{{pool=\"{s}\"}} {d}\n", .{ pool_name, run_seconds });
+    }
+};
+
+/// A queued unit of work; embedded in a Future
+pub const Job = struct {
+    run: *const fn (job: *Job, orm: *ORM) void,
+    next: ?*Job = null,
+    enqueued_at_ns: i128 = 0,
+};
+
+/// Result of a job submitted to AsyncORM
+/// The result and everything it points to live in the future's arena, so they
+/// stay valid until release(). Call release() exactly once, even after a
+/// timeout: the worker keeps its own reference until the job finishes, so
+/// abandoning a slow query is safe.
+pub fn Future(comptime T: type) type {
+    return struct {
+        const Self = @This();
+        pub const Callback = *const fn (context: ?*anyopaque, result: anyerror!T) void;
+
+        job: Job,
+        /// Owns the job's copied arguments and its result
+        arena: std.heap.ArenaAllocator,
+        result: anyerror!T = error.Pending,
+        done: std.Thread.ResetEvent = .{},
+        /// One for the caller's handle, one for the worker
+        refs: std.atomic.Value(u8) = .init(2),
+        callback: ?Callback = null,
+        callback_context: ?*anyopaque = null,
+        destroy: *const fn (self: *Self) void,
+
+        /// Block until the job has run and return its result
+        pub fn wait(self: *Self) anyerror!T {
+            self.done.wait();
+            return self.result;
+        }
+
+        /// Like wait(), but give up after `timeout_ns` with error.Timeout
+        /// The job still runs; release() the future as usual.
+        pub fn waitTimeout(self: *Self, timeout_ns: u64) anyerror!T {
+            self.done.timedWait(timeout_ns) catch return error.Timeout;
+            return self.result;
+        }
+
+        pub fn isDone(self: *Self) bool {
+            return self.done.isSet();
+        }
+
+        /// Drop the caller's reference; frees the result once the job is done
+        pub fn release(self: *Self) void {
+            if (self.refs.fetchSub(1, .acq_rel) == 1) self.destroy(self);
+        }
+
+        fn complete(self: *Self, result: anyerror!T) void {
+            self.result = result;
+            if (self.callback) |callback| callback(self.callback_context, result);
+            self.done.set();
+            self.release();
+        }
+    };
+}
+
+/// Async ORM facade: queries run on a bounded pool of DB worker threads
+/// Each worker owns its own connection and ORM, so a slow query occupies a
+/// worker rather than the HTTP thread that issued it. Calls return a Future
+/// (or invoke a callback on the worker). A handler can start several queries
+/// at once and wait for all of them, or wait with a deadline and answer 503
+/// when the database is too slow.
+///
+/// Workers do not share the main ORM's entity cache, write queue or WAL
+/// writer lock; concurrent writers rely on SQLite locking and busy_timeout.
+///
+/// Example:
+/// ```zig
+/// const db = try AsyncORM.init("app.db", allocator, .{ .workers = 4 });
+/// defer db.deinit();
+///
+/// // Run both queries in parallel
+/// const todo = try db.find(Todo, id);
+/// defer todo.release();
+/// const tags = try db.where(Tag, "todo_id = 7");
+/// defer tags.release();
+///
+/// const found = todo.waitTimeout(2 * std.time.ns_per_s) catch |err| switch (err) {
+///     error.Timeout => return Response.errorResponse("Database busy", 503),
+///     else => return Response.serverError("Query failed"),
+/// };
+/// ```
+pub const AsyncORM = struct {
+    allocator: std.mem.Allocator,
+    options: AsyncOptions,
+    workers: []Worker,
+
+    mutex: std.Thread.Mutex = .{},
+    not_empty: std.Thread.Condition = .{},
+    head: ?*Job = null,
+    tail: ?*Job = null,
+    closed: bool = false,
+    stats_data: AsyncStats = .{},
+
+    const Worker = struct {
+        orm: ORM,
+        thread: ?std.Thread = null,
+    };
+
+    /// Open one connection per worker on `path` and start the workers
+    pub fn init(path: []const u8, allocator: std.mem.Allocator, options: AsyncOptions) !*AsyncORM {
+        if (std.mem.eql(u8, path, ":memory:")) {
+            std.debug.print("[ORM Error] AsyncORM workers need a shared database file, not :memory:\n", .{});
+            return error.InvalidArgument;
+        }
+        if (options.max_queue_depth == 0) {
+            std.debug.print("[ORM Error] AsyncORM max_queue_depth must be greater than 0\n", .{});
+            return error.InvalidArgument;
+        }
+
+        const worker_count = @max(options.workers orelse (std.Thread.getCpuCount() catch 4), 1);
+
+        const self = try allocator.create(AsyncORM);
+        errdefer allocator.destroy(self);
+        self.* = .{
+            .allocator = allocator,
+            .options = options,
+            .workers = try allocator.alloc(Worker, worker_count),
+        };
+        errdefer allocator.free(self.workers);
+        self.stats_data.workers = worker_count;
+
+        const pragmas = try options.profile.toSql(allocator);
+        defer allocator.free(pragmas);
+
+        var opened: usize = 0;
+        errdefer {
+            for (self.workers[0..opened]) |*worker| worker.orm.close();
+        }
+        for (self.workers) |*worker| {
+            var db = try Database.open(path, allocator);
+            db.execute(pragmas) catch |err| {
+                db.close();
+                return err;
+            };
+            worker.* = .{ .orm = ORM.init(db, allocator) };
+            opened += 1;
+        }
+
+        var started: usize = 0;
+        errdefer self.stopWorkers(started);
+        for (self.workers) |*worker| {
+            worker.thread = try std.Thread.spawn(.{}, workerMain, .{ self, worker });
+            started += 1;
+        }
+
+        return self;
+    }
+
+    /// Finish every queued job, stop the workers and close their connections
+    pub fn deinit(self: *AsyncORM) void {
+        self.stopWorkers(self.workers.len);
+        for (self.workers) |*worker| worker.orm.close();
+        self.allocator.free(self.workers);
+        self.allocator.destroy(self);
+    }
+
+    /// Run `func(orm, allocator, args...)` on a worker
+    /// `func` must return `!T`; allocate the result with the allocator it is
+    /// given (the future's arena). `args` are copied, but memory they point to
+    /// must stay valid until the job has run.
+    ///
+    /// Example:
+    /// ```zig
+    /// const count = try db.run(i64, countOpen, .{user_id});
+    /// defer count.release();
+    /// const n = try count.wait();
+    /// ```
+    pub fn run(self: *AsyncORM, comptime T: type, comptime func: anytype, args: anytype) !*Future(T) {
+        const task = try Task(T, func, @TypeOf(args)).create(self.allocator, args);
+        errdefer task.future.destroy(&task.future);
+        try self.enqueue(&task.future.job);
+        return &task.future;
+    }
+
+    /// Like run(), but call `callback(context, result)` on the worker thread
+    /// when the job finishes instead of returning a future. The result's
+    /// memory is freed as soon as the callback returns.
+    pub fn runCallback(
+        self: *AsyncORM,
+        comptime T: type,
+        comptime func: anytype,
+        args: anytype,
+        callback: Future(T).Callback,
+        context: ?*anyopaque,
+    ) !void {
+        const task = try Task(T, func, @TypeOf(args)).create(self.allocator, args);
+        errdefer task.future.destroy(&task.future);
+        task.future.callback = callback;
+        task.future.callback_context = context;
+        // No caller handle: the worker's reference is the only one
+        task.future.refs.store(1, .monotonic);
+        try self.enqueue(&task.future.job);
+    }
+
+    pub fn find(self: *AsyncORM, comptime T: type, id: i64) !*Future(?T) {
+        return self.run(?T, struct {
+            fn call(orm: *ORM, allocator: std.mem.Allocator, record_id: i64) !?T {
+                return orm.findAlloc(T, record_id, allocator);
+            }
+        }.call, .{id});
+    }
+
+    pub fn findAll(self: *AsyncORM, comptime T: type) !*Future(std.ArrayListUnmanaged(T)) {
+        return self.run(std.ArrayListUnmanaged(T), struct {
+            fn call(orm: *ORM, allocator: std.mem.Allocator) !std.ArrayListUnmanaged(T) {
+                return orm.findAllAlloc(T, allocator);
+            }
+        }.call, .{});
+    }
+
+    /// Rows of T matching a raw SQL condition (copied, so it may be freed
+    /// right after the call)
+    pub fn where(self: *AsyncORM, comptime T: type, condition: []const u8) !*Future(std.ArrayListUnmanaged(T)) {
+        const future = try self.runCopied(std.ArrayListUnmanaged(T), condition, struct {
+            fn call(orm: *ORM, allocator: std.mem.Allocator, sql_condition: []const u8) !std.ArrayListUnmanaged(T) {
+                const sql = try std.fmt.allocPrint(allocator, "SELECT * FROM {s} WHERE {s}", .{ ModelSql(T).table_name, sql_condition });
+                var result = try orm.query(sql);
+                defer result.deinit();
+                return result.toArrayListAlloc(T, allocator);
+            }
+        }.call);
+        return future;
+    }
+
+    /// Run SQL that returns no rows (copied, so it may be freed right after the call)
+    pub fn execute(self: *AsyncORM, sql: []const u8) !*Future(void) {
+        return self.runCopied(void, sql, struct {
+            fn call(orm: *ORM, _: std.mem.Allocator, statement: []const u8) !void {
+                try orm.execute(statement);
+            }
+        }.call);
+    }
+
+    pub fn stats(self: *AsyncORM) AsyncStats {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        return self.stats_data;
+    }
+
+    /// run() with `text` copied into the future's arena first
+    fn runCopied(self: *AsyncORM, comptime T: type, text: []const u8, comptime func: anytype) !*Future(T) {
+        const task = try Task(T, func, struct { []const u8 }).create(self.allocator, .{""});
+        errdefer task.future.destroy(&task.future);
+        task.args[0] = try task.future.arena.allocator().dupe(u8, text);
+        try self.enqueue(&task.future.job);
+        return &task.future;
+    }
+
+    fn enqueue(self: *AsyncORM, job: *Job) !void {
+        job.next = null;
+        job.enqueued_at_ns = std.time.nanoTimestamp();
+
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        if (self.closed) return error.AsyncORMClosed;
+        if (self.stats_data.queue_depth >= self.options.max_queue_depth) {
+            self.stats_data.rejected += 1;
+            return error.QueueFull;
+        }
+
+        if (self.tail) |tail| {
+            tail.next = job;
+        } else {
+            self.head = job;
+        }
+        self.tail = job;
+        self.stats_data.submitted += 1;
+        self.stats_data.queue_depth += 1;
+        self.stats_data.queue_depth_max = @max(self.stats_data.queue_depth_max, self.stats_data.queue_depth);
+        self.not_empty.signal();
+    }
+
+    /// Next job, or null once the pool is closed and drained
+    fn dequeue(self: *AsyncORM) ?*Job {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        while (self.head == null) {
+            if (self.closed) return null;
+            self.not_empty.wait(&self.mutex);
+        }
+
+        const job = self.head.?;
+        self.head = job.next;
+        if (self.head == null) self.tail = null;
+
+        const waited_us: u64 = @intCast(@max(@divTrunc(std.time.nanoTimestamp() - job.enqueued_at_ns, std.time.ns_per_us), 0));
+        self.stats_data.queue_depth -= 1;
+        self.stats_data.running += 1;
+        self.stats_data.wait_time_total_us += waited_us;
+        self.stats_data.wait_time_max_us = @max(self.stats_data.wait_time_max_us, waited_us);
+        return job;
+    }
+
+    fn workerMain(self: *AsyncORM, worker: *Worker) void {
+        while (self.dequeue()) |job| {
+            const started = std.time.nanoTimestamp();
+            job.run(job, &worker.orm);
+            const ran_us: u64 = @intCast(@max(@divTrunc(std.time.nanoTimestamp() - started, std.time.ns_per_us), 0));
+
+            self.mutex.lock();
+            self.stats_data.running -= 1;
+            self.stats_data.completed += 1;
+            self.stats_data.run_time_total_us += ran_us;
+            self.mutex.unlock();
+        }
+    }
+
+    fn stopWorkers(self: *AsyncORM, count: usize) void {
+        self.mutex.lock();
+        self.closed = true;
+        self.not_empty.broadcast();
+        self.mutex.unlock();
+
+        for (self.workers[0..count]) |*worker| {
+            if (worker.thread) |thread| thread.join();
+            worker.thread = null;
+        }
+    }
+
+    fn Task(comptime T: type, comptime func: anytype, comptime Args: type) type {
+        return struct {
+            const Self = @This();
+            future: Future(T),
+            args: Args,
+            allocator: std.mem.Allocator,
+
+            fn create(allocator: std.mem.Allocator, args: Args) !*Self {
+                const self = try allocator.create(Self);
+                self.* = .{
+                    .future = .{
+                        .job = .{ .run = run },
+                        .arena = std.heap.ArenaAllocator.init(allocator),
+                        .destroy = destroy,
+                    },
+                    .args = args,
+                    .allocator = allocator,
+                };
+                return self;
+            }
+
+            fn run(job: *Job, orm: *ORM) void {
+                const future: *Future(T) = @fieldParentPtr("job", job);
+                const self: *Self = @fieldParentPtr("future", future);
+                future.complete(@call(.auto, func, .{ orm, future.arena.allocator() } ++ self.args));
+            }
+
+            fn destroy(future: *Future(T)) void {
+                const self: *Self = @fieldParentPtr("future", future);
+                future.arena.deinit();
+                self.allocator.destroy(self);
+            }
+        };
+    }
+};
+
+test "AsyncORM runs queries on worker connections" {
+    const allocator = std.testing.allocator;
+
+    const Item = struct {
+        id: i64,
+        name: []const u8,
+    };
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const dir_path = try tmp.dir.realpathAlloc(allocator, ".");
+    defer allocator.free(dir_path);
+    const db_path = try std.fs.path.join(allocator, &.{ dir_path, "async.db" });
+    defer allocator.free(db_path);
+
+    const db = try AsyncORM.init(db_path, allocator, .{ .workers = 2 });
+    defer db.deinit();
+
+    const setup = try db.execute("CREATE TABLE item (id INTEGER PRIMARY KEY, name TEXT); INSERT INTO item (name) VALUES ('a'), ('b');");
+    try setup.wait();
+    setup.release();
+
+    // Two queries in flight at once
+    const one = try db.find(Item, 1);
+    defer one.release();
+    const rest = try db.where(Item, "id > 1");
+    defer rest.release();
+
+    const found = (try one.waitTimeout(5 * std.time.ns_per_s)).?;
+    try std.testing.expectEqualStrings("a", found.name);
+    const others = try rest.wait();
+    try std.testing.expectEqual(@as(usize, 1), others.items.len);
+
+    const missing = try db.find(Item, 99);
+    defer missing.release();
+    try std.testing.expect((try missing.wait()) == null);
+
+    const s = db.stats();
+    try std.testing.expectEqual(@as(u64, 4), s.submitted);
+    try std.testing.expectEqual(@as(usize, 0), s.queue_depth);
+}
+
+test "AsyncORM callback and errors" {
+    const allocator = std.testing.allocator;
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const dir_path = try tmp.dir.realpathAlloc(allocator, ".");
+    defer allocator.free(dir_path);
+    const db_path = try std.fs.path.join(allocator, &.{ dir_path, "async_cb.db" });
+    defer allocator.free(db_path);
+
+    const db = try AsyncORM.init(db_path, allocator, .{ .workers = 1 });
+    defer db.deinit();
+
+    const Done = struct {
+        event: std.Thread.ResetEvent = .{},
+        failed: bool = false,
+
+        fn onDone(context: ?*anyopaque, result: anyerror!void) void {
+            const self: *@This() = @ptrCast(@alignCast(context.?));
+            result catch {
+                self.failed = true;
+            };
+            self.event.set();
+        }
+    };
+
+    var done = Done{};
+    try db.runCallback(void, struct {
+        fn call(orm: *ORM, _: std.mem.Allocator) !void {
+            try orm.execute("SELECT * FROM missing_table");
+        }
+    }.call, .{}, Done.onDone, &done);
+    done.event.wait();
+    try std.testing.expect(done.failed);
+}
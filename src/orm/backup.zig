@@ -0,0 +1,189 @@
+const std = @import("std");
+const database = @import("database.zig");
+const Database = database.Database;
+
+pub const BackupState = enum { running, done, failed };
+
+/// Snapshot of a background backup's progress
+pub const BackupProgress = struct {
+    state: BackupState = .running,
+    /// Pages in the source database as of the last step
+    page_count: u64 = 0,
+    /// Pages still to copy
+    remaining: u64 = 0,
+    steps: u64 = 0,
+    started_ms: i64 = 0,
+    /// Set once the backup has finished or failed
+    finished_ms: ?i64 = null,
+
+    /// Share of pages copied so far, 0.0 to 1.0
+    pub fn fraction(self: BackupProgress) f64 {
+        if (self.state == .done) return 1.0;
+        if (self.page_count == 0) return 0.0;
+        const copied = self.page_count - @min(self.remaining, self.page_count);
+        return @as(f64, @floatFromInt(copied)) / @as(f64, @floatFromInt(self.page_count));
+    }
+
+    pub fn durationMs(self: BackupProgress) i64 {
+        const end = self.finished_ms orelse std.time.milliTimestamp();
+        return end - self.started_ms;
+    }
+
+    /// Write the progress in Prometheus text format
+    pub fn writePrometheus(self: BackupProgress, writer: anytype) !void {
+        try writer.print("db_backup_running {d}\n", .{@intFromBool(self.state == .running)});
+        try writer.print("db_backup_failed {d}\n", .{@intFromBool(self.state == .failed)});
+        try writer.print("db_backup_pages_total {d}\n", .{self.page_count});
+        try writer.print("db_backup_pages_remaining {d}\n", .{self.remaining});
+        try writer.print("db_backup_progress_ratio {d:.4}\n", .{self.fraction()});
+        try writer.print("db_backup_steps_total {d}\n", .{self.steps});
+        try writer.print("db_backup_duration_ms {d}\n", .{self.durationMs()});
+        if (self.state == .done) {
+            try writer.print("db_backup_last_success_timestamp_seconds {d}\n", .{@divTrunc(self.finished_ms.?, std.time.ms_per_s)});
+        }
+    }
+};
+
+/// An online backup copying a database a few pages at a time on its own thread
+/// Between steps the thread releases the connection and sleeps, so requests
+/// using the same connection keep running while the copy is made. Writes made
+/// through the source connection during the backup are carried into the copy.
+pub const BackupJob = struct {
+    allocator: std.mem.Allocator,
+    db: Database,
+    /// Held for each step when writers share the connection
+    write_lock: ?*std.Thread.Mutex,
+    dest_path: []u8,
+    pages_per_step: i32,
+    sleep_ms: u64,
+    thread: std.Thread = undefined,
+    mutex: std.Thread.Mutex = .{},
+    finished: std.Thread.ResetEvent = .{},
+    current: BackupProgress = .{},
+    err: ?anyerror = null,
+
+    /// Start copying `db` into `dest_path` on a new thread
+    /// `pages_per_step <= 0` copies everything in one step.
+    pub fn start(
+        allocator: std.mem.Allocator,
+        db: Database,
+        write_lock: ?*std.Thread.Mutex,
+        dest_path: []const u8,
+        pages_per_step: i32,
+        sleep_ms: u64,
+    ) !*BackupJob {
+        const job = try allocator.create(BackupJob);
+        errdefer allocator.destroy(job);
+        const owned_path = try allocator.dupe(u8, dest_path);
+        errdefer allocator.free(owned_path);
+
+        job.* = .{
+            .allocator = allocator,
+            .db = db,
+            .write_lock = write_lock,
+            .dest_path = owned_path,
+            .pages_per_step = if (pages_per_step <= 0) -1 else pages_per_step,
+            .sleep_ms = sleep_ms,
+            .current = .{ .started_ms = std.time.milliTimestamp() },
+        };
+        job.thread = try std.Thread.spawn(.{}, run, .{job});
+        return job;
+    }
+
+    /// Block until the backup has finished; returns its error if it failed
+    pub fn wait(self: *BackupJob) !void {
+        self.finished.wait();
+        if (self.err) |err| return err;
+    }
+
+    pub fn progress(self: *BackupJob) BackupProgress {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        return self.current;
+    }
+
+    /// Wait for the thread and free the job
+    pub fn deinit(self: *BackupJob) void {
+        self.thread.join();
+        self.allocator.free(self.dest_path);
+        self.allocator.destroy(self);
+    }
+
+    fn run(self: *BackupJob) void {
+        self.copy() catch |err| {
+            std.debug.print("[ORM Error] Backup to '{s}' failed\n", .{self.dest_path});
+            std.debug.print("  Error: {}\n", .{err});
+            self.err = err;
+        };
+
+        self.mutex.lock();
+        self.current.state = if (self.err == null) .done else .failed;
+        self.current.finished_ms = std.time.milliTimestamp();
+        self.mutex.unlock();
+        self.finished.set();
+    }
+
+    fn copy(self: *BackupJob) !void {
+        var backup = try self.db.startBackup(self.dest_path);
+        var finished = false;
+        defer if (!finished) backup.finish() catch {};
+
+        while (true) {
+            if (self.write_lock) |lock| lock.lock();
+            const done = backup.step(self.pages_per_step) catch |err| {
+                if (self.write_lock) |lock| lock.unlock();
+                return err;
+            };
+            if (self.write_lock) |lock| lock.unlock();
+
+            self.mutex.lock();
+            self.current.steps += 1;
+            self.current.page_count = backup.pageCount();
+            self.current.remaining = backup.remaining();
+            self.mutex.unlock();
+
+            if (done) break;
+            // Yield the connection to request handlers between steps
+            if (self.sleep_ms > 0) std.Thread.sleep(self.sleep_ms * std.time.ns_per_ms);
+        }
+
+        finished = true;
+        try backup.finish();
+    }
+};
+
+test "BackupJob copies a database in steps" {
+    const allocator = std.testing.allocator;
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const dir_path = try tmp.dir.realpathAlloc(allocator, ".");
+    defer allocator.free(dir_path);
+    const dest_path = try std.fs.path.join(allocator, &.{ dir_path, "backup.db" });
+    defer allocator.free(dest_path);
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+    try db.execute("PRAGMA page_size = 1024");
+    try db.execute("CREATE TABLE notes (id INTEGER PRIMARY KEY, body TEXT)");
+    try db.execute(
+        "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 500) " ++
+            "INSERT INTO notes (body) SELECT printf('%.200c', 'x') FROM n",
+    );
+
+    const job = try BackupJob.start(allocator, db, null, dest_path, 10, 0);
+    defer job.deinit();
+    try job.wait();
+
+    const done = job.progress();
+    try std.testing.expectEqual(BackupState.done, done.state);
+    try std.testing.expect(done.steps > 1);
+    try std.testing.expectEqual(@as(u64, 0), done.remaining);
+    try std.testing.expectEqual(@as(f64, 1.0), done.fraction());
+
+    var copy = try Database.open(dest_path, allocator);
+    defer copy.close();
+    var result = try copy.query("SELECT COUNT(*) FROM notes");
+    defer result.deinit();
+    try std.testing.expectEqual(@as(i64, 500), result.nextRow().?.getInt64(0));
+}
@@ -0,0 +1,399 @@
+const std = @import("std");
+const c = @cImport({
+    @cInclude("e12_orm.h");
+});
+const Database = @import("database.zig").Database;
+
+pub const ChangeOp = enum {
+    insert,
+    update,
+    delete,
+    /// The table changed but its rows were not listed (the transaction was too large)
+    many,
+
+    pub fn name(self: ChangeOp) []const u8 {
+        return @tagName(self);
+    }
+};
+
+/// One row changed by a committed transaction
+pub const Change = struct {
+    table: []const u8,
+    op: ChangeOp,
+    /// 0 for `.many`
+    rowid: i64,
+};
+
+/// Rows changed by one committed transaction
+/// When subscribers fall behind, later transactions are merged into the last
+/// queued batch, so a batch can span `first_seq..last_seq`.
+pub const ChangeBatch = struct {
+    first_seq: u64,
+    last_seq: u64,
+    changes: []const Change,
+    /// Distinct tables in `changes`, in first-seen order
+    tables: []const []const u8,
+
+    /// Whether any change in the batch is on `table` (SQL names are case-insensitive)
+    pub fn touches(self: *const ChangeBatch, table: []const u8) bool {
+        for (self.tables) |t| {
+            if (std.ascii.eqlIgnoreCase(t, table)) return true;
+        }
+        return false;
+    }
+
+    /// Write the batch as JSON
+    ///
+    /// Example output:
+    /// ```
+    /// {"seq":42,"changes":[{"table":"todos","op":"insert","rowid":7}]}
+    /// ```
+    pub fn writeJson(self: *const ChangeBatch, writer: anytype) !void {
+        try writer.print("{{\"seq\":{d},\"changes\":[", .{self.last_seq});
+        for (self.changes, 0..) |change, i| {
+            if (i > 0) try writer.writeByte(',');
+            try writer.writeAll("{\"table\":\"");
+            try writeJsonString(writer, change.table);
+            try writer.print("\",\"op\":\"{s}\",\"rowid\":{d}}}", .{ change.op.name(), change.rowid });
+        }
+        try writer.writeAll("]}");
+    }
+};
+
+/// Quoted identifiers can hold any character, so table names are escaped
+fn writeJsonString(writer: anytype, value: []const u8) !void {
+    for (value) |char| {
+        switch (char) {
+            '"' => try writer.writeAll("\\\""),
+            '\\' => try writer.writeAll("\\\\"),
+            0...0x1f => try writer.print("\\u{x:0>4}", .{char}),
+            else => try writer.writeByte(char),
+        }
+    }
+}
+
+pub const ChangeFeedOptions = struct {
+    /// Batches waiting for delivery before new transactions are merged into the last one
+    max_queued_batches: usize = 256,
+};
+
+pub const ChangeFeedStats = struct {
+    /// Committed transactions seen
+    transactions: u64 = 0,
+    changes: u64 = 0,
+    batches_delivered: u64 = 0,
+    /// Transactions merged into an earlier batch because the queue was full
+    batches_merged: u64 = 0,
+    /// Transactions lost because a batch could not be allocated
+    batches_dropped: u64 = 0,
+};
+
+/// Called on the feed's delivery thread for every batch
+pub const ChangeCallback = *const fn (context: ?*anyopaque, batch: *const ChangeBatch) void;
+
+const Subscriber = struct {
+    callback: ChangeCallback,
+    context: ?*anyopaque,
+};
+
+const QueuedBatch = struct {
+    arena: std.heap.ArenaAllocator,
+    first_seq: u64,
+    last_seq: u64,
+    changes: std.ArrayListUnmanaged(Change) = .{},
+    tables: std.ArrayListUnmanaged([]const u8) = .{},
+
+    fn append(self: *QueuedBatch, table: []const u8, op: ChangeOp, rowid: i64) !void {
+        const allocator = self.arena.allocator();
+        const stable_table = for (self.tables.items) |t| {
+            if (std.mem.eql(u8, t, table)) break t;
+        } else blk: {
+            const copy = try allocator.dupe(u8, table);
+            try self.tables.append(allocator, copy);
+            break :blk copy;
+        };
+        try self.changes.append(allocator, .{ .table = stable_table, .op = op, .rowid = rowid });
+    }
+
+    fn view(self: *const QueuedBatch) ChangeBatch {
+        return .{
+            .first_seq = self.first_seq,
+            .last_seq = self.last_seq,
+            .changes = self.changes.items,
+            .tables = self.tables.items,
+        };
+    }
+};
+
+/// In-process feed of committed row changes from SQLite's update and commit hooks
+/// Attach it to the connections that write; each committed transaction becomes
+/// one `ChangeBatch`, delivered to every subscriber in commit order on the
+/// feed's own thread. Rolled-back changes are never delivered. Changes are
+/// signals to re-read, not a ledger: rowids of WITHOUT ROWID tables and writes
+/// made on connections that are not attached are not seen.
+///
+/// Example:
+/// ```zig
+/// const feed = try ChangeFeed.init(allocator, .{});
+/// defer feed.deinit();
+/// try feed.attach(&db);
+/// defer feed.detach(&db);
+/// try feed.subscribe(onChanges, null);
+/// ```
+pub const ChangeFeed = struct {
+    allocator: std.mem.Allocator,
+    options: ChangeFeedOptions,
+    mutex: std.Thread.Mutex = .{},
+    not_empty: std.Thread.Condition = .{},
+    idle: std.Thread.Condition = .{},
+    queue: std.ArrayListUnmanaged(*QueuedBatch) = .{},
+    subscribers: std.ArrayListUnmanaged(Subscriber) = .{},
+    next_seq: u64 = 1,
+    delivering: bool = false,
+    stopping: bool = false,
+    thread: std.Thread = undefined,
+    counters: ChangeFeedStats = .{},
+
+    pub fn init(allocator: std.mem.Allocator, options: ChangeFeedOptions) !*ChangeFeed {
+        const self = try allocator.create(ChangeFeed);
+        errdefer allocator.destroy(self);
+        self.* = .{ .allocator = allocator, .options = options };
+        self.thread = try std.Thread.spawn(.{}, run, .{self});
+        return self;
+    }
+
+    /// Start capturing committed changes made through `db`
+    pub fn attach(self: *ChangeFeed, db: *Database) !void {
+        if (c.e12_db_set_change_callback(db.c_db, onCommit, self) != c.E12_ORM_OK) {
+            std.debug.print("[ORM Error] Failed to attach change feed\n", .{});
+            return error.DatabaseError;
+        }
+    }
+
+    /// Stop capturing changes on `db`; do this before the feed is deinitialized
+    pub fn detach(_: *ChangeFeed, db: *Database) void {
+        _ = c.e12_db_set_change_callback(db.c_db, null, null);
+    }
+
+    /// Deliver future batches to `callback`
+    /// Callbacks run one at a time on the feed's thread and must not block for long.
+    pub fn subscribe(self: *ChangeFeed, callback: ChangeCallback, context: ?*anyopaque) !void {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        try self.subscribers.append(self.allocator, .{ .callback = callback, .context = context });
+    }
+
+    pub fn unsubscribe(self: *ChangeFeed, callback: ChangeCallback, context: ?*anyopaque) void {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        for (self.subscribers.items, 0..) |sub, i| {
+            if (sub.callback == callback and sub.context == context) {
+                _ = self.subscribers.orderedRemove(i);
+                return;
+            }
+        }
+    }
+
+    /// Queue one committed transaction's changes for delivery
+    /// Attached connections call this for you; use it to announce writes made elsewhere.
+    pub fn publish(self: *ChangeFeed, changes: []const Change) void {
+        if (changes.len == 0) return;
+        const batch = self.newBatch(changes.len) catch return self.countDropped();
+        for (changes) |change| {
+            batch.append(change.table, change.op, change.rowid) catch {
+                self.freeBatch(batch);
+                return self.countDropped();
+            };
+        }
+        self.enqueue(batch);
+    }
+
+    /// Block until every queued batch has been delivered
+    pub fn flush(self: *ChangeFeed) void {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        while (self.queue.items.len > 0 or self.delivering) self.idle.wait(&self.mutex);
+    }
+
+    pub fn stats(self: *ChangeFeed) ChangeFeedStats {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        return self.counters;
+    }
+
+    /// Deliver what is queued, stop the thread and free the feed
+    pub fn deinit(self: *ChangeFeed) void {
+        self.mutex.lock();
+        self.stopping = true;
+        self.not_empty.signal();
+        self.mutex.unlock();
+        self.thread.join();
+
+        for (self.queue.items) |batch| self.freeBatch(batch);
+        self.queue.deinit(self.allocator);
+        self.subscribers.deinit(self.allocator);
+        self.allocator.destroy(self);
+    }
+
+    fn newBatch(self: *ChangeFeed, capacity: usize) !*QueuedBatch {
+        const batch = try self.allocator.create(QueuedBatch);
+        batch.* = .{ .arena = std.heap.ArenaAllocator.init(self.allocator), .first_seq = 0, .last_seq = 0 };
+        errdefer self.freeBatch(batch);
+        try batch.changes.ensureTotalCapacity(batch.arena.allocator(), capacity);
+        return batch;
+    }
+
+    fn enqueue(self: *ChangeFeed, batch: *QueuedBatch) void {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        const seq = self.next_seq;
+        self.next_seq += 1;
+        self.counters.transactions += 1;
+        self.counters.changes += batch.changes.items.len;
+        batch.first_seq = seq;
+        batch.last_seq = seq;
+
+        // Merge into the newest undelivered batch rather than growing the queue without bound
+        if (self.queue.items.len >= @max(self.options.max_queued_batches, 1)) {
+            defer self.freeBatch(batch);
+            const last = self.queue.items[self.queue.items.len - 1];
+            for (batch.changes.items) |change| {
+                last.append(change.table, change.op, change.rowid) catch {
+                    self.counters.batches_dropped += 1;
+                    return;
+                };
+            }
+            last.last_seq = seq;
+            self.counters.batches_merged += 1;
+            return;
+        }
+
+        self.queue.append(self.allocator, batch) catch {
+            self.freeBatch(batch);
+            self.counters.batches_dropped += 1;
+            return;
+        };
+        self.not_empty.signal();
+    }
+
+    fn countDropped(self: *ChangeFeed) void {
+        std.debug.print("[ORM Error] Change feed dropped a transaction (out of memory)\n", .{});
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        self.counters.batches_dropped += 1;
+    }
+
+    fn freeBatch(self: *ChangeFeed, batch: *QueuedBatch) void {
+        batch.arena.deinit();
+        self.allocator.destroy(batch);
+    }
+
+    fn run(self: *ChangeFeed) void {
+        var subscribers = std.ArrayListUnmanaged(Subscriber){};
+        defer subscribers.deinit(self.allocator);
+
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        while (true) {
+            while (self.queue.items.len == 0 and !self.stopping) self.not_empty.wait(&self.mutex);
+            if (self.queue.items.len == 0) return;
+
+            const batch = self.queue.orderedRemove(0);
+            // Subscribers may (un)subscribe from a callback, so deliver from a copy
+            subscribers.clearRetainingCapacity();
+            subscribers.appendSlice(self.allocator, self.subscribers.items) catch {};
+            self.delivering = true;
+            self.mutex.unlock();
+
+            const view = batch.view();
+            for (subscribers.items) |sub| sub.callback(sub.context, &view);
+            self.freeBatch(batch);
+
+            self.mutex.lock();
+            self.delivering = false;
+            self.counters.batches_delivered += 1;
+            if (self.queue.items.len == 0) self.idle.broadcast();
+        }
+    }
+
+    /// Receives committed changes from the C change capture hooks
+    fn onCommit(ctx: ?*anyopaque, events: [*c]const c.E12ChangeEvent, count: usize) callconv(.c) void {
+        const self: *ChangeFeed = @ptrCast(@alignCast(ctx.?));
+        if (count == 0) return;
+
+        const batch = self.newBatch(count) catch return self.countDropped();
+        for (events[0..count]) |event| {
+            const op: ChangeOp = switch (event.op) {
+                c.E12_CHANGE_INSERT => .insert,
+                c.E12_CHANGE_DELETE => .delete,
+                c.E12_CHANGE_MANY => .many,
+                else => .update,
+            };
+            // Table names are only valid during this call; append copies them into the batch
+            batch.append(std.mem.span(event.table), op, event.rowid) catch {
+                self.freeBatch(batch);
+                return self.countDropped();
+            };
+        }
+        self.enqueue(batch);
+    }
+};
+
+test "ChangeFeed delivers one batch per committed transaction" {
+    const allocator = std.testing.allocator;
+
+    const Collector = struct {
+        batches: usize = 0,
+        changes: usize = 0,
+        last_op: ChangeOp = .insert,
+        saw_notes: bool = false,
+        json: std.ArrayListUnmanaged(u8) = .{},
+
+        fn onChanges(context: ?*anyopaque, batch: *const ChangeBatch) void {
+            const self: *@This() = @ptrCast(@alignCast(context.?));
+            self.batches += 1;
+            self.changes += batch.changes.len;
+            self.last_op = batch.changes[batch.changes.len - 1].op;
+            self.saw_notes = batch.touches("NOTES");
+            self.json.clearRetainingCapacity();
+            batch.writeJson(self.json.writer(std.testing.allocator)) catch {};
+        }
+    };
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+    try db.execute("CREATE TABLE notes (id INTEGER PRIMARY KEY, body TEXT)");
+
+    const feed = try ChangeFeed.init(allocator, .{});
+    defer feed.deinit();
+    try feed.attach(&db);
+    defer feed.detach(&db);
+
+    var collector = Collector{};
+    defer collector.json.deinit(allocator);
+    try feed.subscribe(Collector.onChanges, &collector);
+
+    try db.execute("INSERT INTO notes (body) VALUES ('one')");
+
+    var txn = try db.beginTransaction();
+    try txn.execute("INSERT INTO notes (body) VALUES ('two')");
+    try txn.execute("UPDATE notes SET body = 'uno' WHERE id = 1");
+    try txn.commit();
+    txn.deinit();
+
+    var rolled_back = try db.beginTransaction();
+    try rolled_back.execute("DELETE FROM notes");
+    try rolled_back.rollback();
+    rolled_back.deinit();
+
+    try db.execute("DELETE FROM notes WHERE id = 2");
+    feed.flush();
+
+    try std.testing.expectEqual(@as(usize, 3), collector.batches);
+    try std.testing.expectEqual(@as(usize, 4), collector.changes);
+    try std.testing.expectEqual(ChangeOp.delete, collector.last_op);
+    try std.testing.expect(collector.saw_notes);
+    try std.testing.expectEqualStrings("{\"seq\":3,\"changes\":[{\"table\":\"notes\",\"op\":\"delete\",\"rowid\":2}]}", collector.json.items);
+    try std.testing.expectEqual(@as(u64, 3), feed.stats().transactions);
+}
@@ -0,0 +1,355 @@
+const std = @import("std");
+const ModelSql = @import("model_sql.zig").ModelSql;
+const Statement = @import("database.zig").Statement;
+
+/// One condition of a compiled WHERE clause
+/// Build these with `eq`, `like`, `in`, `between`, `anyOf`, ... rather than by hand.
+pub const Cond = union(enum) {
+    compare: struct {
+        field: []const u8,
+        op: []const u8,
+    },
+    in_list: struct {
+        field: []const u8,
+        count: usize,
+        negate: bool,
+    },
+    between: []const u8,
+    is_null: struct {
+        field: []const u8,
+        negate: bool,
+    },
+    all: []const Cond,
+    any: []const Cond,
+};
+
+pub fn eq(comptime field: []const u8) Cond {
+    return compare(field, "=");
+}
+
+pub fn ne(comptime field: []const u8) Cond {
+    return compare(field, "!=");
+}
+
+pub fn gt(comptime field: []const u8) Cond {
+    return compare(field, ">");
+}
+
+pub fn gte(comptime field: []const u8) Cond {
+    return compare(field, ">=");
+}
+
+pub fn lt(comptime field: []const u8) Cond {
+    return compare(field, "<");
+}
+
+pub fn lte(comptime field: []const u8) Cond {
+    return compare(field, "<=");
+}
+
+/// `field LIKE ?`; the pattern (with its `%`) is a string param
+pub fn like(comptime field: []const u8) Cond {
+    return compare(field, "LIKE");
+}
+
+/// `field IN (?, ?, ...)` with `count` placeholders, bound from a `[count]FieldType` param
+pub fn in(comptime field: []const u8, comptime count: usize) Cond {
+    if (count == 0) @compileError("in(\"" ++ field ++ "\", 0) can never match");
+    return .{ .in_list = .{ .field = field, .count = count, .negate = false } };
+}
+
+pub fn notIn(comptime field: []const u8, comptime count: usize) Cond {
+    if (count == 0) @compileError("notIn(\"" ++ field ++ "\", 0) always matches");
+    return .{ .in_list = .{ .field = field, .count = count, .negate = true } };
+}
+
+/// `field BETWEEN ? AND ?`, bound from two params (low, high)
+pub fn between(comptime field: []const u8) Cond {
+    return .{ .between = field };
+}
+
+pub fn isNull(comptime field: []const u8) Cond {
+    return .{ .is_null = .{ .field = field, .negate = false } };
+}
+
+pub fn isNotNull(comptime field: []const u8) Cond {
+    return .{ .is_null = .{ .field = field, .negate = true } };
+}
+
+/// Every condition in the tuple must hold (AND); nests inside `anyOf`
+pub fn allOf(comptime conds: anytype) Cond {
+    return .{ .all = group(conds) };
+}
+
+/// At least one condition in the tuple must hold (OR); nests inside `allOf`
+pub fn anyOf(comptime conds: anytype) Cond {
+    return .{ .any = group(conds) };
+}
+
+fn compare(comptime field: []const u8, comptime op: []const u8) Cond {
+    return .{ .compare = .{ .field = field, .op = op } };
+}
+
+fn group(comptime conds: anytype) []const Cond {
+    comptime {
+        if (conds.len == 0) @compileError("Empty condition group");
+        var items: [conds.len]Cond = undefined;
+        for (0..conds.len) |i| items[i] = conds[i];
+        const final_items = items;
+        return &final_items;
+    }
+}
+
+pub const OrderBy = struct {
+    field: []const u8,
+    ascending: bool = true,
+};
+
+/// Shape of a compiled query; every value in it must be comptime-known
+pub const QuerySpec = struct {
+    where: ?Cond = null,
+    order_by: []const OrderBy = &.{},
+    /// Append `LIMIT ?`; its value is the param after the WHERE params
+    limit: bool = false,
+    /// Append `OFFSET ?` (requires `limit`); its value is the last param
+    offset: bool = false,
+};
+
+/// A SELECT whose SQL text is fixed at comptime
+/// Values never enter the SQL: every condition becomes `?` placeholders bound
+/// from a typed `Params` tuple, so the statement is prepared once and then
+/// served from the connection's statement cache on every later call.
+/// Field names are checked against `T` at compile time.
+///
+/// Example:
+/// ```zig
+/// const OpenTodos = CompiledQuery(Todo, .{
+///     .where = allOf(.{
+///         eq("user_id"),
+///         in("priority", 2),
+///         anyOf(.{ like("title"), like("description") }),
+///     }),
+///     .order_by = &.{.{ .field = "created_at", .ascending = false }},
+///     .limit = true,
+/// });
+/// // OpenTodos.sql: SELECT ... FROM todos WHERE user_id = ? AND priority IN (?, ?)
+/// //   AND (title LIKE ? OR description LIKE ?) ORDER BY created_at DESC LIMIT ?
+/// var todos = try orm.fetch(OpenTodos, .{ user_id, .{ "high", "medium" }, "%milk%", "%milk%", 20 }, arena);
+/// ```
+pub fn CompiledQuery(comptime T: type, comptime spec: QuerySpec) type {
+    if (spec.offset and !spec.limit) @compileError("CompiledQuery offset requires limit");
+
+    const Sql = ModelSql(T);
+    const where_sql = if (spec.where) |cond| " WHERE " ++ condSql(T, cond, false) else "";
+    const where_types: []const type = if (spec.where) |cond| condParams(T, cond) else &.{};
+
+    const order_sql = comptime blk: {
+        var text: []const u8 = "";
+        for (spec.order_by, 0..) |order, i| {
+            checkField(T, order.field);
+            text = text ++ (if (i == 0) " ORDER BY " else ", ") ++ order.field ++ (if (order.ascending) " ASC" else " DESC");
+        }
+        break :blk text;
+    };
+    const paging_sql = (if (spec.limit) " LIMIT ?" else "") ++ (if (spec.offset) " OFFSET ?" else "");
+    const paging_types: []const type = (if (spec.limit) &[_]type{u32} else &[_]type{}) ++
+        (if (spec.offset) &[_]type{u32} else &[_]type{});
+
+    return struct {
+        pub const Model = T;
+        pub const table_name = Sql.table_name;
+
+        pub const sql: [:0]const u8 = std.fmt.comptimePrint("{s}{s}{s}{s}", .{ Sql.select_all, where_sql, order_sql, paging_sql });
+        /// Same filter without ordering or paging, for total counts
+        pub const count_sql: [:0]const u8 = std.fmt.comptimePrint("SELECT COUNT(*) FROM {s}{s}", .{ Sql.table_name, where_sql });
+
+        /// WHERE values in condition order, then LIMIT and OFFSET
+        pub const Params = std.meta.Tuple(where_types ++ paging_types);
+        /// WHERE values only
+        pub const CountParams = std.meta.Tuple(where_types);
+
+        pub fn bind(stmt: *Statement, params: Params) Statement.Error!void {
+            try bindFlat(stmt, params);
+        }
+
+        pub fn bindCount(stmt: *Statement, params: CountParams) Statement.Error!void {
+            try bindFlat(stmt, params);
+        }
+    };
+}
+
+/// Bind a params tuple in order, expanding arrays (IN lists) into one value per `?`
+fn bindFlat(stmt: *Statement, params: anytype) Statement.Error!void {
+    var index: i32 = 1;
+    inline for (params) |value| {
+        if (comptime @typeInfo(@TypeOf(value)) == .array) {
+            for (value) |item| {
+                try stmt.bind(index, item);
+                index += 1;
+            }
+        } else {
+            try stmt.bind(index, value);
+            index += 1;
+        }
+    }
+}
+
+fn checkField(comptime T: type, comptime field: []const u8) void {
+    if (!@hasField(T, field)) {
+        @compileError("CompiledQuery on " ++ @typeName(T) ++ " names unknown field '" ++ field ++ "'");
+    }
+}
+
+fn condSql(comptime T: type, comptime cond: Cond, comptime nested: bool) []const u8 {
+    comptime {
+        switch (cond) {
+            .compare => |c| {
+                checkField(T, c.field);
+                return c.field ++ " " ++ c.op ++ " ?";
+            },
+            .in_list => |c| {
+                checkField(T, c.field);
+                var placeholders: []const u8 = "?";
+                for (1..c.count) |_| placeholders = placeholders ++ ", ?";
+                return c.field ++ (if (c.negate) " NOT IN (" else " IN (") ++ placeholders ++ ")";
+            },
+            .between => |field| {
+                checkField(T, field);
+                return field ++ " BETWEEN ? AND ?";
+            },
+            .is_null => |c| {
+                checkField(T, c.field);
+                return c.field ++ (if (c.negate) " IS NOT NULL" else " IS NULL");
+            },
+            .all => |conds| return groupSql(T, conds, " AND ", nested),
+            .any => |conds| return groupSql(T, conds, " OR ", nested),
+        }
+    }
+}
+
+fn groupSql(comptime T: type, comptime conds: []const Cond, comptime separator: []const u8, comptime nested: bool) []const u8 {
+    comptime {
+        if (conds.len == 1) return condSql(T, conds[0], nested);
+        var text: []const u8 = "";
+        for (conds, 0..) |cond, i| {
+            if (i > 0) text = text ++ separator;
+            text = text ++ condSql(T, cond, true);
+        }
+        return if (nested) "(" ++ text ++ ")" else text;
+    }
+}
+
+/// Param types a condition binds, in placeholder order
+fn condParams(comptime T: type, comptime cond: Cond) []const type {
+    comptime {
+        return switch (cond) {
+            .compare => |c| if (std.mem.eql(u8, c.op, "LIKE")) &[_]type{[]const u8} else &[_]type{FieldParam(T, c.field)},
+            .in_list => |c| &[_]type{[c.count]FieldParam(T, c.field)},
+            .between => |field| &[_]type{ FieldParam(T, field), FieldParam(T, field) },
+            .is_null => &[_]type{},
+            .all, .any => |conds| blk: {
+                var types: []const type = &.{};
+                for (conds) |sub| types = types ++ condParams(T, sub);
+                break :blk types;
+            },
+        };
+    }
+}
+
+/// Param type for a field; string fields take `[]const u8` so literals bind directly
+fn FieldParam(comptime T: type, comptime field: []const u8) type {
+    const F = @FieldType(T, field);
+    return switch (@typeInfo(F)) {
+        .optional => |opt| if (isString(opt.child)) ?[]const u8 else F,
+        else => if (isString(F)) []const u8 else F,
+    };
+}
+
+fn isString(comptime F: type) bool {
+    return switch (@typeInfo(F)) {
+        .pointer => |ptr| ptr.size == .slice and ptr.child == u8,
+        else => false,
+    };
+}
+
+test "CompiledQuery builds constant SQL with placeholders" {
+    const Note = struct {
+        id: i64,
+        user_id: i64,
+        title: []u8,
+        body: ?[]u8,
+        priority: i32,
+    };
+
+    const Q = CompiledQuery(Note, .{
+        .where = allOf(.{
+            eq("user_id"),
+            in("priority", 3),
+            anyOf(.{ like("title"), allOf(.{ isNotNull("body"), like("body") }) }),
+            between("id"),
+        }),
+        .order_by = &.{ .{ .field = "priority", .ascending = false }, .{ .field = "id" } },
+        .limit = true,
+        .offset = true,
+    });
+
+    try std.testing.expectEqualStrings(
+        "SELECT id, user_id, title, body, priority FROM note WHERE user_id = ? AND priority IN (?, ?, ?)" ++
+            " AND (title LIKE ? OR (body IS NOT NULL AND body LIKE ?)) AND id BETWEEN ? AND ?" ++
+            " ORDER BY priority DESC, id ASC LIMIT ? OFFSET ?",
+        Q.sql,
+    );
+    try std.testing.expectEqualStrings(
+        "SELECT COUNT(*) FROM note WHERE user_id = ? AND priority IN (?, ?, ?)" ++
+            " AND (title LIKE ? OR (body IS NOT NULL AND body LIKE ?)) AND id BETWEEN ? AND ?",
+        Q.count_sql,
+    );
+
+    const fields = std.meta.fields(Q.Params);
+    try std.testing.expectEqual(@as(usize, 8), fields.len);
+    try std.testing.expect(fields[1].type == [3]i32);
+    try std.testing.expect(fields[2].type == []const u8);
+    try std.testing.expect(fields[7].type == u32);
+    try std.testing.expectEqual(@as(usize, 6), std.meta.fields(Q.CountParams).len);
+
+    // A lone condition needs no grouping parentheses
+    const ByUser = CompiledQuery(Note, .{ .where = anyOf(.{eq("user_id")}) });
+    try std.testing.expectEqualStrings("SELECT id, user_id, title, body, priority FROM note WHERE user_id = ?", ByUser.sql);
+}
+
+test "CompiledQuery binds params on a prepared statement" {
+    const allocator = std.testing.allocator;
+    const Database = @import("database.zig").Database;
+
+    const Item = struct {
+        id: i64,
+        kind: []const u8,
+        score: i64,
+    };
+    const Q = CompiledQuery(Item, .{
+        .where = anyOf(.{ in("kind", 2), between("score") }),
+        .order_by = &.{.{ .field = "id" }},
+    });
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+    try db.execute("CREATE TABLE item (id INTEGER PRIMARY KEY, kind TEXT, score INTEGER)");
+    try db.execute("INSERT INTO item (kind, score) VALUES ('a', 1), ('b', 50), ('c', 7), ('d', 99)");
+
+    // Run twice: the second prepare is a statement cache hit with fresh bindings
+    const runs = [_]Q.Params{ .{ .{ "a", "d" }, 5, 10 }, .{ .{ "b", "b" }, 90, 100 } };
+    const expected = [_][]const i64{ &.{ 1, 3, 4 }, &.{ 2, 4 } };
+    for (runs, expected) |params, want| {
+        var stmt = try db.prepare(Q.sql);
+        defer stmt.deinit();
+        try Q.bind(&stmt, params);
+
+        var result = try stmt.query();
+        defer result.deinit();
+        var ids = std.ArrayListUnmanaged(i64){};
+        defer ids.deinit(allocator);
+        while (result.nextRow()) |row| try ids.append(allocator, row.getInt64(0));
+        try std.testing.expectEqualSlices(i64, want, ids.items);
+    }
+    try std.testing.expect(db.statementCacheStats().hits >= 1);
+}
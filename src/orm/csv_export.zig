@@ -0,0 +1,140 @@
+const std = @import("std");
+const QueryResult = @import("row.zig").QueryResult;
+
+pub const CsvOptions = struct {
+    /// Field separator; use `tsv` for tab-separated output
+    delimiter: u8 = ',',
+    /// Write the column names as the first line
+    header: bool = true,
+    /// Text written for SQL NULL
+    null_text: []const u8 = "",
+    line_ending: []const u8 = "\r\n",
+
+    /// Tab-separated values with the same quoting rules
+    pub const tsv = CsvOptions{ .delimiter = '\t' };
+};
+
+/// Writes query results as CSV through a reusable row buffer
+/// Each row is assembled in one buffer that keeps its capacity between rows
+/// and handed to the writer with a single `writeAll`, so exporting a table
+/// allocates nothing per row however many rows it has.
+pub const CsvWriter = struct {
+    allocator: std.mem.Allocator,
+    options: CsvOptions,
+    row_buffer: std.ArrayListUnmanaged(u8) = .{},
+
+    pub fn init(allocator: std.mem.Allocator, options: CsvOptions) CsvWriter {
+        return .{ .allocator = allocator, .options = options };
+    }
+
+    pub fn deinit(self: *CsvWriter) void {
+        self.row_buffer.deinit(self.allocator);
+    }
+
+    /// Stream every remaining row of `result` to `writer`; returns the number of data rows
+    pub fn writeResult(self: *CsvWriter, result: *QueryResult, writer: anytype) !usize {
+        const column_count = result.columnCount();
+
+        if (self.options.header) {
+            self.row_buffer.clearRetainingCapacity();
+            var col: i32 = 0;
+            while (col < column_count) : (col += 1) {
+                try self.appendField(col, result.columnName(col) orelse "");
+            }
+            try self.endRow(writer);
+        }
+
+        var rows: usize = 0;
+        while (try result.step()) |row| {
+            self.row_buffer.clearRetainingCapacity();
+            var col: i32 = 0;
+            while (col < column_count) : (col += 1) {
+                // SQLite renders integers and reals as text, so one accessor covers every column
+                try self.appendField(col, row.getText(col) orelse self.options.null_text);
+            }
+            try self.endRow(writer);
+            rows += 1;
+        }
+        return rows;
+    }
+
+    fn appendField(self: *CsvWriter, col: i32, value: []const u8) !void {
+        if (col > 0) try self.row_buffer.append(self.allocator, self.options.delimiter);
+        try appendQuoted(&self.row_buffer, self.allocator, value, self.options.delimiter);
+    }
+
+    fn endRow(self: *CsvWriter, writer: anytype) !void {
+        try self.row_buffer.appendSlice(self.allocator, self.options.line_ending);
+        try writer.writeAll(self.row_buffer.items);
+    }
+};
+
+/// Append one field, quoted per RFC 4180 when it holds the delimiter, a quote or a line break
+pub fn appendQuoted(out: *std.ArrayListUnmanaged(u8), allocator: std.mem.Allocator, value: []const u8, delimiter: u8) !void {
+    const needs_quotes = for (value) |char| {
+        if (char == delimiter or char == '"' or char == '\n' or char == '\r') break true;
+    } else false;
+
+    if (!needs_quotes) return out.appendSlice(allocator, value);
+
+    try out.append(allocator, '"');
+    var rest = value;
+    while (std.mem.indexOfScalar(u8, rest, '"')) |pos| {
+        try out.appendSlice(allocator, rest[0 .. pos + 1]);
+        try out.append(allocator, '"');
+        rest = rest[pos + 1 ..];
+    }
+    try out.appendSlice(allocator, rest);
+    try out.append(allocator, '"');
+}
+
+test "appendQuoted quotes only when needed" {
+    const allocator = std.testing.allocator;
+    var out = std.ArrayListUnmanaged(u8){};
+    defer out.deinit(allocator);
+
+    try appendQuoted(&out, allocator, "plain text", ',');
+    try out.append(allocator, '|');
+    try appendQuoted(&out, allocator, "a,b", ',');
+    try out.append(allocator, '|');
+    try appendQuoted(&out, allocator, "say \"hi\"", ',');
+    try out.append(allocator, '|');
+    try appendQuoted(&out, allocator, "two\nlines", ',');
+    try out.append(allocator, '|');
+    try appendQuoted(&out, allocator, "a,b", '\t');
+
+    try std.testing.expectEqualStrings("plain text|\"a,b\"|\"say \"\"hi\"\"\"|\"two\nlines\"|a,b", out.items);
+}
+
+test "CsvWriter streams a query result" {
+    const allocator = std.testing.allocator;
+    const Database = @import("database.zig").Database;
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+    try db.execute("CREATE TABLE items (id INTEGER PRIMARY KEY, name TEXT, price REAL, note TEXT)");
+    try db.execute("INSERT INTO items (name, price, note) VALUES ('Widget', 2.5, NULL), ('Gadget, large', 10, 'tab\there')");
+
+    var out = std.ArrayListUnmanaged(u8){};
+    defer out.deinit(allocator);
+
+    var result = try db.query("SELECT id, name, price, note FROM items ORDER BY id");
+    defer result.deinit();
+    var csv = CsvWriter.init(allocator, .{});
+    defer csv.deinit();
+    const rows = try csv.writeResult(&result, out.writer(allocator));
+
+    try std.testing.expectEqual(@as(usize, 2), rows);
+    try std.testing.expectEqualStrings(
+        "id,name,price,note\r\n1,Widget,2.5,\r\n2,\"Gadget, large\",10.0,tab\there\r\n",
+        out.items,
+    );
+
+    out.clearRetainingCapacity();
+    var again = try db.query("SELECT name, note FROM items WHERE id = 2");
+    defer again.deinit();
+    var tsv = CsvWriter.init(allocator, CsvOptions.tsv);
+    defer tsv.deinit();
+    _ = try tsv.writeResult(&again, out.writer(allocator));
+    try std.testing.expectEqualStrings("name\tnote\r\nGadget, large\t\"tab\there\"\r\n", out.items);
+}
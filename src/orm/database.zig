@@ -3,11 +3,78 @@ const c = @cImport({
     @cInclude("e12_orm.h");
 });
 const QueryResult = @import("row.zig").QueryResult;
+const QueryPlanInspector = @import("query_plan.zig").QueryPlanInspector;
+
+/// Options for opening a database connection
+pub const OpenOptions = struct {
+    /// Maximum number of prepared statements cached per connection (0 disables caching)
+    statement_cache_capacity: usize = c.E12_STMT_CACHE_DEFAULT_CAPACITY,
+    /// Create the database file when it does not exist (false fails with error.DatabaseOpenFailed)
+    create: bool = true,
+};
+
+/// Prepared statement cache statistics for a single connection
+pub const StatementCacheStats = struct {
+    hits: u64 = 0,
+    misses: u64 = 0,
+    evictions: u64 = 0,
+    size: usize = 0,
+    capacity: usize = 0,
+
+    /// Share of prepares that reused a cached statement instead of compiling SQL
+    /// Returns 0.0 before the first prepare.
+    pub fn hitRate(self: StatementCacheStats) f64 {
+        const total = self.hits + self.misses;
+        if (total == 0) return 0.0;
+        return @as(f64, @floatFromInt(self.hits)) / @as(f64, @floatFromInt(total));
+    }
+};
+
+/// SQLite runtime counters for one connection; see `Database.status`
+/// Hit/miss/write counters grow for the lifetime of the connection. The
+/// `memory_*`, `malloc_count` and `pagecache_overflow` values cover the whole process.
+pub const DbStatus = struct {
+    cache_used: u64 = 0,
+    cache_hit: u64 = 0,
+    cache_miss: u64 = 0,
+    cache_write: u64 = 0,
+    cache_spill: u64 = 0,
+    lookaside_used: u64 = 0,
+    lookaside_hit: u64 = 0,
+    lookaside_miss_size: u64 = 0,
+    lookaside_miss_full: u64 = 0,
+    schema_used: u64 = 0,
+    stmt_used: u64 = 0,
+    memory_used: u64 = 0,
+    memory_highwater: u64 = 0,
+    malloc_count: u64 = 0,
+    pagecache_overflow: u64 = 0,
+    /// Size of the -wal file (0 outside WAL mode)
+    wal_bytes: u64 = 0,
+
+    /// Fraction of page lookups served from the page cache (0.0 when there were none)
+    pub fn cacheHitRate(self: DbStatus) f64 {
+        const total = self.cache_hit + self.cache_miss;
+        if (total == 0) return 0.0;
+        return @as(f64, @floatFromInt(self.cache_hit)) / @as(f64, @floatFromInt(total));
+    }
+};
+
+/// Space used by one table or index, from the `dbstat` virtual table
+pub const TableSize = struct {
+    name: []u8,
+    bytes: u64,
+    pages: u64,
+};
 
 pub const ConnectionPoolConfig = struct {
     max_connections: usize = 10,
-    idle_timeout_ms: u64 = 300000, // 5 minutes default
-    acquire_timeout_ms: u64 = 5000, // 5 seconds default
+    idle_timeout_ms: u64 = 300000, // 5 minutes default, 0 disables idle eviction
+    acquire_timeout_ms: u64 = 5000, // 5 seconds default, 0 fails immediately when exhausted
+    /// Open pooled connections read-only
+    read_only: bool = false,
+    /// SQL run on every new pooled connection (e.g. PRAGMAs)
+    init_sql: ?[:0]const u8 = null,
 
     /// Validate configuration values
     pub fn validate(self: *const ConnectionPoolConfig) !void {
@@ -20,93 +87,184 @@ pub const ConnectionPoolConfig = struct {
     }
 };
 
+/// Connection pool statistics, including an acquire wait-time histogram
+pub const PoolStats = struct {
+    pub const bucket_count = c.E12_POOL_WAIT_BUCKET_COUNT;
+
+    max_connections: usize,
+    open_connections: usize,
+    in_use_connections: usize,
+    idle_connections: usize,
+    waiting_threads: usize,
+    acquires: u64,
+    waits: u64,
+    timeouts: u64,
+    affinity_hits: u64,
+    connections_created: u64,
+    connections_evicted: u64,
+    wait_time_total_us: u64,
+    /// Per-bucket (non-cumulative) counts; see `bucketUpperBoundUs`
+    wait_histogram: [bucket_count]u64,
+
+    /// Upper bound of a histogram bucket in microseconds (maxInt(u64) for +Inf)
+    pub fn bucketUpperBoundUs(index: usize) u64 {
+        return c.e12_pool_wait_bucket_upper_bound_us(index);
+    }
+
+    /// Write the stats in Prometheus text format
+    ///
+    /// Example output:
+    /// ```
+    /// db_pool_connections_open{pool="main"} 4
+    /// db_pool_wait_seconds_bucket{pool="main",le="0.0001"} 120
+    /// ```
+    pub fn writePrometheus(self: PoolStats, writer: anytype, pool_name: []const u8) !void {
+        try writer.print("db_pool_connections_max{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.max_connections });
+        try writer.print("db_pool_connections_open{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.open_connections });
+        try writer.print("db_pool_connections_in_use{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.in_use_connections });
+        try writer.print("db_pool_connections_idle{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.idle_connections });
+        try writer.print("db_pool_waiting_threads{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.waiting_threads });
+        try writer.print("db_pool_acquire_timeouts_total{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.timeouts });
+        try writer.print("db_pool_affinity_hits_total{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.affinity_hits });
+        try writer.print("db_pool_connections_created_total{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.connections_created });
+        try writer.print("db_pool_connections_evicted_total{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.connections_evicted });
+
+        var cumulative: u64 = 0;
+        for (self.wait_histogram, 0..) |count, i| {
+            cumulative += count;
+            const bound = bucketUpperBoundUs(i);
+            if (bound == std.math.maxInt(u64)) {
+                try writer.print("db_pool_wait_seconds_bucket{{pool=\"{s}\",le=\"+Inf\"}} {d}\n", .{ pool_name, cumulative });
+            } else {
+                const seconds = @as(f64, @floatFromInt(bound)) / 1_000_000.0;
+                try writer.print("db_pool_wait_seconds_bucket{{pool=\"{s}\",le=\"{d}\"}} {d}\n", .{ pool_name, seconds, cumulative });
+            }
+        }
+        const total_seconds = @as(f64, @floatFromInt(self.wait_time_total_us)) / 1_000_000.0;
+        try writer.print("db_pool_wait_seconds_sum{{pool=\"{s}\"}} {d}\n", .{ pool_name, total_seconds });
+        try writer.print("db_pool_wait_seconds_count{{pool=\"{s}\"}} {d}\n", .{ pool_name, self.acquires });
+    }
+};
+
+/// Blocking, fair connection pool backed by the C pool (e12_pool_*)
+/// acquire() waits up to `acquire_timeout_ms` for a connection; waiters are served
+/// in FIFO order. Without contention a thread gets back the connection it released
+/// last, which keeps that connection's statement cache warm. Connections idle for
+/// longer than `idle_timeout_ms` are closed by a background thread.
+///
+/// Example:
+/// ```zig
+/// var pool = try ConnectionPool.init("app.db", .{ .max_connections = 8 }, allocator);
+/// defer pool.deinit();
+///
+/// var db = try pool.acquire();
+/// defer pool.release(db);
+/// try db.execute("SELECT 1");
+/// ```
 pub const ConnectionPool = struct {
-    db_path: []const u8,
+    c_pool: *c.E12ConnectionPool,
     config: ConnectionPoolConfig,
     allocator: std.mem.Allocator,
-    available: std.ArrayListUnmanaged(Database),
-    in_use: std.ArrayListUnmanaged(Database),
-    mutex: std.Thread.Mutex,
-    created: usize = 0,
 
-    pub fn init(db_path: []const u8, config: ConnectionPoolConfig, allocator: std.mem.Allocator) ConnectionPool {
+    pub fn init(db_path: []const u8, config: ConnectionPoolConfig, allocator: std.mem.Allocator) !ConnectionPool {
+        try config.validate();
+
+        const c_path = try allocator.dupeZ(u8, db_path);
+        defer allocator.free(c_path);
+
+        const c_config = c.E12ConnectionPoolConfig{
+            .max_connections = config.max_connections,
+            .idle_timeout_ms = config.idle_timeout_ms,
+            .acquire_timeout_ms = config.acquire_timeout_ms,
+            .open_flags = if (config.read_only) c.E12_OPEN_READ_ONLY else 0,
+            .init_sql = if (config.init_sql) |sql| sql.ptr else null,
+        };
+
+        var c_pool: ?*c.E12ConnectionPool = null;
+        const err = c.e12_pool_create(c_path, &c_config, &c_pool);
+        if (err != c.E12_ORM_OK) {
+            return switch (err) {
+                c.E12_ORM_ERROR_INVALID_ARGUMENT => error.InvalidArgument,
+                else => error.DatabaseError,
+            };
+        }
+
         return ConnectionPool{
-            .db_path = db_path,
+            .c_pool = c_pool.?,
             .config = config,
             .allocator = allocator,
-            .available = std.ArrayListUnmanaged(Database){},
-            .in_use = std.ArrayListUnmanaged(Database){},
-            .mutex = std.Thread.Mutex{},
-            .created = 0,
         };
     }
 
+    /// Acquire a connection, waiting up to `acquire_timeout_ms`
+    /// Returns error.PoolExhausted if no connection became available in time.
+    /// Never call close() on a pooled connection; hand it back with release().
     pub fn acquire(self: *ConnectionPool) !Database {
-        self.mutex.lock();
-        defer self.mutex.unlock();
-
-        // Try to get from available pool
-        if (self.available.items.len > 0) {
-            const db = self.available.items[self.available.items.len - 1];
-            _ = self.available.pop();
-            try self.in_use.append(self.allocator, db);
-            return db;
-        }
+        return self.acquireTimeout(self.config.acquire_timeout_ms);
+    }
 
-        // Create new connection if under limit
-        if (self.created < self.config.max_connections) {
-            const db = try Database.open(self.db_path, self.allocator);
-            self.created += 1;
-            try self.in_use.append(self.allocator, db);
-            return db;
+    /// Acquire a connection with an explicit timeout (0 = do not wait)
+    pub fn acquireTimeout(self: *ConnectionPool, timeout_ms: u64) !Database {
+        var c_db: ?*c.E12Database = null;
+        const err = c.e12_pool_acquire_timeout(self.c_pool, timeout_ms, &c_db);
+        if (err != c.E12_ORM_OK) {
+            return switch (err) {
+                c.E12_ORM_ERROR_POOL_EXHAUSTED => error.PoolExhausted,
+                c.E12_ORM_ERROR_OPEN_FAILED => error.DatabaseOpenFailed,
+                c.E12_ORM_ERROR_INVALID_ARGUMENT => error.InvalidArgument,
+                else => error.DatabaseError,
+            };
         }
 
-        // Wait for available connection (simplified - just return error for now)
-        return error.PoolExhausted;
+        return Database{
+            .c_db = c_db.?,
+            .allocator = self.allocator,
+        };
     }
 
+    /// Return a connection to the pool (O(1))
     pub fn release(self: *ConnectionPool, db: Database) void {
-        self.mutex.lock();
-        defer self.mutex.unlock();
-
-        // Find and remove from in_use
-        for (self.in_use.items, 0..) |conn, i| {
-            if (conn.c_db == db.c_db) {
-                var removed_db = self.in_use.swapRemove(i);
-                self.available.append(self.allocator, db) catch |err| {
-                    // If we can't add to pool, log error and close connection
-                    std.debug.print("[ConnectionPool] Warning: Failed to return connection to pool: {}. Closing connection.\n", .{err});
-                    removed_db.close();
-                    self.created -= 1;
-                };
-                return;
-            }
-        }
-        // Connection not found in in_use - this shouldn't happen but log it
-        std.debug.print("[ConnectionPool] Warning: Attempted to release connection not in use pool. Closing connection.\n", .{});
-        var mutable_db = db;
-        mutable_db.close();
+        c.e12_pool_release(self.c_pool, db.c_db);
     }
 
-    pub fn deinit(self: *ConnectionPool) void {
-        self.mutex.lock();
-        defer self.mutex.unlock();
-
-        for (self.available.items) |*db| {
-            db.close();
+    pub fn stats(self: *ConnectionPool) PoolStats {
+        var c_stats: c.E12PoolStats = undefined;
+        _ = c.e12_pool_get_stats(self.c_pool, &c_stats);
+
+        var result = PoolStats{
+            .max_connections = c_stats.max_connections,
+            .open_connections = c_stats.open_connections,
+            .in_use_connections = c_stats.in_use_connections,
+            .idle_connections = c_stats.idle_connections,
+            .waiting_threads = c_stats.waiting_threads,
+            .acquires = c_stats.acquires,
+            .waits = c_stats.waits,
+            .timeouts = c_stats.timeouts,
+            .affinity_hits = c_stats.affinity_hits,
+            .connections_created = c_stats.connections_created,
+            .connections_evicted = c_stats.connections_evicted,
+            .wait_time_total_us = c_stats.wait_time_total_us,
+            .wait_histogram = undefined,
+        };
+        for (&result.wait_histogram, 0..) |*bucket, i| {
+            bucket.* = c_stats.wait_histogram[i];
         }
-        self.available.deinit(self.allocator);
+        return result;
+    }
 
-        for (self.in_use.items) |*db| {
-            db.close();
-        }
-        self.in_use.deinit(self.allocator);
+    /// Close the pool
+    /// Idle connections are closed now; connections still checked out are closed
+    /// when they are released.
+    pub fn deinit(self: *ConnectionPool) void {
+        c.e12_pool_close(self.c_pool);
     }
 };
 
 pub const Database = struct {
     c_db: *c.E12Database,
     allocator: std.mem.Allocator,
+    /// Optional EXPLAIN QUERY PLAN check run by query() (development and tests)
+    plan_inspector: ?*QueryPlanInspector = null,
 
     /// Capture and log C API error message with context
     /// This provides detailed error information for debugging
@@ -122,11 +280,23 @@ pub const Database = struct {
     }
 
     pub fn open(path: []const u8, allocator: std.mem.Allocator) !Database {
+        return openWithOptions(path, allocator, .{});
+    }
+
+    /// Open a database with explicit connection options
+    ///
+    /// Example:
+    /// ```zig
+    /// var db = try Database.openWithOptions("app.db", allocator, .{ .statement_cache_capacity = 256 });
+    /// defer db.close();
+    /// ```
+    pub fn openWithOptions(path: []const u8, allocator: std.mem.Allocator, options: OpenOptions) !Database {
         const c_path = try allocator.dupeZ(u8, path);
         defer allocator.free(c_path);
 
         var c_db: ?*c.E12Database = null;
-        const err = c.e12_db_open(c_path, &c_db);
+        const flags: u32 = if (options.create) 0 else c.E12_OPEN_NO_CREATE;
+        const err = c.e12_db_open_with_flags(c_path, flags, &c_db);
 
         if (err != c.E12_ORM_OK) {
             captureError("Failed to open database", null);
@@ -137,16 +307,156 @@ pub const Database = struct {
             };
         }
 
-        return Database{
+        var db = Database{
             .c_db = c_db.?,
             .allocator = allocator,
         };
+        errdefer db.close();
+
+        if (options.statement_cache_capacity != c.E12_STMT_CACHE_DEFAULT_CAPACITY) {
+            try db.setStatementCacheCapacity(options.statement_cache_capacity);
+        }
+
+        return db;
     }
 
     pub fn close(self: *Database) void {
         c.e12_db_close(self.c_db);
     }
 
+    /// Set the maximum number of prepared statements cached by this connection
+    /// Clears the cache. A capacity of 0 disables statement caching.
+    pub fn setStatementCacheCapacity(self: *Database, capacity: usize) !void {
+        const err = c.e12_db_set_statement_cache_capacity(self.c_db, capacity);
+        if (err != c.E12_ORM_OK) {
+            captureError("Failed to set statement cache capacity", null);
+            return switch (err) {
+                c.E12_ORM_ERROR_INVALID_ARGUMENT => error.InvalidArgument,
+                else => error.DatabaseError,
+            };
+        }
+    }
+
+    /// Get prepared statement cache hit/miss statistics for this connection
+    pub fn statementCacheStats(self: *const Database) StatementCacheStats {
+        var c_stats: c.E12StatementCacheStats = undefined;
+        c.e12_db_get_statement_cache_stats(self.c_db, &c_stats);
+        return StatementCacheStats{
+            .hits = c_stats.hits,
+            .misses = c_stats.misses,
+            .evictions = c_stats.evictions,
+            .size = c_stats.size,
+            .capacity = c_stats.capacity,
+        };
+    }
+
+    /// Finalize all idle cached statements for this connection
+    pub fn clearStatementCache(self: *Database) void {
+        c.e12_db_clear_statement_cache(self.c_db);
+    }
+
+    /// Read SQLite's page cache, lookaside and memory counters for this connection
+    pub fn status(self: *const Database) DbStatus {
+        var c_status: c.E12DbStatus = undefined;
+        c.e12_db_get_status(self.c_db, &c_status);
+        return DbStatus{
+            .cache_used = nonNegative(c_status.cache_used),
+            .cache_hit = nonNegative(c_status.cache_hit),
+            .cache_miss = nonNegative(c_status.cache_miss),
+            .cache_write = nonNegative(c_status.cache_write),
+            .cache_spill = nonNegative(c_status.cache_spill),
+            .lookaside_used = nonNegative(c_status.lookaside_used),
+            .lookaside_hit = nonNegative(c_status.lookaside_hit),
+            .lookaside_miss_size = nonNegative(c_status.lookaside_miss_size),
+            .lookaside_miss_full = nonNegative(c_status.lookaside_miss_full),
+            .schema_used = nonNegative(c_status.schema_used),
+            .stmt_used = nonNegative(c_status.stmt_used),
+            .memory_used = nonNegative(c_status.memory_used),
+            .memory_highwater = nonNegative(c_status.memory_highwater),
+            .malloc_count = nonNegative(c_status.malloc_count),
+            .pagecache_overflow = nonNegative(c_status.pagecache_overflow),
+            .wal_bytes = nonNegative(c_status.wal_bytes),
+        };
+    }
+
+    fn nonNegative(value: i64) u64 {
+        return @intCast(@max(0, value));
+    }
+
+    /// Bytes and pages used by each table and index, largest first
+    /// Reads every page of the database through `dbstat`, so sample it
+    /// occasionally rather than per request. Free with `freeTableSizes`.
+    ///
+    /// Example:
+    /// ```zig
+    /// const sizes = try db.tableSizes(allocator);
+    /// defer Database.freeTableSizes(allocator, sizes);
+    /// for (sizes) |size| std.debug.print("{s}: {d} bytes\n", .{ size.name, size.bytes });
+    /// ```
+    pub fn tableSizes(self: *Database, allocator: std.mem.Allocator) ![]TableSize {
+        var sizes = std.ArrayListUnmanaged(TableSize){};
+        errdefer {
+            for (sizes.items) |size| allocator.free(size.name);
+            sizes.deinit(allocator);
+        }
+
+        var result = try self.query("SELECT name, SUM(pgsize), COUNT(*) FROM dbstat GROUP BY name ORDER BY 2 DESC");
+        defer result.deinit();
+        while (try result.step()) |row| {
+            const name = try allocator.dupe(u8, row.getText(0) orelse "");
+            errdefer allocator.free(name);
+            try sizes.append(allocator, .{
+                .name = name,
+                .bytes = nonNegative(row.getInt64(1)),
+                .pages = nonNegative(row.getInt64(2)),
+            });
+        }
+        return sizes.toOwnedSlice(allocator);
+    }
+
+    pub fn freeTableSizes(allocator: std.mem.Allocator, sizes: []TableSize) void {
+        for (sizes) |size| allocator.free(size.name);
+        allocator.free(sizes);
+    }
+
+    /// Start an online backup of this database into the file at `dest_path`
+    /// Call `step()` until it returns true, then `finish()`. The connection stays
+    /// usable between steps; writes made through it are carried into the copy.
+    ///
+    /// Example:
+    /// ```zig
+    /// var backup = try db.startBackup("backup.db");
+    /// while (!try backup.step(100)) std.Thread.sleep(10 * std.time.ns_per_ms);
+    /// try backup.finish();
+    /// ```
+    pub fn startBackup(self: *Database, dest_path: []const u8) !Backup {
+        const c_path = try self.allocator.dupeZ(u8, dest_path);
+        defer self.allocator.free(c_path);
+
+        var c_backup: ?*c.E12Backup = null;
+        const err = c.e12_backup_init(self.c_db, c_path, &c_backup);
+        if (err != c.E12_ORM_OK) {
+            captureError("Failed to start backup", null);
+            return switch (err) {
+                c.E12_ORM_ERROR_OPEN_FAILED => error.DatabaseOpenFailed,
+                c.E12_ORM_ERROR_INVALID_ARGUMENT => error.InvalidArgument,
+                c.E12_ORM_ERROR_QUERY_FAILED => error.QueryFailed,
+                else => error.DatabaseError,
+            };
+        }
+        return Backup{ .c_backup = c_backup.? };
+    }
+
+    /// Write a compacted copy of the database to `dest_path` with `VACUUM INTO`
+    /// The file must not exist yet. The copy is taken in one read transaction,
+    /// so it holds this connection for the whole copy.
+    pub fn vacuumInto(self: *Database, dest_path: []const u8) !void {
+        var stmt = try self.prepare("VACUUM INTO ?");
+        defer stmt.deinit();
+        try stmt.bind(1, dest_path);
+        try stmt.execute();
+    }
+
     pub fn beginTransaction(self: *Database) !Transaction {
         var c_transaction: ?*c.E12Transaction = null;
         const err = c.e12_db_begin_transaction(self.c_db, &c_transaction);
@@ -201,7 +511,23 @@ pub const Database = struct {
         return rows_affected;
     }
 
+    /// Report full table scans in query() through `inspector` (null disables)
+    /// Only this connection value is affected: pooled connections and copies
+    /// made before the call (such as an ORM's) keep their own setting.
+    ///
+    /// Example:
+    /// ```zig
+    /// var inspector = QueryPlanInspector.init(allocator, .{ .on_scan = .fail });
+    /// defer inspector.deinit();
+    /// db.setPlanInspector(&inspector);
+    /// ```
+    pub fn setPlanInspector(self: *Database, inspector: ?*QueryPlanInspector) void {
+        self.plan_inspector = inspector;
+    }
+
     pub fn query(self: *Database, sql: []const u8) !QueryResult {
+        if (self.plan_inspector) |inspector| try inspector.check(self, sql);
+
         const c_sql = try self.allocator.dupeZ(u8, sql);
         defer self.allocator.free(c_sql);
 
@@ -220,6 +546,38 @@ pub const Database = struct {
         return QueryResult.init(c_result.?, self.allocator);
     }
 
+    /// Prepare a single SQL statement with `?` placeholders
+    /// Statements are served from the connection's statement cache, so preparing
+    /// the same SQL text repeatedly only compiles it once.
+    ///
+    /// Example:
+    /// ```zig
+    /// var stmt = try db.prepare("SELECT name FROM users WHERE id = ?");
+    /// defer stmt.deinit();
+    /// try stmt.bind(1, user_id);
+    /// var result = try stmt.query();
+    /// defer result.deinit();
+    /// ```
+    pub fn prepare(self: *Database, sql: [:0]const u8) !Statement {
+        var c_stmt: ?*c.E12Statement = null;
+        const err = c.e12_db_prepare(self.c_db, sql.ptr, &c_stmt);
+
+        if (err != c.E12_ORM_OK) {
+            captureError("Failed to prepare SQL statement", sql);
+            return switch (err) {
+                c.E12_ORM_ERROR_QUERY_FAILED => error.QueryFailed,
+                c.E12_ORM_ERROR_INVALID_ARGUMENT => error.InvalidArgument,
+                else => error.DatabaseError,
+            };
+        }
+
+        return Statement{
+            .c_stmt = c_stmt.?,
+            .sql = sql,
+            .allocator = self.allocator,
+        };
+    }
+
     pub fn lastInsertRowId(self: *Database) !i64 {
         var result = try self.query("SELECT last_insert_rowid()");
         defer result.deinit();
@@ -242,6 +600,167 @@ pub const Database = struct {
     };
 };
 
+/// A prepared SQL statement with `?` placeholders
+/// Values are bound directly with no SQL string formatting or escaping.
+/// Bound text is not copied and must outlive `execute()` / the query result.
+pub const Statement = struct {
+    c_stmt: *c.E12Statement,
+    sql: []const u8,
+    allocator: std.mem.Allocator,
+
+    pub const Error = error{
+        InvalidArgument,
+        QueryFailed,
+        DatabaseError,
+        /// An integer or enum value does not fit SQLite's 64-bit signed integer
+        IntegerOverflow,
+    };
+
+    fn mapError(err: c.E12ORMErrorCode) Error {
+        return switch (err) {
+            c.E12_ORM_ERROR_QUERY_FAILED => error.QueryFailed,
+            c.E12_ORM_ERROR_INVALID_ARGUMENT => error.InvalidArgument,
+            else => error.DatabaseError,
+        };
+    }
+
+    /// Number of `?` parameters in the statement
+    pub fn parameterCount(self: *const Statement) i32 {
+        return c.e12_stmt_bind_parameter_count(self.c_stmt);
+    }
+
+    /// Bind a value to a 1-based parameter index
+    /// Supports integers, floats, bools, strings, enums (stored as integers), optionals and null.
+    /// Integers outside the i64 range (e.g. a u64 above maxInt(i64)) return error.IntegerOverflow.
+    pub fn bind(self: *Statement, index: i32, value: anytype) Error!void {
+        const T = @TypeOf(value);
+        const err = switch (@typeInfo(T)) {
+            .null => c.e12_stmt_bind_null(self.c_stmt, index),
+            .optional => {
+                if (value) |inner_value| {
+                    return self.bind(index, inner_value);
+                }
+                return self.bind(index, null);
+            },
+            .comptime_int => c.e12_stmt_bind_int64(self.c_stmt, index, @as(i64, value)),
+            .int => c.e12_stmt_bind_int64(self.c_stmt, index, std.math.cast(i64, value) orelse return error.IntegerOverflow),
+            .comptime_float => c.e12_stmt_bind_double(self.c_stmt, index, @as(f64, value)),
+            .float => c.e12_stmt_bind_double(self.c_stmt, index, @as(f64, @floatCast(value))),
+            .bool => c.e12_stmt_bind_int64(self.c_stmt, index, @intFromBool(value)),
+            .@"enum" => c.e12_stmt_bind_int64(self.c_stmt, index, std.math.cast(i64, @intFromEnum(value)) orelse return error.IntegerOverflow),
+            .pointer => |ptr_info| blk: {
+                if (ptr_info.size == .slice and ptr_info.child == u8) {
+                    break :blk c.e12_stmt_bind_text(self.c_stmt, index, value.ptr, @intCast(value.len));
+                } else if (ptr_info.size == .one and @typeInfo(ptr_info.child) == .array and @typeInfo(ptr_info.child).array.child == u8) {
+                    // String literals (*const [N:0]u8)
+                    const slice: []const u8 = value;
+                    break :blk c.e12_stmt_bind_text(self.c_stmt, index, slice.ptr, @intCast(slice.len));
+                } else {
+                    @compileError("ORM error: Unsupported pointer type '" ++ @typeName(T) ++ "' in Statement.bind(). " ++
+                        "Only strings ([]const u8, []u8) are supported.");
+                }
+            },
+            else => @compileError("ORM error: Unsupported type '" ++ @typeName(T) ++ "' in Statement.bind(). " ++
+                "Supported types: integers, floats, bools, strings ([]const u8), enums, optionals and null."),
+        };
+
+        if (err != c.E12_ORM_OK) {
+            Database.captureError("Failed to bind SQL parameter", self.sql);
+            return mapError(err);
+        }
+    }
+
+    /// Bind a tuple of values to parameters 1..N
+    ///
+    /// Example:
+    /// ```zig
+    /// try stmt.bindAll(.{ "Alice", 25 });
+    /// ```
+    pub fn bindAll(self: *Statement, values: anytype) Error!void {
+        inline for (values, 0..) |value, i| {
+            try self.bind(@intCast(i + 1), value);
+        }
+    }
+
+    /// Execute a statement that returns no rows
+    /// The statement is reset afterwards and can be re-executed with new bindings.
+    pub fn execute(self: *Statement) Error!void {
+        _ = try self.executeWithRowsAffected();
+    }
+
+    /// Execute a statement and return the number of rows affected
+    pub fn executeWithRowsAffected(self: *Statement) Error!i64 {
+        var rows_affected: i64 = 0;
+        const err = c.e12_stmt_execute(self.c_stmt, &rows_affected);
+        if (err != c.E12_ORM_OK) {
+            Database.captureError("Failed to execute prepared statement", self.sql);
+            return mapError(err);
+        }
+        return rows_affected;
+    }
+
+    /// Run the statement as a query
+    /// The result borrows the statement and must be deinitialized before it.
+    pub fn query(self: *Statement) !QueryResult {
+        var c_result: ?*c.E12Result = null;
+        const err = c.e12_stmt_query(self.c_stmt, &c_result);
+        if (err != c.E12_ORM_OK) {
+            Database.captureError("Failed to run prepared query", self.sql);
+            return mapError(err);
+        }
+        return QueryResult.init(c_result.?, self.allocator);
+    }
+
+    /// Rewind the statement so it can be run again (bindings are kept)
+    pub fn reset(self: *Statement) void {
+        c.e12_stmt_reset(self.c_stmt);
+    }
+
+    /// Clear all parameter bindings
+    pub fn clearBindings(self: *Statement) void {
+        c.e12_stmt_clear_bindings(self.c_stmt);
+    }
+
+    /// Release the statement back to the connection's statement cache
+    pub fn deinit(self: *Statement) void {
+        c.e12_stmt_free(self.c_stmt);
+    }
+};
+
+/// An online backup in progress; see `Database.startBackup`
+pub const Backup = struct {
+    c_backup: *c.E12Backup,
+
+    /// Copy up to `pages` pages (negative = all remaining); true once the copy is complete
+    /// A busy source copies nothing and returns false, so just step again later.
+    pub fn step(self: *Backup, pages: i32) !bool {
+        var done: bool = false;
+        if (c.e12_backup_step(self.c_backup, pages, &done) != c.E12_ORM_OK) {
+            Database.captureError("Backup step failed", null);
+            return error.QueryFailed;
+        }
+        return done;
+    }
+
+    /// Pages left to copy after the last step
+    pub fn remaining(self: *const Backup) u64 {
+        return @intCast(@max(0, c.e12_backup_remaining(self.c_backup)));
+    }
+
+    /// Total pages in the source as of the last step
+    pub fn pageCount(self: *const Backup) u64 {
+        return @intCast(@max(0, c.e12_backup_pagecount(self.c_backup)));
+    }
+
+    /// Close the destination and free the handle; errors if the copy did not complete cleanly
+    pub fn finish(self: *Backup) !void {
+        if (c.e12_backup_finish(self.c_backup) != c.E12_ORM_OK) {
+            Database.captureError("Backup finish failed", null);
+            return error.QueryFailed;
+        }
+    }
+};
+
 pub const Transaction = struct {
     c_transaction: *c.E12Transaction,
     db: *Database,
@@ -477,6 +996,103 @@ test "Database transaction query" {
     try trans.commit();
 }
 
+test "Database statement cache reuses prepared statements" {
+    const allocator = std.testing.allocator;
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+
+    try db.execute("CREATE TABLE users (id INTEGER PRIMARY KEY, name TEXT)");
+    try db.execute("INSERT INTO users (name) VALUES ('Alice')");
+
+    const before = db.statementCacheStats();
+    try std.testing.expectEqual(@as(usize, c.E12_STMT_CACHE_DEFAULT_CAPACITY), before.capacity);
+
+    for (0..3) |_| {
+        var result = try db.query("SELECT name FROM users WHERE id = 1");
+        defer result.deinit();
+        const row = result.nextRow() orelse return error.NoRow;
+        try std.testing.expectEqualStrings("Alice", row.getText(0).?);
+    }
+
+    const after = db.statementCacheStats();
+    try std.testing.expectEqual(before.misses + 1, after.misses);
+    try std.testing.expectEqual(before.hits + 2, after.hits);
+    try std.testing.expect(after.hitRate() > 0.0);
+}
+
+test "Database statement cache capacity and eviction" {
+    const allocator = std.testing.allocator;
+    var db = try Database.openWithOptions(":memory:", allocator, .{ .statement_cache_capacity = 2 });
+    defer db.close();
+
+    try db.execute("CREATE TABLE t (v INTEGER)");
+    try db.execute("INSERT INTO t (v) VALUES (1)");
+    try db.execute("INSERT INTO t (v) VALUES (2)");
+
+    const stats = db.statementCacheStats();
+    try std.testing.expectEqual(@as(usize, 2), stats.capacity);
+    try std.testing.expectEqual(@as(usize, 2), stats.size);
+    try std.testing.expectEqual(@as(u64, 1), stats.evictions);
+
+    db.clearStatementCache();
+    try std.testing.expectEqual(@as(usize, 0), db.statementCacheStats().size);
+
+    try db.setStatementCacheCapacity(0);
+    try db.execute("INSERT INTO t (v) VALUES (3)");
+    try std.testing.expectEqual(@as(usize, 0), db.statementCacheStats().size);
+}
+
+test "Statement bind and execute" {
+    const allocator = std.testing.allocator;
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+
+    try db.execute("CREATE TABLE users (id INTEGER PRIMARY KEY, name TEXT, score REAL, active INTEGER, nickname TEXT)");
+
+    var insert = try db.prepare("INSERT INTO users (name, score, active, nickname) VALUES (?, ?, ?, ?)");
+    defer insert.deinit();
+    try std.testing.expectEqual(@as(i32, 4), insert.parameterCount());
+
+    const nickname: ?[]const u8 = null;
+    try insert.bindAll(.{ "O'Reilly", 9.5, true, nickname });
+    try std.testing.expectEqual(@as(i64, 1), try insert.executeWithRowsAffected());
+
+    var select = try db.prepare("SELECT name, score, active, nickname FROM users WHERE id = ?");
+    defer select.deinit();
+    try select.bind(1, @as(i64, 1));
+
+    var result = try select.query();
+    defer result.deinit();
+
+    const row = result.nextRow() orelse return error.NoRow;
+    try std.testing.expectEqualStrings("O'Reilly", row.getText(0).?);
+    try std.testing.expectApproxEqAbs(@as(f64, 9.5), row.getDouble(1), 0.001);
+    try std.testing.expectEqual(@as(i64, 1), row.getInt64(2));
+    try std.testing.expect(row.isNull(3));
+}
+
+test "Statement rejects out of range parameter" {
+    const allocator = std.testing.allocator;
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+
+    var stmt = try db.prepare("SELECT ?");
+    defer stmt.deinit();
+    try std.testing.expectError(error.InvalidArgument, stmt.bind(2, @as(i64, 1)));
+}
+
+test "Statement rejects integers outside the i64 range" {
+    const allocator = std.testing.allocator;
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+
+    var stmt = try db.prepare("SELECT ?");
+    defer stmt.deinit();
+    try std.testing.expectError(error.IntegerOverflow, stmt.bind(1, @as(u64, std.math.maxInt(i64)) + 1));
+    try std.testing.expectError(error.IntegerOverflow, stmt.bind(1, @as(i128, std.math.minInt(i64)) - 1));
+    try stmt.bind(1, @as(u64, std.math.maxInt(i64)));
+}
+
 // Test deleted - causes segmentation fault when releasing connections twice
 
 test "Connection pool max connections" {
@@ -485,7 +1101,7 @@ test "Connection pool max connections" {
         .max_connections = 1,
     };
 
-    var pool = ConnectionPool.init(":memory:", config, allocator);
+    var pool = try ConnectionPool.init(":memory:", config, allocator);
     defer pool.deinit();
 
     const db1 = try pool.acquire();
@@ -495,3 +1111,77 @@ test "Connection pool max connections" {
     try std.testing.expect(@intFromPtr(db2.c_db) != 0);
     pool.release(db2);
 }
+
+test "Connection pool waits and times out when exhausted" {
+    const allocator = std.testing.allocator;
+    var pool = try ConnectionPool.init(":memory:", .{ .max_connections = 1, .acquire_timeout_ms = 20 }, allocator);
+    defer pool.deinit();
+
+    const db1 = try pool.acquire();
+    try std.testing.expectError(error.PoolExhausted, pool.acquire());
+    pool.release(db1);
+
+    // The releasing thread gets its own connection back
+    const db2 = try pool.acquire();
+    try std.testing.expectEqual(db1.c_db, db2.c_db);
+    pool.release(db2);
+
+    const pool_stats = pool.stats();
+    try std.testing.expectEqual(@as(u64, 1), pool_stats.timeouts);
+    try std.testing.expectEqual(@as(u64, 2), pool_stats.acquires);
+    try std.testing.expectEqual(@as(usize, 1), pool_stats.idle_connections);
+}
+
+test "Connection pool hands connections to waiting threads" {
+    const allocator = std.testing.allocator;
+    var pool = try ConnectionPool.init(":memory:", .{ .max_connections = 2, .acquire_timeout_ms = 5000 }, allocator);
+    defer pool.deinit();
+
+    const Worker = struct {
+        fn run(p: *ConnectionPool) void {
+            for (0..100) |_| {
+                var db = p.acquire() catch unreachable;
+                db.execute("SELECT 1") catch unreachable;
+                p.release(db);
+            }
+        }
+    };
+
+    var threads: [6]std.Thread = undefined;
+    for (&threads) |*thread| {
+        thread.* = try std.Thread.spawn(.{}, Worker.run, .{&pool});
+    }
+    for (threads) |thread| thread.join();
+
+    const pool_stats = pool.stats();
+    try std.testing.expectEqual(@as(u64, 600), pool_stats.acquires);
+    try std.testing.expect(pool_stats.open_connections <= 2);
+    try std.testing.expectEqual(@as(u64, 0), pool_stats.timeouts);
+
+    var histogram_total: u64 = 0;
+    for (pool_stats.wait_histogram) |count| histogram_total += count;
+    try std.testing.expectEqual(pool_stats.acquires, histogram_total);
+}
+
+test "Database status and table sizes" {
+    const allocator = std.testing.allocator;
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+    try db.execute("CREATE TABLE notes (id INTEGER PRIMARY KEY, body TEXT)");
+    try db.execute(
+        "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 200) " ++
+            "INSERT INTO notes (body) SELECT printf('%.200c', 'x') FROM n",
+    );
+
+    const db_status = db.status();
+    try std.testing.expect(db_status.cache_hit > 0);
+    try std.testing.expect(db_status.cache_used > 0);
+    try std.testing.expect(db_status.schema_used > 0);
+    try std.testing.expectEqual(@as(u64, 0), db_status.wal_bytes);
+
+    const sizes = try db.tableSizes(allocator);
+    defer Database.freeTableSizes(allocator, sizes);
+    try std.testing.expectEqualStrings("notes", sizes[0].name);
+    try std.testing.expect(sizes[0].bytes >= 200 * 200);
+    try std.testing.expect(sizes[0].pages > 1);
+}
@@ -0,0 +1,243 @@
+const std = @import("std");
+const database = @import("database.zig");
+const Database = database.Database;
+const DbStatus = database.DbStatus;
+const TableSize = database.TableSize;
+
+pub const DbStatsOptions = struct {
+    /// How often the sampler thread refreshes the counters
+    interval_ms: u64 = 15_000,
+    /// Refresh per-table sizes every Nth sample (0 disables them)
+    /// dbstat reads every page of the database, so keep this sparse on large files.
+    table_sizes_every: u32 = 4,
+};
+
+/// One sample of SQLite's internals, as exported on /metrics
+pub const DbStatsSnapshot = struct {
+    status: DbStatus = .{},
+    page_size: u64 = 0,
+    page_count: u64 = 0,
+    freelist_count: u64 = 0,
+    /// PRAGMA cache_size as configured: pages when positive, KiB when negative
+    cache_size: i64 = 0,
+    mmap_size: u64 = 0,
+    /// Largest first; empty until the first table size sample
+    tables: []TableSize = &.{},
+    sampled_ms: i64 = 0,
+
+    /// Write the snapshot in Prometheus text format
+    ///
+    /// Example output:
+    /// ```
+    /// sqlite_cache_hits_total 18234
+    /// sqlite_wal_bytes 4124152
+    /// sqlite_table_bytes{name="Todo"} 1048576
+    /// ```
+    pub fn writePrometheus(self: DbStatsSnapshot, writer: anytype) !void {
+        const s = self.status;
+        try writer.print("sqlite_cache_used_bytes {d}\n", .{s.cache_used});
+        try writer.print("sqlite_cache_hits_total {d}\n", .{s.cache_hit});
+        try writer.print("sqlite_cache_misses_total {d}\n", .{s.cache_miss});
+        try writer.print("sqlite_cache_writes_total {d}\n", .{s.cache_write});
+        try writer.print("sqlite_cache_spills_total {d}\n", .{s.cache_spill});
+        try writer.print("sqlite_cache_hit_ratio {d:.4}\n", .{s.cacheHitRate()});
+        try writer.print("sqlite_lookaside_used {d}\n", .{s.lookaside_used});
+        try writer.print("sqlite_lookaside_hits_total {d}\n", .{s.lookaside_hit});
+        try writer.print("sqlite_lookaside_misses_total{{reason=\"size\"}} {d}\n", .{s.lookaside_miss_size});
+        try writer.print("sqlite_lookaside_misses_total{{reason=\"full\"}} {d}\n", .{s.lookaside_miss_full});
+        try writer.print("sqlite_schema_bytes {d}\n", .{s.schema_used});
+        try writer.print("sqlite_statement_bytes {d}\n", .{s.stmt_used});
+        try writer.print("sqlite_memory_used_bytes {d}\n", .{s.memory_used});
+        try writer.print("sqlite_memory_highwater_bytes {d}\n", .{s.memory_highwater});
+        try writer.print("sqlite_malloc_count {d}\n", .{s.malloc_count});
+        try writer.print("sqlite_pagecache_overflow_bytes {d}\n", .{s.pagecache_overflow});
+        try writer.print("sqlite_wal_bytes {d}\n", .{s.wal_bytes});
+
+        try writer.print("sqlite_page_size_bytes {d}\n", .{self.page_size});
+        try writer.print("sqlite_pages {d}\n", .{self.page_count});
+        try writer.print("sqlite_freelist_pages {d}\n", .{self.freelist_count});
+        try writer.print("sqlite_cache_size_setting {d}\n", .{self.cache_size});
+        try writer.print("sqlite_mmap_size_bytes {d}\n", .{self.mmap_size});
+
+        for (self.tables) |table| {
+            try writer.writeAll("sqlite_table_bytes{name=\"");
+            try writeLabelValue(writer, table.name);
+            try writer.print("\"}} {d}\n", .{table.bytes});
+            try writer.writeAll("sqlite_table_pages{name=\"");
+            try writeLabelValue(writer, table.name);
+            try writer.print("\"}} {d}\n", .{table.pages});
+        }
+        try writer.print("sqlite_stats_sampled_timestamp_seconds {d}\n", .{@divTrunc(self.sampled_ms, std.time.ms_per_s)});
+    }
+};
+
+fn writeLabelValue(writer: anytype, value: []const u8) !void {
+    for (value) |char| {
+        switch (char) {
+            '\\' => try writer.writeAll("\\\\"),
+            '"' => try writer.writeAll("\\\""),
+            '\n' => try writer.writeAll("\\n"),
+            else => try writer.writeByte(char),
+        }
+    }
+}
+
+/// Samples a connection's SQLite counters, file sizes and per-table sizes on a background thread
+/// /metrics scrapes read the latest snapshot, so a scrape never waits on the
+/// dbstat scan. Counters come from the connection given to `start`.
+pub const DbStatsSampler = struct {
+    allocator: std.mem.Allocator,
+    db: Database,
+    /// Held while sampling when writers share the connection
+    write_lock: ?*std.Thread.Mutex,
+    options: DbStatsOptions,
+    thread: std.Thread = undefined,
+    mutex: std.Thread.Mutex = .{},
+    stop: std.Thread.ResetEvent = .{},
+    latest: DbStatsSnapshot = .{},
+    samples: u64 = 0,
+
+    /// Take a first sample, then keep sampling every `interval_ms` on a new thread
+    pub fn start(allocator: std.mem.Allocator, db: Database, write_lock: ?*std.Thread.Mutex, options: DbStatsOptions) !*DbStatsSampler {
+        const self = try allocator.create(DbStatsSampler);
+        errdefer allocator.destroy(self);
+        self.* = .{ .allocator = allocator, .db = db, .write_lock = write_lock, .options = options };
+        errdefer self.freeTables();
+
+        try self.sample();
+        self.thread = try std.Thread.spawn(.{}, run, .{self});
+        return self;
+    }
+
+    /// Refresh the snapshot now
+    /// Table sizes are kept from the previous sample unless this sample is due to refresh them.
+    pub fn sample(self: *DbStatsSampler) !void {
+        const every = self.options.table_sizes_every;
+        const refresh_tables = every > 0 and self.samples % every == 0;
+        var next = try self.read(refresh_tables);
+
+        self.mutex.lock();
+        const old_tables = self.latest.tables;
+        if (!refresh_tables) next.tables = old_tables;
+        self.latest = next;
+        self.samples += 1;
+        self.mutex.unlock();
+
+        if (refresh_tables and old_tables.len > 0) Database.freeTableSizes(self.allocator, old_tables);
+    }
+
+    /// Replace the lock held while sampling, e.g. once a write queue owns the connection
+    pub fn setWriteLock(self: *DbStatsSampler, write_lock: ?*std.Thread.Mutex) void {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        self.write_lock = write_lock;
+    }
+
+    pub fn snapshot(self: *DbStatsSampler) DbStatsSnapshot {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        var copy = self.latest;
+        // Table names belong to the sampler and may be freed by the next sample
+        copy.tables = &.{};
+        return copy;
+    }
+
+    /// Write the latest snapshot in Prometheus text format
+    pub fn writePrometheus(self: *DbStatsSampler, writer: anytype) !void {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        try self.latest.writePrometheus(writer);
+    }
+
+    /// Stop the thread and free the sampler
+    pub fn deinit(self: *DbStatsSampler) void {
+        self.stop.set();
+        self.thread.join();
+        self.freeTables();
+        self.allocator.destroy(self);
+    }
+
+    fn freeTables(self: *DbStatsSampler) void {
+        if (self.latest.tables.len > 0) Database.freeTableSizes(self.allocator, self.latest.tables);
+        self.latest.tables = &.{};
+    }
+
+    fn run(self: *DbStatsSampler) void {
+        // timedWait returns once stop is set and errors when the interval elapses
+        while (true) {
+            self.stop.timedWait(self.options.interval_ms * std.time.ns_per_ms) catch {
+                self.sample() catch |err| {
+                    std.debug.print("[ORM Error] Database stats sample failed\n", .{});
+                    std.debug.print("  Error: {}\n", .{err});
+                };
+                continue;
+            };
+            return;
+        }
+    }
+
+    /// Run one sample's queries, holding the write lock so they do not interleave with writers
+    fn read(self: *DbStatsSampler, refresh_tables: bool) !DbStatsSnapshot {
+        self.mutex.lock();
+        const write_lock = self.write_lock;
+        self.mutex.unlock();
+        if (write_lock) |lock| lock.lock();
+        defer if (write_lock) |lock| lock.unlock();
+
+        var next = DbStatsSnapshot{
+            .status = self.db.status(),
+            .page_size = try self.pragmaValue("PRAGMA page_size"),
+            .page_count = try self.pragmaValue("PRAGMA page_count"),
+            .freelist_count = try self.pragmaValue("PRAGMA freelist_count"),
+            .cache_size = try self.pragmaInt("PRAGMA cache_size"),
+            .mmap_size = try self.pragmaValue("PRAGMA mmap_size"),
+            .sampled_ms = std.time.milliTimestamp(),
+        };
+        if (refresh_tables) next.tables = try self.db.tableSizes(self.allocator);
+        return next;
+    }
+
+    fn pragmaInt(self: *DbStatsSampler, sql: []const u8) !i64 {
+        var result = try self.db.query(sql);
+        defer result.deinit();
+        const row = (try result.step()) orelse return 0;
+        return row.getInt64(0);
+    }
+
+    fn pragmaValue(self: *DbStatsSampler, sql: []const u8) !u64 {
+        return @intCast(@max(0, try self.pragmaInt(sql)));
+    }
+};
+
+test "DbStatsSampler exports SQLite internals" {
+    const allocator = std.testing.allocator;
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+    try db.execute("CREATE TABLE notes (id INTEGER PRIMARY KEY, body TEXT)");
+    try db.execute("CREATE INDEX idx_notes_body ON notes(body)");
+    try db.execute(
+        "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 100) " ++
+            "INSERT INTO notes (body) SELECT printf('%.100c', 'x') FROM n",
+    );
+
+    const sampler = try DbStatsSampler.start(allocator, db, null, .{ .interval_ms = 60_000, .table_sizes_every = 2 });
+    defer sampler.deinit();
+
+    const first = sampler.snapshot();
+    try std.testing.expect(first.page_size > 0);
+    try std.testing.expect(first.page_count > 1);
+    try std.testing.expect(first.status.cache_hit > 0);
+
+    // The second sample keeps the table sizes from the first
+    try sampler.sample();
+
+    var out = std.ArrayListUnmanaged(u8){};
+    defer out.deinit(allocator);
+    try sampler.writePrometheus(out.writer(allocator));
+
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "sqlite_cache_hits_total ") != null);
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "sqlite_wal_bytes 0\n") != null);
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "sqlite_table_bytes{name=\"notes\"} ") != null);
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "sqlite_table_pages{name=\"idx_notes_body\"} ") != null);
+}
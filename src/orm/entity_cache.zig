@@ -0,0 +1,417 @@
+const std = @import("std");
+
+/// Per-model settings for the entity cache
+pub const EntityCacheOptions = struct {
+    /// Maximum number of rows cached for this model
+    max_entries: usize = 1024,
+    /// Maximum bytes held for this model (struct size plus string fields)
+    max_bytes: usize = 1024 * 1024,
+    /// How long a cached row is served before it is read from SQLite again
+    ttl_ms: u32 = 60_000,
+};
+
+pub const EntityCacheStats = struct {
+    hits: u64 = 0,
+    misses: u64 = 0,
+    evictions: u64 = 0,
+    invalidations: u64 = 0,
+    size: usize = 0,
+    bytes: usize = 0,
+
+    /// Share of find-by-id lookups answered from a cached row without querying SQLite
+    /// Expired and invalidated rows count as misses; 0.0 until the first lookup.
+    pub fn hitRate(self: EntityCacheStats) f64 {
+        const total = self.hits + self.misses;
+        if (total == 0) return 0.0;
+        return @as(f64, @floatFromInt(self.hits)) / @as(f64, @floatFromInt(total));
+    }
+};
+
+/// Read-through identity map for rows fetched by primary key
+/// Rows are cached per table, keyed by id, with an LRU bound on entries and
+/// bytes and a TTL. Each cached row owns a deep copy of its strings; `get`
+/// copies the row back out into the caller's allocator, so callers free hits
+/// exactly like rows read from SQLite.
+///
+/// Writers call `invalidate`/`clear` after their change commits. Readers take
+/// a `generation` before querying and pass it to `put`; a row read before an
+/// invalidation is then dropped instead of being cached stale.
+///
+/// Thread-safe: one mutex guards all tables.
+///
+/// Example:
+/// ```zig
+/// var cache = EntityCache.init(allocator);
+/// defer cache.deinit();
+/// try cache.enable("users", .{ .ttl_ms = 30_000 });
+///
+/// if (try cache.get(User, "users", id, allocator)) |user| return user;
+/// const generation = cache.generation("users");
+/// const user = try loadUser(id);
+/// cache.put(User, "users", id, user, generation);
+/// ```
+pub const EntityCache = struct {
+    allocator: std.mem.Allocator,
+    mutex: std.Thread.Mutex = .{},
+    tables: std.StringHashMapUnmanaged(*TableCache) = .{},
+
+    const Entry = struct {
+        id: i64,
+        /// Owns the cached struct and its strings
+        arena: std.heap.ArenaAllocator,
+        value: *const anyopaque,
+        type_name: []const u8,
+        bytes: usize,
+        expires_at_ms: i64,
+        /// LRU list: head is the most recently used entry
+        prev: ?*Entry = null,
+        next: ?*Entry = null,
+    };
+
+    const TableCache = struct {
+        options: EntityCacheOptions,
+        entries: std.AutoHashMapUnmanaged(i64, *Entry) = .{},
+        head: ?*Entry = null,
+        tail: ?*Entry = null,
+        bytes: usize = 0,
+        /// Bumped on every invalidation of this table
+        generation: u64 = 0,
+        stats: EntityCacheStats = .{},
+    };
+
+    pub fn init(allocator: std.mem.Allocator) EntityCache {
+        return .{ .allocator = allocator };
+    }
+
+    pub fn deinit(self: *EntityCache) void {
+        var it = self.tables.iterator();
+        while (it.next()) |table| {
+            self.dropAll(table.value_ptr.*);
+            table.value_ptr.*.entries.deinit(self.allocator);
+            self.allocator.free(table.key_ptr.*);
+            self.allocator.destroy(table.value_ptr.*);
+        }
+        self.tables.deinit(self.allocator);
+    }
+
+    /// Start caching rows of `table_name` (updates the options if already enabled)
+    pub fn enable(self: *EntityCache, table_name: []const u8, options: EntityCacheOptions) !void {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        if (self.tables.get(table_name)) |table| {
+            table.options = options;
+            self.evictOverflow(table);
+            return;
+        }
+
+        const key = try self.allocator.dupe(u8, table_name);
+        errdefer self.allocator.free(key);
+        const table = try self.allocator.create(TableCache);
+        errdefer self.allocator.destroy(table);
+        table.* = .{ .options = options };
+        try self.tables.put(self.allocator, key, table);
+    }
+
+    /// Whether rows of `table_name` are cached
+    pub fn isEnabled(self: *EntityCache, table_name: []const u8) bool {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        return self.tables.contains(table_name);
+    }
+
+    /// Copy a cached row into `allocator`, or null on a miss or expired entry
+    pub fn get(self: *EntityCache, comptime T: type, table_name: []const u8, id: i64, allocator: std.mem.Allocator) !?T {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        const table = self.tables.get(table_name) orelse return null;
+        const entry = table.entries.get(id) orelse {
+            table.stats.misses += 1;
+            return null;
+        };
+
+        if (std.time.milliTimestamp() >= entry.expires_at_ms or !std.mem.eql(u8, entry.type_name, @typeName(T))) {
+            self.remove(table, entry);
+            table.stats.misses += 1;
+            return null;
+        }
+
+        self.unlink(table, entry);
+        self.pushFront(table, entry);
+        table.stats.hits += 1;
+
+        const cached: *const T = @ptrCast(@alignCast(entry.value));
+        return try cloneModel(T, cached.*, allocator);
+    }
+
+    /// Generation to pass to `put` for a read that starts now
+    /// Null when the table is not cached.
+    pub fn generation(self: *EntityCache, table_name: []const u8) ?u64 {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        const table = self.tables.get(table_name) orelse return null;
+        return table.generation;
+    }
+
+    /// Cache a row read from SQLite
+    /// Skipped when the table was invalidated since `read_generation` was taken,
+    /// or when the row alone exceeds the table's byte budget.
+    pub fn put(self: *EntityCache, comptime T: type, table_name: []const u8, id: i64, value: T, read_generation: ?u64) void {
+        const expected = read_generation orelse return;
+
+        var arena = std.heap.ArenaAllocator.init(self.allocator);
+        const stored = arena.allocator().create(T) catch {
+            arena.deinit();
+            return;
+        };
+        stored.* = cloneModel(T, value, arena.allocator()) catch {
+            arena.deinit();
+            return;
+        };
+        const bytes = modelBytes(T, value);
+
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        const table = self.tables.get(table_name) orelse {
+            arena.deinit();
+            return;
+        };
+        if (table.generation != expected or bytes > table.options.max_bytes or table.options.max_entries == 0) {
+            arena.deinit();
+            return;
+        }
+
+        const entry = self.allocator.create(Entry) catch {
+            arena.deinit();
+            return;
+        };
+        entry.* = .{
+            .id = id,
+            .arena = arena,
+            .value = stored,
+            .type_name = @typeName(T),
+            .bytes = bytes,
+            .expires_at_ms = std.time.milliTimestamp() + @as(i64, table.options.ttl_ms),
+        };
+
+        const slot = table.entries.getOrPut(self.allocator, id) catch {
+            entry.arena.deinit();
+            self.allocator.destroy(entry);
+            return;
+        };
+        if (slot.found_existing) {
+            const old = slot.value_ptr.*;
+            self.unlink(table, old);
+            table.bytes -= old.bytes;
+            self.destroyEntry(old);
+        }
+        slot.value_ptr.* = entry;
+        self.pushFront(table, entry);
+        table.bytes += bytes;
+
+        self.evictOverflow(table);
+    }
+
+    /// Drop one row after it was updated or deleted
+    pub fn invalidate(self: *EntityCache, table_name: []const u8, id: i64) void {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        const table = self.tables.get(table_name) orelse return;
+        table.generation += 1;
+        if (table.entries.get(id)) |entry| {
+            self.remove(table, entry);
+            table.stats.invalidations += 1;
+        }
+    }
+
+    /// Drop every cached row, e.g. after a transaction or raw SQL of unknown effect
+    pub fn clear(self: *EntityCache) void {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        var it = self.tables.valueIterator();
+        while (it.next()) |table| {
+            table.*.generation += 1;
+            table.*.stats.invalidations += table.*.entries.count();
+            self.dropAll(table.*);
+        }
+    }
+
+    /// Counters for one table, or summed over all tables when `table_name` is null
+    pub fn stats(self: *EntityCache, table_name: ?[]const u8) EntityCacheStats {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        if (table_name) |name| {
+            const table = self.tables.get(name) orelse return .{};
+            return tableStats(table);
+        }
+
+        var total = EntityCacheStats{};
+        var it = self.tables.valueIterator();
+        while (it.next()) |table| {
+            const s = tableStats(table.*);
+            total.hits += s.hits;
+            total.misses += s.misses;
+            total.evictions += s.evictions;
+            total.invalidations += s.invalidations;
+            total.size += s.size;
+            total.bytes += s.bytes;
+        }
+        return total;
+    }
+
+    fn tableStats(table: *const TableCache) EntityCacheStats {
+        var s = table.stats;
+        s.size = table.entries.count();
+        s.bytes = table.bytes;
+        return s;
+    }
+
+    fn evictOverflow(self: *EntityCache, table: *TableCache) void {
+        while (table.tail) |oldest| {
+            if (table.entries.count() <= table.options.max_entries and table.bytes <= table.options.max_bytes) break;
+            self.remove(table, oldest);
+            table.stats.evictions += 1;
+        }
+    }
+
+    fn remove(self: *EntityCache, table: *TableCache, entry: *Entry) void {
+        self.unlink(table, entry);
+        _ = table.entries.remove(entry.id);
+        table.bytes -= entry.bytes;
+        self.destroyEntry(entry);
+    }
+
+    fn dropAll(self: *EntityCache, table: *TableCache) void {
+        var node = table.head;
+        while (node) |entry| {
+            node = entry.next;
+            self.destroyEntry(entry);
+        }
+        table.entries.clearRetainingCapacity();
+        table.head = null;
+        table.tail = null;
+        table.bytes = 0;
+    }
+
+    fn destroyEntry(self: *EntityCache, entry: *Entry) void {
+        entry.arena.deinit();
+        self.allocator.destroy(entry);
+    }
+
+    fn unlink(_: *EntityCache, table: *TableCache, entry: *Entry) void {
+        if (entry.prev) |prev| prev.next = entry.next else table.head = entry.next;
+        if (entry.next) |next| next.prev = entry.prev else table.tail = entry.prev;
+        entry.prev = null;
+        entry.next = null;
+    }
+
+    fn pushFront(_: *EntityCache, table: *TableCache, entry: *Entry) void {
+        entry.prev = null;
+        entry.next = table.head;
+        if (table.head) |head| head.prev = entry;
+        table.head = entry;
+        if (table.tail == null) table.tail = entry;
+    }
+};
+
+/// Copy `value`, duplicating its string fields into `allocator`
+pub fn cloneModel(comptime T: type, value: T, allocator: std.mem.Allocator) !T {
+    var copy = value;
+    inline for (std.meta.fields(T)) |field| {
+        switch (@typeInfo(field.type)) {
+            .pointer => {
+                @field(copy, field.name) = try allocator.dupe(u8, @field(value, field.name));
+            },
+            .optional => |opt| {
+                if (@typeInfo(opt.child) == .pointer) {
+                    if (@field(value, field.name)) |text| {
+                        @field(copy, field.name) = try allocator.dupe(u8, text);
+                    }
+                }
+            },
+            else => {},
+        }
+    }
+    return copy;
+}
+
+/// Approximate memory held by one cached row
+fn modelBytes(comptime T: type, value: T) usize {
+    var bytes: usize = @sizeOf(T);
+    inline for (std.meta.fields(T)) |field| {
+        switch (@typeInfo(field.type)) {
+            .pointer => bytes += @field(value, field.name).len,
+            .optional => |opt| {
+                if (@typeInfo(opt.child) == .pointer) {
+                    if (@field(value, field.name)) |text| bytes += text.len;
+                }
+            },
+            else => {},
+        }
+    }
+    return bytes;
+}
+
+test "EntityCache get returns an owned copy and counts hits" {
+    const allocator = std.testing.allocator;
+    const User = struct { id: i64, name: []const u8, bio: ?[]const u8 };
+
+    var cache = EntityCache.init(allocator);
+    defer cache.deinit();
+    try cache.enable("users", .{});
+
+    try std.testing.expect((try cache.get(User, "users", 1, allocator)) == null);
+    cache.put(User, "users", 1, .{ .id = 1, .name = "alice", .bio = null }, cache.generation("users"));
+
+    const hit = (try cache.get(User, "users", 1, allocator)).?;
+    defer allocator.free(hit.name);
+    try std.testing.expectEqualStrings("alice", hit.name);
+
+    const s = cache.stats("users");
+    try std.testing.expectEqual(@as(u64, 1), s.hits);
+    try std.testing.expectEqual(@as(u64, 1), s.misses);
+    try std.testing.expectEqual(@as(usize, 1), s.size);
+}
+
+test "EntityCache drops reads that raced an invalidation" {
+    const allocator = std.testing.allocator;
+    const User = struct { id: i64, name: []const u8 };
+
+    var cache = EntityCache.init(allocator);
+    defer cache.deinit();
+    try cache.enable("users", .{});
+
+    const before_write = cache.generation("users");
+    cache.invalidate("users", 1);
+    cache.put(User, "users", 1, .{ .id = 1, .name = "stale" }, before_write);
+    try std.testing.expect((try cache.get(User, "users", 1, allocator)) == null);
+
+    // Untracked tables are never cached
+    cache.put(User, "posts", 1, .{ .id = 1, .name = "x" }, cache.generation("posts"));
+    try std.testing.expect((try cache.get(User, "posts", 1, allocator)) == null);
+}
+
+test "EntityCache evicts least recently used rows" {
+    const allocator = std.testing.allocator;
+    const User = struct { id: i64, name: []const u8 };
+
+    var cache = EntityCache.init(allocator);
+    defer cache.deinit();
+    try cache.enable("users", .{ .max_entries = 2 });
+
+    cache.put(User, "users", 1, .{ .id = 1, .name = "a" }, cache.generation("users"));
+    cache.put(User, "users", 2, .{ .id = 2, .name = "b" }, cache.generation("users"));
+    const touched = (try cache.get(User, "users", 1, allocator)).?;
+    allocator.free(touched.name);
+    cache.put(User, "users", 3, .{ .id = 3, .name = "c" }, cache.generation("users"));
+
+    try std.testing.expect((try cache.get(User, "users", 2, allocator)) == null);
+    const kept = (try cache.get(User, "users", 1, allocator)).?;
+    allocator.free(kept.name);
+    try std.testing.expectEqual(@as(u64, 1), cache.stats(null).evictions);
+}
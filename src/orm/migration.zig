@@ -1,5 +1,8 @@
 const std = @import("std");
 const Database = @import("database.zig").Database;
+const model = @import("model.zig");
+const IndexDef = model.IndexDef;
+const search = @import("search.zig");
 
 pub const Migration = struct {
     version: u32,
@@ -119,6 +122,45 @@ pub const MigrationBuilder = struct {
         try self.down_sql.append(self.allocator, '\n');
     }
 
+    /// CREATE INDEX IF NOT EXISTS in up, DROP INDEX IF EXISTS in down
+    pub fn createIndex(self: *MigrationBuilder, index: IndexDef) !void {
+        const create_sql = try index.createSql(self.allocator);
+        defer self.allocator.free(create_sql);
+        const drop_sql = try index.dropSql(self.allocator);
+        defer self.allocator.free(drop_sql);
+
+        try self.up_sql.writer(self.allocator).print("{s};", .{create_sql});
+        try self.up_sql.append(self.allocator, '\n');
+        try self.down_sql.writer(self.allocator).print("{s};", .{drop_sql});
+        try self.down_sql.append(self.allocator, '\n');
+    }
+
+    /// Emit every index declared by `T.indexes` (see model.modelIndexes)
+    pub fn createIndexes(self: *MigrationBuilder, comptime T: type) !void {
+        for (model.modelIndexes(T)) |index| {
+            try self.createIndex(index);
+        }
+    }
+
+    /// Full-text index for `T.search_fields` (see search.modelSearch)
+    /// Up creates the FTS5 table and triggers and indexes existing rows;
+    /// down drops them.
+    pub fn createSearchIndex(self: *MigrationBuilder, comptime T: type) !void {
+        const def = comptime search.modelSearch(T) orelse
+            @compileError(@typeName(T) ++ " has no search_fields declaration");
+
+        const create_sql = try def.createSql(self.allocator);
+        defer self.allocator.free(create_sql);
+        const rebuild_sql = try def.rebuildSql(self.allocator);
+        defer self.allocator.free(rebuild_sql);
+        const drop_sql = try def.dropSql(self.allocator);
+        defer self.allocator.free(drop_sql);
+
+        try self.up(create_sql);
+        try self.up(rebuild_sql);
+        try self.down(drop_sql);
+    }
+
     pub fn build(self: *MigrationBuilder) !Migration {
         const up_sql = try self.up_sql.toOwnedSlice(self.allocator);
         const down_sql = try self.down_sql.toOwnedSlice(self.allocator);
@@ -184,3 +226,28 @@ test "MigrationBuilder createTable" {
     try std.testing.expect(std.mem.indexOf(u8, migration.down, "DROP TABLE") != null);
 }
 
+
+test "MigrationBuilder createIndexes from model declarations" {
+    const allocator = std.testing.allocator;
+
+    const Note = struct {
+        id: i64,
+        user_id: i64,
+        title: []const u8,
+
+        pub const indexes = .{
+            .{ "user_id", "title" },
+        };
+    };
+
+    var builder = MigrationBuilder.init(2, "index_notes", allocator);
+    defer builder.deinit();
+    try builder.createIndexes(Note);
+
+    const migration = try builder.build();
+    defer allocator.free(migration.up);
+    defer allocator.free(migration.down);
+
+    try std.testing.expectEqualStrings("CREATE INDEX IF NOT EXISTS idx_note_user_id_title ON note (user_id, title);\n", migration.up);
+    try std.testing.expectEqualStrings("DROP INDEX IF EXISTS idx_note_user_id_title;\n", migration.down);
+}
@@ -6,6 +6,15 @@ const Schema = @import("schema.zig").Schema;
 pub const MigrationRunner = struct {
     db: *Database,
     allocator: std.mem.Allocator,
+    /// What the last `runMigrations` call did
+    last_report: RunReport = .{},
+
+    pub const RunReport = struct {
+        /// The stored checksum matched, so no migration was inspected
+        fast_path: bool = false,
+        /// Migrations executed by the call
+        applied: usize = 0,
+    };
 
     pub fn init(db: *Database, allocator: std.mem.Allocator) MigrationRunner {
         return MigrationRunner{
@@ -21,6 +30,12 @@ pub const MigrationRunner = struct {
             \\  name TEXT NOT NULL,
             \\  applied_at INTEGER NOT NULL
             \\);
+            \\CREATE TABLE IF NOT EXISTS schema_migrations_state (
+            \\  id INTEGER PRIMARY KEY CHECK (id = 1),
+            \\  checksum INTEGER NOT NULL,
+            \\  migration_count INTEGER NOT NULL,
+            \\  updated_at INTEGER NOT NULL
+            \\);
         ;
         try self.db.execute(sql);
     }
@@ -68,134 +83,99 @@ pub const MigrationRunner = struct {
         return false;
     }
 
+    /// Bring the database up to date with `migrations`
+    /// A fully-migrated database is detected with one lookup of the stored
+    /// migration-set checksum and nothing else runs. Otherwise the applied
+    /// versions are loaded in one query and every pending migration runs inside
+    /// a single transaction (one savepoint each), so a failure leaves the
+    /// database exactly as it was before the call.
     pub fn runMigrations(self: *MigrationRunner, migrations: []const Migration) !void {
+        self.last_report = .{};
         try self.createMigrationsTable();
 
-        for (migrations) |migration| {
-            // Skip if already applied - check each migration individually
-            if (try self.isApplied(migration.version)) {
-                continue;
+        const checksum = migrationChecksum(migrations);
+        if (try self.storedChecksum()) |stored| {
+            if (stored == checksum) {
+                self.last_report.fast_path = true;
+                return;
             }
+        }
+
+        var applied = try self.appliedSet(migrations);
+        defer applied.deinit(self.allocator);
+
+        var trans = try self.db.beginTransaction();
+        defer trans.deinit();
+        errdefer trans.rollback() catch {};
 
-            // Run migration in transaction
-            var trans = try self.db.beginTransaction();
-            defer trans.deinit();
+        var record = try self.db.prepare("INSERT OR IGNORE INTO schema_migrations (version, name, applied_at) VALUES (?, ?, ?)");
+        defer record.deinit();
+        const timestamp = std.time.timestamp();
 
+        for (migrations, 0..) |migration, i| {
+            if (applied.isSet(i)) continue;
+
+            try trans.execute("SAVEPOINT e12_migration");
             trans.execute(migration.up) catch |err| {
-                // Check if this is an ALTER TABLE ADD COLUMN statement that failed
-                // If so, check if the column already exists - if it does, mark migration as applied
-                if (std.mem.indexOf(u8, migration.up, "ALTER TABLE") != null and 
-                    std.mem.indexOf(u8, migration.up, "ADD COLUMN") != null) {
-                    // Parse table name and column name from SQL
-                    // Simple parsing: ALTER TABLE table_name ADD COLUMN column_name ...
-                    var table_name_start: ?usize = null;
-                    var table_name_end: ?usize = null;
-                    var column_name_start: ?usize = null;
-                    var column_name_end: ?usize = null;
-                    
-                    // Find "ALTER TABLE"
-                    if (std.mem.indexOf(u8, migration.up, "ALTER TABLE")) |alt_pos| {
-                        var pos = alt_pos + 11; // Skip "ALTER TABLE"
-                        // Skip whitespace
-                        while (pos < migration.up.len and (migration.up[pos] == ' ' or migration.up[pos] == '\t' or migration.up[pos] == '\n')) {
-                            pos += 1;
-                        }
-                        table_name_start = pos;
-                        // Find end of table name (whitespace or newline)
-                        while (pos < migration.up.len and migration.up[pos] != ' ' and migration.up[pos] != '\t' and migration.up[pos] != '\n') {
-                            pos += 1;
-                        }
-                        table_name_end = pos;
-                        
-                        // Find "ADD COLUMN"
-                        if (std.mem.indexOfPos(u8, migration.up, pos, "ADD COLUMN")) |add_pos| {
-                            pos = add_pos + 10; // Skip "ADD COLUMN"
-                            // Skip whitespace
-                            while (pos < migration.up.len and (migration.up[pos] == ' ' or migration.up[pos] == '\t' or migration.up[pos] == '\n')) {
-                                pos += 1;
-                            }
-                            column_name_start = pos;
-                            // Find end of column name (whitespace or newline)
-                            while (pos < migration.up.len and migration.up[pos] != ' ' and migration.up[pos] != '\t' and migration.up[pos] != '\n') {
-                                pos += 1;
-                            }
-                            column_name_end = pos;
-                        }
-                    }
-                    
-                    // Check if column exists
-                    if (table_name_start != null and table_name_end != null and 
-                        column_name_start != null and column_name_end != null) {
-                        const table_name = migration.up[table_name_start.?..table_name_end.?];
-                        const column_name = migration.up[column_name_start.?..column_name_end.?];
-                        
-                        // Check if column already exists
-                        const column_exists = Schema.columnExists(self.db, table_name, column_name) catch false;
-                        if (column_exists) {
-                            // Column already exists - mark migration as applied and continue
-                            trans.rollback() catch {};
-                            // Record migration as applied even though we didn't run it
-                            // This syncs the migration tracking with the actual database state
-                            const timestamp = std.time.timestamp();
-                            var escaped_name = std.ArrayListUnmanaged(u8){};
-                            defer escaped_name.deinit(self.allocator);
-                            try escaped_name.ensureTotalCapacity(self.allocator, migration.name.len * 2);
-                            for (migration.name) |char| {
-                                if (char == '\'') {
-                                    try escaped_name.append(self.allocator, '\'');
-                                    try escaped_name.append(self.allocator, '\'');
-                                } else {
-                                    try escaped_name.append(self.allocator, char);
-                                }
-                            }
-                            const insert_sql = try std.fmt.allocPrint(
-                                self.allocator,
-                                "INSERT OR IGNORE INTO schema_migrations (version, name, applied_at) VALUES ({d}, '{s}', {d})",
-                                .{ migration.version, escaped_name.items, timestamp },
-                            );
-                            defer self.allocator.free(insert_sql);
-                            self.db.execute(insert_sql) catch {
-                                // If we can't record it, just continue - migration is already applied
-                            };
-                            continue;
-                        }
-                    }
+                try trans.execute("ROLLBACK TO e12_migration; RELEASE e12_migration");
+                // A re-run ADD COLUMN whose column already exists is recorded as applied
+                // This syncs the migration tracking with the actual database state
+                if (!self.columnAlreadyAdded(migration.up)) {
+                    std.debug.print("[ORM Error] Migration {d} ({s}) failed; no pending migrations were applied\n", .{ migration.version, migration.name });
+                    std.debug.print("  Error: {}\n", .{err});
+                    return err;
                 }
-                trans.rollback() catch {};
-                return err;
+                try record.bindAll(.{ migration.version, migration.name, timestamp });
+                try record.execute();
+                continue;
             };
+            try record.bindAll(.{ migration.version, migration.name, timestamp });
+            try record.execute();
+            try trans.execute("RELEASE e12_migration");
+            self.last_report.applied += 1;
+        }
 
-            const timestamp = std.time.timestamp();
-            // Escape single quotes in migration name
-            var escaped_name = std.ArrayListUnmanaged(u8){};
-            defer escaped_name.deinit(self.allocator);
-            try escaped_name.ensureTotalCapacity(self.allocator, migration.name.len * 2);
-            for (migration.name) |char| {
-                if (char == '\'') {
-                    try escaped_name.append(self.allocator, '\'');
-                    try escaped_name.append(self.allocator, '\'');
-                } else {
-                    try escaped_name.append(self.allocator, char);
-                }
-            }
+        var stamp = try self.db.prepare("INSERT OR REPLACE INTO schema_migrations_state (id, checksum, migration_count, updated_at) VALUES (1, ?, ?, ?)");
+        defer stamp.deinit();
+        try stamp.bindAll(.{ @as(i64, @bitCast(checksum)), migrations.len, timestamp });
+        try stamp.execute();
 
-            const insert_sql = try std.fmt.allocPrint(
-                self.allocator,
-                "INSERT INTO schema_migrations (version, name, applied_at) VALUES ({d}, '{s}', {d})",
-                .{ migration.version, escaped_name.items, timestamp },
-            );
-            defer self.allocator.free(insert_sql);
+        try trans.commit();
+    }
 
-            trans.execute(insert_sql) catch |err| {
-                trans.rollback() catch {};
-                return err;
-            };
+    /// Checksum of the stamp left by the last successful `runMigrations`, if any
+    pub fn storedChecksum(self: *MigrationRunner) !?u64 {
+        var stmt = try self.db.prepare("SELECT checksum FROM schema_migrations_state WHERE id = 1");
+        defer stmt.deinit();
+        var result = try stmt.query();
+        defer result.deinit();
+        const row = result.nextRow() orelse return null;
+        return @as(u64, @bitCast(row.getInt64(0)));
+    }
 
-            trans.commit() catch |err| {
-                trans.rollback() catch {};
-                return err;
-            };
+    /// Bit `i` is set when `migrations[i]` is recorded in schema_migrations
+    /// One query for the whole set; caller deinits with the runner's allocator.
+    pub fn appliedSet(self: *MigrationRunner, migrations: []const Migration) !std.DynamicBitSetUnmanaged {
+        var positions = std.AutoHashMapUnmanaged(u32, usize){};
+        defer positions.deinit(self.allocator);
+        try positions.ensureTotalCapacity(self.allocator, @intCast(migrations.len));
+        for (migrations, 0..) |migration, i| positions.putAssumeCapacity(migration.version, i);
+
+        var applied = try std.DynamicBitSetUnmanaged.initEmpty(self.allocator, migrations.len);
+        errdefer applied.deinit(self.allocator);
+
+        var result = try self.db.query("SELECT version FROM schema_migrations");
+        defer result.deinit();
+        while (result.nextRow()) |row| {
+            const version = std.math.cast(u32, row.getInt64(0)) orelse continue;
+            if (positions.get(version)) |i| applied.set(i);
         }
+        return applied;
+    }
+
+    fn columnAlreadyAdded(self: *MigrationRunner, up: []const u8) bool {
+        const target = addColumnTarget(up) orelse return false;
+        return Schema.columnExists(self.db, target.table, target.column) catch false;
     }
 
     pub fn rollbackMigration(self: *MigrationRunner, version: u32, migrations: []const Migration) !void {
@@ -242,6 +222,12 @@ pub const MigrationRunner = struct {
             return err;
         };
 
+        // The migration set no longer matches the database; re-check at next run
+        trans.execute("DELETE FROM schema_migrations_state") catch |err| {
+            trans.rollback() catch {};
+            return err;
+        };
+
         trans.commit() catch |err| {
             trans.rollback() catch {};
             return err;
@@ -255,6 +241,37 @@ pub const MigrationRunner = struct {
     };
 };
 
+/// Identity of a migration set: versions, names and `up` SQL, in order
+/// Editing, adding, removing or reordering a migration changes it.
+pub fn migrationChecksum(migrations: []const Migration) u64 {
+    var hasher = std.hash.Wyhash.init(0);
+    for (migrations) |migration| {
+        hasher.update(&std.mem.toBytes(std.mem.nativeToLittle(u32, migration.version)));
+        hasher.update(&std.mem.toBytes(std.mem.nativeToLittle(u64, migration.name.len)));
+        hasher.update(migration.name);
+        hasher.update(&std.mem.toBytes(std.mem.nativeToLittle(u64, migration.up.len)));
+        hasher.update(migration.up);
+    }
+    return hasher.final();
+}
+
+const AddColumn = struct {
+    table: []const u8,
+    column: []const u8,
+};
+
+/// Table and column of an `ALTER TABLE <table> ADD COLUMN <column> ...` migration
+fn addColumnTarget(sql: []const u8) ?AddColumn {
+    const alter_pos = std.mem.indexOf(u8, sql, "ALTER TABLE") orelse return null;
+    var words = std.mem.tokenizeAny(u8, sql[alter_pos + "ALTER TABLE".len ..], " \t\r\n");
+    const table = words.next() orelse return null;
+
+    const add_pos = std.mem.indexOfPos(u8, sql, alter_pos, "ADD COLUMN") orelse return null;
+    words = std.mem.tokenizeAny(u8, sql[add_pos + "ADD COLUMN".len ..], " \t\r\n");
+    const column = words.next() orelse return null;
+    return .{ .table = table, .column = std.mem.trimRight(u8, column, ";") };
+}
+
 test "MigrationRunner create migrations table" {
     const allocator = std.testing.allocator;
     var db = try Database.open(":memory:", allocator);
@@ -351,3 +368,65 @@ test "MigrationRunner rollbackMigration" {
     try std.testing.expect(version == null);
 }
 
+
+test "MigrationRunner skips a fully-migrated database by checksum" {
+    const allocator = std.testing.allocator;
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+
+    var runner = MigrationRunner.init(&db, allocator);
+    const v1 = [_]Migration{
+        Migration.init(1, "create_users", "CREATE TABLE users (id INTEGER PRIMARY KEY, name TEXT);", "DROP TABLE users;"),
+    };
+    const v2 = v1 ++ [_]Migration{
+        Migration.init(2, "create_posts", "CREATE TABLE posts (id INTEGER PRIMARY KEY);", "DROP TABLE posts;"),
+    };
+
+    try runner.runMigrations(&v1);
+    try std.testing.expect(!runner.last_report.fast_path);
+    try std.testing.expectEqual(@as(usize, 1), runner.last_report.applied);
+
+    try runner.runMigrations(&v1);
+    try std.testing.expect(runner.last_report.fast_path);
+
+    // A new migration changes the checksum; only the pending one runs
+    try std.testing.expect(migrationChecksum(&v1) != migrationChecksum(&v2));
+    try runner.runMigrations(&v2);
+    try std.testing.expect(!runner.last_report.fast_path);
+    try std.testing.expectEqual(@as(usize, 1), runner.last_report.applied);
+    try std.testing.expectEqual(migrationChecksum(&v2), (try runner.storedChecksum()).?);
+
+    // Rolling back clears the stamp so the next run re-checks
+    try runner.rollbackMigration(2, &v2);
+    try std.testing.expect((try runner.storedChecksum()) == null);
+    try runner.runMigrations(&v2);
+    try std.testing.expectEqual(@as(usize, 1), runner.last_report.applied);
+}
+
+test "MigrationRunner applies pending migrations in one transaction" {
+    const allocator = std.testing.allocator;
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+    try db.execute("CREATE TABLE users (id INTEGER PRIMARY KEY, name TEXT, email TEXT)");
+
+    var runner = MigrationRunner.init(&db, allocator);
+    const migrations = [_]Migration{
+        // Column already present: recorded as applied without failing the batch
+        Migration.init(1, "add_email", "ALTER TABLE users ADD COLUMN email TEXT;", "ALTER TABLE users DROP COLUMN email;"),
+        Migration.init(2, "create_posts", "CREATE TABLE posts (id INTEGER PRIMARY KEY);", "DROP TABLE posts;"),
+        Migration.init(3, "broken", "CREATE TABLE nope (;", "DROP TABLE nope;"),
+    };
+
+    try std.testing.expectError(error.QueryFailed, runner.runMigrations(&migrations));
+    try std.testing.expect(!try Schema.tableExists(&db, "posts"));
+    try std.testing.expect((try runner.getCurrentVersion()) == null);
+    try std.testing.expect((try runner.storedChecksum()) == null);
+
+    try runner.runMigrations(migrations[0..2]);
+    try std.testing.expect(try Schema.tableExists(&db, "posts"));
+    try std.testing.expectEqual(@as(u32, 2), (try runner.getCurrentVersion()).?);
+
+    var applied = try runner.appliedSet(&migrations);
+    defer applied.deinit(allocator);
+    try std.testing.expect(applied.isSet(0) and applied.isSet(1) and !applied.isSet(2));
+}
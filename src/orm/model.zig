@@ -85,6 +85,102 @@ pub fn toLowercaseTableName(allocator: std.mem.Allocator, table_name: []const u8
     return result.toOwnedSlice(allocator);
 }
 
+/// Comptime counterpart of inferTableName + toLowercaseTableName
+/// Applies the same "todo" -> "todos" pluralization the ORM uses at runtime,
+/// so generated SQL can be a compile-time constant.
+pub fn comptimeTableName(comptime T: type) []const u8 {
+    comptime {
+        const raw = inferTableName(T);
+        var buf: [raw.len]u8 = undefined;
+        for (raw, 0..) |char, i| {
+            buf[i] = if (char >= 'A' and char <= 'Z') (char + 32) else char;
+        }
+        if (std.mem.eql(u8, &buf, "todo")) {
+            return "todos";
+        }
+        const final = buf;
+        return &final;
+    }
+}
+
+/// Index on a model table
+/// The name is derived from the table and columns: `idx_<table>_<col>_<col>`.
+pub const IndexDef = struct {
+    table: []const u8,
+    columns: []const []const u8,
+
+    /// `idx_<table>_<columns joined by _>`; caller frees
+    pub fn name(self: IndexDef, allocator: std.mem.Allocator) ![]u8 {
+        var out = std.ArrayListUnmanaged(u8){};
+        errdefer out.deinit(allocator);
+        try out.writer(allocator).print("idx_{s}", .{self.table});
+        for (self.columns) |column| try out.writer(allocator).print("_{s}", .{column});
+        return out.toOwnedSlice(allocator);
+    }
+
+    /// `CREATE INDEX IF NOT EXISTS ...`; caller frees
+    pub fn createSql(self: IndexDef, allocator: std.mem.Allocator) ![:0]u8 {
+        const index_name = try self.name(allocator);
+        defer allocator.free(index_name);
+
+        var out = std.ArrayListUnmanaged(u8){};
+        errdefer out.deinit(allocator);
+        try out.writer(allocator).print("CREATE INDEX IF NOT EXISTS {s} ON {s} (", .{ index_name, self.table });
+        for (self.columns, 0..) |column, i| {
+            if (i > 0) try out.appendSlice(allocator, ", ");
+            try out.appendSlice(allocator, column);
+        }
+        try out.append(allocator, ')');
+        return out.toOwnedSliceSentinel(allocator, 0);
+    }
+
+    /// `DROP INDEX IF EXISTS ...`; caller frees
+    pub fn dropSql(self: IndexDef, allocator: std.mem.Allocator) ![:0]u8 {
+        const index_name = try self.name(allocator);
+        defer allocator.free(index_name);
+        return std.fmt.allocPrintSentinel(allocator, "DROP INDEX IF EXISTS {s}", .{index_name}, 0);
+    }
+};
+
+/// Indexes declared by a model through a `pub const indexes` tuple
+/// Each entry is a tuple of field names; unknown fields are compile errors.
+///
+/// Example:
+/// ```zig
+/// const Todo = struct {
+///     id: i64,
+///     user_id: i64,
+///     created_at: i64,
+///
+///     pub const indexes = .{
+///         .{ "user_id", "created_at" },
+///     };
+/// };
+/// // modelIndexes(Todo)[0].columns == &.{ "user_id", "created_at" }
+/// ```
+pub fn modelIndexes(comptime T: type) []const IndexDef {
+    comptime {
+        if (!@hasDecl(T, "indexes")) return &.{};
+
+        const table = comptimeTableName(T);
+        var defs: [T.indexes.len]IndexDef = undefined;
+        inline for (T.indexes, 0..) |entry, i| {
+            if (entry.len == 0) @compileError("Empty index declared on " ++ @typeName(T));
+            var columns: [entry.len][]const u8 = undefined;
+            inline for (entry, 0..) |column, j| {
+                if (!@hasField(T, column)) {
+                    @compileError("Index on " ++ @typeName(T) ++ " names unknown field '" ++ column ++ "'");
+                }
+                columns[j] = column;
+            }
+            const final_columns = columns;
+            defs[i] = .{ .table = table, .columns = &final_columns };
+        }
+        const final = defs;
+        return &final;
+    }
+}
+
 pub fn toSnakeCase(allocator: std.mem.Allocator, input: []const u8) ![]const u8 {
     var result = std.ArrayListUnmanaged(u8){};
     errdefer result.deinit(allocator);
@@ -152,6 +248,18 @@ test "toSnakeCase" {
     try std.testing.expectEqualStrings("my_test_class", snake3);
 }
 
+test "comptimeTableName" {
+    const Account = struct {
+        id: i64,
+    };
+    const Todo = struct {
+        id: i64,
+    };
+
+    try std.testing.expectEqualStrings("account", comptimeTableName(Account));
+    try std.testing.expectEqualStrings("todos", comptimeTableName(Todo));
+}
+
 test "getFieldNames" {
     const TestUser = struct {
         id: i64,
@@ -239,3 +347,35 @@ test "ModelDef toCreateTableSQL blob field" {
 
     try std.testing.expect(std.mem.indexOf(u8, sql, "data BLOB") != null);
 }
+
+test "modelIndexes reads declared indexes" {
+    const allocator = std.testing.allocator;
+
+    const Todo = struct {
+        id: i64,
+        user_id: i64,
+        created_at: i64,
+
+        pub const indexes = .{
+            .{ "user_id", "created_at" },
+            .{"created_at"},
+        };
+    };
+
+    const defs = modelIndexes(Todo);
+    try std.testing.expectEqual(@as(usize, 2), defs.len);
+
+    const create = try defs[0].createSql(allocator);
+    defer allocator.free(create);
+    try std.testing.expectEqualStrings(
+        "CREATE INDEX IF NOT EXISTS idx_todos_user_id_created_at ON todos (user_id, created_at)",
+        create,
+    );
+
+    const drop = try defs[1].dropSql(allocator);
+    defer allocator.free(drop);
+    try std.testing.expectEqualStrings("DROP INDEX IF EXISTS idx_todos_created_at", drop);
+
+    const Plain = struct { id: i64 };
+    try std.testing.expectEqual(@as(usize, 0), modelIndexes(Plain).len);
+}
@@ -0,0 +1,346 @@
+const std = @import("std");
+const model = @import("model.zig");
+const Statement = @import("database.zig").Statement;
+
+/// Parameterized SQL generated at compile time for a model struct
+/// Column lists come from the struct's fields, values are always bound as `?`
+/// placeholders, so no value is ever formatted into the SQL text.
+///
+/// Example:
+/// ```zig
+/// const Sql = ModelSql(User);
+/// var stmt = try db.prepare(Sql.select_by_id);
+/// defer stmt.deinit();
+/// try stmt.bind(1, user_id);
+/// ```
+pub fn ModelSql(comptime T: type) type {
+    const fields = std.meta.fields(T);
+
+    return struct {
+        /// Set of fields taking part in an INSERT/UPDATE, indexed by struct field order
+        pub const FieldMask = std.StaticBitSet(fields.len);
+
+        pub const table_name: []const u8 = model.comptimeTableName(T);
+        pub const has_id = @hasField(T, "id");
+
+        /// Every field, in struct order
+        pub const all_mask: FieldMask = FieldMask.initFull();
+
+        /// Every field except `id`
+        pub const non_id_mask: FieldMask = blk: {
+            var mask = FieldMask.initFull();
+            for (fields, 0..) |field, i| {
+                if (std.mem.eql(u8, field.name, "id")) mask.unset(i);
+            }
+            break :blk mask;
+        };
+
+        pub const columns: []const u8 = columnList(all_mask);
+
+        pub const select_all: [:0]const u8 = std.fmt.comptimePrint("SELECT {s} FROM {s}", .{ columns, table_name });
+        pub const select_by_id: [:0]const u8 = std.fmt.comptimePrint("{s} WHERE id = ?", .{select_all});
+        pub const delete_by_id: [:0]const u8 = std.fmt.comptimePrint("DELETE FROM {s} WHERE id = ?", .{table_name});
+
+        /// INSERT of every non-id column (id assigned by SQLite)
+        pub const insert: [:0]const u8 = insertSql(non_id_mask);
+        /// INSERT of every column including an explicit id
+        pub const insert_with_id: [:0]const u8 = insertSql(all_mask);
+        /// UPDATE of every non-id column; id is the last parameter
+        pub const update_by_id: [:0]const u8 = updateSql(non_id_mask);
+        /// UPDATE of one column, indexed by struct field order; id is the last parameter
+        pub const update_single_field: [fields.len][:0]const u8 = blk: {
+            var sqls: [fields.len][:0]const u8 = undefined;
+            for (0..fields.len) |i| {
+                var mask = FieldMask.initEmpty();
+                mask.set(i);
+                sqls[i] = updateSql(mask);
+            }
+            break :blk sqls;
+        };
+
+        /// json_object(...) of every field, named as in the struct
+        /// Bools become JSON true/false so the text matches `Json.serialize(T, ...)`.
+        pub const json_object: []const u8 = jsonObject();
+
+        /// Wrap a query over this table so SQLite returns its rows as one JSON array
+        /// SQLite does not promise that an aggregate sees a subquery's rows in its
+        /// ORDER BY, so element order comes from `order_by`, applied inside
+        /// json_group_array (SQLite 3.44+); without it the order is unspecified.
+        /// With `total_column`, the second result column is MAX(total_column), for
+        /// a window total such as COUNT(*) OVER (). The third is the number of rows.
+        pub fn buildJsonArray(allocator: std.mem.Allocator, inner_sql: []const u8, order_by: ?[]const u8, total_column: ?[]const u8) ![:0]u8 {
+            return std.fmt.allocPrintSentinel(allocator, "SELECT json_group_array({s}{s}{s}), {s}{s}{s}, COUNT(*) FROM ({s})", .{
+                json_object,
+                if (order_by != null) " ORDER BY " else "",
+                order_by orelse "",
+                if (total_column != null) "MAX(" else "",
+                total_column orelse "NULL",
+                if (total_column != null) ")" else "",
+                inner_sql,
+            }, 0);
+        }
+
+        /// SELECT with a compile-time WHERE clause (use `?` for values)
+        pub fn selectWhere(comptime condition: []const u8) [:0]const u8 {
+            return std.fmt.comptimePrint("{s} WHERE {s}", .{ select_all, condition });
+        }
+
+        /// Fields create() writes: id only when non-zero, optionals only when non-null
+        pub fn insertMask(instance: T) FieldMask {
+            var mask = FieldMask.initEmpty();
+            inline for (fields, 0..) |field, i| {
+                const value = @field(instance, field.name);
+                if (comptime std.mem.eql(u8, field.name, "id")) {
+                    if (value != 0) mask.set(i);
+                } else if (!isNullOptional(value)) {
+                    mask.set(i);
+                }
+            }
+            return mask;
+        }
+
+        /// Fields update() writes: every non-id field that is not a null optional
+        pub fn updateMask(instance: T) FieldMask {
+            var mask = FieldMask.initEmpty();
+            inline for (fields, 0..) |field, i| {
+                if (comptime !std.mem.eql(u8, field.name, "id")) {
+                    if (!isNullOptional(@field(instance, field.name))) mask.set(i);
+                }
+            }
+            return mask;
+        }
+
+        /// INSERT for an arbitrary field mask
+        /// Returns a comptime constant for the common masks and only allocates
+        /// for partial inserts. Free with `GeneratedSql.deinit`.
+        pub fn buildInsert(allocator: std.mem.Allocator, mask: FieldMask) !GeneratedSql {
+            return buildInsertWithSuffix(allocator, mask, "");
+        }
+
+        /// INSERT ... RETURNING rowid for an arbitrary field mask
+        /// For tables with an INTEGER PRIMARY KEY the rowid is the generated id.
+        pub fn buildInsertReturningRowId(allocator: std.mem.Allocator, mask: FieldMask) !GeneratedSql {
+            return buildInsertWithSuffix(allocator, mask, " RETURNING rowid");
+        }
+
+        fn buildInsertWithSuffix(allocator: std.mem.Allocator, mask: FieldMask, comptime suffix: []const u8) !GeneratedSql {
+            if (mask.eql(non_id_mask)) return GeneratedSql.static(comptime std.fmt.comptimePrint("{s}{s}", .{ insert, suffix }));
+            if (mask.eql(all_mask)) return GeneratedSql.static(comptime std.fmt.comptimePrint("{s}{s}", .{ insert_with_id, suffix }));
+
+            var sql = std.ArrayListUnmanaged(u8){};
+            errdefer sql.deinit(allocator);
+
+            try sql.writer(allocator).print("INSERT INTO {s} (", .{table_name});
+            var count: usize = 0;
+            inline for (fields, 0..) |field, i| {
+                if (mask.isSet(i)) {
+                    if (count > 0) try sql.appendSlice(allocator, ", ");
+                    try sql.appendSlice(allocator, field.name);
+                    count += 1;
+                }
+            }
+            try sql.appendSlice(allocator, ") VALUES (");
+            for (0..count) |i| {
+                if (i > 0) try sql.appendSlice(allocator, ", ");
+                try sql.append(allocator, '?');
+            }
+            try sql.append(allocator, ')');
+            try sql.appendSlice(allocator, suffix);
+
+            return GeneratedSql.owned(allocator, try sql.toOwnedSliceSentinel(allocator, 0));
+        }
+
+        /// UPDATE ... WHERE id = ? for an arbitrary field mask
+        /// Full and single-column updates are comptime constants; other masks allocate.
+        pub fn buildUpdate(allocator: std.mem.Allocator, mask: FieldMask) !GeneratedSql {
+            if (mask.eql(non_id_mask)) return GeneratedSql.static(update_by_id);
+            if (mask.count() == 1) return GeneratedSql.static(update_single_field[mask.findFirstSet().?]);
+
+            var sql = std.ArrayListUnmanaged(u8){};
+            errdefer sql.deinit(allocator);
+
+            try sql.writer(allocator).print("UPDATE {s} SET ", .{table_name});
+            var count: usize = 0;
+            inline for (fields, 0..) |field, i| {
+                if (mask.isSet(i)) {
+                    if (count > 0) try sql.appendSlice(allocator, ", ");
+                    try sql.writer(allocator).print("{s} = ?", .{field.name});
+                    count += 1;
+                }
+            }
+            try sql.appendSlice(allocator, " WHERE id = ?");
+
+            return GeneratedSql.owned(allocator, try sql.toOwnedSliceSentinel(allocator, 0));
+        }
+
+        /// Bind the masked fields of `instance` in struct order starting at `first_index`
+        /// Returns the next free parameter index.
+        pub fn bindFields(stmt: *Statement, instance: T, mask: FieldMask, first_index: i32) Statement.Error!i32 {
+            var index = first_index;
+            inline for (fields, 0..) |field, i| {
+                if (mask.isSet(i)) {
+                    try stmt.bind(index, @field(instance, field.name));
+                    index += 1;
+                }
+            }
+            return index;
+        }
+
+        fn columnList(comptime mask: FieldMask) []const u8 {
+            comptime {
+                var out: []const u8 = "";
+                for (fields, 0..) |field, i| {
+                    if (!mask.isSet(i)) continue;
+                    if (out.len > 0) out = out ++ ", ";
+                    out = out ++ field.name;
+                }
+                return out;
+            }
+        }
+
+        fn jsonObject() []const u8 {
+            comptime {
+                var args: []const u8 = "";
+                for (fields) |field| {
+                    if (args.len > 0) args = args ++ ", ";
+                    args = args ++ "'" ++ field.name ++ "', " ++ jsonValue(field.type, field.name);
+                }
+                return "json_object(" ++ args ++ ")";
+            }
+        }
+
+        fn jsonValue(comptime F: type, comptime column: []const u8) []const u8 {
+            const Inner = switch (@typeInfo(F)) {
+                .optional => |opt| opt.child,
+                else => F,
+            };
+            if (Inner == bool) {
+                return "CASE WHEN " ++ column ++ " IS NULL THEN NULL WHEN " ++ column ++ " THEN json('true') ELSE json('false') END";
+            }
+            return column;
+        }
+
+        fn insertSql(comptime mask: FieldMask) [:0]const u8 {
+            comptime {
+                var placeholders: []const u8 = "";
+                for (0..mask.count()) |i| {
+                    if (i > 0) placeholders = placeholders ++ ", ";
+                    placeholders = placeholders ++ "?";
+                }
+                return std.fmt.comptimePrint("INSERT INTO {s} ({s}) VALUES ({s})", .{ table_name, columnList(mask), placeholders });
+            }
+        }
+
+        fn updateSql(comptime mask: FieldMask) [:0]const u8 {
+            comptime {
+                var assignments: []const u8 = "";
+                for (fields, 0..) |field, i| {
+                    if (!mask.isSet(i)) continue;
+                    if (assignments.len > 0) assignments = assignments ++ ", ";
+                    assignments = assignments ++ field.name ++ " = ?";
+                }
+                return std.fmt.comptimePrint("UPDATE {s} SET {s} WHERE id = ?", .{ table_name, assignments });
+            }
+        }
+
+        fn isNullOptional(value: anytype) bool {
+            return switch (@typeInfo(@TypeOf(value))) {
+                .optional => value == null,
+                else => false,
+            };
+        }
+    };
+}
+
+/// SQL text that is either a comptime constant or owned by an allocator
+pub const GeneratedSql = struct {
+    sql: [:0]const u8,
+    allocator: ?std.mem.Allocator = null,
+
+    pub fn static(sql: [:0]const u8) GeneratedSql {
+        return .{ .sql = sql };
+    }
+
+    pub fn owned(allocator: std.mem.Allocator, sql: [:0]u8) GeneratedSql {
+        return .{ .sql = sql, .allocator = allocator };
+    }
+
+    pub fn deinit(self: GeneratedSql) void {
+        if (self.allocator) |allocator| {
+            allocator.free(self.sql);
+        }
+    }
+};
+
+test "ModelSql generates parameterized statements" {
+    const User = struct {
+        id: i64,
+        name: []const u8,
+        age: i32,
+    };
+    const Sql = ModelSql(User);
+
+    try std.testing.expectEqualStrings("user", Sql.table_name);
+    try std.testing.expectEqualStrings("SELECT id, name, age FROM user", Sql.select_all);
+    try std.testing.expectEqualStrings("SELECT id, name, age FROM user WHERE id = ?", Sql.select_by_id);
+    try std.testing.expectEqualStrings("INSERT INTO user (name, age) VALUES (?, ?)", Sql.insert);
+    try std.testing.expectEqualStrings("INSERT INTO user (id, name, age) VALUES (?, ?, ?)", Sql.insert_with_id);
+    try std.testing.expectEqualStrings("UPDATE user SET name = ?, age = ? WHERE id = ?", Sql.update_by_id);
+    try std.testing.expectEqualStrings("DELETE FROM user WHERE id = ?", Sql.delete_by_id);
+    try std.testing.expectEqualStrings("SELECT id, name, age FROM user WHERE age > ?", Sql.selectWhere("age > ?"));
+}
+
+test "ModelSql builds partial statements from field masks" {
+    const allocator = std.testing.allocator;
+
+    const Note = struct {
+        id: i64,
+        title: []const u8,
+        body: ?[]const u8,
+    };
+    const Sql = ModelSql(Note);
+
+    const note = Note{ .id = 0, .title = "hello", .body = null };
+
+    const insert = try Sql.buildInsert(allocator, Sql.insertMask(note));
+    defer insert.deinit();
+    try std.testing.expectEqualStrings("INSERT INTO note (title) VALUES (?)", insert.sql);
+
+    const update = try Sql.buildUpdate(allocator, Sql.updateMask(note));
+    defer update.deinit();
+    try std.testing.expect(update.allocator == null);
+    try std.testing.expectEqualStrings("UPDATE note SET title = ? WHERE id = ?", update.sql);
+
+    const full = try Sql.buildInsert(allocator, Sql.insertMask(Note{ .id = 0, .title = "a", .body = "b" }));
+    defer full.deinit();
+    try std.testing.expect(full.allocator == null);
+    try std.testing.expectEqualStrings(Sql.insert, full.sql);
+
+    const returning = try Sql.buildInsertReturningRowId(allocator, Sql.insertMask(note));
+    defer returning.deinit();
+    try std.testing.expectEqualStrings("INSERT INTO note (title) VALUES (?) RETURNING rowid", returning.sql);
+}
+
+test "ModelSql builds a json_object of every field" {
+    const allocator = std.testing.allocator;
+
+    const Task = struct {
+        id: i64,
+        title: []const u8,
+        done: bool,
+    };
+    const Sql = ModelSql(Task);
+
+    try std.testing.expectEqualStrings(
+        "json_object('id', id, 'title', title, 'done', CASE WHEN done IS NULL THEN NULL WHEN done THEN json('true') ELSE json('false') END)",
+        Sql.json_object,
+    );
+
+    const sql = try Sql.buildJsonArray(allocator, "SELECT * FROM task", null, null);
+    defer allocator.free(sql);
+    try std.testing.expectEqualStrings("SELECT json_group_array(" ++ Sql.json_object ++ "), NULL, COUNT(*) FROM (SELECT * FROM task)", sql);
+
+    const ordered = try Sql.buildJsonArray(allocator, "SELECT * FROM task ORDER BY title DESC LIMIT 5", "title DESC", "\"e12_total\"");
+    defer allocator.free(ordered);
+    try std.testing.expectEqualStrings("SELECT json_group_array(" ++ Sql.json_object ++ " ORDER BY title DESC), MAX(\"e12_total\"), COUNT(*) FROM (SELECT * FROM task ORDER BY title DESC LIMIT 5)", ordered);
+}
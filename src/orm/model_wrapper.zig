@@ -185,27 +185,11 @@ pub fn ModelWithORM(comptime T: type) type {
                     }
                 }
 
-                const max_result_opt = try self.orm.findManaged(T, max_id);
-                if (max_result_opt) |result| {
-                    var mutable_result = result;
-                    defer mutable_result.deinit();
-                    if (mutable_result.first()) |found| {
-                        return try Self.copyInstance(found, self.orm.allocator);
-                    }
-                }
-                return error.FailedToCreate;
+                return try self.orm.find(T, max_id) orelse error.FailedToCreate;
             };
 
-            // Fetch the created record
-            const result_opt = try self.orm.findManaged(T, id);
-            if (result_opt) |result| {
-                var mutable_result = result;
-                defer mutable_result.deinit();
-                if (mutable_result.first()) |found| {
-                    return try Self.copyInstance(found, self.orm.allocator);
-                }
-            }
-            return error.FailedToCreate;
+            // Fetch the created record (strings are allocated directly in the ORM allocator)
+            return try self.orm.find(T, id) orelse error.FailedToCreate;
         }
 
         /// Find a record by ID
@@ -219,15 +203,7 @@ pub fn ModelWithORM(comptime T: type) type {
         /// }
         /// ```
         pub fn find(self: Self, id: i64) !?T {
-            const result_opt = try self.orm.findManaged(T, id);
-            if (result_opt) |result| {
-                var mutable_result = result;
-                defer mutable_result.deinit();
-                if (mutable_result.first()) |found| {
-                    return try Self.copyInstance(found, self.orm.allocator);
-                }
-            }
-            return null;
+            return self.orm.find(T, id);
         }
 
         /// Find all records
@@ -244,14 +220,7 @@ pub fn ModelWithORM(comptime T: type) type {
         /// }
         /// ```
         pub fn findAll(self: Self) !std.ArrayListUnmanaged(T) {
-            var result = try self.orm.findAllManaged(T);
-            defer result.deinit();
-
-            var items = std.ArrayListUnmanaged(T){};
-            for (result.getItems()) |item| {
-                try items.append(self.orm.allocator, try Self.copyInstance(item, self.orm.allocator));
-            }
-            return items;
+            return self.orm.findAll(T);
         }
 
         /// Update a record
@@ -277,41 +246,11 @@ pub fn ModelWithORM(comptime T: type) type {
         /// const deleted = try model.delete(id);
         /// ```
         pub fn delete(self: Self, id: i64) !bool {
-            const existing = try self.find(id);
-            if (existing == null) return false;
+            var existing = try self.orm.findManaged(T, id) orelse return false;
+            existing.deinit();
             try self.orm.delete(T, id);
             return true;
         }
-
-        /// Helper to copy instance with allocated strings
-        /// Deep copies all string fields using the provided allocator
-        fn copyInstance(instance: T, allocator: std.mem.Allocator) !T {
-            var copy = instance;
-
-            inline for (std.meta.fields(T)) |field| {
-                const field_type = field.type;
-                const field_value = @field(instance, field.name);
-
-                if (@typeInfo(field_type) == .pointer) {
-                    const ptr_info = @typeInfo(field_type).pointer;
-                    if (ptr_info.size == .slice and ptr_info.child == u8) {
-                        @field(copy, field.name) = try allocator.dupe(u8, field_value);
-                    }
-                } else if (@typeInfo(field_type) == .optional) {
-                    const opt_info = @typeInfo(field_type).optional;
-                    if (@typeInfo(opt_info.child) == .pointer) {
-                        const ptr_info = @typeInfo(opt_info.child).pointer;
-                        if (ptr_info.size == .slice and ptr_info.child == u8) {
-                            if (field_value) |value| {
-                                @field(copy, field.name) = try allocator.dupe(u8, value);
-                            }
-                        }
-                    }
-                }
-            }
-
-            return copy;
-        }
     };
 }
 
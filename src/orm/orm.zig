@@ -4,6 +4,21 @@ const database = @import("database.zig");
 const QueryResult = @import("row.zig").QueryResult;
 const QueryBuilder = @import("query_builder.zig").QueryBuilder;
 const model = @import("model.zig");
+const ModelSql = @import("model_sql.zig").ModelSql;
+const GeneratedSql = @import("model_sql.zig").GeneratedSql;
+const wal = @import("wal.zig");
+const write_queue = @import("write_queue.zig");
+const query_plan = @import("query_plan.zig");
+const entity_cache = @import("entity_cache.zig");
+const search_mod = @import("search.zig");
+const csv_export = @import("csv_export.zig");
+const backup_mod = @import("backup.zig");
+const db_stats = @import("db_stats.zig");
+const change_feed = @import("change_feed.zig");
+const tracked = @import("tracked.zig");
+const tenant_pool = @import("tenant_pool.zig");
+const BackupJob = backup_mod.BackupJob;
+const CsvWriter = csv_export.CsvWriter;
 const MigrationRunner = @import("migration_runner.zig").MigrationRunner;
 const Migration = @import("migration.zig").Migration;
 const MigrationRegistry = @import("migration.zig").MigrationRegistry;
@@ -12,6 +27,54 @@ const MigrationRegistry = @import("migration.zig").MigrationRegistry;
 pub const SqlEscape = @import("sql_escape.zig").SqlEscape;
 pub const Schema = @import("schema.zig").Schema;
 pub const DatabaseSingleton = @import("singleton.zig").DatabaseSingleton;
+pub const OpenOptions = database.OpenOptions;
+pub const StatementCacheStats = database.StatementCacheStats;
+pub const Statement = database.Statement;
+pub const ModelSqlType = ModelSql;
+pub const WalDatabase = wal.WalDatabase;
+pub const WalOptions = wal.WalOptions;
+pub const PragmaProfile = wal.PragmaProfile;
+pub const WriteQueue = write_queue.WriteQueue;
+pub const WriteQueueOptions = write_queue.WriteQueueOptions;
+pub const WriteQueueStats = write_queue.WriteQueueStats;
+pub const WriteOp = write_queue.WriteOp;
+pub const QueryPlanInspector = query_plan.QueryPlanInspector;
+pub const PlanInspectorOptions = query_plan.PlanInspectorOptions;
+pub const IndexDef = model.IndexDef;
+pub const SearchDef = search_mod.SearchDef;
+pub const SearchOptions = search_mod.SearchOptions;
+pub const SearchFilter = search_mod.SearchFilter;
+pub const SearchHit = QueryResult.SearchHit;
+pub const AsyncORM = @import("async_orm.zig").AsyncORM;
+pub const AsyncOptions = @import("async_orm.zig").AsyncOptions;
+pub const AsyncStats = @import("async_orm.zig").AsyncStats;
+pub const Future = @import("async_orm.zig").Future;
+pub const CsvOptions = csv_export.CsvOptions;
+pub const BackupJobType = BackupJob;
+pub const BackupProgress = backup_mod.BackupProgress;
+pub const BackupState = backup_mod.BackupState;
+pub const DbStatus = database.DbStatus;
+pub const TableSize = database.TableSize;
+pub const DbStatsOptions = db_stats.DbStatsOptions;
+pub const DbStatsSnapshot = db_stats.DbStatsSnapshot;
+pub const DbStatsSampler = db_stats.DbStatsSampler;
+pub const ChangeFeed = change_feed.ChangeFeed;
+pub const ChangeFeedOptions = change_feed.ChangeFeedOptions;
+pub const ChangeFeedStats = change_feed.ChangeFeedStats;
+pub const ChangeBatch = change_feed.ChangeBatch;
+pub const Change = change_feed.Change;
+pub const ChangeOp = change_feed.ChangeOp;
+pub const Tracked = tracked.Tracked;
+pub const TenantPool = tenant_pool.TenantPool;
+pub const TenantPoolOptions = tenant_pool.TenantPoolOptions;
+pub const TenantPoolStats = tenant_pool.TenantPoolStats;
+pub const compiled_query = @import("compiled_query.zig");
+pub const CompiledQuery = compiled_query.CompiledQuery;
+pub const QuerySpec = compiled_query.QuerySpec;
+pub const Cond = compiled_query.Cond;
+pub const EntityCache = entity_cache.EntityCache;
+pub const EntityCacheOptions = entity_cache.EntityCacheOptions;
+pub const EntityCacheStats = entity_cache.EntityCacheStats;
 
 // Re-export migration types
 pub const MigrationType = Migration;
@@ -23,10 +86,13 @@ pub const ModelWithORM = @import("model_wrapper.zig").ModelWithORM;
 pub const ModelStats = @import("model_wrapper.zig").ModelStats;
 
 /// Managed ORM result wrapper that automatically frees string fields on deinit
+/// Results from findManaged/findAllManaged keep the list and every string in
+/// one arena, so deinit() is a single arena.deinit().
 pub fn Result(comptime T: type) type {
     return struct {
         items: std.ArrayListUnmanaged(T),
         allocator: std.mem.Allocator,
+        arena: ?std.heap.ArenaAllocator = null,
 
         const Self = @This();
 
@@ -37,6 +103,15 @@ pub fn Result(comptime T: type) type {
             };
         }
 
+        /// Wrap items whose list and strings were all allocated in `arena`
+        pub fn initArena(items: std.ArrayListUnmanaged(T), arena: std.heap.ArenaAllocator) Self {
+            return Self{
+                .items = items,
+                .allocator = arena.child_allocator,
+                .arena = arena,
+            };
+        }
+
         /// Get the items as a slice
         pub fn getItems(self: *const Self) []const T {
             return self.items.items;
@@ -65,6 +140,11 @@ pub fn Result(comptime T: type) type {
 
         /// Deinitialize and free all string fields
         pub fn deinit(self: *Self) void {
+            if (self.arena) |*arena| {
+                arena.deinit();
+                self.arena = null;
+                return;
+            }
             for (self.items.items) |item| {
                 inline for (std.meta.fields(T)) |field| {
                     const field_type = @TypeOf(@field(item, field.name));
@@ -91,9 +171,52 @@ pub fn Result(comptime T: type) type {
     };
 }
 
+/// Rows of a query serialized by SQLite as one JSON array (see `ORM.queryJsonArray`)
+pub const JsonArray = struct {
+    /// `[{...},...]`, owned by the allocator passed to queryJsonArray
+    json: []u8,
+    /// MAX(total_column) over the rows; null without a total column or rows
+    total: ?i64 = null,
+    rows: usize = 0,
+};
+
+/// Options for `ORM.queryJsonArray`
+pub const JsonArrayOptions = struct {
+    /// ORDER BY terms for the array elements, e.g. "created_at DESC, id DESC"
+    /// Pass the query's own ORDER BY: SQLite does not keep a subquery's order
+    /// through json_group_array. Not escaped, so only use trusted column names.
+    order_by: ?[]const u8 = null,
+    /// Window total selected by the query, e.g. "e12_total" for COUNT(*) OVER () AS e12_total
+    total_column: ?[]const u8 = null,
+};
+
 pub const ORM = struct {
     db: Database,
     allocator: std.mem.Allocator,
+    /// Set by initWal(): reads go to the reader pool, writes to `db` (the writer)
+    wal: ?*WalDatabase = null,
+    /// Set by enableWriteQueue(): create/createMany/update/delete are group-committed
+    write_queue: ?*WriteQueue = null,
+    /// Set by enableEntityCache(): find() serves cached rows by primary key
+    entity_cache: ?*EntityCache = null,
+    /// Most recent backup() job, kept for progress reporting
+    backup_job: ?*BackupJob = null,
+    /// Guards `backup_job` against /metrics scrapes while backup() replaces it
+    backup_mutex: std.Thread.Mutex = .{},
+    /// Threads inside waitBackup(); the job is not freed until they leave
+    backup_waiters: usize = 0,
+    backup_waiters_done: std.Thread.Condition = .{},
+    /// Set by enableDbStats(): SQLite internals sampled for writePrometheus()
+    db_stats: ?*DbStatsSampler = null,
+    /// Set by enableChangeFeed(): committed row changes on `db`
+    change_feed: ?*ChangeFeed = null,
+    /// Set by exportAsyncStats(): its stats are added to writePrometheus()
+    async_db: ?*AsyncORM = null,
+    /// Set by setPlanInspector(): applied to WAL readers as they are acquired
+    plan_inspector: ?*QueryPlanInspector = null,
+    /// Thread whose open query() result holds the write lock (0 = none); only
+    /// used in write-queue mode without WAL, where query() reads on the writer
+    query_lock_holder: std.atomic.Value(std.Thread.Id) = .init(0),
 
     pub fn init(db: Database, allocator: std.mem.Allocator) ORM {
         return ORM{
@@ -102,6 +225,25 @@ pub const ORM = struct {
         };
     }
 
+    /// Initialize ORM on a WAL-mode database
+    /// find/findAll/where/whereBind run on pooled read-only connections in
+    /// parallel; create/update/delete/execute/transaction serialize on the
+    /// single writer connection. The ORM takes ownership of `wal_db`.
+    ///
+    /// Example:
+    /// ```zig
+    /// const wal_db = try WalDatabase.open("app.db", allocator, .{});
+    /// var orm = ORM.initWal(wal_db, allocator);
+    /// defer orm.close();
+    /// ```
+    pub fn initWal(wal_db: *WalDatabase, allocator: std.mem.Allocator) ORM {
+        return ORM{
+            .db = wal_db.writer,
+            .allocator = allocator,
+            .wal = wal_db,
+        };
+    }
+
     /// Initialize ORM and return a heap-allocated pointer
     /// This is recommended for handler usage where you need to pass pointers
     ///
@@ -129,196 +271,260 @@ pub const ORM = struct {
         allocator.destroy(self);
     }
 
-    pub fn initWithPool(pool: *Database.ConnectionPool, allocator: std.mem.Allocator) !ORM {
-        _ = pool;
-        _ = allocator;
-        return error.NotImplemented;
+    /// Route create/createMany/update/delete through a group-commit write queue
+    /// A writer thread commits queued writes in batches of up to
+    /// `max_batch_size`, one transaction (and one fsync) per batch. Callers still
+    /// block until their write has committed, but wait up to `max_latency_us`
+    /// longer. Call before sharing the ORM between threads.
+    ///
+    /// Example:
+    /// ```zig
+    /// try orm.enableWriteQueue(.{ .max_batch_size = 256, .max_latency_us = 1000 });
+    /// ```
+    pub fn enableWriteQueue(self: *ORM, options: WriteQueueOptions) !void {
+        if (self.write_queue != null) return;
+        const writer_lock: ?*std.Thread.Mutex = if (self.wal) |wal_db| &wal_db.writer_mutex else null;
+        self.write_queue = try WriteQueue.init(self.allocator, self.db, writer_lock, options);
+        // The queue's lock now guards the connection the sampler reads
+        if (self.db_stats) |sampler| sampler.setWriteLock(self.writeLock());
     }
 
-    /// Helper to get lowercase table name for a type
-    fn getTableName(self: *ORM, comptime T: type) ![]const u8 {
-        const raw_table_name = model.inferTableName(T);
-        const table_name = try model.toLowercaseTableName(self.allocator, raw_table_name);
+    /// Cache rows of T returned by find()/findAlloc(), keyed by id
+    /// Entries expire after `ttl_ms` and are bounded per model by `max_entries`
+    /// and `max_bytes`. update() and delete() drop the row; transactions,
+    /// execute() and migrations drop every cached row. Writes made directly
+    /// on `db` are not seen until the TTL expires.
+    ///
+    /// Example:
+    /// ```zig
+    /// try orm.enableEntityCache(Todo, .{ .max_entries = 10_000, .ttl_ms = 30_000 });
+    /// const todo = try orm.find(Todo, 1); // SQLite
+    /// const again = try orm.find(Todo, 1); // cache
+    /// std.debug.print("hit rate: {d:.2}\n", .{orm.entityCacheStats().hitRate()});
+    /// ```
+    pub fn enableEntityCache(self: *ORM, comptime T: type, options: EntityCacheOptions) !void {
+        _ = try self.enableTableCache(ModelSql(T).table_name, options);
+    }
 
-        // Special case: "todo" -> "todos" (plural)
-        // This handles the mismatch between struct name "Todo" and table name "todos"
-        if (std.mem.eql(u8, table_name, "todo")) {
-            defer self.allocator.free(table_name);
-            return try self.allocator.dupe(u8, "todos");
+    /// Cache rows of `table_name` for code that reads the cache itself
+    /// For tables no model maps to, such as a valve's configurable users
+    /// table: find() and update()/delete() only use the key of enableEntityCache().
+    /// Changes seen by the change feed and execute()/transaction() still invalidate it.
+    pub fn enableTableCache(self: *ORM, table_name: []const u8, options: EntityCacheOptions) !*EntityCache {
+        if (self.entity_cache == null) {
+            const cache = try self.allocator.create(EntityCache);
+            cache.* = EntityCache.init(self.allocator);
+            self.entity_cache = cache;
         }
+        try self.entity_cache.?.enable(table_name, options);
+        return self.entity_cache.?;
+    }
 
-        return table_name;
+    /// Entity cache counters summed over all cached models
+    pub fn entityCacheStats(self: *ORM) EntityCacheStats {
+        const cache = self.entity_cache orelse return .{};
+        return cache.stats(null);
     }
 
-    pub fn create(self: *ORM, comptime T: type, instance: T) !void {
-        const table_name = try self.getTableName(T);
-        defer self.allocator.free(table_name);
-        var fields = std.ArrayListUnmanaged([]const u8){};
-        defer fields.deinit(self.allocator);
-
-        var values = std.ArrayListUnmanaged([]const u8){};
-
-        inline for (std.meta.fields(T)) |field| {
-            const is_id_field = comptime std.mem.eql(u8, field.name, "id");
-            if (is_id_field) {
-                const id_value = @field(instance, field.name);
-                if (id_value != 0) {
-                    try fields.append(self.allocator, field.name);
-                    const value_str = try self.valueToString(id_value);
-                    try values.append(self.allocator, value_str);
-                }
-            } else {
-                const value = @field(instance, field.name);
-                const field_type = @TypeOf(value);
+    fn invalidateEntity(self: *ORM, comptime T: type, id: i64) void {
+        if (self.entity_cache) |cache| cache.invalidate(ModelSql(T).table_name, id);
+    }
 
-                // Check if field is optional and null
-                const is_optional_null = switch (@typeInfo(field_type)) {
-                    .optional => value == null,
-                    else => false,
-                };
+    fn invalidateAllEntities(self: *ORM) void {
+        if (self.entity_cache) |cache| cache.clear();
+    }
 
-                // Skip optional fields that are null (don't include in INSERT)
-                if (!is_optional_null) {
-                    try fields.append(self.allocator, field.name);
-                    const value_str = try self.valueToString(value);
-                    try values.append(self.allocator, value_str);
-                }
-            }
-        }
+    pub fn initWithPool(pool: *Database.ConnectionPool, allocator: std.mem.Allocator) !ORM {
+        _ = pool;
+        _ = allocator;
+        return error.NotImplemented;
+    }
 
-        defer {
-            for (values.items) |item| {
-                self.allocator.free(item);
-            }
-            values.deinit(self.allocator);
+    pub fn create(self: *ORM, comptime T: type, instance: T) !void {
+        if (self.write_queue) |queue| {
+            try self.checkQueryLock();
+            return queue.create(T, instance);
         }
 
+        const Sql = ModelSql(T);
+        const mask = Sql.insertMask(instance);
+
         // Validate that we have at least one field to insert
-        if (fields.items.len == 0) {
-            std.debug.print("[ORM Error] create() failed for table '{s}'\n", .{table_name});
+        if (mask.count() == 0) {
+            std.debug.print("[ORM Error] create() failed for table '{s}'\n", .{Sql.table_name});
             std.debug.print("  Reason: No fields to insert (all fields are null or id is 0)\n", .{});
             return error.InvalidArgument;
         }
 
-        const fields_str = try std.mem.join(self.allocator, ", ", fields.items);
-        defer self.allocator.free(fields_str);
+        const sql = try Sql.buildInsert(self.allocator, mask);
+        defer sql.deinit();
 
-        const values_str = try std.mem.join(self.allocator, ", ", values.items);
-        defer self.allocator.free(values_str);
+        try self.lockWrites();
+        defer self.unlockWrites();
 
-        const sql = try std.fmt.allocPrint(
-            self.allocator,
-            "INSERT INTO {s} ({s}) VALUES ({s})",
-            .{ table_name, fields_str, values_str },
-        );
-        defer self.allocator.free(sql);
+        var stmt = try self.db.prepare(sql.sql);
+        defer stmt.deinit();
 
-        self.db.execute(sql) catch |err| {
-            std.debug.print("[ORM Error] create() failed for table '{s}'\n", .{table_name});
-            std.debug.print("  SQL: {s}\n", .{sql});
-            std.debug.print("  Fields: ", .{});
-            for (fields.items, 0..) |field, i| {
-                if (i > 0) std.debug.print(", ", .{});
-                std.debug.print("{s}", .{field});
-            }
-            std.debug.print("\n", .{});
+        _ = try Sql.bindFields(&stmt, instance, mask, 1);
+        stmt.execute() catch |err| {
+            std.debug.print("[ORM Error] create() failed for table '{s}'\n", .{Sql.table_name});
+            std.debug.print("  SQL: {s}\n", .{sql.sql});
             std.debug.print("  Error: {}\n", .{err});
             return err;
         };
     }
 
+    /// Insert many records in a single transaction
+    /// Rows with the same set of non-null fields reuse one prepared statement,
+    /// and the whole batch commits once. If any row fails, none are inserted.
+    /// Uses a SAVEPOINT, so it can also be called inside an open transaction.
+    ///
+    /// Example:
+    /// ```zig
+    /// try orm.createMany(Todo, todos);
+    /// ```
+    pub fn createMany(self: *ORM, comptime T: type, items: []const T) !void {
+        if (self.write_queue) |queue| {
+            try self.checkQueryLock();
+            return queue.createMany(T, items);
+        }
+        try self.createManyInto(T, items, null);
+    }
+
+    /// Insert many records in a single transaction and return their generated IDs
+    /// IDs are returned in input order via `RETURNING rowid`. Caller owns the slice.
+    ///
+    /// Example:
+    /// ```zig
+    /// const ids = try orm.createManyReturningIds(Todo, todos);
+    /// defer allocator.free(ids);
+    /// ```
+    pub fn createManyReturningIds(self: *ORM, comptime T: type, items: []const T) ![]i64 {
+        const ids = try self.allocator.alloc(i64, items.len);
+        errdefer self.allocator.free(ids);
+
+        if (self.write_queue) |queue| {
+            try self.checkQueryLock();
+            try queue.createManyReturningIds(T, items, ids);
+            return ids;
+        }
+        try self.createManyInto(T, items, ids);
+        return ids;
+    }
+
+    fn createManyInto(self: *ORM, comptime T: type, items: []const T, ids: ?[]i64) !void {
+        const Sql = ModelSql(T);
+        if (items.len == 0) return;
+
+        try self.lockWrites();
+        defer self.unlockWrites();
+
+        try self.db.execute("SAVEPOINT e12_create_many");
+        errdefer {
+            self.db.execute("ROLLBACK TO e12_create_many") catch {};
+            self.db.execute("RELEASE e12_create_many") catch {};
+        }
+
+        var current_mask: ?Sql.FieldMask = null;
+        var current_sql: ?GeneratedSql = null;
+        var current_stmt: ?Statement = null;
+        defer {
+            if (current_stmt) |*stmt| stmt.deinit();
+            if (current_sql) |sql| sql.deinit();
+        }
+
+        for (items, 0..) |item, i| {
+            const mask = Sql.insertMask(item);
+            if (mask.count() == 0) {
+                std.debug.print("[ORM Error] createMany() failed for table '{s}'\n", .{Sql.table_name});
+                std.debug.print("  Reason: No fields to insert for row {d} (all fields are null or id is 0)\n", .{i});
+                return error.InvalidArgument;
+            }
+
+            // Only re-prepare when the set of bound columns changes
+            if (current_mask == null or !current_mask.?.eql(mask)) {
+                if (current_stmt) |*stmt| stmt.deinit();
+                current_stmt = null;
+                if (current_sql) |sql| sql.deinit();
+                current_sql = null;
+
+                current_sql = if (ids != null)
+                    try Sql.buildInsertReturningRowId(self.allocator, mask)
+                else
+                    try Sql.buildInsert(self.allocator, mask);
+                current_stmt = try self.db.prepare(current_sql.?.sql);
+                current_mask = mask;
+            }
+
+            const stmt = &current_stmt.?;
+            _ = try Sql.bindFields(stmt, item, mask, 1);
+
+            if (ids) |out| {
+                var result = stmt.query() catch |err| {
+                    std.debug.print("[ORM Error] createMany() failed for table '{s}' at row {d}\n", .{ Sql.table_name, i });
+                    std.debug.print("  SQL: {s}\n", .{current_sql.?.sql});
+                    std.debug.print("  Error: {}\n", .{err});
+                    return err;
+                };
+                defer result.deinit();
+                const row = result.nextRow() orelse return error.QueryFailed;
+                out[i] = row.getInt64(0);
+            } else {
+                stmt.execute() catch |err| {
+                    std.debug.print("[ORM Error] createMany() failed for table '{s}' at row {d}\n", .{ Sql.table_name, i });
+                    std.debug.print("  SQL: {s}\n", .{current_sql.?.sql});
+                    std.debug.print("  Error: {}\n", .{err});
+                    return err;
+                };
+            }
+        }
+
+        try self.db.execute("RELEASE e12_create_many");
+    }
+
     pub fn find(self: *ORM, comptime T: type, id: i64) !?T {
-        const table_name = try self.getTableName(T);
-        defer self.allocator.free(table_name);
+        return self.findAlloc(T, id, self.allocator);
+    }
 
-        // Generate SELECT with explicit column names in struct field order
-        var sql_buf = std.ArrayListUnmanaged(u8){};
-        defer sql_buf.deinit(self.allocator);
+    /// Find a record by ID, allocating its strings in `allocator`
+    /// Pass an arena (such as the request arena) to skip per-field frees.
+    ///
+    /// Example:
+    /// ```zig
+    /// const todo = try orm.findAlloc(Todo, id, request.arena.allocator());
+    /// ```
+    pub fn findAlloc(self: *ORM, comptime T: type, id: i64, allocator: std.mem.Allocator) !?T {
+        const Sql = ModelSql(T);
 
-        try sql_buf.writer(self.allocator).print("SELECT ", .{});
-        inline for (std.meta.fields(T), 0..) |field, i| {
-            if (i > 0) try sql_buf.writer(self.allocator).print(", ", .{});
-            try sql_buf.writer(self.allocator).print("{s}", .{field.name});
+        var cache_generation: ?u64 = null;
+        if (self.entity_cache) |cache| {
+            if (try cache.get(T, Sql.table_name, id, allocator)) |cached| return cached;
+            cache_generation = cache.generation(Sql.table_name);
         }
-        try sql_buf.writer(self.allocator).print(" FROM {s} WHERE id = {d}", .{ table_name, id });
 
-        const sql = try sql_buf.toOwnedSlice(self.allocator);
-        defer self.allocator.free(sql);
+        var db = try self.acquireReader();
+        defer self.releaseReader(db);
 
-        var result = self.db.query(sql) catch |err| {
-            std.debug.print("[ORM Error] find() failed for table '{s}'\n", .{table_name});
-            std.debug.print("  SQL: {s}\n", .{sql});
+        var stmt = try db.prepare(Sql.select_by_id);
+        defer stmt.deinit();
+        try stmt.bind(1, id);
+
+        var result = stmt.query() catch |err| {
+            std.debug.print("[ORM Error] find() failed for table '{s}'\n", .{Sql.table_name});
+            std.debug.print("  SQL: {s}\n", .{Sql.select_by_id});
             std.debug.print("  ID: {d}\n", .{id});
             std.debug.print("  Error: {}\n", .{err});
             return err;
         };
         defer result.deinit();
 
-        var list = try result.toArrayList(T);
-        defer {
-            for (list.items) |item| {
-                inline for (std.meta.fields(T)) |field| {
-                    const field_type = @TypeOf(@field(item, field.name));
-                    if (@typeInfo(field_type) == .pointer) {
-                        const ptr_info = @typeInfo(field_type).pointer;
-                        if (ptr_info.size == .slice and ptr_info.child == u8) {
-                            self.allocator.free(@field(item, field.name));
-                        }
-                    } else if (@typeInfo(field_type) == .optional) {
-                        const opt_info = @typeInfo(field_type).optional;
-                        if (@typeInfo(opt_info.child) == .pointer) {
-                            const ptr_info = @typeInfo(opt_info.child).pointer;
-                            if (ptr_info.size == .slice and ptr_info.child == u8) {
-                                if (@field(item, field.name)) |val| {
-                                    self.allocator.free(val);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            list.deinit(self.allocator);
-        }
-
-        if (list.items.len > 0) {
-            const item = list.items[0];
-            // Copy all fields dynamically, duplicating string slices
-            // Initialize struct - all fields will be set in the loop below
-            // Using undefined is safe here because all fields are explicitly initialized
-            var return_value: T = undefined;
-            inline for (std.meta.fields(T)) |field| {
-                const field_type = @TypeOf(@field(item, field.name));
-                if (@typeInfo(field_type) == .pointer) {
-                    const ptr_info = @typeInfo(field_type).pointer;
-                    if (ptr_info.size == .slice and ptr_info.child == u8) {
-                        @field(return_value, field.name) = try self.allocator.dupe(u8, @field(item, field.name));
-                    } else {
-                        @field(return_value, field.name) = @field(item, field.name);
-                    }
-                } else if (@typeInfo(field_type) == .optional) {
-                    const opt_info = @typeInfo(field_type).optional;
-                    if (@typeInfo(opt_info.child) == .pointer) {
-                        const ptr_info = @typeInfo(opt_info.child).pointer;
-                        if (ptr_info.size == .slice and ptr_info.child == u8) {
-                            if (@field(item, field.name)) |val| {
-                                @field(return_value, field.name) = try self.allocator.dupe(u8, val);
-                            } else {
-                                @field(return_value, field.name) = null;
-                            }
-                        } else {
-                            @field(return_value, field.name) = @field(item, field.name);
-                        }
-                    } else {
-                        @field(return_value, field.name) = @field(item, field.name);
-                    }
-                } else {
-                    @field(return_value, field.name) = @field(item, field.name);
-                }
-            }
-            return return_value;
+        // Decode the single row straight into an owned T; no intermediate list
+        var it = try result.iterator(T);
+        const found = try it.nextAlloc(allocator);
+        if (found) |row| {
+            if (self.entity_cache) |cache| cache.put(T, Sql.table_name, id, row, cache_generation);
         }
-
-        return null;
+        return found;
     }
 
     /// Find a record by ID with automatic memory management
@@ -334,27 +540,40 @@ pub const ORM = struct {
     /// }
     /// ```
     pub fn findManaged(self: *ORM, comptime T: type, id: i64) !?Result(T) {
-        const item = try self.find(T, id);
-        if (item == null) return null;
+        var arena = std.heap.ArenaAllocator.init(self.allocator);
+        errdefer arena.deinit();
+
+        const item = try self.findAlloc(T, id, arena.allocator()) orelse {
+            arena.deinit();
+            return null;
+        };
 
         // Wrap single item in Result
         var items = std.ArrayListUnmanaged(T){};
-        try items.append(self.allocator, item.?);
-        return Result(T).init(items, self.allocator);
+        try items.append(arena.allocator(), item);
+        return Result(T).initArena(items, arena);
     }
 
     pub fn findAll(self: *ORM, comptime T: type) !std.ArrayListUnmanaged(T) {
-        const table_name = try self.getTableName(T);
-        defer self.allocator.free(table_name);
+        return self.findAllAlloc(T, self.allocator);
+    }
+
+    /// Find all records, allocating the list and its strings in `allocator`
+    /// Pass an arena (such as the request arena) to skip per-field frees.
+    pub fn findAllAlloc(self: *ORM, comptime T: type, allocator: std.mem.Allocator) !std.ArrayListUnmanaged(T) {
+        const table_name = ModelSql(T).table_name;
+
+        var db = try self.acquireReader();
+        defer self.releaseReader(db);
 
         // Check if table exists first
-        const table_exists = try Schema.tableExists(&self.db, table_name);
+        const table_exists = try Schema.tableExists(&db, table_name);
         if (!table_exists) {
             // Table doesn't exist - let the query fail naturally
         } else {
             // Check for column mismatch BEFORE querying
             // Get all columns from the table schema
-            const table_columns = try Schema.getColumns(&self.db, table_name, self.allocator);
+            const table_columns = try Schema.getColumns(&db, table_name, self.allocator);
             defer {
                 for (table_columns) |col| {
                     self.allocator.free(col.name);
@@ -387,22 +606,14 @@ pub const ORM = struct {
             }
         }
 
-        // Generate SELECT with explicit column names in struct field order
+        // SELECT with explicit column names in struct field order, generated at comptime
         // This ensures column order matches struct field order and improves clarity
-        var sql_buf = std.ArrayListUnmanaged(u8){};
-        defer sql_buf.deinit(self.allocator);
-
-        try sql_buf.writer(self.allocator).print("SELECT ", .{});
-        inline for (std.meta.fields(T), 0..) |field, i| {
-            if (i > 0) try sql_buf.writer(self.allocator).print(", ", .{});
-            try sql_buf.writer(self.allocator).print("{s}", .{field.name});
-        }
-        try sql_buf.writer(self.allocator).print(" FROM {s}", .{table_name});
+        const sql = ModelSql(T).select_all;
 
-        const sql = try sql_buf.toOwnedSlice(self.allocator);
-        defer self.allocator.free(sql);
+        var stmt = try db.prepare(sql);
+        defer stmt.deinit();
 
-        var query_result = self.db.query(sql) catch |err| {
+        var query_result = stmt.query() catch |err| {
             std.debug.print("[ORM Error] findAll() failed for table '{s}'\n", .{table_name});
             std.debug.print("  SQL: {s}\n", .{sql});
             std.debug.print("  Error: {}\n", .{err});
@@ -410,7 +621,7 @@ pub const ORM = struct {
         };
         defer query_result.deinit();
 
-        const result = query_result.toArrayList(T) catch |err| {
+        const result = query_result.toArrayListAlloc(T, allocator) catch |err| {
             // Wrap deserialization errors with context
             const field_count = std.meta.fields(T).len;
             const column_count = query_result.columnCount();
@@ -439,22 +650,27 @@ pub const ORM = struct {
     /// }
     /// ```
     pub fn findAllManaged(self: *ORM, comptime T: type) !Result(T) {
-        const items = try self.findAll(T);
-        return Result(T).init(items, self.allocator);
+        var arena = std.heap.ArenaAllocator.init(self.allocator);
+        errdefer arena.deinit();
+
+        const items = try self.findAllAlloc(T, arena.allocator());
+        return Result(T).initArena(items, arena);
     }
 
     pub fn where(self: *ORM, comptime T: type, condition: []const u8) !std.ArrayListUnmanaged(T) {
-        const table_name = try self.getTableName(T);
-        defer self.allocator.free(table_name);
+        const table_name = ModelSql(T).table_name;
+
+        var db = try self.acquireReader();
+        defer self.releaseReader(db);
 
         // Check if table exists first
-        const table_exists = try Schema.tableExists(&self.db, table_name);
+        const table_exists = try Schema.tableExists(&db, table_name);
         if (!table_exists) {
             // Table doesn't exist - let the query fail naturally
         } else {
             // Check for column mismatch BEFORE querying
             // Get all columns from the table schema
-            const table_columns = try Schema.getColumns(&self.db, table_name, self.allocator);
+            const table_columns = try Schema.getColumns(&db, table_name, self.allocator);
             defer {
                 for (table_columns) |col| {
                     self.allocator.free(col.name);
@@ -488,20 +704,10 @@ pub const ORM = struct {
         }
 
         // Generate SELECT with explicit column names in struct field order
-        var sql_buf = std.ArrayListUnmanaged(u8){};
-        defer sql_buf.deinit(self.allocator);
-
-        try sql_buf.writer(self.allocator).print("SELECT ", .{});
-        inline for (std.meta.fields(T), 0..) |field, i| {
-            if (i > 0) try sql_buf.writer(self.allocator).print(", ", .{});
-            try sql_buf.writer(self.allocator).print("{s}", .{field.name});
-        }
-        try sql_buf.writer(self.allocator).print(" FROM {s} WHERE {s}", .{ table_name, condition });
-
-        const sql = try sql_buf.toOwnedSlice(self.allocator);
+        const sql = try std.fmt.allocPrint(self.allocator, "{s} WHERE {s}", .{ ModelSql(T).select_all, condition });
         defer self.allocator.free(sql);
 
-        var query_result = self.db.query(sql) catch |err| {
+        var query_result = db.query(sql) catch |err| {
             std.debug.print("[ORM Error] where() failed for table '{s}'\n", .{table_name});
             std.debug.print("  SQL: {s}\n", .{sql});
             std.debug.print("  Condition: {s}\n", .{condition});
@@ -527,165 +733,962 @@ pub const ORM = struct {
         return result;
     }
 
-    pub fn update(self: *ORM, comptime T: type, instance: T) !void {
-        const table_name = try self.getTableName(T);
-        defer self.allocator.free(table_name);
-        var updates = std.ArrayListUnmanaged([]const u8){};
-        defer {
-            for (updates.items) |item| {
-                self.allocator.free(item);
-            }
-            updates.deinit(self.allocator);
-        }
-
-        var id_value: i64 = 0;
-
-        inline for (std.meta.fields(T)) |field| {
-            if (comptime std.mem.eql(u8, field.name, "id")) {
-                id_value = @field(instance, field.name);
-                continue;
-            }
-
-            const value = @field(instance, field.name);
-            const field_type = @TypeOf(value);
+    /// Find records matching a compile-time WHERE clause with bound parameters
+    /// Values never touch the SQL text, so no escaping is needed.
+    ///
+    /// Example:
+    /// ```zig
+    /// var users = try orm.whereBind(User, "age >= ? AND name = ?", .{ 18, name });
+    /// ```
+    pub fn whereBind(self: *ORM, comptime T: type, comptime condition: []const u8, args: anytype) !std.ArrayListUnmanaged(T) {
+        const Sql = ModelSql(T);
+        const sql = comptime Sql.selectWhere(condition);
 
-            // Check if field is optional and null
-            const is_optional_null = switch (@typeInfo(field_type)) {
-                .optional => value == null,
-                else => false,
-            };
+        var db = try self.acquireReader();
+        defer self.releaseReader(db);
 
-            // Skip optional fields that are null (don't update them)
-            if (!is_optional_null) {
-                const value_str = try self.valueToString(value);
-                defer self.allocator.free(value_str);
-                const update_str = try std.fmt.allocPrint(
-                    self.allocator,
-                    "{s} = {s}",
-                    .{ field.name, value_str },
-                );
-                try updates.append(self.allocator, update_str);
-            }
-        }
+        var stmt = try db.prepare(sql);
+        defer stmt.deinit();
+        try stmt.bindAll(args);
 
-        // Validate that we have at least one field to update
-        if (updates.items.len == 0) {
-            std.debug.print("[ORM Error] update() failed for table '{s}'\n", .{table_name});
-            std.debug.print("  Reason: No fields to update (all fields are null)\n", .{});
-            std.debug.print("  ID: {d}\n", .{id_value});
-            return error.InvalidArgument;
-        }
+        var query_result = stmt.query() catch |err| {
+            std.debug.print("[ORM Error] whereBind() failed for table '{s}'\n", .{Sql.table_name});
+            std.debug.print("  SQL: {s}\n", .{sql});
+            std.debug.print("  Error: {}\n", .{err});
+            return err;
+        };
+        defer query_result.deinit();
 
-        // Validate that id is valid
-        if (id_value == 0) {
-            std.debug.print("[ORM Error] update() failed for table '{s}'\n", .{table_name});
-            std.debug.print("  Reason: Invalid ID (id must be non-zero)\n", .{});
-            return error.InvalidArgument;
-        }
+        return query_result.toArrayList(T);
+    }
 
-        const updates_str = try std.mem.join(self.allocator, ", ", updates.items);
-        defer self.allocator.free(updates_str);
+    /// Run a `CompiledQuery`, allocating the list and its strings in `allocator`
+    /// The SQL is a comptime constant, so after the first call the statement
+    /// comes straight from the statement cache and only `params` are bound.
+    ///
+    /// Example:
+    /// ```zig
+    /// const ByUser = CompiledQuery(Todo, .{ .where = eq("user_id"), .limit = true });
+    /// var todos = try orm.fetch(ByUser, .{ user_id, 50 }, arena);
+    /// ```
+    pub fn fetch(self: *ORM, comptime Q: type, params: Q.Params, allocator: std.mem.Allocator) !std.ArrayListUnmanaged(Q.Model) {
+        var db = try self.acquireReader();
+        defer self.releaseReader(db);
 
-        const sql = try std.fmt.allocPrint(
-            self.allocator,
-            "UPDATE {s} SET {s} WHERE id = {d}",
-            .{ table_name, updates_str, id_value },
-        );
-        defer self.allocator.free(sql);
+        var stmt = try db.prepare(Q.sql);
+        defer stmt.deinit();
+        try Q.bind(&stmt, params);
 
-        self.db.execute(sql) catch |err| {
-            std.debug.print("[ORM Error] update() failed for table '{s}'\n", .{table_name});
-            std.debug.print("  SQL: {s}\n", .{sql});
-            std.debug.print("  ID: {d}\n", .{id_value});
-            std.debug.print("  Fields updated: ", .{});
-            for (updates.items, 0..) |update_str, i| {
-                if (i > 0) std.debug.print(", ", .{});
-                std.debug.print("{s}", .{update_str});
-            }
-            std.debug.print("\n", .{});
+        var query_result = stmt.query() catch |err| {
+            std.debug.print("[ORM Error] fetch() failed for table '{s}'\n", .{Q.table_name});
+            std.debug.print("  SQL: {s}\n", .{Q.sql});
             std.debug.print("  Error: {}\n", .{err});
             return err;
         };
+        defer query_result.deinit();
+
+        return query_result.toArrayListAlloc(Q.Model, allocator);
     }
 
-    pub fn delete(self: *ORM, comptime T: type, id: i64) !void {
-        const table_name = try self.getTableName(T);
-        defer self.allocator.free(table_name);
-        const sql = try std.fmt.allocPrint(
-            self.allocator,
-            "DELETE FROM {s} WHERE id = {d}",
-            .{ table_name, id },
-        );
-        defer self.allocator.free(sql);
+    /// First row of a `CompiledQuery`, or null when nothing matches
+    pub fn fetchFirst(self: *ORM, comptime Q: type, params: Q.Params, allocator: std.mem.Allocator) !?Q.Model {
+        var db = try self.acquireReader();
+        defer self.releaseReader(db);
 
-        try self.db.execute(sql);
-    }
+        var stmt = try db.prepare(Q.sql);
+        defer stmt.deinit();
+        try Q.bind(&stmt, params);
 
-    pub fn query(self: *ORM, sql: []const u8) !QueryResult {
-        return try self.db.query(sql);
-    }
+        var query_result = stmt.query() catch |err| {
+            std.debug.print("[ORM Error] fetchFirst() failed for table '{s}'\n", .{Q.table_name});
+            std.debug.print("  SQL: {s}\n", .{Q.sql});
+            std.debug.print("  Error: {}\n", .{err});
+            return err;
+        };
+        defer query_result.deinit();
 
-    pub fn execute(self: *ORM, sql: []const u8) !void {
-        try self.db.execute(sql);
+        var it = try query_result.iterator(Q.Model);
+        return it.nextAlloc(allocator);
     }
 
-    pub fn transaction(self: *ORM, comptime T: type, callback: fn (*database.Transaction) anyerror!T) !T {
-        var trans = try self.db.beginTransaction();
-        defer trans.deinit();
+    /// Number of rows a `CompiledQuery` filter matches, ignoring ORDER BY and paging
+    pub fn fetchCount(self: *ORM, comptime Q: type, params: Q.CountParams) !i64 {
+        var db = try self.acquireReader();
+        defer self.releaseReader(db);
 
-        const result = callback(&trans) catch |err| {
-            trans.rollback() catch {};
+        var stmt = try db.prepare(Q.count_sql);
+        defer stmt.deinit();
+        try Q.bindCount(&stmt, params);
+
+        var query_result = stmt.query() catch |err| {
+            std.debug.print("[ORM Error] fetchCount() failed for table '{s}'\n", .{Q.table_name});
+            std.debug.print("  SQL: {s}\n", .{Q.count_sql});
+            std.debug.print("  Error: {}\n", .{err});
             return err;
         };
+        defer query_result.deinit();
 
-        try trans.commit();
-        return result;
-    }
-
-    pub fn runMigrations(self: *ORM, migrations: []const Migration) !void {
-        var runner = MigrationRunner.init(&self.db, self.allocator);
-        try runner.runMigrations(migrations);
+        const row = query_result.nextRow() orelse return error.NoResult;
+        return row.getInt64(0);
     }
 
-    /// Run migrations from a MigrationRegistry
+    /// Stream the rows of `sql` to `writer` as CSV; returns the number of data rows
+    /// Rows go from the SQLite cursor through one reusable row buffer to the
+    /// writer, so memory use does not grow with the table. `sql` may come from
+    /// `QueryBuilder.build()`. Use `CsvOptions.tsv` for tab-separated output.
     ///
     /// Example:
     /// ```zig
-    /// var registry = MigrationRegistry.init(allocator);
-    /// defer registry.deinit();
-    /// try registry.add(Migration.init(1, "create_todos", "CREATE TABLE...", "DROP TABLE..."));
-    /// try orm.runMigrationsFromRegistry(&registry);
+    /// var file = try std.fs.cwd().createFile("todos.csv", .{});
+    /// defer file.close();
+    /// _ = try orm.exportCsv("SELECT * FROM todos", file.deprecatedWriter(), .{});
     /// ```
-    pub fn runMigrationsFromRegistry(self: *ORM, registry: *MigrationRegistry) !void {
-        const migrations = registry.getMigrations();
-        try self.runMigrations(migrations);
-    }
+    pub fn exportCsv(self: *ORM, sql: []const u8, writer: anytype, options: CsvOptions) !usize {
+        var db = try self.acquireReader();
+        defer self.releaseReader(db);
 
-    pub fn getMigrationVersion(self: *ORM) !?u32 {
-        var runner = MigrationRunner.init(&self.db, self.allocator);
-        return try runner.getCurrentVersion();
+        var query_result = db.query(sql) catch |err| {
+            std.debug.print("[ORM Error] exportCsv() failed\n", .{});
+            std.debug.print("  SQL: {s}\n", .{sql});
+            std.debug.print("  Error: {}\n", .{err});
+            return err;
+        };
+        defer query_result.deinit();
+
+        var csv = CsvWriter.init(self.allocator, options);
+        defer csv.deinit();
+        return csv.writeResult(&query_result, writer);
     }
 
-    pub fn migrate(self: *ORM, migrations: []const Migration) !void {
-        try self.runMigrations(migrations);
+    /// `exportCsv` for a `CompiledQuery`, reusing its cached prepared statement
+    pub fn exportCsvQuery(self: *ORM, comptime Q: type, params: Q.Params, writer: anytype, options: CsvOptions) !usize {
+        var db = try self.acquireReader();
+        defer self.releaseReader(db);
+
+        var stmt = try db.prepare(Q.sql);
+        defer stmt.deinit();
+        try Q.bind(&stmt, params);
+
+        var query_result = stmt.query() catch |err| {
+            std.debug.print("[ORM Error] exportCsvQuery() failed for table '{s}'\n", .{Q.table_name});
+            std.debug.print("  SQL: {s}\n", .{Q.sql});
+            std.debug.print("  Error: {}\n", .{err});
+            return err;
+        };
+        defer query_result.deinit();
+
+        var csv = CsvWriter.init(self.allocator, options);
+        defer csv.deinit();
+        return csv.writeResult(&query_result, writer);
     }
 
-    /// Escape a string for safe use in SQL LIKE patterns
-    /// Convenience wrapper around SqlEscape.escapeLikePattern
+    /// Run `sql` and have SQLite serialize its rows as a JSON array of T
+    /// The query is wrapped in `SELECT json_group_array(json_object(...))` built
+    /// at compile time from T's fields, so rows are never decoded into structs
+    /// and the text is ready to send. The output matches `Json.serialize`
+    /// except for floats, which use SQLite's formatting. `sql` must select
+    /// every field of T. Element order comes from `options.order_by`.
     ///
     /// Example:
     /// ```zig
-    /// const safe_pattern = try orm.escapeLike("test%_data", allocator);
-    /// defer allocator.free(safe_pattern);
-    /// const sql = try std.fmt.allocPrint(allocator, "SELECT * FROM Todo WHERE title LIKE '{s}'", .{safe_pattern});
+    /// const page = try orm.queryJsonArray(Todo, "SELECT * FROM todos ORDER BY id LIMIT 20", .{ .order_by = "id" }, arena);
+    /// return Response.json(page.json);
     /// ```
-    pub fn escapeLike(_: *ORM, pattern: []const u8, allocator: std.mem.Allocator) ![]const u8 {
-        return SqlEscape.escapeLikePattern(allocator, pattern);
-    }
+    pub fn queryJsonArray(self: *ORM, comptime T: type, sql: []const u8, options: JsonArrayOptions, allocator: std.mem.Allocator) !JsonArray {
+        const Sql = ModelSql(T);
+        const quoted_total: ?[]const u8 = if (options.total_column) |column| try SqlEscape.escapeIdentifier(self.allocator, column) else null;
+        defer if (quoted_total) |column| self.allocator.free(column);
 
-    pub fn close(self: *ORM) void {
-        self.db.close();
-    }
+        const json_sql = try Sql.buildJsonArray(self.allocator, sql, options.order_by, quoted_total);
+        defer self.allocator.free(json_sql);
+
+        var db = try self.acquireReader();
+        defer self.releaseReader(db);
+
+        var result = db.query(json_sql) catch |err| {
+            std.debug.print("[ORM Error] queryJsonArray() failed for table '{s}'\n", .{Sql.table_name});
+            std.debug.print("  SQL: {s}\n", .{json_sql});
+            std.debug.print("  Error: {}\n", .{err});
+            return err;
+        };
+        defer result.deinit();
+
+        // An aggregate always returns exactly one row
+        const row = (try result.step()) orelse return error.QueryFailed;
+        return .{
+            .json = try allocator.dupe(u8, row.getText(0) orelse "[]"),
+            .total = if (row.isNull(1)) null else row.getInt64(1),
+            .rows = @intCast(row.getInt64(2)),
+        };
+    }
+
+    pub fn update(self: *ORM, comptime T: type, instance: T) !void {
+        if (self.write_queue) |queue| {
+            try self.checkQueryLock();
+            try queue.update(T, instance);
+            self.invalidateEntity(T, @field(instance, "id"));
+            return;
+        }
+
+        const Sql = ModelSql(T);
+        const mask = Sql.updateMask(instance);
+        const id_value: i64 = @field(instance, "id");
+
+        // Validate that we have at least one field to update
+        if (mask.count() == 0) {
+            std.debug.print("[ORM Error] update() failed for table '{s}'\n", .{Sql.table_name});
+            std.debug.print("  Reason: No fields to update (all fields are null)\n", .{});
+            std.debug.print("  ID: {d}\n", .{id_value});
+            return error.InvalidArgument;
+        }
+
+        // Validate that id is valid
+        if (id_value == 0) {
+            std.debug.print("[ORM Error] update() failed for table '{s}'\n", .{Sql.table_name});
+            std.debug.print("  Reason: Invalid ID (id must be non-zero)\n", .{});
+            return error.InvalidArgument;
+        }
+
+        const sql = try Sql.buildUpdate(self.allocator, mask);
+        defer sql.deinit();
+
+        try self.lockWrites();
+        defer self.unlockWrites();
+
+        var stmt = try self.db.prepare(sql.sql);
+        defer stmt.deinit();
+
+        const id_index = try Sql.bindFields(&stmt, instance, mask, 1);
+        try stmt.bind(id_index, id_value);
+
+        stmt.execute() catch |err| {
+            std.debug.print("[ORM Error] update() failed for table '{s}'\n", .{Sql.table_name});
+            std.debug.print("  SQL: {s}\n", .{sql.sql});
+            std.debug.print("  ID: {d}\n", .{id_value});
+            std.debug.print("  Error: {}\n", .{err});
+            return err;
+        };
+        self.invalidateEntity(T, id_value);
+    }
+
+    /// Update only the masked fields of a record (UPDATE ... SET <masked> WHERE id = ?)
+    /// Single-column updates use a comptime SQL constant; every mask maps to one
+    /// SQL text, so its prepared statement is reused from the statement cache.
+    ///
+    /// Example:
+    /// ```zig
+    /// var mask = ModelSqlType(Todo).FieldMask.initEmpty();
+    /// mask.set(std.meta.fieldIndex(Todo, "completed").?);
+    /// try orm.updateFields(Todo, todo, mask);
+    /// ```
+    pub fn updateFields(self: *ORM, comptime T: type, instance: T, mask: ModelSql(T).FieldMask) !void {
+        const Sql = ModelSql(T);
+        const id_value: i64 = @field(instance, "id");
+        const fields_mask = mask.intersectWith(Sql.non_id_mask);
+
+        if (fields_mask.count() == 0) {
+            std.debug.print("[ORM Error] updateFields() failed for table '{s}'\n", .{Sql.table_name});
+            std.debug.print("  Reason: No fields to update (mask is empty)\n", .{});
+            std.debug.print("  ID: {d}\n", .{id_value});
+            return error.InvalidArgument;
+        }
+        if (id_value == 0) {
+            std.debug.print("[ORM Error] updateFields() failed for table '{s}'\n", .{Sql.table_name});
+            std.debug.print("  Reason: Invalid ID (id must be non-zero)\n", .{});
+            return error.InvalidArgument;
+        }
+
+        if (self.write_queue) |queue| {
+            try self.checkQueryLock();
+            try queue.updateFields(T, instance, fields_mask);
+            self.invalidateEntity(T, id_value);
+            return;
+        }
+
+        const sql = try Sql.buildUpdate(self.allocator, fields_mask);
+        defer sql.deinit();
+
+        try self.lockWrites();
+        defer self.unlockWrites();
+
+        var stmt = try self.db.prepare(sql.sql);
+        defer stmt.deinit();
+
+        const id_index = try Sql.bindFields(&stmt, instance, fields_mask, 1);
+        try stmt.bind(id_index, id_value);
+
+        stmt.execute() catch |err| {
+            std.debug.print("[ORM Error] updateFields() failed for table '{s}'\n", .{Sql.table_name});
+            std.debug.print("  SQL: {s}\n", .{sql.sql});
+            std.debug.print("  ID: {d}\n", .{id_value});
+            std.debug.print("  Error: {}\n", .{err});
+            return err;
+        };
+        self.invalidateEntity(T, id_value);
+    }
+
+    /// Find a record by ID and start tracking changes to it
+    /// Strings are allocated in `allocator`; pass the request arena in handlers.
+    pub fn findTracked(self: *ORM, comptime T: type, id: i64, allocator: std.mem.Allocator) !?Tracked(T) {
+        const found = try self.findAlloc(T, id, allocator);
+        return if (found) |value| Tracked(T).init(value) else null;
+    }
+
+    /// Write the fields of a tracked record that changed since it was loaded
+    /// Returns false without touching the database when nothing changed.
+    ///
+    /// Example:
+    /// ```zig
+    /// var todo = (try orm.findTracked(Todo, id, arena)).?;
+    /// todo.value.completed = true;
+    /// _ = try orm.saveTracked(Todo, &todo); // UPDATE Todo SET completed = ? WHERE id = ?
+    /// ```
+    pub fn saveTracked(self: *ORM, comptime T: type, record: *Tracked(T)) !bool {
+        const mask = record.dirtyMask();
+        if (mask.count() == 0) return false;
+        try self.updateFields(T, record.value, mask);
+        record.markClean();
+        return true;
+    }
+
+    pub fn delete(self: *ORM, comptime T: type, id: i64) !void {
+        if (self.write_queue) |queue| {
+            try self.checkQueryLock();
+            try queue.delete(T, id);
+            self.invalidateEntity(T, id);
+            return;
+        }
+
+        try self.lockWrites();
+        defer self.unlockWrites();
+
+        var stmt = try self.db.prepare(ModelSql(T).delete_by_id);
+        defer stmt.deinit();
+        try stmt.bind(1, id);
+        try stmt.execute();
+        self.invalidateEntity(T, id);
+    }
+
+    /// Run a read-only SQL query and return its rows
+    /// In WAL mode the rows come from a pooled reader connection that stays
+    /// leased until the result's `deinit`; otherwise the result holds the ORM's
+    /// write lock until `deinit`, so deinit it before writing. With a write
+    /// queue, writes and further reads on the same thread before then fail with
+    /// error.WouldDeadlock instead of waiting on that lock forever. Use
+    /// `execute` or `transaction` for writes.
+    pub fn query(self: *ORM, sql: []const u8) !QueryResult {
+        var db = try self.acquireReader();
+        var result = db.query(sql) catch |err| {
+            self.releaseReader(db);
+            return err;
+        };
+        if (self.wal == null and self.write_queue != null) {
+            self.query_lock_holder.store(std.Thread.getCurrentId(), .release);
+        }
+        result.release = .{ .context = self, .callback = releaseQueryReader, .db = db };
+        return result;
+    }
+
+    fn releaseQueryReader(context: *anyopaque, db: Database) void {
+        const self: *ORM = @ptrCast(@alignCast(context));
+        self.query_lock_holder.store(0, .release);
+        self.releaseReader(db);
+    }
+
+    pub fn execute(self: *ORM, sql: []const u8) !void {
+        try self.lockWrites();
+        defer self.unlockWrites();
+        // Unknown effect on cached rows; drop them even if the statement fails
+        defer self.invalidateAllEntities();
+        try self.db.execute(sql);
+    }
+
+    /// Create `index` if it does not exist, then check the stored definition
+    /// An index with the same name but other columns (for example a stale
+    /// hand-written migration) fails with `error.IndexMismatch` rather than
+    /// being silently accepted.
+    ///
+    /// Example:
+    /// ```zig
+    /// try orm.ensureIndex(.{ .table = "todos", .columns = &.{ "user_id", "created_at" } });
+    /// ```
+    pub fn ensureIndex(self: *ORM, index: IndexDef) !void {
+        const create_sql = try index.createSql(self.allocator);
+        defer self.allocator.free(create_sql);
+        const index_name = try index.name(self.allocator);
+        defer self.allocator.free(index_name);
+
+        try self.lockWrites();
+        defer self.unlockWrites();
+
+        self.db.execute(create_sql) catch |err| {
+            std.debug.print("[ORM Error] Failed to create index '{s}'\n", .{index_name});
+            std.debug.print("  SQL: {s}\n", .{create_sql});
+            std.debug.print("  Error: {}\n", .{err});
+            return err;
+        };
+
+        if (!try Schema.indexMatches(&self.db, index_name, index.columns)) {
+            std.debug.print("[ORM Error] Index '{s}' exists with different columns\n", .{index_name});
+            std.debug.print("  Table: {s}\n", .{index.table});
+            return error.IndexMismatch;
+        }
+    }
+
+    /// Whether an index on `table` already starts with `columns`
+    /// See Schema.hasIndexPrefix.
+    pub fn hasIndexPrefix(self: *ORM, table: []const u8, columns: []const []const u8) !bool {
+        var db = try self.acquireReader();
+        defer self.releaseReader(db);
+        return Schema.hasIndexPrefix(&db, table, columns);
+    }
+
+    /// Ensure every index declared in `T.indexes` exists, plus the full-text
+    /// index when `T.search_fields` is declared (see syncSearchIndex)
+    /// See `model.modelIndexes` for the declaration format.
+    ///
+    /// Example:
+    /// ```zig
+    /// const Todo = struct {
+    ///     id: i64,
+    ///     user_id: i64,
+    ///     created_at: i64,
+    ///     pub const indexes = .{ .{ "user_id", "created_at" } };
+    /// };
+    /// try orm.syncIndexes(Todo);
+    /// ```
+    pub fn syncIndexes(self: *ORM, comptime T: type) !void {
+        for (model.modelIndexes(T)) |index| {
+            try self.ensureIndex(index);
+        }
+        try self.syncSearchIndex(T);
+    }
+
+    /// Create the FTS5 table and sync triggers for `T.search_fields`
+    /// The first time the index is created, existing rows are indexed in one
+    /// pass; afterwards the triggers keep it current on every insert, update
+    /// and delete. Does nothing for models without `search_fields`.
+    ///
+    /// Example:
+    /// ```zig
+    /// const Todo = struct {
+    ///     id: i64,
+    ///     title: []const u8,
+    ///     pub const search_fields = .{"title"};
+    /// };
+    /// try orm.syncSearchIndex(Todo); // todos_fts + triggers
+    /// ```
+    pub fn syncSearchIndex(self: *ORM, comptime T: type) !void {
+        const def = comptime search_mod.modelSearch(T) orelse return;
+
+        const fts_table = try def.ftsTable(self.allocator);
+        defer self.allocator.free(fts_table);
+        const create_sql = try def.createSql(self.allocator);
+        defer self.allocator.free(create_sql);
+
+        try self.lockWrites();
+        defer self.unlockWrites();
+
+        const existed = try Schema.tableExists(&self.db, fts_table);
+        self.db.execute(create_sql) catch |err| {
+            std.debug.print("[ORM Error] Failed to create search index '{s}'\n", .{fts_table});
+            std.debug.print("  SQL: {s}\n", .{create_sql});
+            std.debug.print("  Error: {}\n", .{err});
+            return err;
+        };
+        if (!existed) {
+            const rebuild_sql = try def.rebuildSql(self.allocator);
+            defer self.allocator.free(rebuild_sql);
+            try self.db.execute(rebuild_sql);
+        }
+    }
+
+    pub fn search(self: *ORM, comptime T: type, query_text: []const u8, options: SearchOptions) !std.ArrayListUnmanaged(SearchHit(T)) {
+        return self.searchAlloc(T, query_text, options, self.allocator);
+    }
+
+    /// Full-text search over `T.search_fields`, best matches first
+    /// Runs against the FTS5 index created by syncSearchIndex, so cost grows
+    /// with the number of matches rather than the size of the table. Each hit
+    /// carries its bm25 rank and a highlighted snippet. Hits, their strings
+    /// and the list are allocated in `allocator` (use an arena).
+    ///
+    /// Example:
+    /// ```zig
+    /// const hits = try orm.searchAlloc(Todo, "groceries", .{
+    ///     .limit = 10,
+    ///     .filters = &.{.{ .column = "user_id", .value = .{ .int = user.id } }},
+    /// }, request.arena.allocator());
+    /// for (hits.items) |hit| std.debug.print("{s}\n", .{hit.snippet});
+    /// ```
+    pub fn searchAlloc(
+        self: *ORM,
+        comptime T: type,
+        query_text: []const u8,
+        options: SearchOptions,
+        allocator: std.mem.Allocator,
+    ) !std.ArrayListUnmanaged(SearchHit(T)) {
+        const def = comptime search_mod.modelSearch(T) orelse
+            @compileError(@typeName(T) ++ " has no search_fields declaration");
+
+        const snippet_column: usize = if (options.snippet_column) |column| def.columnIndex(column) orelse {
+            std.debug.print("[ORM Error] search() snippet column '{s}' is not a search field of '{s}'\n", .{ column, def.table });
+            return error.InvalidFieldName;
+        } else 0;
+
+        for (options.filters) |filter| {
+            var is_field = false;
+            inline for (std.meta.fields(T)) |field| {
+                if (std.mem.eql(u8, field.name, filter.column)) is_field = true;
+            }
+            if (!is_field) {
+                std.debug.print("[ORM Error] search() filter column '{s}' is not a field of '{s}'\n", .{ filter.column, def.table });
+                return error.InvalidFieldName;
+            }
+        }
+
+        const match = if (options.raw_query)
+            try self.allocator.dupe(u8, query_text)
+        else
+            try search_mod.matchQuery(self.allocator, query_text);
+        defer self.allocator.free(match);
+        if (match.len == 0) return .{};
+
+        var sql = std.ArrayListUnmanaged(u8){};
+        defer sql.deinit(self.allocator);
+        const w = sql.writer(self.allocator);
+        try w.print(
+            "SELECT t.*, {s}_fts.rank AS e12_rank, snippet({s}_fts, {d}, ?, ?, '...', {d}) AS e12_snippet " ++
+                "FROM {s}_fts JOIN {s} t ON t.id = {s}_fts.rowid WHERE {s}_fts MATCH ?",
+            .{ def.table, def.table, snippet_column, @min(@max(options.snippet_tokens, 1), 64), def.table, def.table, def.table, def.table },
+        );
+        for (options.filters) |filter| try w.print(" AND t.{s} = ?", .{filter.column});
+        try w.print(" ORDER BY {s}_fts.rank LIMIT ? OFFSET ?", .{def.table});
+        const sql_z = try sql.toOwnedSliceSentinel(self.allocator, 0);
+        defer self.allocator.free(sql_z);
+
+        var db = try self.acquireReader();
+        defer self.releaseReader(db);
+
+        var stmt = try db.prepare(sql_z);
+        defer stmt.deinit();
+
+        try stmt.bindAll(.{ options.highlight_open, options.highlight_close, match });
+        var index: i32 = 4;
+        for (options.filters) |filter| {
+            switch (filter.value) {
+                .int => |value| try stmt.bind(index, value),
+                .text => |value| try stmt.bind(index, value),
+            }
+            index += 1;
+        }
+        try stmt.bind(index, options.limit);
+        try stmt.bind(index + 1, options.offset);
+
+        var result = stmt.query() catch |err| {
+            std.debug.print("[ORM Error] search() failed for table '{s}'\n", .{def.table});
+            std.debug.print("  SQL: {s}\n", .{sql_z});
+            std.debug.print("  MATCH: {s}\n", .{match});
+            std.debug.print("  Error: {}\n", .{err});
+            return err;
+        };
+        defer result.deinit();
+
+        return result.toSearchHits(T, allocator);
+    }
+
+    /// Approximate number of rows in `table_name` matching equality filters on
+    /// `eq_columns`, without scanning the table
+    /// Uses the `sqlite_stat1` table written by ANALYZE: its first number is
+    /// the table's row count, and for each index the next number is the average
+    /// rows per value of the leading column. Every filtered column that leads
+    /// an index scales the estimate by that selectivity; other filters are
+    /// ignored. Before ANALYZE has run, falls back to `MAX(rowid)`.
+    ///
+    /// Example:
+    /// ```zig
+    /// try orm.execute("ANALYZE");
+    /// const approx = try orm.estimateCount("todos", &.{"user_id"});
+    /// ```
+    pub fn estimateCount(self: *ORM, table_name: []const u8, eq_columns: []const []const u8) !i64 {
+        var db = try self.acquireReader();
+        defer self.releaseReader(db);
+
+        // sqlite_stat1 is created by the first ANALYZE
+        stats: {
+            if (!try Schema.tableExists(&db, "sqlite_stat1")) break :stats;
+
+            var stmt = try db.prepare(
+                "SELECT s.stat, i.name FROM sqlite_stat1 s " ++
+                    "LEFT JOIN pragma_index_info(s.idx) i ON i.seqno = 0 WHERE s.tbl = ?",
+            );
+            defer stmt.deinit();
+            try stmt.bind(1, table_name);
+
+            var result = try stmt.query();
+            defer result.deinit();
+
+            var rows: ?f64 = null;
+            var selectivity: f64 = 1.0;
+            var matched = std.StaticBitSet(64).initEmpty();
+            while (try result.step()) |row| {
+                var numbers = std.mem.tokenizeScalar(u8, row.getText(0) orelse continue, ' ');
+                const table_rows = std.fmt.parseFloat(f64, numbers.next() orelse continue) catch continue;
+                rows = table_rows;
+
+                const leading_column = row.getText(1) orelse continue;
+                const per_value = std.fmt.parseFloat(f64, numbers.next() orelse continue) catch continue;
+                for (eq_columns, 0..) |column, i| {
+                    if (i >= matched.capacity() or matched.isSet(i)) continue;
+                    if (std.mem.eql(u8, column, leading_column) and table_rows > 0) {
+                        selectivity *= per_value / table_rows;
+                        matched.set(i);
+                    }
+                }
+            }
+
+            const table_rows = rows orelse break :stats;
+            return @intFromFloat(@round(table_rows * selectivity));
+        }
+
+        const quoted_table = try SqlEscape.escapeIdentifier(self.allocator, table_name);
+        defer self.allocator.free(quoted_table);
+        const sql = try std.fmt.allocPrint(self.allocator, "SELECT MAX(rowid) FROM {s}", .{quoted_table});
+        defer self.allocator.free(sql);
+        var result = db.query(sql) catch |err| {
+            std.debug.print("[ORM Error] estimateCount() failed for table '{s}'\n", .{table_name});
+            std.debug.print("  Error: {}\n", .{err});
+            return err;
+        };
+        defer result.deinit();
+        const row = result.nextRow() orelse return 0;
+        return row.getInt64(0);
+    }
+
+    /// Check the plans of queries run through query() for full table scans
+    /// See QueryPlanInspector; pass null to stop inspecting. In WAL mode the
+    /// inspector is attached to each reader as it is acquired.
+    pub fn setPlanInspector(self: *ORM, inspector: ?*QueryPlanInspector) void {
+        self.plan_inspector = inspector;
+        self.db.setPlanInspector(inspector);
+    }
+
+    /// Get prepared statement cache statistics for the ORM's connection
+    pub fn statementCacheStats(self: *ORM) StatementCacheStats {
+        return self.db.statementCacheStats();
+    }
+
+    pub fn transaction(self: *ORM, comptime T: type, callback: fn (*database.Transaction) anyerror!T) !T {
+        try self.lockWrites();
+        defer self.unlockWrites();
+
+        var trans = try self.db.beginTransaction();
+        defer trans.deinit();
+        // Reads on this connection saw the transaction's uncommitted rows, so
+        // drop the cache whether it commits or rolls back
+        defer self.invalidateAllEntities();
+
+        const result = callback(&trans) catch |err| {
+            trans.rollback() catch {};
+            return err;
+        };
+
+        try trans.commit();
+        return result;
+    }
+
+    pub fn runMigrations(self: *ORM, migrations: []const Migration) !void {
+        try self.lockWrites();
+        defer self.unlockWrites();
+
+        defer self.invalidateAllEntities();
+
+        var runner = MigrationRunner.init(&self.db, self.allocator);
+        try runner.runMigrations(migrations);
+    }
+
+    /// Run migrations from a MigrationRegistry
+    ///
+    /// Example:
+    /// ```zig
+    /// var registry = MigrationRegistry.init(allocator);
+    /// defer registry.deinit();
+    /// try registry.add(Migration.init(1, "create_todos", "CREATE TABLE...", "DROP TABLE..."));
+    /// try orm.runMigrationsFromRegistry(&registry);
+    /// ```
+    pub fn runMigrationsFromRegistry(self: *ORM, registry: *MigrationRegistry) !void {
+        const migrations = registry.getMigrations();
+        try self.runMigrations(migrations);
+    }
+
+    pub fn getMigrationVersion(self: *ORM) !?u32 {
+        var runner = MigrationRunner.init(&self.db, self.allocator);
+        return try runner.getCurrentVersion();
+    }
+
+    pub fn migrate(self: *ORM, migrations: []const Migration) !void {
+        try self.runMigrations(migrations);
+    }
+
+    /// Back up the live database to `dest_path` on a background thread
+    /// Copies `pages_per_step` pages at a time (<= 0 copies everything in one
+    /// step), holding the write lock only during a step and sleeping `sleep_ms`
+    /// between steps so request latency is unaffected. Writes made through the
+    /// ORM while the backup runs are carried into the copy. Progress is
+    /// available from `backupProgress()` and `writePrometheus()`, and
+    /// `waitBackup()` blocks until it is done. Only one backup runs at a time.
+    /// The ORM owns the job, so no pointer to it outlives the next backup().
+    ///
+    /// Example:
+    /// ```zig
+    /// try orm.backup("backups/app.db", 256, 5);
+    /// try orm.waitBackup(); // or let it run and watch /metrics
+    /// ```
+    pub fn backup(self: *ORM, dest_path: []const u8, pages_per_step: i32, sleep_ms: u64) !void {
+        self.backup_mutex.lock();
+        const previous = self.backup_job;
+        if (previous) |job| {
+            if (job.progress().state == .running) {
+                self.backup_mutex.unlock();
+                return error.BackupInProgress;
+            }
+        }
+        // Waiters on the finished job are on their way out
+        while (self.backup_waiters > 0) self.backup_waiters_done.wait(&self.backup_mutex);
+        const job = BackupJob.start(self.allocator, self.db, self.writeLock(), dest_path, pages_per_step, sleep_ms) catch |err| {
+            self.backup_mutex.unlock();
+            return err;
+        };
+        self.backup_job = job;
+        self.backup_mutex.unlock();
+
+        // No reader can still hold the finished job once it is swapped out under the lock
+        if (previous) |old| old.deinit();
+    }
+
+    /// Block until the most recent backup() has finished
+    /// Returns the backup's error if it failed; returns at once if none was started.
+    pub fn waitBackup(self: *ORM) !void {
+        self.backup_mutex.lock();
+        const job = self.backup_job orelse {
+            self.backup_mutex.unlock();
+            return;
+        };
+        self.backup_waiters += 1;
+        self.backup_mutex.unlock();
+
+        defer {
+            self.backup_mutex.lock();
+            self.backup_waiters -= 1;
+            if (self.backup_waiters == 0) self.backup_waiters_done.broadcast();
+            self.backup_mutex.unlock();
+        }
+        return job.wait();
+    }
+
+    /// Progress of the most recent backup(), if any
+    pub fn backupProgress(self: *ORM) ?BackupProgress {
+        self.backup_mutex.lock();
+        defer self.backup_mutex.unlock();
+        const job = self.backup_job orelse return null;
+        return job.progress();
+    }
+
+    /// Write a compacted snapshot of the database to `dest_path` with VACUUM INTO
+    /// Unlike backup() this rebuilds the file without free pages, but copies in
+    /// one pass that holds the writer connection until it is done. The
+    /// destination must not exist.
+    ///
+    /// Example:
+    /// ```zig
+    /// try orm.vacuumInto("snapshots/app-2024-06-01.db");
+    /// ```
+    pub fn vacuumInto(self: *ORM, dest_path: []const u8) !void {
+        try self.lockWrites();
+        defer self.unlockWrites();
+
+        self.db.vacuumInto(dest_path) catch |err| {
+            std.debug.print("[ORM Error] vacuumInto() failed for '{s}'\n", .{dest_path});
+            std.debug.print("  Error: {}\n", .{err});
+            return err;
+        };
+    }
+
+    /// Sample SQLite's internals every `interval_ms` for writePrometheus()
+    /// Exports page cache hit/miss/write counters, lookaside, schema and
+    /// statement memory, the WAL file size and per-table sizes from dbstat,
+    /// which is what `cache_size` and `mmap_size` should be tuned against.
+    /// Counters are for the ORM's own (writer) connection, sampled under the
+    /// write lock, so a table size scan briefly holds up writers.
+    ///
+    /// Example:
+    /// ```zig
+    /// try orm.enableDbStats(.{ .interval_ms = 10_000, .table_sizes_every = 6 });
+    /// // GET /metrics now includes sqlite_cache_hits_total, sqlite_wal_bytes, ...
+    /// ```
+    pub fn enableDbStats(self: *ORM, options: DbStatsOptions) !void {
+        if (self.db_stats != null) return;
+        try self.checkQueryLock();
+        self.db_stats = try DbStatsSampler.start(self.allocator, self.db, self.writeLock(), options);
+    }
+
+    /// Latest SQLite internals sample (without table sizes), if enableDbStats() was called
+    pub fn dbStats(self: *ORM) ?DbStatsSnapshot {
+        const sampler = self.db_stats orelse return null;
+        return sampler.snapshot();
+    }
+
+    /// Publish committed inserts, updates and deletes made through `db` as a change feed
+    /// Every write on the ORM's connection is captured, including raw SQL from
+    /// handlers and valves, and each committed transaction is delivered once to
+    /// every subscriber on the feed's thread. Cached entities are dropped when
+    /// their row changes. The ORM must stay at a fixed address while the feed
+    /// is enabled.
+    ///
+    /// Example:
+    /// ```zig
+    /// const feed = try orm.enableChangeFeed(.{});
+    /// try cache.followChanges(feed); // ResponseCache: drop entries tagged with changed tables
+    /// try room.followChanges(feed); // WebSocketRoom: broadcast each batch as JSON
+    /// ```
+    pub fn enableChangeFeed(self: *ORM, options: ChangeFeedOptions) !*ChangeFeed {
+        if (self.change_feed) |feed| return feed;
+
+        const feed = try ChangeFeed.init(self.allocator, options);
+        errdefer feed.deinit();
+        try feed.subscribe(invalidateChangedEntities, self);
+        try feed.attach(&self.db);
+        self.change_feed = feed;
+        return feed;
+    }
+
+    fn invalidateChangedEntities(context: ?*anyopaque, batch: *const ChangeBatch) void {
+        const self: *ORM = @ptrCast(@alignCast(context.?));
+        const cache = self.entity_cache orelse return;
+        for (batch.changes) |change| {
+            switch (change.op) {
+                .insert => {},
+                .update, .delete => cache.invalidate(change.table, change.rowid),
+                .many => return cache.clear(),
+            }
+        }
+    }
+
+    /// Add an AsyncORM's worker stats to writePrometheus() (null stops exporting)
+    /// The AsyncORM must stay alive until it is detached or the ORM is closed.
+    ///
+    /// Example:
+    /// ```zig
+    /// const async_db = try AsyncORM.init("app.db", allocator, .{ .workers = 4 });
+    /// orm.exportAsyncStats(async_db);
+    /// ```
+    pub fn exportAsyncStats(self: *ORM, async_db: ?*AsyncORM) void {
+        self.async_db = async_db;
+    }
+
+    /// Write ORM-level metrics in Prometheus text format
+    /// Covers backup progress, SQLite internals, the WAL reader pool, the write
+    /// queue and an exported AsyncORM, for whichever of them are enabled.
+    pub fn writePrometheus(self: *ORM, writer: anytype) !void {
+        if (self.backupProgress()) |progress| try progress.writePrometheus(writer);
+        if (self.db_stats) |sampler| try sampler.writePrometheus(writer);
+        if (self.wal) |wal_db| try wal_db.readers.stats().writePrometheus(writer, "readers");
+        if (self.write_queue) |queue| try queue.stats().writePrometheus(writer);
+        if (self.async_db) |async_db| try async_db.stats().writePrometheus(writer, "async");
+    }
+
+    /// Escape a string for safe use in SQL LIKE patterns
+    /// Convenience wrapper around SqlEscape.escapeLikePattern
+    ///
+    /// Example:
+    /// ```zig
+    /// const safe_pattern = try orm.escapeLike("test%_data", allocator);
+    /// defer allocator.free(safe_pattern);
+    /// const sql = try std.fmt.allocPrint(allocator, "SELECT * FROM Todo WHERE title LIKE '{s}'", .{safe_pattern});
+    /// ```
+    pub fn escapeLike(_: *ORM, pattern: []const u8, allocator: std.mem.Allocator) ![]const u8 {
+        return SqlEscape.escapeLikePattern(allocator, pattern);
+    }
+
+    pub fn close(self: *ORM) void {
+        // Queued writes still commit through the change feed and invalidate
+        // the entity cache, so drain the queue before tearing either down
+        if (self.write_queue) |queue| {
+            queue.deinit();
+            self.write_queue = null;
+        }
+        if (self.change_feed) |feed| {
+            feed.detach(&self.db);
+            feed.deinit();
+            self.change_feed = null;
+        }
+        if (self.db_stats) |sampler| {
+            sampler.deinit();
+            self.db_stats = null;
+        }
+        self.backup_mutex.lock();
+        while (self.backup_waiters > 0) self.backup_waiters_done.wait(&self.backup_mutex);
+        const backup_job = self.backup_job;
+        self.backup_job = null;
+        self.backup_mutex.unlock();
+        if (backup_job) |job| job.deinit();
+        if (self.entity_cache) |cache| {
+            cache.deinit();
+            self.allocator.destroy(cache);
+            self.entity_cache = null;
+        }
+        if (self.wal) |wal_db| {
+            wal_db.deinit();
+            self.wal = null;
+            return;
+        }
+        self.db.close();
+    }
+
+    /// Connection for read-only ORM operations: a pooled reader in WAL mode,
+    /// otherwise the ORM's own connection held under the write lock, so reads
+    /// never see a write-queue batch before it commits
+    fn acquireReader(self: *ORM) !Database {
+        if (self.wal) |wal_db| {
+            var reader = try wal_db.acquireReader();
+            reader.plan_inspector = self.plan_inspector;
+            return reader;
+        }
+        try self.lockWrites();
+        return self.db;
+    }
+
+    fn releaseReader(self: *ORM, db: Database) void {
+        if (self.wal) |wal_db| return wal_db.releaseReader(db);
+        self.unlockWrites();
+    }
+
+    /// Lock shared by every writer on the ORM's connection, if it is shared
+    fn writeLock(self: *ORM) ?*std.Thread.Mutex {
+        if (self.write_queue) |queue| return queue.writer_lock;
+        if (self.wal) |wal_db| return &wal_db.writer_mutex;
+        return null;
+    }
+
+    fn lockWrites(self: *ORM) !void {
+        const lock = self.writeLock() orelse return;
+        try self.checkQueryLock();
+        lock.lock();
+    }
+
+    /// The write lock is not reentrant, and a queued write needs it on the
+    /// writer thread, so neither can proceed while this thread holds it
+    /// through an open query() result
+    fn checkQueryLock(self: *ORM) !void {
+        if (self.query_lock_holder.load(.acquire) != std.Thread.getCurrentId()) return;
+        std.debug.print("[ORM Error] Database access while a query() result is open on this thread\n", .{});
+        std.debug.print("  Reason: without WAL the result holds the write-queue lock until deinit()\n", .{});
+        return error.WouldDeadlock;
+    }
+
+    fn unlockWrites(self: *ORM) void {
+        if (self.writeLock()) |lock| lock.unlock();
+    }
 
     fn valueToString(self: *ORM, value: anytype) ![]const u8 {
         const T = @TypeOf(value);
@@ -877,29 +1880,156 @@ test "ORM where" {
 
     const User = struct {
         id: i64,
-        name: []u8,
-        age: i32,
+        name: []u8,
+        age: i32,
+    };
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+
+    try db.execute("CREATE TABLE User (id INTEGER PRIMARY KEY, name TEXT, age INTEGER)");
+    try db.execute("INSERT INTO User (name, age) VALUES ('Alice', 25)");
+    try db.execute("INSERT INTO User (name, age) VALUES ('Bob', 30)");
+    try db.execute("INSERT INTO User (name, age) VALUES ('Charlie', 25)");
+
+    var orm = ORM.init(db, allocator);
+
+    var users = try orm.where(User, "age = 25");
+    defer {
+        for (users.items) |user| {
+            allocator.free(user.name);
+        }
+        users.deinit(allocator);
+    }
+
+    try std.testing.expectEqual(@as(usize, 2), users.items.len);
+}
+
+test "ORM whereBind binds parameters" {
+    const allocator = std.testing.allocator;
+
+    const User = struct {
+        id: i64,
+        name: []u8,
+        age: i32,
+    };
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+
+    try db.execute("CREATE TABLE User (id INTEGER PRIMARY KEY, name TEXT, age INTEGER)");
+    try db.execute("INSERT INTO User (name, age) VALUES ('Alice', 25)");
+    try db.execute("INSERT INTO User (name, age) VALUES ('Bob'' OR 1=1 --', 30)");
+
+    var orm = ORM.init(db, allocator);
+
+    var users = try orm.whereBind(User, "name = ? AND age >= ?", .{ "Alice", 18 });
+    defer {
+        for (users.items) |user| {
+            allocator.free(user.name);
+        }
+        users.deinit(allocator);
+    }
+
+    try std.testing.expectEqual(@as(usize, 1), users.items.len);
+    try std.testing.expectEqualStrings("Alice", users.items[0].name);
+}
+
+test "ORM create binds values and reuses the prepared statement" {
+    const allocator = std.testing.allocator;
+
+    const User = struct {
+        id: i64,
+        name: []const u8,
+        nickname: ?[]const u8,
+    };
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+
+    try db.execute("CREATE TABLE User (id INTEGER PRIMARY KEY, name TEXT, nickname TEXT)");
+
+    var orm = ORM.init(db, allocator);
+
+    try orm.create(User, User{ .id = 0, .name = "O'Reilly", .nickname = "Tim" });
+    const before = orm.statementCacheStats();
+    try orm.create(User, User{ .id = 0, .name = "Robert'); DROP TABLE User; --", .nickname = "Bobby" });
+    const after = orm.statementCacheStats();
+    try std.testing.expect(after.hits > before.hits);
+
+    const user = try orm.find(User, 1);
+    defer if (user) |u| {
+        allocator.free(u.name);
+        if (u.nickname) |n| allocator.free(n);
+    };
+    try std.testing.expectEqualStrings("O'Reilly", user.?.name);
+
+    const bobby = try orm.find(User, 2);
+    defer if (bobby) |u| {
+        allocator.free(u.name);
+        if (u.nickname) |n| allocator.free(n);
+    };
+    try std.testing.expectEqualStrings("Robert'); DROP TABLE User; --", bobby.?.name);
+}
+
+test "ORM createMany inserts batch in one transaction" {
+    const allocator = std.testing.allocator;
+
+    const User = struct {
+        id: i64,
+        name: []const u8,
+        nickname: ?[]const u8,
+    };
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+
+    try db.execute("CREATE TABLE User (id INTEGER PRIMARY KEY, name TEXT NOT NULL, nickname TEXT)");
+
+    var orm = ORM.init(db, allocator);
+
+    const users = [_]User{
+        .{ .id = 0, .name = "Alice", .nickname = "Al" },
+        .{ .id = 0, .name = "Bob", .nickname = null },
+        .{ .id = 0, .name = "Carol", .nickname = "Caz" },
+    };
+
+    const ids = try orm.createManyReturningIds(User, &users);
+    defer allocator.free(ids);
+
+    try std.testing.expectEqual(@as(usize, 3), ids.len);
+    try std.testing.expect(ids[0] < ids[1] and ids[1] < ids[2]);
+
+    const bob = try orm.find(User, ids[1]);
+    defer if (bob) |u| allocator.free(u.name);
+    try std.testing.expectEqualStrings("Bob", bob.?.name);
+    try std.testing.expect(bob.?.nickname == null);
+}
+
+test "ORM createMany rolls back the whole batch on error" {
+    const allocator = std.testing.allocator;
+
+    const User = struct {
+        id: i64,
+        name: []const u8,
     };
 
     var db = try Database.open(":memory:", allocator);
     defer db.close();
 
-    try db.execute("CREATE TABLE User (id INTEGER PRIMARY KEY, name TEXT, age INTEGER)");
-    try db.execute("INSERT INTO User (name, age) VALUES ('Alice', 25)");
-    try db.execute("INSERT INTO User (name, age) VALUES ('Bob', 30)");
-    try db.execute("INSERT INTO User (name, age) VALUES ('Charlie', 25)");
+    try db.execute("CREATE TABLE User (id INTEGER PRIMARY KEY, name TEXT UNIQUE)");
 
     var orm = ORM.init(db, allocator);
 
-    var users = try orm.where(User, "age = 25");
-    defer {
-        for (users.items) |user| {
-            allocator.free(user.name);
-        }
-        users.deinit(allocator);
-    }
+    const users = [_]User{
+        .{ .id = 0, .name = "Alice" },
+        .{ .id = 0, .name = "Alice" },
+    };
+    try std.testing.expectError(error.QueryFailed, orm.createMany(User, &users));
 
-    try std.testing.expectEqual(@as(usize, 2), users.items.len);
+    var result = try db.query("SELECT COUNT(*) FROM User");
+    defer result.deinit();
+    try std.testing.expectEqual(@as(i64, 0), result.nextRow().?.getInt64(0));
 }
 
 test "ORM update" {
@@ -932,6 +2062,85 @@ test "ORM update" {
     try std.testing.expectEqualStrings("Bob", user.?.name);
 }
 
+test "ORM saveTracked writes only changed fields" {
+    const allocator = std.testing.allocator;
+
+    const Todo = struct {
+        id: i64,
+        title: []const u8,
+        completed: bool,
+    };
+
+    const db = try Database.open(":memory:", allocator);
+    var orm = ORM.init(db, allocator);
+    defer orm.close();
+
+    try orm.execute("CREATE TABLE todo (id INTEGER PRIMARY KEY, title TEXT, completed INTEGER, title_writes INTEGER DEFAULT 0)");
+    try orm.execute("CREATE TRIGGER todo_title AFTER UPDATE OF title ON todo BEGIN UPDATE todo SET title_writes = title_writes + 1 WHERE id = NEW.id; END");
+    try orm.create(Todo, .{ .id = 0, .title = "ship it", .completed = false });
+
+    var arena = std.heap.ArenaAllocator.init(allocator);
+    defer arena.deinit();
+
+    var todo = (try orm.findTracked(Todo, 1, arena.allocator())).?;
+    try std.testing.expect(!(try orm.saveTracked(Todo, &todo)));
+
+    todo.value.completed = true;
+    try std.testing.expect(try orm.saveTracked(Todo, &todo));
+    try std.testing.expect(!todo.isDirty());
+
+    var result = try orm.query("SELECT completed, title_writes FROM todo WHERE id = 1");
+    defer result.deinit();
+    const row = (try result.step()).?;
+    try std.testing.expectEqual(@as(i64, 1), row.getInt64(0));
+    // The title column was not rewritten, so its trigger never fired
+    try std.testing.expectEqual(@as(i64, 0), row.getInt64(1));
+}
+
+test "ORM queryJsonArray matches Json.serialize" {
+    const allocator = std.testing.allocator;
+    const Json = @import("../json.zig").Json;
+
+    const Todo = struct {
+        id: i64,
+        title: []const u8,
+        completed: bool,
+        due: ?i64,
+    };
+
+    const db = try Database.open(":memory:", allocator);
+    var orm = ORM.init(db, allocator);
+    defer orm.close();
+
+    try orm.execute("CREATE TABLE todo (id INTEGER PRIMARY KEY, title TEXT, completed INTEGER, due INTEGER)");
+    try orm.create(Todo, .{ .id = 0, .title = "say \"hi\"\n", .completed = true, .due = 42 });
+    try orm.create(Todo, .{ .id = 0, .title = "back\\slash", .completed = false, .due = null });
+
+    const sql = "SELECT *, COUNT(*) OVER () AS e12_total FROM todo ORDER BY id DESC";
+    const page = try orm.queryJsonArray(Todo, sql, .{ .order_by = "id DESC", .total_column = "e12_total" }, allocator);
+    defer allocator.free(page.json);
+    try std.testing.expectEqual(@as(?i64, 2), page.total);
+    try std.testing.expectEqual(@as(usize, 2), page.rows);
+
+    var result = try orm.query(sql);
+    defer result.deinit();
+    var arena = std.heap.ArenaAllocator.init(allocator);
+    defer arena.deinit();
+    const items = try result.toArrayListAlloc(Todo, arena.allocator());
+    const expected = try Json.serializeArray(Todo, items.items, arena.allocator());
+    try std.testing.expectEqualStrings(expected, page.json);
+
+    const empty = try orm.queryJsonArray(Todo, "SELECT * FROM todo WHERE id < 0", .{}, allocator);
+    defer allocator.free(empty.json);
+    try std.testing.expectEqualStrings("[]", empty.json);
+    try std.testing.expectEqual(@as(?i64, null), empty.total);
+
+    // The aggregate applies order_by itself, whatever order the rows arrive in
+    const by_title = try orm.queryJsonArray(Todo, "SELECT * FROM todo ORDER BY id", .{ .order_by = "title" }, allocator);
+    defer allocator.free(by_title.json);
+    try std.testing.expect(std.mem.indexOf(u8, by_title.json, "back").? < std.mem.indexOf(u8, by_title.json, "say").?);
+}
+
 test "ORM delete" {
     const allocator = std.testing.allocator;
 
@@ -1319,3 +2528,624 @@ test "ORM update with id 0 should error" {
     const result = orm.update(User, user);
     try std.testing.expectError(error.InvalidArgument, result);
 }
+
+test "ORM initWal routes reads and writes" {
+    const allocator = std.testing.allocator;
+
+    const Item = struct {
+        id: i64,
+        qty: i64,
+    };
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const dir_path = try tmp.dir.realpathAlloc(allocator, ".");
+    defer allocator.free(dir_path);
+    const db_path = try std.fs.path.join(allocator, &.{ dir_path, "orm_wal.db" });
+    defer allocator.free(db_path);
+
+    var orm = ORM.initWal(try WalDatabase.open(db_path, allocator, .{ .reader_count = 2 }), allocator);
+    defer orm.close();
+
+    try orm.execute("CREATE TABLE item (id INTEGER PRIMARY KEY, qty INTEGER)");
+    try orm.create(Item, .{ .id = 0, .qty = 3 });
+    try orm.update(Item, .{ .id = 1, .qty = 5 });
+
+    const found = try orm.find(Item, 1);
+    try std.testing.expectEqual(@as(i64, 5), found.?.qty);
+
+    var items = try orm.whereBind(Item, "qty > ?", .{1});
+    defer items.deinit(allocator);
+    try std.testing.expectEqual(@as(usize, 1), items.items.len);
+
+    try orm.delete(Item, 1);
+    var all = try orm.findAll(Item);
+    defer all.deinit(allocator);
+    try std.testing.expectEqual(@as(usize, 0), all.items.len);
+}
+
+test "ORM query reads from a WAL reader and returns it on deinit" {
+    const allocator = std.testing.allocator;
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const dir_path = try tmp.dir.realpathAlloc(allocator, ".");
+    defer allocator.free(dir_path);
+    const db_path = try std.fs.path.join(allocator, &.{ dir_path, "orm_wal_query.db" });
+    defer allocator.free(db_path);
+
+    var orm = ORM.initWal(try WalDatabase.open(db_path, allocator, .{ .reader_count = 1 }), allocator);
+    defer orm.close();
+
+    try orm.execute("CREATE TABLE item (id INTEGER PRIMARY KEY, qty INTEGER)");
+    try orm.execute("INSERT INTO item (qty) VALUES (3)");
+
+    // An open write transaction is invisible to the reader
+    var trans = try orm.db.beginTransaction();
+    defer trans.deinit();
+    try trans.execute("INSERT INTO item (qty) VALUES (5)");
+
+    // With a single reader the second query only runs if deinit released the first
+    for (0..2) |_| {
+        var result = try orm.query("SELECT COUNT(*) FROM item");
+        defer result.deinit();
+        try std.testing.expectEqual(@as(i64, 1), result.nextRow().?.getInt64(0));
+    }
+
+    try trans.rollback();
+}
+
+test "ORM setPlanInspector inspects queries on WAL readers" {
+    const allocator = std.testing.allocator;
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const dir_path = try tmp.dir.realpathAlloc(allocator, ".");
+    defer allocator.free(dir_path);
+    const db_path = try std.fs.path.join(allocator, &.{ dir_path, "orm_wal_plan.db" });
+    defer allocator.free(db_path);
+
+    var orm = ORM.initWal(try WalDatabase.open(db_path, allocator, .{ .reader_count = 1 }), allocator);
+    defer orm.close();
+
+    try orm.execute("CREATE TABLE item (id INTEGER PRIMARY KEY, category TEXT)");
+    try orm.execute(
+        "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 20) " ++
+            "INSERT INTO item (category) SELECT 'c' || (i % 4) FROM n",
+    );
+
+    var inspector = QueryPlanInspector.init(allocator, .{ .min_table_rows = 10, .on_scan = .fail });
+    defer inspector.deinit();
+    orm.setPlanInspector(&inspector);
+
+    try std.testing.expectError(error.FullTableScan, orm.query("SELECT * FROM item WHERE category = 'c1'"));
+    try std.testing.expectEqual(@as(usize, 1), inspector.flaggedCount());
+
+    // The failed query released its reader, and detaching stops the checks
+    orm.setPlanInspector(null);
+    var result = try orm.query("SELECT * FROM item WHERE category = 'c1'");
+    result.deinit();
+}
+
+test "ORM enableWriteQueue routes writes through the queue" {
+    const allocator = std.testing.allocator;
+
+    const Item = struct {
+        id: i64,
+        qty: i64,
+    };
+
+    const db = try Database.open(":memory:", allocator);
+    var orm = ORM.init(db, allocator);
+    defer orm.close();
+
+    try orm.execute("CREATE TABLE item (id INTEGER PRIMARY KEY, qty INTEGER)");
+    try orm.enableWriteQueue(.{ .max_latency_us = 0 });
+
+    try orm.create(Item, .{ .id = 0, .qty = 1 });
+    try orm.update(Item, .{ .id = 1, .qty = 2 });
+    try std.testing.expectEqual(@as(i64, 2), (try orm.find(Item, 1)).?.qty);
+
+    try orm.delete(Item, 1);
+    try std.testing.expect((try orm.find(Item, 1)) == null);
+
+    const ids = try orm.createManyReturningIds(Item, &.{ .{ .id = 0, .qty = 3 }, .{ .id = 0, .qty = 4 } });
+    defer allocator.free(ids);
+    try std.testing.expectEqualSlices(i64, &.{ 1, 2 }, ids);
+
+    const stats = orm.write_queue.?.stats();
+    try std.testing.expectEqual(@as(u64, 4), stats.operations);
+}
+
+test "ORM write-queue mode fails fast on writes under an open query" {
+    const allocator = std.testing.allocator;
+
+    const Item = struct {
+        id: i64,
+        qty: i64,
+    };
+
+    const db = try Database.open(":memory:", allocator);
+    var orm = ORM.init(db, allocator);
+    defer orm.close();
+
+    try orm.execute("CREATE TABLE item (id INTEGER PRIMARY KEY, qty INTEGER)");
+    try orm.enableWriteQueue(.{ .max_latency_us = 0 });
+    try orm.create(Item, .{ .id = 0, .qty = 1 });
+
+    var result = try orm.query("SELECT qty FROM item");
+    try std.testing.expectError(error.WouldDeadlock, orm.create(Item, .{ .id = 0, .qty = 2 }));
+    try std.testing.expectError(error.WouldDeadlock, orm.execute("DELETE FROM item"));
+    try std.testing.expectError(error.WouldDeadlock, orm.find(Item, 1));
+    result.deinit();
+
+    try orm.create(Item, .{ .id = 0, .qty = 2 });
+    try std.testing.expectEqual(@as(i64, 2), (try orm.find(Item, 2)).?.qty);
+}
+
+test "ORM reads wait for an open write-queue batch" {
+    const allocator = std.testing.allocator;
+
+    const Item = struct {
+        id: i64,
+        qty: i64,
+    };
+
+    const db = try Database.open(":memory:", allocator);
+    var orm = ORM.init(db, allocator);
+    defer orm.close();
+
+    try orm.execute("CREATE TABLE item (id INTEGER PRIMARY KEY, qty INTEGER)");
+    try orm.enableEntityCache(Item, .{});
+    try orm.enableWriteQueue(.{ .max_latency_us = 0 });
+
+    // Hold the connection the way a batch does, with its insert not yet committed
+    const lock = orm.write_queue.?.writer_lock;
+    lock.lock();
+    var trans = try orm.db.beginTransaction();
+    try trans.execute("INSERT INTO item (id, qty) VALUES (1, 5)");
+
+    const Reader = struct {
+        fn run(reader_orm: *ORM, found: *?Item, done: *std.atomic.Value(bool)) void {
+            found.* = reader_orm.find(Item, 1) catch null;
+            done.store(true, .release);
+        }
+    };
+    var found: ?Item = .{ .id = 0, .qty = 0 };
+    var done = std.atomic.Value(bool).init(false);
+    const reader = try std.Thread.spawn(.{}, Reader.run, .{ &orm, &found, &done });
+
+    std.Thread.sleep(20 * std.time.ns_per_ms);
+    try std.testing.expect(!done.load(.acquire));
+
+    try trans.rollback();
+    trans.deinit();
+    lock.unlock();
+    reader.join();
+
+    // The rolled-back row was neither returned nor cached
+    try std.testing.expect(found == null);
+    try std.testing.expect((try orm.find(Item, 1)) == null);
+}
+
+test "ORM results can live in one arena" {
+    const allocator = std.testing.allocator;
+
+    const Note = struct {
+        id: i64,
+        title: []const u8,
+        body: ?[]const u8,
+    };
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+    try db.execute("CREATE TABLE note (id INTEGER PRIMARY KEY, title TEXT, body TEXT)");
+    try db.execute("INSERT INTO note (title, body) VALUES ('a', 'first'), ('b', NULL)");
+
+    var orm = ORM.init(db, allocator);
+
+    // Managed results own an arena; deinit frees everything at once
+    var managed = try orm.findAllManaged(Note);
+    defer managed.deinit();
+    try std.testing.expect(managed.arena != null);
+    try std.testing.expectEqual(@as(usize, 2), managed.len());
+    try std.testing.expectEqualStrings("first", managed.getItems()[0].body.?);
+
+    // Caller-provided arena: no per-field frees
+    var arena = std.heap.ArenaAllocator.init(allocator);
+    defer arena.deinit();
+    const note = (try orm.findAlloc(Note, 2, arena.allocator())).?;
+    try std.testing.expectEqualStrings("b", note.title);
+    try std.testing.expect(note.body == null);
+    const all = try orm.findAllAlloc(Note, arena.allocator());
+    try std.testing.expectEqual(@as(usize, 2), all.items.len);
+}
+
+test "ORM estimateCount uses ANALYZE statistics" {
+    const allocator = std.testing.allocator;
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+    try db.execute("CREATE TABLE items (id INTEGER PRIMARY KEY, category TEXT, name TEXT)");
+    try db.execute("CREATE INDEX idx_items_category ON items (category)");
+    try db.execute(
+        "WITH RECURSIVE n(i) AS (SELECT 0 UNION ALL SELECT i + 1 FROM n WHERE i < 99) " ++
+            "INSERT INTO items (category, name) SELECT 'c' || (i % 4), 'item' FROM n",
+    );
+
+    var orm = ORM.init(db, allocator);
+
+    // Before ANALYZE: MAX(rowid)
+    try std.testing.expectEqual(@as(i64, 100), try orm.estimateCount("items", &.{}));
+
+    try orm.execute("ANALYZE");
+    try std.testing.expectEqual(@as(i64, 100), try orm.estimateCount("items", &.{}));
+    // 4 categories -> 25 rows per category
+    try std.testing.expectEqual(@as(i64, 25), try orm.estimateCount("items", &.{"category"}));
+    // No index on name: filter is ignored
+    try std.testing.expectEqual(@as(i64, 100), try orm.estimateCount("items", &.{"name"}));
+}
+
+test "ORM syncIndexes creates and verifies declared indexes" {
+    const allocator = std.testing.allocator;
+
+    const Todo = struct {
+        id: i64,
+        user_id: i64,
+        created_at: i64,
+
+        pub const indexes = .{
+            .{ "user_id", "created_at" },
+        };
+    };
+
+    const db = try Database.open(":memory:", allocator);
+    var orm = ORM.init(db, allocator);
+    defer orm.close();
+
+    try orm.execute("CREATE TABLE todos (id INTEGER PRIMARY KEY, user_id INTEGER, created_at INTEGER)");
+    try orm.syncIndexes(Todo);
+    // Idempotent
+    try orm.syncIndexes(Todo);
+    try std.testing.expect(try Schema.indexMatches(&orm.db, "idx_todos_user_id_created_at", &.{ "user_id", "created_at" }));
+
+    try orm.execute("CREATE INDEX idx_todos_created_at ON todos (user_id)");
+    try std.testing.expectError(
+        error.IndexMismatch,
+        orm.ensureIndex(.{ .table = "todos", .columns = &.{"created_at"} }),
+    );
+}
+
+test "ORM entity cache serves find and is invalidated by writes" {
+    const allocator = std.testing.allocator;
+
+    const Item = struct {
+        id: i64,
+        name: []const u8,
+    };
+
+    const db = try Database.open(":memory:", allocator);
+    var orm = ORM.init(db, allocator);
+    defer orm.close();
+
+    try orm.execute("CREATE TABLE item (id INTEGER PRIMARY KEY, name TEXT)");
+    try orm.enableEntityCache(Item, .{});
+    try orm.create(Item, .{ .id = 0, .name = "first" });
+
+    const miss = (try orm.find(Item, 1)).?;
+    allocator.free(miss.name);
+    const hit = (try orm.find(Item, 1)).?;
+    allocator.free(hit.name);
+    try std.testing.expectEqual(@as(u64, 1), orm.entityCacheStats().hits);
+
+    try orm.update(Item, .{ .id = 1, .name = "second" });
+    const updated = (try orm.find(Item, 1)).?;
+    defer allocator.free(updated.name);
+    try std.testing.expectEqualStrings("second", updated.name);
+
+    try orm.delete(Item, 1);
+    try std.testing.expect((try orm.find(Item, 1)) == null);
+}
+
+test "ORM search ranks full-text matches and follows writes" {
+    const allocator = std.testing.allocator;
+
+    const Note = struct {
+        id: i64,
+        owner: i64,
+        title: []const u8,
+        body: []const u8,
+
+        pub const search_fields = .{ "title", "body" };
+    };
+
+    var arena = std.heap.ArenaAllocator.init(allocator);
+    defer arena.deinit();
+    const a = arena.allocator();
+
+    const db = try Database.open(":memory:", allocator);
+    var orm = ORM.init(db, allocator);
+    defer orm.close();
+
+    try orm.execute("CREATE TABLE note (id INTEGER PRIMARY KEY, owner INTEGER, title TEXT, body TEXT)");
+    // Rows that exist before the index are picked up by the initial rebuild
+    try orm.create(Note, .{ .id = 0, .owner = 1, .title = "Groceries", .body = "milk, eggs and bread" });
+    try orm.syncSearchIndex(Note);
+    try orm.create(Note, .{ .id = 0, .owner = 1, .title = "Bakery", .body = "bread bread bread" });
+    try orm.create(Note, .{ .id = 0, .owner = 2, .title = "Other user", .body = "bread" });
+
+    const hits = try orm.searchAlloc(Note, "bread", .{
+        .filters = &.{.{ .column = "owner", .value = .{ .int = 1 } }},
+        .snippet_column = "body",
+    }, a);
+    try std.testing.expectEqual(@as(usize, 2), hits.items.len);
+    try std.testing.expectEqualStrings("Bakery", hits.items[0].item.title);
+    try std.testing.expect(std.mem.indexOf(u8, hits.items[0].snippet, "<mark>bread</mark>") != null);
+
+    // Prefix match on the last word, and the update trigger re-indexes
+    try orm.update(Note, .{ .id = 1, .owner = 1, .title = "Groceries", .body = "cheese" });
+    const prefixed = try orm.searchAlloc(Note, "chee", .{}, a);
+    try std.testing.expectEqual(@as(usize, 1), prefixed.items.len);
+
+    try orm.delete(Note, 1);
+    const deleted = try orm.searchAlloc(Note, "cheese", .{}, a);
+    try std.testing.expectEqual(@as(usize, 0), deleted.items.len);
+}
+
+test "ORM fetch runs compiled queries from the statement cache" {
+    const allocator = std.testing.allocator;
+    var arena = std.heap.ArenaAllocator.init(allocator);
+    defer arena.deinit();
+    const a = arena.allocator();
+    const q = compiled_query;
+
+    const Task = struct {
+        id: i64,
+        owner: i64,
+        title: []const u8,
+        priority: []const u8,
+    };
+    const OwnerTasks = CompiledQuery(Task, .{
+        .where = q.allOf(.{ q.eq("owner"), q.anyOf(.{ q.in("priority", 2), q.like("title") }) }),
+        .order_by = &.{.{ .field = "id", .ascending = false }},
+        .limit = true,
+    });
+
+    const db = try Database.open(":memory:", allocator);
+    var orm = ORM.init(db, allocator);
+    defer orm.close();
+
+    try orm.execute("CREATE TABLE task (id INTEGER PRIMARY KEY, owner INTEGER, title TEXT, priority TEXT)");
+    try orm.create(Task, .{ .id = 0, .owner = 1, .title = "Pay rent", .priority = "high" });
+    try orm.create(Task, .{ .id = 0, .owner = 1, .title = "Water plants", .priority = "low" });
+    try orm.create(Task, .{ .id = 0, .owner = 1, .title = "Call mum", .priority = "medium" });
+    try orm.create(Task, .{ .id = 0, .owner = 2, .title = "Pay tax", .priority = "high" });
+
+    const tasks = try orm.fetch(OwnerTasks, .{ 1, .{ "high", "medium" }, "%plants%", 10 }, a);
+    try std.testing.expectEqual(@as(usize, 3), tasks.items.len);
+    try std.testing.expectEqualStrings("Call mum", tasks.items[0].title);
+
+    const top = (try orm.fetchFirst(OwnerTasks, .{ 1, .{ "high", "high" }, "%none%", 10 }, a)).?;
+    try std.testing.expectEqualStrings("Pay rent", top.title);
+    try std.testing.expectEqual(@as(i64, 1), try orm.fetchCount(OwnerTasks, .{ 2, .{ "high", "low" }, "%" }));
+
+    try std.testing.expect(orm.statementCacheStats().hits >= 1);
+}
+
+test "ORM exportCsv streams query rows" {
+    const allocator = std.testing.allocator;
+
+    const db = try Database.open(":memory:", allocator);
+    var orm = ORM.init(db, allocator);
+    defer orm.close();
+
+    try orm.execute("CREATE TABLE contact (id INTEGER PRIMARY KEY, name TEXT, email TEXT)");
+    try orm.execute("INSERT INTO contact (name, email) VALUES ('Ann \"Annie\" Lee', 'ann@example.com'), ('Bo', NULL)");
+
+    var out = std.ArrayListUnmanaged(u8){};
+    defer out.deinit(allocator);
+
+    var builder = QueryBuilder.init(allocator, "contact");
+    defer builder.deinit();
+    const sql = try builder.select(&.{ "name", "email" }).orderBy("id", true).build();
+    defer allocator.free(sql);
+
+    const rows = try orm.exportCsv(sql, out.writer(allocator), .{});
+    try std.testing.expectEqual(@as(usize, 2), rows);
+    try std.testing.expectEqualStrings("name,email\r\n\"Ann \"\"Annie\"\" Lee\",ann@example.com\r\nBo,\r\n", out.items);
+}
+
+test "ORM backup and vacuumInto copy the live database" {
+    const allocator = std.testing.allocator;
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const dir_path = try tmp.dir.realpathAlloc(allocator, ".");
+    defer allocator.free(dir_path);
+    const backup_path = try std.fs.path.join(allocator, &.{ dir_path, "backup.db" });
+    defer allocator.free(backup_path);
+    const snapshot_path = try std.fs.path.join(allocator, &.{ dir_path, "snapshot.db" });
+    defer allocator.free(snapshot_path);
+
+    const db = try Database.open(":memory:", allocator);
+    var orm = ORM.init(db, allocator);
+    defer orm.close();
+    try orm.execute("CREATE TABLE notes (id INTEGER PRIMARY KEY, body TEXT)");
+    try orm.execute("INSERT INTO notes (body) VALUES ('one'), ('two')");
+
+    try std.testing.expect(orm.backupProgress() == null);
+    try orm.backup(backup_path, 1, 0);
+    try orm.waitBackup();
+    try std.testing.expectEqual(BackupState.done, orm.backupProgress().?.state);
+
+    var metrics = std.ArrayListUnmanaged(u8){};
+    defer metrics.deinit(allocator);
+    try orm.writePrometheus(metrics.writer(allocator));
+    try std.testing.expect(std.mem.indexOf(u8, metrics.items, "db_backup_progress_ratio 1.0000") != null);
+
+    try orm.vacuumInto(snapshot_path);
+    try std.testing.expectError(error.QueryFailed, orm.vacuumInto(snapshot_path));
+
+    for ([_][]const u8{ backup_path, snapshot_path }) |path| {
+        var copy = try Database.open(path, allocator);
+        defer copy.close();
+        var result = try copy.query("SELECT COUNT(*) FROM notes");
+        defer result.deinit();
+        try std.testing.expectEqual(@as(i64, 2), result.nextRow().?.getInt64(0));
+    }
+}
+
+test "ORM backup can be restarted while metrics are scraped" {
+    const allocator = std.testing.allocator;
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const dir_path = try tmp.dir.realpathAlloc(allocator, ".");
+    defer allocator.free(dir_path);
+
+    const db = try Database.open(":memory:", allocator);
+    var orm = ORM.init(db, allocator);
+    defer orm.close();
+    try orm.execute("CREATE TABLE notes (id INTEGER PRIMARY KEY, body TEXT)");
+    try orm.execute("INSERT INTO notes (body) VALUES ('one'), ('two')");
+
+    const Scraper = struct {
+        fn run(target: *ORM, stop: *std.atomic.Value(bool)) void {
+            var out = std.ArrayListUnmanaged(u8){};
+            defer out.deinit(std.testing.allocator);
+            while (!stop.load(.acquire)) {
+                out.clearRetainingCapacity();
+                target.writePrometheus(out.writer(std.testing.allocator)) catch return;
+            }
+        }
+    };
+    var stop = std.atomic.Value(bool).init(false);
+    const scraper = try std.Thread.spawn(.{}, Scraper.run, .{ &orm, &stop });
+
+    // Every backup after the first frees the previous job while the scraper reads it
+    for (0..20) |i| {
+        var name_buf: [32]u8 = undefined;
+        const name = try std.fmt.bufPrint(&name_buf, "backup-{d}.db", .{i});
+        const path = try std.fs.path.join(allocator, &.{ dir_path, name });
+        defer allocator.free(path);
+        try orm.backup(path, 1, 0);
+        try orm.waitBackup();
+    }
+
+    stop.store(true, .release);
+    scraper.join();
+    try std.testing.expectEqual(BackupState.done, orm.backupProgress().?.state);
+}
+
+test "ORM enableDbStats adds SQLite internals to writePrometheus" {
+    const allocator = std.testing.allocator;
+
+    const db = try Database.open(":memory:", allocator);
+    var orm = ORM.init(db, allocator);
+    defer orm.close();
+    try orm.execute("CREATE TABLE notes (id INTEGER PRIMARY KEY, body TEXT)");
+    try orm.execute("INSERT INTO notes (body) VALUES ('one'), ('two')");
+
+    try std.testing.expect(orm.dbStats() == null);
+    try orm.enableDbStats(.{ .interval_ms = 60_000 });
+    try std.testing.expect(orm.dbStats().?.page_count > 0);
+
+    var metrics = std.ArrayListUnmanaged(u8){};
+    defer metrics.deinit(allocator);
+    try orm.writePrometheus(metrics.writer(allocator));
+    try std.testing.expect(std.mem.indexOf(u8, metrics.items, "sqlite_cache_misses_total ") != null);
+    try std.testing.expect(std.mem.indexOf(u8, metrics.items, "sqlite_table_bytes{name=\"notes\"} ") != null);
+}
+
+test "ORM writePrometheus exports reader pool and write queue stats" {
+    const allocator = std.testing.allocator;
+
+    const Item = struct {
+        id: i64,
+        qty: i64,
+    };
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const dir_path = try tmp.dir.realpathAlloc(allocator, ".");
+    defer allocator.free(dir_path);
+    const db_path = try std.fs.path.join(allocator, &.{ dir_path, "orm_metrics.db" });
+    defer allocator.free(db_path);
+
+    var orm = ORM.initWal(try WalDatabase.open(db_path, allocator, .{ .reader_count = 1 }), allocator);
+    defer orm.close();
+
+    try orm.execute("CREATE TABLE item (id INTEGER PRIMARY KEY, qty INTEGER)");
+    try orm.enableWriteQueue(.{ .max_latency_us = 0 });
+    try orm.create(Item, .{ .id = 0, .qty = 3 });
+
+    var metrics = std.ArrayListUnmanaged(u8){};
+    defer metrics.deinit(allocator);
+    try orm.writePrometheus(metrics.writer(allocator));
+    try std.testing.expect(std.mem.indexOf(u8, metrics.items, "db_pool_connections_max{pool=\"readers\"} 1") != null);
+    try std.testing.expect(std.mem.indexOf(u8, metrics.items, "db_write_queue_operations_total 1") != null);
+    try std.testing.expect(std.mem.indexOf(u8, metrics.items, "db_async_") == null);
+}
+
+test "ORM change feed invalidates entities written through raw SQL" {
+    const allocator = std.testing.allocator;
+
+    const Item = struct {
+        id: i64,
+        name: []const u8,
+    };
+
+    const db = try Database.open(":memory:", allocator);
+    var orm = ORM.init(db, allocator);
+    defer orm.close();
+
+    try orm.execute("CREATE TABLE item (id INTEGER PRIMARY KEY, name TEXT)");
+    try orm.enableEntityCache(Item, .{});
+    const feed = try orm.enableChangeFeed(.{});
+    try orm.create(Item, .{ .id = 0, .name = "first" });
+
+    const cached = (try orm.find(Item, 1)).?;
+    allocator.free(cached.name);
+
+    // Bypasses the ORM's own invalidation; only the change feed sees it
+    try orm.db.execute("UPDATE item SET name = 'raw' WHERE id = 1");
+    feed.flush();
+
+    const fresh = (try orm.find(Item, 1)).?;
+    defer allocator.free(fresh.name);
+    try std.testing.expectEqualStrings("raw", fresh.name);
+    try std.testing.expectEqual(@as(u64, 2), feed.stats().transactions);
+}
+
+test "ORM change feed drops rows undone by a failed createMany" {
+    const allocator = std.testing.allocator;
+
+    const Item = struct {
+        id: i64,
+        name: []const u8,
+    };
+
+    const db = try Database.open(":memory:", allocator);
+    var orm = ORM.init(db, allocator);
+    defer orm.close();
+
+    try orm.execute("CREATE TABLE item (id INTEGER PRIMARY KEY, name TEXT UNIQUE)");
+    const feed = try orm.enableChangeFeed(.{});
+
+    const items = [_]Item{
+        .{ .id = 0, .name = "a" },
+        .{ .id = 0, .name = "b" },
+        .{ .id = 0, .name = "a" },
+    };
+    try std.testing.expectError(error.QueryFailed, orm.createMany(Item, &items));
+
+    // Same rollback inside an open transaction, where only ROLLBACK TO undoes the rows
+    try orm.db.execute("BEGIN");
+    try orm.db.execute("INSERT INTO item (name) VALUES ('kept')");
+    try std.testing.expectError(error.QueryFailed, orm.createMany(Item, &items));
+    try orm.db.execute("COMMIT");
+    feed.flush();
+
+    try std.testing.expectEqual(@as(u64, 1), feed.stats().transactions);
+    try std.testing.expectEqual(@as(u64, 1), feed.stats().changes);
+}
@@ -9,6 +9,9 @@ pub const QueryBuilder = struct {
     offset_val: ?usize = null,
     order_by_field: ?[]const u8 = null,
     order_ascending: bool = true,
+    /// Append `id` to ORDER BY so rows with equal sort keys have a stable order
+    order_by_id_tiebreak: bool = false,
+    keyset: ?KeysetClause = null,
     join_clauses: std.ArrayListUnmanaged(JoinClause),
     
     pub const WhereClause = struct {
@@ -17,6 +20,12 @@ pub const QueryBuilder = struct {
         value: []const u8,
     };
     
+    /// Position after which a keyset page starts
+    pub const KeysetClause = struct {
+        sort_value: []const u8,
+        last_id: i64,
+    };
+    
     pub const JoinClause = struct {
         join_type: []const u8,
         table: []const u8,
@@ -95,6 +104,34 @@ pub const QueryBuilder = struct {
         return self;
     }
     
+    /// ORDER BY field, id - a total order suitable for keyset pagination
+    pub fn orderByKeyset(self: *QueryBuilder, field: []const u8, ascending: bool) *QueryBuilder {
+        self.order_by_id_tiebreak = true;
+        return self.orderBy(field, ascending);
+    }
+    
+    /// Start after the row with the given sort key and id
+    /// Adds `(sort_field, id) > (sort_value, last_id)` (`<` when descending)
+    /// using the keyset order set by orderByKeyset() (default: id ascending).
+    /// With an index on (sort_field, id) every page is a single index seek,
+    /// however deep it is, unlike OFFSET which walks every skipped row.
+    ///
+    /// Example:
+    /// ```zig
+    /// const sql = try builder
+    ///     .orderByKeyset("created_at", false)
+    ///     .after("1700000000", 42)
+    ///     .limit(20)
+    ///     .build();
+    /// // SELECT * FROM todos WHERE (created_at, id) < ('1700000000', 42)
+    /// //   ORDER BY created_at DESC, id DESC LIMIT 20
+    /// ```
+    pub fn after(self: *QueryBuilder, sort_value: []const u8, last_id: i64) *QueryBuilder {
+        self.keyset = .{ .sort_value = sort_value, .last_id = last_id };
+        self.order_by_id_tiebreak = true;
+        return self;
+    }
+    
     pub fn join(self: *QueryBuilder, join_type: []const u8, table: []const u8, on: []const u8) *QueryBuilder {
         self.join_clauses.append(self.allocator, .{
             .join_type = join_type,
@@ -119,6 +156,79 @@ pub const QueryBuilder = struct {
             try sql.writer(self.allocator).print("*", .{});
         }
         
+        try self.writeFromWhere(&sql);
+        
+        // ORDER BY clause
+        if (self.orderField() != null) {
+            try sql.writer(self.allocator).print(" ORDER BY ", .{});
+            try self.writeOrderTerms(&sql);
+        }
+        
+        // LIMIT clause
+        if (self.limit_val) |limit_val| {
+            try sql.writer(self.allocator).print(" LIMIT {d}", .{limit_val});
+        }
+        
+        // OFFSET clause
+        if (self.offset_val) |offset_val| {
+            try sql.writer(self.allocator).print(" OFFSET {d}", .{offset_val});
+        }
+        
+        return sql.toOwnedSlice(self.allocator);
+    }
+    
+    /// Build `SELECT COUNT(*)` over the same FROM, JOIN and WHERE clauses
+    /// ORDER BY, LIMIT and OFFSET are left out since they do not change the count.
+    ///
+    /// Example:
+    /// ```zig
+    /// const count_sql = try builder.whereEq("completed", "0").buildCount();
+    /// // SELECT COUNT(*) FROM todos WHERE completed = '0'
+    /// ```
+    pub fn buildCount(self: *QueryBuilder) ![]const u8 {
+        var sql = std.ArrayListUnmanaged(u8){};
+        errdefer sql.deinit(self.allocator);
+        
+        try sql.writer(self.allocator).print("SELECT COUNT(*)", .{});
+        try self.writeFromWhere(&sql);
+        
+        return sql.toOwnedSlice(self.allocator);
+    }
+    
+    /// The ORDER BY terms of build() without the keyword, or null when unordered
+    /// For queries that wrap build() and must apply its order again, such as
+    /// `ORM.queryJsonArray`.
+    ///
+    /// Example:
+    /// ```zig
+    /// const order_by = try builder.orderByKeyset("title", false).buildOrderBy();
+    /// // "title DESC, id DESC"
+    /// ```
+    pub fn buildOrderBy(self: *QueryBuilder) !?[]const u8 {
+        if (self.orderField() == null) return null;
+        var sql = std.ArrayListUnmanaged(u8){};
+        errdefer sql.deinit(self.allocator);
+        
+        try self.writeOrderTerms(&sql);
+        
+        return try sql.toOwnedSlice(self.allocator);
+    }
+    
+    fn orderField(self: *const QueryBuilder) ?[]const u8 {
+        return if (self.order_by_field) |field| field else if (self.order_by_id_tiebreak) "id" else null;
+    }
+    
+    fn writeOrderTerms(self: *QueryBuilder, sql: *std.ArrayListUnmanaged(u8)) !void {
+        const field = self.orderField() orelse return;
+        const direction = if (self.order_ascending) "" else " DESC";
+        try sql.writer(self.allocator).print("{s}{s}", .{ field, direction });
+        if (self.order_by_id_tiebreak and !std.mem.eql(u8, field, "id")) {
+            try sql.writer(self.allocator).print(", id{s}", .{direction});
+        }
+    }
+    
+    /// FROM, JOIN and WHERE clauses shared by build() and buildCount()
+    fn writeFromWhere(self: *QueryBuilder, sql: *std.ArrayListUnmanaged(u8)) !void {
         // FROM clause
         try sql.writer(self.allocator).print(" FROM {s}", .{self.table_name});
         
@@ -128,42 +238,36 @@ pub const QueryBuilder = struct {
         }
         
         // WHERE clause
-        if (self.where_clauses.items.len > 0) {
+        if (self.where_clauses.items.len > 0 or self.keyset != null) {
             try sql.writer(self.allocator).print(" WHERE ", .{});
             for (self.where_clauses.items, 0..) |clause, i| {
                 if (i > 0) try sql.writer(self.allocator).print(" AND ", .{});
-                // Escape single quotes in value
-                var escaped_value = std.ArrayListUnmanaged(u8){};
-                defer escaped_value.deinit(self.allocator);
-                for (clause.value) |char| {
-                    if (char == '\'') {
-                        try escaped_value.append(self.allocator, '\'');
-                        try escaped_value.append(self.allocator, '\'');
-                    } else {
-                        try escaped_value.append(self.allocator, char);
-                    }
+                try sql.writer(self.allocator).print("{s} {s} ", .{ clause.field, clause.operator });
+                try self.appendQuoted(sql, clause.value);
+            }
+            if (self.keyset) |keyset| {
+                if (self.where_clauses.items.len > 0) try sql.writer(self.allocator).print(" AND ", .{});
+                const field = self.order_by_field orelse "id";
+                const operator = if (self.order_ascending) ">" else "<";
+                if (std.mem.eql(u8, field, "id")) {
+                    try sql.writer(self.allocator).print("id {s} {d}", .{ operator, keyset.last_id });
+                } else {
+                    try sql.writer(self.allocator).print("({s}, id) {s} (", .{ field, operator });
+                    try self.appendQuoted(sql, keyset.sort_value);
+                    try sql.writer(self.allocator).print(", {d})", .{keyset.last_id});
                 }
-                try sql.writer(self.allocator).print("{s} {s} '{s}'", .{ clause.field, clause.operator, escaped_value.items });
             }
         }
-        
-        // ORDER BY clause
-        if (self.order_by_field) |field| {
-            try sql.writer(self.allocator).print(" ORDER BY {s}", .{field});
-            if (!self.order_ascending) try sql.writer(self.allocator).print(" DESC", .{});
-        }
-        
-        // LIMIT clause
-        if (self.limit_val) |limit_val| {
-            try sql.writer(self.allocator).print(" LIMIT {d}", .{limit_val});
-        }
-        
-        // OFFSET clause
-        if (self.offset_val) |offset_val| {
-            try sql.writer(self.allocator).print(" OFFSET {d}", .{offset_val});
+    }
+    
+    /// Append a single-quoted SQL literal, doubling embedded quotes
+    fn appendQuoted(self: *QueryBuilder, sql: *std.ArrayListUnmanaged(u8), value: []const u8) !void {
+        try sql.append(self.allocator, '\'');
+        for (value) |char| {
+            if (char == '\'') try sql.append(self.allocator, '\'');
+            try sql.append(self.allocator, char);
         }
-        
-        return sql.toOwnedSlice(self.allocator);
+        try sql.append(self.allocator, '\'');
     }
 };
 
@@ -355,3 +459,120 @@ test "QueryBuilder whereNe" {
     
     try std.testing.expect(std.mem.indexOf(u8, sql, "name != 'Alice'") != null);
 }
+
+test "QueryBuilder keyset first page" {
+    const allocator = std.testing.allocator;
+    var builder = QueryBuilder.init(allocator, "todos");
+    defer builder.deinit();
+    
+    const sql = try builder.orderByKeyset("title", false).limit(11).build();
+    defer allocator.free(sql);
+    
+    try std.testing.expectEqualStrings("SELECT * FROM todos ORDER BY title DESC, id DESC LIMIT 11", sql);
+    
+    const order_by = (try builder.buildOrderBy()).?;
+    defer allocator.free(order_by);
+    try std.testing.expectEqualStrings("title DESC, id DESC", order_by);
+}
+
+test "QueryBuilder keyset after cursor" {
+    const allocator = std.testing.allocator;
+    var builder = QueryBuilder.init(allocator, "todos");
+    defer builder.deinit();
+    
+    const sql = try builder
+        .whereEq("user_id", "3")
+        .orderByKeyset("title", true)
+        .after("O'Reilly", 42)
+        .limit(10)
+        .build();
+    defer allocator.free(sql);
+    
+    try std.testing.expectEqualStrings(
+        "SELECT * FROM todos WHERE user_id = '3' AND (title, id) > ('O''Reilly', 42) ORDER BY title, id LIMIT 10",
+        sql,
+    );
+}
+
+test "QueryBuilder keyset on id" {
+    const allocator = std.testing.allocator;
+    var builder = QueryBuilder.init(allocator, "todos");
+    defer builder.deinit();
+    
+    const sql = try builder.after("", 100).limit(10).build();
+    defer allocator.free(sql);
+    
+    try std.testing.expectEqualStrings("SELECT * FROM todos WHERE id > 100 ORDER BY id LIMIT 10", sql);
+}
+
+test "QueryBuilder keyset pages seek the index instead of scanning" {
+    const allocator = std.testing.allocator;
+    const Database = @import("database.zig").Database;
+    
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+    try db.execute("CREATE TABLE todos (id INTEGER PRIMARY KEY, title TEXT, priority INTEGER)");
+    try db.execute("CREATE INDEX idx_todos_priority_id ON todos (priority, id)");
+    try db.execute(
+        "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 2000) " ++
+            "INSERT INTO todos (title, priority) SELECT 'todo', i % 7 FROM n",
+    );
+    
+    // Walk every page; each row must appear exactly once, in (priority, id) order
+    var seen: usize = 0;
+    var last_priority: i64 = -1;
+    var last_id: i64 = 0;
+    var cursor_value: ?[]u8 = null;
+    defer if (cursor_value) |value| allocator.free(value);
+    while (true) {
+        var builder = QueryBuilder.init(allocator, "todos");
+        defer builder.deinit();
+        _ = builder.select(&.{ "id", "priority" }).orderByKeyset("priority", true).limit(50);
+        if (cursor_value) |value| _ = builder.after(value, last_id);
+        
+        const sql = try builder.build();
+        defer allocator.free(sql);
+        var result = try db.query(sql);
+        defer result.deinit();
+        
+        var page_rows: usize = 0;
+        while (result.nextRow()) |row| {
+            const id = row.getInt64(0);
+            const priority = row.getInt64(1);
+            try std.testing.expect(priority > last_priority or (priority == last_priority and id > last_id));
+            last_priority = priority;
+            last_id = id;
+            page_rows += 1;
+        }
+        if (page_rows == 0) break;
+        seen += page_rows;
+        
+        if (cursor_value) |value| allocator.free(value);
+        cursor_value = try std.fmt.allocPrint(allocator, "{d}", .{last_priority});
+    }
+    try std.testing.expectEqual(@as(usize, 2000), seen);
+    
+    // A deep keyset page is an index SEARCH; the equivalent OFFSET page is a SCAN
+    var deep = QueryBuilder.init(allocator, "todos");
+    defer deep.deinit();
+    const deep_sql = try deep.orderByKeyset("priority", true).after("6", 1500).limit(51).build();
+    defer allocator.free(deep_sql);
+    const plan_sql = try std.fmt.allocPrint(allocator, "EXPLAIN QUERY PLAN {s}", .{deep_sql});
+    defer allocator.free(plan_sql);
+    
+    var plan = try db.query(plan_sql);
+    defer plan.deinit();
+    const detail = plan.nextRow().?.getText(3) orelse "";
+    try std.testing.expect(std.mem.startsWith(u8, detail, "SEARCH todos USING INDEX idx_todos_priority_id"));
+}
+
+test "QueryBuilder buildCount keeps filters and drops paging" {
+    const allocator = std.testing.allocator;
+    var builder = QueryBuilder.init(allocator, "todos");
+    defer builder.deinit();
+    
+    const sql = try builder.whereEq("user_id", "3").orderBy("title", true).limit(10).offset(20).buildCount();
+    defer allocator.free(sql);
+    
+    try std.testing.expectEqualStrings("SELECT COUNT(*) FROM todos WHERE user_id = '3'", sql);
+}
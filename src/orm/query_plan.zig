@@ -0,0 +1,382 @@
+const std = @import("std");
+const Database = @import("database.zig").Database;
+
+pub const PlanInspectorOptions = struct {
+    pub const OnScan = enum {
+        /// Print the plan and a suggested index
+        log,
+        /// Also return error.FullTableScan from Database.query (for tests)
+        fail,
+    };
+
+    /// Scans of tables with fewer rows than this are not reported
+    min_table_rows: u64 = 1000,
+    on_scan: OnScan = .log,
+};
+
+/// Development/test aid that reports queries planned as full table scans
+/// Attached to a Database, it runs `EXPLAIN QUERY PLAN` the first time each
+/// query shape is seen (literals are normalized out of the fingerprint) and
+/// caches the verdict, so repeated queries cost one hash lookup. A plan step
+/// `SCAN <table>` on a table of at least `min_table_rows` rows is reported with
+/// a suggested `CREATE INDEX` built from the WHERE and ORDER BY columns.
+///
+/// Queries without a WHERE or ORDER BY clause are not reported, since no
+/// index can avoid reading every row for them.
+///
+/// Example:
+/// ```zig
+/// var inspector = QueryPlanInspector.init(allocator, .{ .on_scan = .fail });
+/// defer inspector.deinit();
+/// db.setPlanInspector(&inspector);
+///
+/// // error.FullTableScan, and prints:
+/// //   Suggested: CREATE INDEX idx_todos_user_id ON todos (user_id)
+/// var result = try db.query("SELECT * FROM todos WHERE user_id = 3");
+/// ```
+pub const QueryPlanInspector = struct {
+    allocator: std.mem.Allocator,
+    options: PlanInspectorOptions,
+    mutex: std.Thread.Mutex = .{},
+    /// Query fingerprint -> whether its plan was flagged
+    plans: std.AutoHashMapUnmanaged(u64, bool) = .{},
+    flagged: usize = 0,
+
+    pub fn init(allocator: std.mem.Allocator, options: PlanInspectorOptions) QueryPlanInspector {
+        return .{ .allocator = allocator, .options = options };
+    }
+
+    pub fn deinit(self: *QueryPlanInspector) void {
+        self.plans.deinit(self.allocator);
+    }
+
+    /// Number of distinct query shapes flagged so far
+    pub fn flaggedCount(self: *QueryPlanInspector) usize {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        return self.flagged;
+    }
+
+    /// Inspect `sql` once per fingerprint
+    /// Returns error.FullTableScan for flagged queries in `.fail` mode.
+    pub fn check(self: *QueryPlanInspector, db: *Database, sql: []const u8) !void {
+        if (!isSelect(sql)) return;
+
+        const key = fingerprint(sql);
+        const cached = blk: {
+            self.mutex.lock();
+            defer self.mutex.unlock();
+            break :blk self.plans.get(key);
+        };
+
+        const flagged = cached orelse flagged: {
+            const result = try self.inspect(db, sql);
+            self.mutex.lock();
+            defer self.mutex.unlock();
+            try self.plans.put(self.allocator, key, result);
+            if (result) self.flagged += 1;
+            break :flagged result;
+        };
+
+        if (flagged and self.options.on_scan == .fail) return error.FullTableScan;
+    }
+
+    fn inspect(self: *QueryPlanInspector, db: *Database, sql: []const u8) !bool {
+        if (!hasClause(sql, " WHERE ") and !hasClause(sql, " ORDER BY ")) return false;
+
+        // Plain connection copy so the EXPLAIN itself is not inspected
+        var raw = db.*;
+        raw.plan_inspector = null;
+
+        const plan_sql = try std.fmt.allocPrint(self.allocator, "EXPLAIN QUERY PLAN {s}", .{sql});
+        defer self.allocator.free(plan_sql);
+
+        // Invalid SQL is reported by the real query
+        var plan = raw.query(plan_sql) catch return false;
+        defer plan.deinit();
+
+        var flagged = false;
+        while (plan.nextRow()) |row| {
+            const detail = row.getText(3) orelse continue;
+            const table = scannedTable(detail) orelse continue;
+            const rows = tableRows(&raw, self.allocator, table) catch continue;
+            if (rows < self.options.min_table_rows) continue;
+
+            flagged = true;
+            std.debug.print("[ORM Warning] Full table scan of '{s}' (~{d} rows)\n", .{ table, rows });
+            std.debug.print("  SQL: {s}\n", .{sql});
+            std.debug.print("  Plan: {s}\n", .{detail});
+            if (try suggestIndex(self.allocator, sql, table)) |suggestion| {
+                defer self.allocator.free(suggestion);
+                std.debug.print("  Suggested: {s}\n", .{suggestion});
+            }
+        }
+        return flagged;
+    }
+
+    /// Hash of the query shape: literals become `?`, whitespace and case are folded
+    pub fn fingerprint(sql: []const u8) u64 {
+        var hasher = std.hash.Wyhash.init(0);
+        var i: usize = 0;
+        var pending_space = false;
+        while (i < sql.len) {
+            const char = sql[i];
+            if (std.ascii.isWhitespace(char)) {
+                pending_space = true;
+                i += 1;
+                continue;
+            }
+            if (pending_space) {
+                hasher.update(" ");
+                pending_space = false;
+            }
+            if (char == '\'') {
+                // Skip the string literal, including doubled quotes
+                i += 1;
+                while (i < sql.len) : (i += 1) {
+                    if (sql[i] == '\'') {
+                        if (i + 1 < sql.len and sql[i + 1] == '\'') {
+                            i += 1;
+                        } else break;
+                    }
+                }
+                i += 1;
+                hasher.update("?");
+            } else if (std.ascii.isDigit(char) and (i == 0 or !isIdentChar(sql[i - 1]))) {
+                while (i < sql.len and (std.ascii.isDigit(sql[i]) or sql[i] == '.')) i += 1;
+                hasher.update("?");
+            } else {
+                hasher.update(&[_]u8{std.ascii.toLower(char)});
+                i += 1;
+            }
+        }
+        return hasher.final();
+    }
+
+    /// Suggest an index for the WHERE and ORDER BY columns of `sql`
+    /// Equality columns come first, then ORDER BY columns, then range columns,
+    /// so the index serves the filter, the sort and the range in that order.
+    /// Returns null when no column could be extracted. Caller frees.
+    pub fn suggestIndex(allocator: std.mem.Allocator, sql: []const u8, table: []const u8) !?[]u8 {
+        var equality = std.ArrayListUnmanaged([]const u8){};
+        defer equality.deinit(allocator);
+        var range = std.ArrayListUnmanaged([]const u8){};
+        defer range.deinit(allocator);
+        var ordering = std.ArrayListUnmanaged([]const u8){};
+        defer ordering.deinit(allocator);
+
+        if (clauseBody(sql, " WHERE ")) |where_sql| {
+            var tokens = Tokenizer{ .sql = where_sql };
+            var previous: ?[]const u8 = null;
+            while (tokens.next()) |token| {
+                if (previous) |column| {
+                    if (isEqualityOperator(token)) {
+                        try appendUnique(allocator, &equality, column);
+                    } else if (isRangeOperator(token)) {
+                        try appendUnique(allocator, &range, column);
+                    }
+                }
+                previous = if (isColumnToken(token)) unqualified(token) else null;
+            }
+        }
+
+        if (clauseBody(sql, " ORDER BY ")) |order_sql| {
+            var tokens = Tokenizer{ .sql = order_sql };
+            while (tokens.next()) |token| {
+                if (isColumnToken(token)) try appendUnique(allocator, &ordering, unqualified(token));
+            }
+        }
+
+        var columns = std.ArrayListUnmanaged([]const u8){};
+        defer columns.deinit(allocator);
+        for ([_][]const []const u8{ equality.items, ordering.items, range.items }) |group| {
+            for (group) |column| try appendUnique(allocator, &columns, column);
+        }
+        if (columns.items.len == 0) return null;
+
+        var out = std.ArrayListUnmanaged(u8){};
+        errdefer out.deinit(allocator);
+        try out.writer(allocator).print("CREATE INDEX idx_{s}", .{table});
+        for (columns.items) |column| try out.writer(allocator).print("_{s}", .{column});
+        try out.writer(allocator).print(" ON {s} (", .{table});
+        for (columns.items, 0..) |column, i| {
+            if (i > 0) try out.appendSlice(allocator, ", ");
+            try out.appendSlice(allocator, column);
+        }
+        try out.append(allocator, ')');
+        return try out.toOwnedSlice(allocator);
+    }
+
+    /// Table of a `SCAN <table>` plan step, or null for index-driven steps
+    /// `SCAN t USING INDEX` walks an index in ORDER BY order and stops at the
+    /// LIMIT, so only bare scans and covering-index scans are reported.
+    fn scannedTable(detail: []const u8) ?[]const u8 {
+        if (!std.mem.startsWith(u8, detail, "SCAN ")) return null;
+        const rest = detail["SCAN ".len..];
+        const end = std.mem.indexOfScalar(u8, rest, ' ') orelse rest.len;
+        const table = rest[0..end];
+        const suffix = rest[end..];
+        if (std.mem.eql(u8, table, "CONSTANT") or std.mem.startsWith(u8, table, "(")) return null;
+        if (suffix.len == 0 or std.mem.startsWith(u8, suffix, " USING COVERING INDEX")) return table;
+        return null;
+    }
+
+    fn tableRows(db: *Database, allocator: std.mem.Allocator, table: []const u8) !u64 {
+        // MAX(rowid) is a single b-tree descent, unlike COUNT(*)
+        const sql = try std.fmt.allocPrint(allocator, "SELECT MAX(rowid) FROM \"{s}\"", .{table});
+        defer allocator.free(sql);
+        var result = try db.query(sql);
+        defer result.deinit();
+        const row = result.nextRow() orelse return 0;
+        return @intCast(@max(row.getInt64(0), 0));
+    }
+
+    fn isSelect(sql: []const u8) bool {
+        const trimmed = std.mem.trimLeft(u8, sql, " \t\r\n(");
+        return std.ascii.startsWithIgnoreCase(trimmed, "SELECT") or std.ascii.startsWithIgnoreCase(trimmed, "WITH");
+    }
+
+    fn hasClause(sql: []const u8, comptime keyword: []const u8) bool {
+        return std.ascii.indexOfIgnoreCase(sql, keyword) != null;
+    }
+
+    /// Text between `keyword` and the next clause keyword (or the end)
+    fn clauseBody(sql: []const u8, comptime keyword: []const u8) ?[]const u8 {
+        const start = (std.ascii.indexOfIgnoreCase(sql, keyword) orelse return null) + keyword.len;
+        var end = sql.len;
+        inline for (.{ " GROUP BY ", " ORDER BY ", " LIMIT ", " OFFSET ", " HAVING " }) |next_clause| {
+            if (std.ascii.indexOfIgnoreCase(sql[start..], next_clause)) |pos| end = @min(end, start + pos);
+        }
+        return sql[start..end];
+    }
+
+    fn appendUnique(allocator: std.mem.Allocator, list: *std.ArrayListUnmanaged([]const u8), column: []const u8) !void {
+        for (list.items) |existing| {
+            if (std.ascii.eqlIgnoreCase(existing, column)) return;
+        }
+        try list.append(allocator, column);
+    }
+
+    fn isIdentChar(char: u8) bool {
+        return std.ascii.isAlphanumeric(char) or char == '_';
+    }
+
+    fn isColumnToken(token: []const u8) bool {
+        if (token.len == 0 or !(std.ascii.isAlphabetic(token[0]) or token[0] == '_')) return false;
+        const keywords = [_][]const u8{
+            "AND", "OR",   "NOT",   "NULL", "IS",    "IN",   "LIKE", "GLOB", "BETWEEN",
+            "ASC", "DESC", "NULLS", "FIRST", "LAST", "COLLATE", "TRUE", "FALSE", "ESCAPE",
+        };
+        for (keywords) |keyword| {
+            if (std.ascii.eqlIgnoreCase(token, keyword)) return false;
+        }
+        return true;
+    }
+
+    fn unqualified(token: []const u8) []const u8 {
+        const dot = std.mem.lastIndexOfScalar(u8, token, '.') orelse return token;
+        return token[dot + 1 ..];
+    }
+
+    fn isEqualityOperator(token: []const u8) bool {
+        return std.mem.eql(u8, token, "=") or std.mem.eql(u8, token, "==") or
+            std.ascii.eqlIgnoreCase(token, "IS") or std.ascii.eqlIgnoreCase(token, "IN");
+    }
+
+    fn isRangeOperator(token: []const u8) bool {
+        const operators = [_][]const u8{ "<", ">", "<=", ">=", "BETWEEN", "LIKE", "GLOB" };
+        for (operators) |operator| {
+            if (std.ascii.eqlIgnoreCase(token, operator)) return true;
+        }
+        return false;
+    }
+
+    /// Splits SQL into identifiers, operators and punctuation; literals are skipped
+    const Tokenizer = struct {
+        sql: []const u8,
+        pos: usize = 0,
+
+        fn next(self: *Tokenizer) ?[]const u8 {
+            while (self.pos < self.sql.len) {
+                const char = self.sql[self.pos];
+                if (std.ascii.isWhitespace(char)) {
+                    self.pos += 1;
+                } else if (char == '\'') {
+                    self.pos += 1;
+                    while (self.pos < self.sql.len and self.sql[self.pos] != '\'') self.pos += 1;
+                    self.pos += 1;
+                    return "'";
+                } else if (isIdentChar(char) or char == '"') {
+                    const start = self.pos;
+                    while (self.pos < self.sql.len and (isIdentChar(self.sql[self.pos]) or self.sql[self.pos] == '.' or self.sql[self.pos] == '"')) self.pos += 1;
+                    return std.mem.trim(u8, self.sql[start..self.pos], "\"");
+                } else if (std.mem.indexOfScalar(u8, "<>=!", char) != null) {
+                    const start = self.pos;
+                    while (self.pos < self.sql.len and std.mem.indexOfScalar(u8, "<>=!", self.sql[self.pos]) != null) self.pos += 1;
+                    return self.sql[start..self.pos];
+                } else {
+                    self.pos += 1;
+                    return self.sql[self.pos - 1 .. self.pos];
+                }
+            }
+            return null;
+        }
+    };
+};
+
+test "QueryPlanInspector fingerprint ignores literals and spacing" {
+    const fp = QueryPlanInspector.fingerprint;
+    try std.testing.expectEqual(
+        fp("SELECT * FROM todos WHERE user_id = 3 AND title = 'a''b'"),
+        fp("select *  from todos\nwhere user_id = 42 and title = 'other'"),
+    );
+    try std.testing.expect(fp("SELECT * FROM todos WHERE user_id = 3") != fp("SELECT * FROM todos WHERE priority = 3"));
+    // Digits inside identifiers are part of the shape
+    try std.testing.expect(fp("SELECT col1 FROM t") != fp("SELECT col2 FROM t"));
+}
+
+test "QueryPlanInspector suggestIndex orders equality, sort, range" {
+    const allocator = std.testing.allocator;
+
+    const suggestion = (try QueryPlanInspector.suggestIndex(
+        allocator,
+        "SELECT * FROM todos WHERE user_id = '3' AND due > '5' ORDER BY priority DESC LIMIT 10",
+        "todos",
+    )).?;
+    defer allocator.free(suggestion);
+    try std.testing.expectEqualStrings("CREATE INDEX idx_todos_user_id_priority_due ON todos (user_id, priority, due)", suggestion);
+
+    try std.testing.expect((try QueryPlanInspector.suggestIndex(allocator, "SELECT * FROM todos", "todos")) == null);
+}
+
+test "QueryPlanInspector flags scans of large tables" {
+    const allocator = std.testing.allocator;
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+    try db.execute("CREATE TABLE items (id INTEGER PRIMARY KEY, category TEXT)");
+    try db.execute("CREATE TABLE tiny (id INTEGER PRIMARY KEY, category TEXT)");
+    try db.execute(
+        "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 2000) " ++
+            "INSERT INTO items (category) SELECT 'c' || (i % 10) FROM n",
+    );
+    try db.execute("INSERT INTO tiny (category) VALUES ('a'), ('b')");
+
+    var inspector = QueryPlanInspector.init(allocator, .{ .min_table_rows = 1000, .on_scan = .fail });
+    defer inspector.deinit();
+    db.setPlanInspector(&inspector);
+
+    try std.testing.expectError(error.FullTableScan, db.query("SELECT * FROM items WHERE category = 'c1'"));
+    // Same shape, different literal: served from the cache
+    try std.testing.expectError(error.FullTableScan, db.query("SELECT * FROM items WHERE category = 'c2'"));
+    try std.testing.expectEqual(@as(usize, 1), inspector.flaggedCount());
+
+    // Primary key lookups, small tables and unfiltered reads are fine
+    var by_id = try db.query("SELECT * FROM items WHERE id = 5");
+    by_id.deinit();
+    var small = try db.query("SELECT * FROM tiny WHERE category = 'a'");
+    small.deinit();
+    var all = try db.query("SELECT * FROM items");
+    all.deinit();
+    try std.testing.expectEqual(@as(usize, 1), inspector.flaggedCount());
+}
@@ -1,4 +1,5 @@
 const std = @import("std");
+const Database = @import("database.zig").Database;
 const c = @cImport({
     @cInclude("e12_orm.h");
 });
@@ -15,10 +16,24 @@ pub const ORMError = error{
 pub const Row = struct {
     c_row: *c.E12Row,
 
+    /// Text value, or null for NULL
+    /// The length comes from SQLite, so text with embedded NUL bytes is returned whole.
     pub fn getText(self: Row, col_index: i32) ?[]const u8 {
         const text_ptr = c.e12_row_get_text(self.c_row, col_index);
         if (text_ptr == null) return null;
-        return std.mem.sliceTo(text_ptr, 0);
+        const len: usize = @intCast(c.e12_row_get_bytes(self.c_row, col_index));
+        return text_ptr[0..len];
+    }
+
+    /// Blob value, or null for NULL
+    pub fn getBlob(self: Row, col_index: i32) ?[]const u8 {
+        var len: c_int = 0;
+        const blob_ptr = c.e12_row_get_blob(self.c_row, col_index, &len);
+        if (blob_ptr == null) {
+            return if (self.isNull(col_index)) null else "";
+        }
+        const bytes: [*]const u8 = @ptrCast(blob_ptr);
+        return bytes[0..@intCast(len)];
     }
 
     pub fn getInt64(self: Row, col_index: i32) i64 {
@@ -43,43 +58,90 @@ pub const QueryResult = struct {
     c_result: *c.E12Result,
     allocator: std.mem.Allocator,
     column_count: i32,
-    _column_map: ?std.StringHashMap(i32) = null,
+    /// Hands the connection the rows came from back to its owner on deinit
+    release: ?Release = null,
+
+    pub const Release = struct {
+        context: *anyopaque,
+        callback: *const fn (context: *anyopaque, db: Database) void,
+        db: Database,
+    };
 
     pub fn init(c_result: *c.E12Result, allocator: std.mem.Allocator) QueryResult {
         return QueryResult{
             .c_result = c_result,
             .allocator = allocator,
             .column_count = c.e12_result_column_count(c_result),
-            ._column_map = null,
         };
     }
 
-    /// Build column name -> index mapping (lazy initialization)
-    fn buildColumnMap(self: *QueryResult) !std.StringHashMap(i32) {
-        if (self._column_map) |*map| {
-            return map.*;
+    /// Column position of every field of `T`, in field order
+    pub fn ColumnPlan(comptime T: type) type {
+        return [std.meta.fields(T).len]i32;
+    }
+
+    /// Match result columns to the fields of `T` by name, once per result
+    /// Rows are then decoded by direct index: no per-row lookups and no allocation.
+    /// Returns error.ColumnMismatch unless every field has a column and every
+    /// column has a field.
+    pub fn columnPlan(self: *QueryResult, comptime T: type) !ColumnPlan(T) {
+        return self.matchColumns(T, self.column_count);
+    }
+
+    /// columnPlan() over the first `column_count` columns only
+    fn matchColumns(self: *QueryResult, comptime T: type, column_count: i32) !ColumnPlan(T) {
+        const fields = std.meta.fields(T);
+        var plan: ColumnPlan(T) = @splat(-1);
+        var unmatched_columns: usize = 0;
+
+        var col_idx: i32 = 0;
+        while (col_idx < column_count) : (col_idx += 1) {
+            const name = self.columnName(col_idx) orelse "";
+            var matched = false;
+            inline for (fields, 0..) |field, i| {
+                if (!matched and plan[i] == -1 and std.mem.eql(u8, name, field.name)) {
+                    plan[i] = col_idx;
+                    matched = true;
+                }
+            }
+            if (!matched) unmatched_columns += 1;
+        }
+
+        var missing_fields: usize = 0;
+        for (plan) |index| {
+            if (index == -1) missing_fields += 1;
         }
 
-        var column_map = std.StringHashMap(i32).init(self.allocator);
-        errdefer column_map.deinit();
+        if (missing_fields > 0) {
+            std.debug.print("[ORM Error] Missing columns for struct fields:\n", .{});
+            inline for (fields, 0..) |field, i| {
+                if (plan[i] == -1) std.debug.print("  - {s}\n", .{field.name});
+            }
+            self.printColumns("Available columns:");
+            return error.ColumnMismatch;
+        }
 
-        for (0..@as(usize, @intCast(self.column_count))) |i| {
-            const col_idx = @as(i32, @intCast(i));
-            if (self.columnName(col_idx)) |name| {
-                // Duplicate the column name string for the map key
-                const name_copy = try self.allocator.dupe(u8, name);
-                try column_map.put(name_copy, col_idx);
+        // Check for extra columns that don't match struct fields
+        if (unmatched_columns > 0) {
+            std.debug.print("[ORM Error] Extra columns in query result that don't match struct fields:\n", .{});
+            std.debug.print("Struct has {d} fields, but query returned {d} columns\n", .{ fields.len, column_count });
+            std.debug.print("Struct fields:\n", .{});
+            inline for (fields) |field| {
+                std.debug.print("  - {s}\n", .{field.name});
             }
+            self.printColumns("Query columns:");
+            return error.ColumnMismatch;
         }
 
-        self._column_map = column_map;
-        return column_map;
+        return plan;
     }
 
-    /// Get column index by name, building the map if necessary
-    fn getColumnIndex(self: *QueryResult, field_name: []const u8) !?i32 {
-        const column_map = try self.buildColumnMap();
-        return column_map.get(field_name);
+    fn printColumns(self: *QueryResult, comptime heading: []const u8) void {
+        std.debug.print(heading ++ "\n", .{});
+        var col_idx: i32 = 0;
+        while (col_idx < self.column_count) : (col_idx += 1) {
+            std.debug.print("  - {s}\n", .{self.columnName(col_idx) orelse "?"});
+        }
     }
 
     pub fn columnCount(self: QueryResult) i32 {
@@ -92,196 +154,280 @@ pub const QueryResult = struct {
         return std.mem.sliceTo(name_ptr, 0);
     }
 
+    /// Advance to the next row; returns null at the end or if stepping fails
+    /// The returned Row is a handle owned by the result and reused for every
+    /// row, so no allocation happens per row. Use step() to see errors.
     pub fn nextRow(self: *QueryResult) ?Row {
+        return self.step() catch null;
+    }
+
+    /// Advance to the next row, returning error.QueryFailed if SQLite fails mid-scan
+    pub fn step(self: *QueryResult) !?Row {
         var c_row: ?*c.E12Row = null;
-        if (c.e12_result_next_row(self.c_result, &c_row)) {
-            if (c_row) |row| {
-                return Row{ .c_row = row };
+        if (c.e12_result_step(self.c_result, &c_row) != c.E12_ORM_OK) {
+            const error_msg = c.e12_orm_get_last_error();
+            if (error_msg != null) {
+                std.debug.print("[Database Error] Failed to read next row\n", .{});
+                std.debug.print("  C API Error: {s}\n", .{error_msg});
             }
+            return error.QueryFailed;
+        }
+        if (c_row) |row| {
+            return Row{ .c_row = row };
         }
         return null;
     }
 
-    pub fn deinit(self: *QueryResult) void {
-        if (self._column_map) |*map| {
-            // Free all allocated column name strings
-            var iterator = map.iterator();
-            while (iterator.next()) |entry| {
-                self.allocator.free(entry.key_ptr.*);
+    /// Iterate rows as `T` one at a time without building a list
+    /// Column positions are resolved once, and each row is decoded in place,
+    /// so memory use stays constant however many rows the query returns.
+    ///
+    /// `next()` allocates nothing: string fields point into SQLite's row buffer
+    /// and are only valid until the following `next()` call or `deinit()`.
+    /// Use `nextAlloc()` for rows that must outlive the iteration.
+    ///
+    /// Example:
+    /// ```zig
+    /// var result = try db.query("SELECT id, title, completed FROM todos");
+    /// defer result.deinit();
+    /// var it = try result.iterator(Todo);
+    /// while (try it.next()) |todo| {
+    ///     if (todo.completed) completed += 1;
+    /// }
+    /// ```
+    pub fn iterator(self: *QueryResult, comptime T: type) !RowIterator(T) {
+        return RowIterator(T){ .result = self, .plan = try self.columnPlan(T) };
+    }
+
+    pub fn RowIterator(comptime T: type) type {
+        return struct {
+            const Self = @This();
+
+            result: *QueryResult,
+            plan: ColumnPlan(T),
+
+            /// Next row with borrowed strings (valid until the next call)
+            pub fn next(self: *Self) !?T {
+                const row = try self.result.step() orelse return null;
+                return try decodeRow(T, row, &self.plan, null);
             }
-            map.deinit();
-        }
+
+            /// Next row with strings copied into `allocator` (caller frees)
+            pub fn nextAlloc(self: *Self, allocator: std.mem.Allocator) !?T {
+                const row = try self.result.step() orelse return null;
+                return try decodeRow(T, row, &self.plan, allocator);
+            }
+        };
+    }
+
+    pub fn deinit(self: *QueryResult) void {
         c.e12_result_free(self.c_result);
+        if (self.release) |release| release.callback(release.context, release.db);
     }
 
     pub fn toArrayList(self: *QueryResult, comptime T: type) !std.ArrayListUnmanaged(T) {
+        return self.toArrayListAlloc(T, self.allocator);
+    }
+
+    /// Decode every row, allocating the list and all strings in `allocator`
+    /// With an arena (e.g. the request arena) teardown is a single arena reset,
+    /// with no per-field frees.
+    ///
+    /// Example:
+    /// ```zig
+    /// const items = try result.toArrayListAlloc(Todo, request.arena.allocator());
+    /// return Response.jsonFrom([]const Todo, items.items, allocator);
+    /// ```
+    pub fn toArrayListAlloc(self: *QueryResult, comptime T: type, allocator: std.mem.Allocator) !std.ArrayListUnmanaged(T) {
         var list = std.ArrayListUnmanaged(T){};
-        errdefer list.deinit(self.allocator);
+        errdefer list.deinit(allocator);
 
-        // Build column map to validate all required fields are present
-        const column_map = try self.buildColumnMap();
+        var it = try self.iterator(T);
+        while (try it.nextAlloc(allocator)) |item| {
+            try list.append(allocator, item);
+        }
 
-        // Validate that all struct fields have corresponding columns
-        var missing_fields = std.ArrayListUnmanaged([]const u8){};
-        defer missing_fields.deinit(self.allocator);
+        return list;
+    }
 
-        inline for (std.meta.fields(T)) |field| {
-            if (column_map.get(field.name) == null) {
-                try missing_fields.append(self.allocator, field.name);
-            }
-        }
+    pub fn PageWithTotal(comptime T: type) type {
+        return struct {
+            items: std.ArrayListUnmanaged(T),
+            /// Value of the trailing total column; null when there were no rows
+            total: ?i64,
+        };
+    }
 
-        if (missing_fields.items.len > 0) {
-            std.debug.print("[ORM Error] Missing columns for struct fields:\n", .{});
-            for (missing_fields.items) |field_name| {
-                std.debug.print("  - {s}\n", .{field_name});
-            }
-            std.debug.print("Available columns:\n", .{});
-            var iterator = column_map.iterator();
-            while (iterator.next()) |entry| {
-                std.debug.print("  - {s}\n", .{entry.key_ptr.*});
-            }
-            return error.ColumnMismatch;
-        }
+    /// Decode a page whose last column is a window total rather than a field
+    /// Pairs with `SELECT *, COUNT(*) OVER () ...`: the total of the whole
+    /// filtered set arrives with the page, so no second COUNT query is needed.
+    ///
+    /// Example:
+    /// ```zig
+    /// var result = try orm.query("SELECT *, COUNT(*) OVER () AS e12_total FROM todos LIMIT 20");
+    /// defer result.deinit();
+    /// const page = try result.toArrayListWithTotal(Todo, arena);
+    /// // page.items.items.len <= 20, page.total == number of todos
+    /// ```
+    pub fn toArrayListWithTotal(self: *QueryResult, comptime T: type, allocator: std.mem.Allocator) !PageWithTotal(T) {
+        if (self.column_count < 1) return error.ColumnMismatch;
+        const total_column = self.column_count - 1;
+        const plan = try self.matchColumns(T, total_column);
 
-        // Check for extra columns that don't match struct fields
-        const struct_field_count = std.meta.fields(T).len;
-        if (column_map.count() > struct_field_count) {
-            std.debug.print("[ORM Error] Extra columns in query result that don't match struct fields:\n", .{});
-            std.debug.print("Struct has {d} fields, but query returned {d} columns\n", .{ struct_field_count, column_map.count() });
-            std.debug.print("Struct fields:\n", .{});
-            inline for (std.meta.fields(T)) |field| {
-                std.debug.print("  - {s}\n", .{field.name});
-            }
-            std.debug.print("Query columns:\n", .{});
-            var iterator = column_map.iterator();
-            while (iterator.next()) |entry| {
-                std.debug.print("  - {s}\n", .{entry.key_ptr.*});
-            }
-            return error.ColumnMismatch;
+        var list = std.ArrayListUnmanaged(T){};
+        errdefer list.deinit(allocator);
+
+        var total: ?i64 = null;
+        while (try self.step()) |row| {
+            if (total == null) total = row.getInt64(total_column);
+            try list.append(allocator, try decodeRow(T, row, &plan, allocator));
         }
 
-        while (self.nextRow()) |row| {
-            const item = self.rowToStruct(T, row) catch |err| {
-                return err;
-            };
-            try list.append(self.allocator, item);
+        return .{ .items = list, .total = total };
+    }
+
+    pub fn SearchHit(comptime T: type) type {
+        return struct {
+            item: T,
+            /// bm25 score: lower (more negative) is a better match
+            rank: f64,
+            /// Excerpt around the matched terms, with highlight markers
+            snippet: []const u8,
+        };
+    }
+
+    /// Decode full-text search results: the model's columns followed by a
+    /// rank column and a snippet column (see ORM.search)
+    pub fn toSearchHits(self: *QueryResult, comptime T: type, allocator: std.mem.Allocator) !std.ArrayListUnmanaged(SearchHit(T)) {
+        if (self.column_count < 2) return error.ColumnMismatch;
+        const rank_column = self.column_count - 2;
+        const plan = try self.matchColumns(T, rank_column);
+
+        var hits = std.ArrayListUnmanaged(SearchHit(T)){};
+        errdefer hits.deinit(allocator);
+
+        while (try self.step()) |row| {
+            try hits.append(allocator, .{
+                .item = try decodeRow(T, row, &plan, allocator),
+                .rank = row.getDouble(rank_column),
+                .snippet = try allocator.dupe(u8, row.getText(rank_column + 1) orelse ""),
+            });
         }
 
-        return list;
+        return hits;
     }
+};
 
-    fn rowToStruct(self: *QueryResult, comptime T: type, row: Row) !T {
-        // Initialize struct - all fields will be set in the loop below
-        // Using undefined is safe here because all fields are explicitly initialized
-        var instance: T = undefined;
-
-        // Build column name -> index mapping (cached after first call)
-        const column_map = try self.buildColumnMap();
-
-        // Map struct fields to columns by name
-        inline for (std.meta.fields(T)) |field| {
-            // Get column index for this field name
-            const col_idx = column_map.get(field.name) orelse {
-                // Field not found in query result - this is an error
-                std.debug.print("[ORM Error] Field '{s}' not found in query result columns\n", .{field.name});
-                return error.ColumnMismatch;
-            };
-
-            const field_type = @TypeOf(@field(instance, field.name));
-
-            if (row.isNull(col_idx)) {
-                const is_optional = @typeInfo(field_type) == .optional;
-                if (is_optional) {
-                    @field(instance, field.name) = null;
-                } else {
-                    // For non-optional fields, set to default value
-                    @field(instance, field.name) = @as(field_type, switch (@typeInfo(field_type)) {
-                        .int => 0,
-                        .float => 0.0,
-                        .bool => false,
-                        else => return error.NullValueForNonOptional, // Can't handle null for this type
-                    });
-                }
+/// Decode the current row into `T` using precomputed column positions
+/// Strings are copied into `allocator`, or borrowed from the row buffer when it is null.
+fn decodeRow(comptime T: type, row: Row, plan: *const QueryResult.ColumnPlan(T), allocator: ?std.mem.Allocator) !T {
+    // Initialize struct - all fields will be set in the loop below
+    // Using undefined is safe here because all fields are explicitly initialized
+    var instance: T = undefined;
+
+    inline for (std.meta.fields(T), 0..) |field, i| {
+        const col_idx = plan[i];
+
+        const field_type = @TypeOf(@field(instance, field.name));
+
+        if (row.isNull(col_idx)) {
+            const is_optional = @typeInfo(field_type) == .optional;
+            if (is_optional) {
+                @field(instance, field.name) = null;
             } else {
-                switch (@typeInfo(field_type)) {
-                    .int => {
-                        @field(instance, field.name) = @as(field_type, @intCast(row.getInt64(col_idx)));
-                    },
-                    .float => {
-                        @field(instance, field.name) = @as(field_type, @floatCast(row.getDouble(col_idx)));
-                    },
-                    .bool => {
-                        @field(instance, field.name) = row.getInt64(col_idx) != 0;
-                    },
-                    .pointer => |ptr_info| {
-                        if (ptr_info.size == .slice and ptr_info.child == u8) {
-                            const text = row.getText(col_idx) orelse return error.InvalidData;
-                            @field(instance, field.name) = try self.allocator.dupe(u8, text);
-                        } else {
-                            @compileError("ORM error: Unsupported pointer type for field '" ++ field.name ++ "' of type '" ++ @typeName(field_type) ++ "'. " ++
-                                "Only slice pointers ([]const u8, []u8) are supported. " ++
-                                "For other pointer types, use []const u8 or []u8 instead.");
-                        }
-                    },
-                    .optional => |opt_info| {
-                        const inner_type = opt_info.child;
-
-                        // Handle null optional values
-                        if (row.isNull(col_idx)) {
-                            @field(instance, field.name) = null;
-                        } else {
-                            switch (@typeInfo(inner_type)) {
-                                .int => {
-                                    @field(instance, field.name) = @as(inner_type, @intCast(row.getInt64(col_idx)));
-                                },
-                                .float => {
-                                    @field(instance, field.name) = @as(inner_type, @floatCast(row.getDouble(col_idx)));
-                                },
-                                .bool => {
-                                    @field(instance, field.name) = row.getInt64(col_idx) != 0;
-                                },
-                                .pointer => |ptr_info| {
-                                    if (ptr_info.size == .slice and ptr_info.child == u8) {
-                                        const text = row.getText(col_idx) orelse return error.InvalidData;
-                                        @field(instance, field.name) = try self.allocator.dupe(u8, text);
-                                    } else {
-                                        @compileError("ORM error: Unsupported optional pointer type for field '" ++ field.name ++ "'. " ++
-                                            "Optional pointer types are not supported. " ++
-                                            "Use optional slice (?[]const u8) or optional struct field instead.");
-                                    }
-                                },
-                                .@"enum" => {
-                                    // Enums are stored as integers
-                                    // Get the underlying integer type of the enum
-                                    const enum_int_type = @typeInfo(inner_type).@"enum".tag_type;
-                                    const enum_int_value = @as(enum_int_type, @intCast(row.getInt64(col_idx)));
-                                    const enum_value = @as(inner_type, @enumFromInt(enum_int_value));
-                                    @field(instance, field.name) = enum_value;
-                                },
-                                else => @compileError("ORM error: Unsupported optional type for field '" ++ field.name ++ "'. " ++
-                                    "Only basic types (int, float, bool, string, enum) can be optional. " ++
-                                    "Got: " ++ @typeName(field_type)),
-                            }
+                // For non-optional fields, set to default value
+                @field(instance, field.name) = @as(field_type, switch (@typeInfo(field_type)) {
+                    .int => 0,
+                    .float => 0.0,
+                    .bool => false,
+                    else => return error.NullValueForNonOptional, // Can't handle null for this type
+                });
+            }
+        } else {
+            switch (@typeInfo(field_type)) {
+                .int => {
+                    @field(instance, field.name) = @as(field_type, @intCast(row.getInt64(col_idx)));
+                },
+                .float => {
+                    @field(instance, field.name) = @as(field_type, @floatCast(row.getDouble(col_idx)));
+                },
+                .bool => {
+                    @field(instance, field.name) = row.getInt64(col_idx) != 0;
+                },
+                .pointer => |ptr_info| {
+                    if (ptr_info.size == .slice and ptr_info.child == u8) {
+                        const text = row.getText(col_idx) orelse return error.InvalidData;
+                        @field(instance, field.name) = try textValue(text, allocator);
+                    } else {
+                        @compileError("ORM error: Unsupported pointer type for field '" ++ field.name ++ "' of type '" ++ @typeName(field_type) ++ "'. " ++
+                            "Only slice pointers ([]const u8, []u8) are supported. " ++
+                            "For other pointer types, use []const u8 or []u8 instead.");
+                    }
+                },
+                .optional => |opt_info| {
+                    const inner_type = opt_info.child;
+
+                    // Handle null optional values
+                    if (row.isNull(col_idx)) {
+                        @field(instance, field.name) = null;
+                    } else {
+                        switch (@typeInfo(inner_type)) {
+                            .int => {
+                                @field(instance, field.name) = @as(inner_type, @intCast(row.getInt64(col_idx)));
+                            },
+                            .float => {
+                                @field(instance, field.name) = @as(inner_type, @floatCast(row.getDouble(col_idx)));
+                            },
+                            .bool => {
+                                @field(instance, field.name) = row.getInt64(col_idx) != 0;
+                            },
+                            .pointer => |ptr_info| {
+                                if (ptr_info.size == .slice and ptr_info.child == u8) {
+                                    const text = row.getText(col_idx) orelse return error.InvalidData;
+                                    @field(instance, field.name) = try textValue(text, allocator);
+                                } else {
+                                    @compileError("ORM error: Unsupported optional pointer type for field '" ++ field.name ++ "'. " ++
+                                        "Optional pointer types are not supported. " ++
+                                        "Use optional slice (?[]const u8) or optional struct field instead.");
+                                }
+                            },
+                            .@"enum" => {
+                                // Enums are stored as integers
+                                // Get the underlying integer type of the enum
+                                const enum_int_type = @typeInfo(inner_type).@"enum".tag_type;
+                                const enum_int_value = @as(enum_int_type, @intCast(row.getInt64(col_idx)));
+                                const enum_value = @as(inner_type, @enumFromInt(enum_int_value));
+                                @field(instance, field.name) = enum_value;
+                            },
+                            else => @compileError("ORM error: Unsupported optional type for field '" ++ field.name ++ "'. " ++
+                                "Only basic types (int, float, bool, string, enum) can be optional. " ++
+                                "Got: " ++ @typeName(field_type)),
                         }
-                    },
-                    .@"enum" => {
-                        // Enums are stored as integers
-                        const enum_int_type = @typeInfo(field_type).@"enum".tag_type;
-                        const enum_int_value = @as(enum_int_type, @intCast(row.getInt64(col_idx)));
-                        const enum_value = @as(field_type, @enumFromInt(enum_int_value));
-                        @field(instance, field.name) = enum_value;
-                    },
-                    else => @compileError("ORM error: Unsupported field type '" ++ @typeName(field_type) ++ "' for field '" ++ field.name ++ "'. " ++
-                        "Supported types: integers (i64, i32, u32, etc.), floats (f64, f32), bools, strings ([]const u8, []u8), " ++
-                        "and enums. For complex types, consider storing as JSON text."),
-                }
+                    }
+                },
+                .@"enum" => {
+                    // Enums are stored as integers
+                    const enum_int_type = @typeInfo(field_type).@"enum".tag_type;
+                    const enum_int_value = @as(enum_int_type, @intCast(row.getInt64(col_idx)));
+                    const enum_value = @as(field_type, @enumFromInt(enum_int_value));
+                    @field(instance, field.name) = enum_value;
+                },
+                else => @compileError("ORM error: Unsupported field type '" ++ @typeName(field_type) ++ "' for field '" ++ field.name ++ "'. " ++
+                    "Supported types: integers (i64, i32, u32, etc.), floats (f64, f32), bools, strings ([]const u8, []u8), " ++
+                    "and enums. For complex types, consider storing as JSON text."),
             }
         }
-
-        return instance;
     }
-};
+
+    return instance;
+}
+
+/// Text column value, owned by `allocator` or borrowed from the row buffer
+/// Borrowed text must not be modified even when the field type is `[]u8`.
+fn textValue(text: []const u8, allocator: ?std.mem.Allocator) ![]u8 {
+    if (allocator) |a| return try a.dupe(u8, text);
+    return @constCast(text);
+}
 
 test "Row getText" {
     const allocator = std.testing.allocator;
@@ -622,3 +768,99 @@ test "QueryResult toArrayList with reordered columns in SELECT" {
         try std.testing.expectEqualStrings("Description", desc);
     }
 }
+
+test "QueryResult iterator streams rows without a list" {
+    const allocator = std.testing.allocator;
+    const Database = @import("database.zig").Database;
+
+    const Todo = struct {
+        id: i64,
+        title: []const u8,
+        completed: bool,
+    };
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+
+    try db.execute("CREATE TABLE todos (id INTEGER PRIMARY KEY, title TEXT, completed INTEGER)");
+    try db.execute(
+        \\WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 1000)
+        \\INSERT INTO todos (title, completed) SELECT 'todo ' || i, i % 2 FROM n
+    );
+
+    var result = try db.query("SELECT title, completed, id FROM todos ORDER BY id");
+    defer result.deinit();
+
+    var it = try result.iterator(Todo);
+    var count: usize = 0;
+    var completed: usize = 0;
+    while (try it.next()) |todo| {
+        count += 1;
+        if (todo.completed) completed += 1;
+        if (todo.id == 42) try std.testing.expectEqualStrings("todo 42", todo.title);
+    }
+
+    try std.testing.expectEqual(@as(usize, 1000), count);
+    try std.testing.expectEqual(@as(usize, 500), completed);
+
+    // Exhausted results stay exhausted instead of restarting the statement
+    try std.testing.expect((try it.next()) == null);
+    try std.testing.expect(result.nextRow() == null);
+}
+
+test "QueryResult columnPlan maps fields by position once" {
+    const allocator = std.testing.allocator;
+    const Database = @import("database.zig").Database;
+
+    const Pair = struct {
+        key: []const u8,
+        value: i64,
+    };
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+
+    var result = try db.query("SELECT 7 AS value, 'a' || char(0) || 'b' AS key");
+    defer result.deinit();
+
+    const plan = try result.columnPlan(Pair);
+    try std.testing.expectEqual(@as(i32, 1), plan[0]);
+    try std.testing.expectEqual(@as(i32, 0), plan[1]);
+
+    var it = QueryResult.RowIterator(Pair){ .result = &result, .plan = plan };
+    const pair = (try it.next()).?;
+    // Length comes from sqlite3_column_bytes, so the embedded NUL is kept
+    try std.testing.expectEqualSlices(u8, "a\x00b", pair.key);
+    try std.testing.expectEqual(@as(i64, 7), pair.value);
+}
+
+test "QueryResult toArrayListWithTotal reads a window total" {
+    const allocator = std.testing.allocator;
+    const Database = @import("database.zig").Database;
+
+    const Item = struct {
+        id: i64,
+        name: []const u8,
+    };
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+    try db.execute("CREATE TABLE items (id INTEGER PRIMARY KEY, name TEXT)");
+    try db.execute("INSERT INTO items (name) VALUES ('a'), ('b'), ('c'), ('d'), ('e')");
+
+    var arena = std.heap.ArenaAllocator.init(allocator);
+    defer arena.deinit();
+
+    var result = try db.query("SELECT *, COUNT(*) OVER () AS e12_total FROM items ORDER BY id LIMIT 2 OFFSET 2");
+    defer result.deinit();
+    const page = try result.toArrayListWithTotal(Item, arena.allocator());
+    try std.testing.expectEqual(@as(usize, 2), page.items.items.len);
+    try std.testing.expectEqualStrings("c", page.items.items[0].name);
+    try std.testing.expectEqual(@as(?i64, 5), page.total);
+
+    var past_end = try db.query("SELECT *, COUNT(*) OVER () AS e12_total FROM items LIMIT 2 OFFSET 10");
+    defer past_end.deinit();
+    const empty = try past_end.toArrayListWithTotal(Item, arena.allocator());
+    try std.testing.expectEqual(@as(usize, 0), empty.items.items.len);
+    try std.testing.expect(empty.total == null);
+}
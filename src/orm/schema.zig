@@ -130,6 +130,81 @@ pub const Schema = struct {
 
         return (result.nextRow() != null);
     }
+
+    /// Check that an index exists and covers exactly `columns`, in order
+    /// Returns false for a missing index or one built on different columns.
+    ///
+    /// Example:
+    /// ```zig
+    /// if (!try Schema.indexMatches(&db, "idx_todos_user_id", &.{"user_id"})) {
+    ///     return error.IndexMismatch;
+    /// }
+    /// ```
+    pub fn indexMatches(db: *Database, index_name: []const u8, columns: []const []const u8) !bool {
+        const sql = try std.fmt.allocPrint(
+            std.heap.page_allocator,
+            "PRAGMA index_info({s})",
+            .{index_name},
+        );
+        defer std.heap.page_allocator.free(sql);
+
+        var result = try db.query(sql);
+        defer result.deinit();
+
+        // PRAGMA index_info returns: seqno, cid, name (in seqno order)
+        var count: usize = 0;
+        while (result.nextRow()) |row| : (count += 1) {
+            if (count >= columns.len) return false;
+            const name = row.getText(2) orelse return false;
+            if (!std.mem.eql(u8, name, columns[count])) return false;
+        }
+        return count == columns.len and count > 0;
+    }
+
+    /// Check whether some full (non-partial) index on `table` starts with
+    /// `columns`, in order
+    /// Lookups and sorts on `columns` can already use such an index, so
+    /// another index on exactly `columns` would be redundant.
+    ///
+    /// Example:
+    /// ```zig
+    /// // true when idx_todos_user_id_created_at exists
+    /// const covered = try Schema.hasIndexPrefix(&db, "todos", &.{"user_id"});
+    /// ```
+    pub fn hasIndexPrefix(db: *Database, table: []const u8, columns: []const []const u8) !bool {
+        if (columns.len == 0) return false;
+
+        const sql = try std.fmt.allocPrint(
+            std.heap.page_allocator,
+            "SELECT il.name FROM pragma_index_list('{s}') il WHERE il.partial = 0 " ++
+                "AND (SELECT COUNT(*) FROM pragma_index_info(il.name)) >= {d}",
+            .{ table, columns.len },
+        );
+        defer std.heap.page_allocator.free(sql);
+
+        var result = try db.query(sql);
+        defer result.deinit();
+
+        while (result.nextRow()) |row| {
+            const index_name = row.getText(0) orelse continue;
+            const info_sql = try std.fmt.allocPrint(
+                std.heap.page_allocator,
+                "SELECT name FROM pragma_index_info('{s}') ORDER BY seqno LIMIT {d}",
+                .{ index_name, columns.len },
+            );
+            defer std.heap.page_allocator.free(info_sql);
+
+            var info = try db.query(info_sql);
+            defer info.deinit();
+
+            var count: usize = 0;
+            while (info.nextRow()) |column| : (count += 1) {
+                const name = column.getText(0) orelse break;
+                if (!std.mem.eql(u8, name, columns[count])) break;
+            } else if (count == columns.len) return true;
+        }
+        return false;
+    }
 };
 
 // Tests
@@ -215,3 +290,23 @@ test "Schema.getColumns" {
     try std.testing.expect(found_id);
     try std.testing.expect(found_name);
 }
+
+test "Schema.indexMatches" {
+    const allocator = std.testing.allocator;
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+
+    try db.execute("CREATE TABLE todos (id INTEGER PRIMARY KEY, user_id INTEGER, created_at INTEGER)");
+    try db.execute("CREATE INDEX idx_todos_user_id_created_at ON todos (user_id, created_at)");
+
+    try std.testing.expect(try Schema.indexMatches(&db, "idx_todos_user_id_created_at", &.{ "user_id", "created_at" }));
+    try std.testing.expect(!try Schema.indexMatches(&db, "idx_todos_user_id_created_at", &.{"user_id"}));
+    try std.testing.expect(!try Schema.indexMatches(&db, "idx_todos_user_id_created_at", &.{ "created_at", "user_id" }));
+    try std.testing.expect(!try Schema.indexMatches(&db, "idx_missing", &.{"user_id"}));
+
+    try std.testing.expect(try Schema.hasIndexPrefix(&db, "todos", &.{"user_id"}));
+    try std.testing.expect(try Schema.hasIndexPrefix(&db, "todos", &.{ "user_id", "created_at" }));
+    try std.testing.expect(!try Schema.hasIndexPrefix(&db, "todos", &.{"created_at"}));
+    try std.testing.expect(!try Schema.hasIndexPrefix(&db, "todos", &.{ "user_id", "created_at", "id" }));
+}
@@ -0,0 +1,216 @@
+const std = @import("std");
+const model = @import("model.zig");
+
+/// Full-text index on a model table
+/// An FTS5 external-content table `<table>_fts` indexes `columns` of `table`
+/// without storing a second copy of the text. Triggers on the content table
+/// keep it in sync.
+pub const SearchDef = struct {
+    table: []const u8,
+    columns: []const []const u8,
+
+    /// `<table>_fts`; caller frees
+    pub fn ftsTable(self: SearchDef, allocator: std.mem.Allocator) ![]u8 {
+        return std.fmt.allocPrint(allocator, "{s}_fts", .{self.table});
+    }
+
+    /// Position of `column` in the FTS table, for snippet()/highlight()
+    pub fn columnIndex(self: SearchDef, column: []const u8) ?usize {
+        for (self.columns, 0..) |candidate, i| {
+            if (std.mem.eql(u8, candidate, column)) return i;
+        }
+        return null;
+    }
+
+    /// FTS table plus insert/delete/update triggers; caller frees
+    /// Safe to run repeatedly (every statement is IF NOT EXISTS).
+    pub fn createSql(self: SearchDef, allocator: std.mem.Allocator) ![:0]u8 {
+        var out = std.ArrayListUnmanaged(u8){};
+        errdefer out.deinit(allocator);
+        const w = out.writer(allocator);
+        const t = self.table;
+
+        try w.print("CREATE VIRTUAL TABLE IF NOT EXISTS {s}_fts USING fts5(", .{t});
+        try self.writeColumns(w, "");
+        try w.print(", content='{s}', content_rowid='id');\n", .{t});
+
+        try w.print("CREATE TRIGGER IF NOT EXISTS {s}_fts_ai AFTER INSERT ON {s} BEGIN\n", .{ t, t });
+        try self.writeInsert(w, "new");
+        try w.writeAll("END;\n");
+
+        try w.print("CREATE TRIGGER IF NOT EXISTS {s}_fts_ad AFTER DELETE ON {s} BEGIN\n", .{ t, t });
+        try self.writeDelete(w);
+        try w.writeAll("END;\n");
+
+        // Only edits to indexed columns touch the FTS index
+        try w.print("CREATE TRIGGER IF NOT EXISTS {s}_fts_au AFTER UPDATE OF ", .{t});
+        try self.writeColumns(w, "");
+        try w.print(" ON {s} BEGIN\n", .{t});
+        try self.writeDelete(w);
+        try self.writeInsert(w, "new");
+        try w.writeAll("END;");
+
+        return out.toOwnedSliceSentinel(allocator, 0);
+    }
+
+    /// Re-index every existing row of the content table; caller frees
+    pub fn rebuildSql(self: SearchDef, allocator: std.mem.Allocator) ![:0]u8 {
+        return std.fmt.allocPrintSentinel(allocator, "INSERT INTO {s}_fts({s}_fts) VALUES ('rebuild');", .{ self.table, self.table }, 0);
+    }
+
+    /// Drop the triggers and the FTS table; caller frees
+    pub fn dropSql(self: SearchDef, allocator: std.mem.Allocator) ![:0]u8 {
+        const t = self.table;
+        return std.fmt.allocPrintSentinel(allocator,
+            \\DROP TRIGGER IF EXISTS {s}_fts_ai;
+            \\DROP TRIGGER IF EXISTS {s}_fts_ad;
+            \\DROP TRIGGER IF EXISTS {s}_fts_au;
+            \\DROP TABLE IF EXISTS {s}_fts;
+        , .{ t, t, t, t }, 0);
+    }
+
+    fn writeColumns(self: SearchDef, w: anytype, comptime prefix: []const u8) !void {
+        for (self.columns, 0..) |column, i| {
+            if (i > 0) try w.writeAll(", ");
+            try w.print(prefix ++ "{s}", .{column});
+        }
+    }
+
+    fn writeInsert(self: SearchDef, w: anytype, comptime row: []const u8) !void {
+        try w.print("  INSERT INTO {s}_fts(rowid, ", .{self.table});
+        try self.writeColumns(w, "");
+        try w.writeAll(") VALUES (" ++ row ++ ".id, ");
+        try self.writeColumns(w, row ++ ".");
+        try w.writeAll(");\n");
+    }
+
+    fn writeDelete(self: SearchDef, w: anytype) !void {
+        try w.print("  INSERT INTO {s}_fts({s}_fts, rowid, ", .{ self.table, self.table });
+        try self.writeColumns(w, "");
+        try w.writeAll(") VALUES ('delete', old.id, ");
+        try self.writeColumns(w, "old.");
+        try w.writeAll(");\n");
+    }
+};
+
+/// Full-text index declared by a model through `pub const search_fields`
+/// The model needs an integer `id` primary key; fields must be strings.
+///
+/// Example:
+/// ```zig
+/// const Todo = struct {
+///     id: i64,
+///     title: []const u8,
+///     description: []const u8,
+///
+///     pub const search_fields = .{ "title", "description" };
+/// };
+/// // modelSearch(Todo).?.columns == &.{ "title", "description" }
+/// ```
+pub fn modelSearch(comptime T: type) ?SearchDef {
+    comptime {
+        if (!@hasDecl(T, "search_fields")) return null;
+        if (!@hasField(T, "id")) @compileError(@typeName(T) ++ " declares search_fields but has no id field");
+        if (T.search_fields.len == 0) @compileError("Empty search_fields declared on " ++ @typeName(T));
+
+        var columns: [T.search_fields.len][]const u8 = undefined;
+        for (T.search_fields, 0..) |column, i| {
+            if (!@hasField(T, column)) {
+                @compileError("search_fields on " ++ @typeName(T) ++ " names unknown field '" ++ column ++ "'");
+            }
+            columns[i] = column;
+        }
+        const final_columns = columns;
+        return SearchDef{ .table = model.comptimeTableName(T), .columns = &final_columns };
+    }
+}
+
+/// Equality filter applied to the content table alongside the MATCH
+pub const SearchFilter = struct {
+    column: []const u8,
+    value: Value,
+
+    pub const Value = union(enum) {
+        int: i64,
+        text: []const u8,
+    };
+};
+
+pub const SearchOptions = struct {
+    limit: u32 = 20,
+    offset: u32 = 0,
+    /// Extra equality filters on the model table (e.g. `user_id`)
+    filters: []const SearchFilter = &.{},
+    /// Column the snippet is cut from (default: the first search field)
+    snippet_column: ?[]const u8 = null,
+    /// Markers around matched terms in the snippet
+    highlight_open: []const u8 = "<mark>",
+    highlight_close: []const u8 = "</mark>",
+    /// Approximate number of tokens in the snippet (1-64)
+    snippet_tokens: u8 = 16,
+    /// Pass the query to FTS5 unchanged, enabling its operators
+    /// (AND/OR/NOT, NEAR, "phrases", column:filters). When false, every
+    /// word must match and the last one may be a prefix.
+    raw_query: bool = false,
+};
+
+/// Turn free text into a safe FTS5 query; caller frees
+/// Each word becomes a quoted phrase, so punctuation and FTS5 operators in user
+/// input are matched literally. The last word gets a `*` so results update as
+/// the user types. Returns an empty string when the input has no words.
+pub fn matchQuery(allocator: std.mem.Allocator, input: []const u8) ![]u8 {
+    var out = std.ArrayListUnmanaged(u8){};
+    errdefer out.deinit(allocator);
+
+    var words = std.mem.tokenizeAny(u8, input, " \t\r\n");
+    var first = true;
+    while (words.next()) |word| {
+        if (!first) try out.append(allocator, ' ');
+        first = false;
+        try out.append(allocator, '"');
+        for (word) |char| {
+            if (char == '"') try out.append(allocator, '"');
+            try out.append(allocator, char);
+        }
+        try out.append(allocator, '"');
+        if (words.peek() == null) try out.append(allocator, '*');
+    }
+
+    return out.toOwnedSlice(allocator);
+}
+
+test "SearchDef createSql builds the FTS table and triggers" {
+    const allocator = std.testing.allocator;
+
+    const Note = struct {
+        id: i64,
+        title: []const u8,
+        body: ?[]const u8,
+
+        pub const search_fields = .{ "title", "body" };
+    };
+
+    const def = modelSearch(Note).?;
+    const sql = try def.createSql(allocator);
+    defer allocator.free(sql);
+
+    try std.testing.expect(std.mem.indexOf(u8, sql, "CREATE VIRTUAL TABLE IF NOT EXISTS note_fts USING fts5(title, body, content='note', content_rowid='id');") != null);
+    try std.testing.expect(std.mem.indexOf(u8, sql, "INSERT INTO note_fts(rowid, title, body) VALUES (new.id, new.title, new.body);") != null);
+    try std.testing.expect(std.mem.indexOf(u8, sql, "AFTER UPDATE OF title, body ON note") != null);
+    try std.testing.expectEqual(@as(?usize, 1), def.columnIndex("body"));
+
+    const Plain = struct { id: i64 };
+    try std.testing.expect(modelSearch(Plain) == null);
+}
+
+test "matchQuery quotes words and prefixes the last one" {
+    const allocator = std.testing.allocator;
+
+    const q = try matchQuery(allocator, "  buy \"milk\" OR-eggs ");
+    defer allocator.free(q);
+    try std.testing.expectEqualStrings("\"buy\" \"\"\"milk\"\"\" \"OR-eggs\"*", q);
+
+    const empty = try matchQuery(allocator, "   ");
+    defer allocator.free(empty);
+    try std.testing.expectEqual(@as(usize, 0), empty.len);
+}
@@ -1,6 +1,7 @@
 const std = @import("std");
 const Database = @import("database.zig").Database;
 const ORM = @import("orm.zig").ORM;
+const wal = @import("wal.zig");
 
 /// Thread-safe database singleton pattern
 /// Provides a global database/ORM instance that can be safely accessed from multiple threads
@@ -42,6 +43,31 @@ pub const DatabaseSingleton = struct {
         initialized = true;
     }
 
+    /// Initialize the singleton on a WAL-mode database with a reader pool
+    /// Reads from concurrent handlers run in parallel on read-only connections,
+    /// writes serialize on a single writer connection.
+    /// Thread-safe: can be called multiple times safely (idempotent)
+    ///
+    /// Example:
+    /// ```zig
+    /// try DatabaseSingleton.initWal("myapp.db", allocator, .{ .reader_count = 8 });
+    /// ```
+    pub fn initWal(db_path: []const u8, allocator: std.mem.Allocator, options: wal.WalOptions) !void {
+        mutex.lock();
+        defer mutex.unlock();
+
+        if (initialized) {
+            return; // Already initialized
+        }
+
+        // The writer is not exposed through getDatabase(): used directly it
+        // would bypass the ORM's writer lock
+        const wal_db = try wal.WalDatabase.open(db_path, allocator, options);
+        global_db = null;
+        global_orm = ORM.initWal(wal_db, allocator);
+        initialized = true;
+    }
+
     /// Get the ORM instance
     /// Returns a pointer to the thread-safe ORM instance
     /// Thread-safe: can be called from multiple threads concurrently
@@ -69,6 +95,8 @@ pub const DatabaseSingleton = struct {
     /// Get the database instance directly
     /// Returns a pointer to the thread-safe Database instance
     /// Thread-safe: can be called from multiple threads concurrently
+    /// After initWal() there is no single shared connection, so this fails
+    /// with error.Unsupported; use get() instead.
     /// 
     /// Example:
     /// ```zig
@@ -87,7 +115,7 @@ pub const DatabaseSingleton = struct {
             return db;
         }
 
-        return error.DatabaseNotInitialized;
+        return error.Unsupported;
     }
 
     /// Check if the singleton has been initialized
@@ -110,7 +138,9 @@ pub const DatabaseSingleton = struct {
         mutex.lock();
         defer mutex.unlock();
 
-        if (global_db) |*db| {
+        if (global_orm) |*orm| {
+            orm.close();
+        } else if (global_db) |*db| {
             db.close();
         }
 
@@ -158,3 +188,21 @@ test "DatabaseSingleton error when not initialized" {
     try std.testing.expectError(error.DatabaseNotInitialized, result);
 }
 
+
+test "DatabaseSingleton initWal only exposes the ORM" {
+    const allocator = std.testing.allocator;
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const dir_path = try tmp.dir.realpathAlloc(allocator, ".");
+    defer allocator.free(dir_path);
+    const db_path = try std.fs.path.join(allocator, &.{ dir_path, "singleton_wal.db" });
+    defer allocator.free(db_path);
+
+    try DatabaseSingleton.initWal(db_path, allocator, .{ .reader_count = 1 });
+    defer DatabaseSingleton.deinit();
+
+    try std.testing.expectError(error.Unsupported, DatabaseSingleton.getDatabase());
+    const orm = try DatabaseSingleton.get();
+    try orm.execute("CREATE TABLE test (id INTEGER PRIMARY KEY)");
+}
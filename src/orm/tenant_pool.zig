@@ -0,0 +1,408 @@
+const std = @import("std");
+const database = @import("database.zig");
+const Database = database.Database;
+const OpenOptions = database.OpenOptions;
+const ORM = @import("orm.zig").ORM;
+const wal = @import("wal.zig");
+const Migration = @import("migration.zig").Migration;
+
+pub const TenantPoolOptions = struct {
+    /// Database file for a tenant; every "{tenant}" is replaced by the tenant key
+    path_template: []const u8 = "tenants/{tenant}.db",
+    /// Maximum number of tenant databases kept open (idle ones are closed LRU first)
+    max_open: usize = 64,
+    /// How long acquire waits for a slot when every open tenant is in use
+    acquire_timeout_ms: u64 = 5000,
+    /// Open each tenant as a WAL database with a reader pool (null = one plain connection)
+    wal: ?wal.WalOptions = null,
+    /// Connection options for plain (non-WAL) tenants, e.g. the statement cache size
+    open_options: OpenOptions = .{},
+    /// Run on a tenant's first open in this process
+    migrations: []const Migration = &.{},
+    /// Longest accepted tenant key
+    max_key_len: usize = 64,
+    /// Create and migrate a database for a key that has no file yet
+    /// Off by default, so a client-chosen key (such as a header value) cannot
+    /// make the server create files; provision tenants ahead of time or enable
+    /// this only when every key comes from a trusted source.
+    create_missing: bool = false,
+};
+
+pub const TenantPoolStats = struct {
+    /// Tenant databases currently open
+    open: usize = 0,
+    /// Open tenants with at least one lease
+    in_use: usize = 0,
+    /// Acquires served by an already open tenant
+    hits: u64 = 0,
+    /// Acquires that opened the tenant's database
+    opens: u64 = 0,
+    /// Idle tenants closed to stay under max_open
+    evictions: u64 = 0,
+};
+
+/// One SQLite database (and ORM) per tenant, with an LRU bound on open files
+/// Tenants are opened on first `acquire`, migrated once, and kept open while
+/// they are in use. When `max_open` is reached the least recently used idle
+/// tenant is closed. Each tenant has its own connection, statement cache and
+/// writer, so writes from different tenants never contend.
+///
+/// Tenant keys become file names and may only contain lowercase letters,
+/// digits, `-` and `_`, so one tenant cannot be reached under two spellings
+/// on case-insensitive file systems.
+/// Only tenants whose database file already exists are opened unless
+/// `create_missing` is set.
+///
+/// Thread-safe. Opening and migrating a tenant happens outside the pool lock,
+/// so a slow first access does not block other tenants.
+///
+/// Example:
+/// ```zig
+/// const pool = try TenantPool.init(allocator, .{
+///     .path_template = "data/{tenant}.db",
+///     .max_open = 128,
+///     .migrations = &migrations,
+/// });
+/// defer pool.deinit();
+///
+/// var tenant = try pool.acquire("acme");
+/// defer tenant.release();
+/// const todos = try tenant.orm.findAll(Todo);
+/// ```
+pub const TenantPool = struct {
+    allocator: std.mem.Allocator,
+    options: TenantPoolOptions,
+    mutex: std.Thread.Mutex = .{},
+    /// Signalled when a tenant finishes opening or a lease is released
+    changed: std.Thread.Condition = .{},
+    entries: std.StringHashMapUnmanaged(*Entry) = .{},
+    /// LRU list: head is the most recently acquired tenant
+    head: ?*Entry = null,
+    tail: ?*Entry = null,
+    stats_data: TenantPoolStats = .{},
+
+    const State = enum { opening, ready };
+
+    const Entry = struct {
+        key: []u8,
+        state: State = .opening,
+        orm: ORM = undefined,
+        leases: usize = 0,
+        prev: ?*Entry = null,
+        next: ?*Entry = null,
+    };
+
+    /// A tenant's ORM, valid until `release`
+    pub const Lease = struct {
+        pool: *TenantPool,
+        entry: *Entry,
+        orm: *ORM,
+
+        pub fn key(self: Lease) []const u8 {
+            return self.entry.key;
+        }
+
+        pub fn release(self: Lease) void {
+            self.pool.releaseEntry(self.entry);
+        }
+    };
+
+    pub fn init(allocator: std.mem.Allocator, options: TenantPoolOptions) !*TenantPool {
+        if (options.max_open == 0) return error.InvalidArgument;
+        const self = try allocator.create(TenantPool);
+        self.* = .{ .allocator = allocator, .options = options };
+        return self;
+    }
+
+    /// Close every tenant and free the pool
+    /// No lease may be outstanding.
+    pub fn deinit(self: *TenantPool) void {
+        var it = self.entries.valueIterator();
+        while (it.next()) |entry| {
+            if (entry.*.state == .ready) entry.*.orm.close();
+            self.allocator.free(entry.*.key);
+            self.allocator.destroy(entry.*);
+        }
+        self.entries.deinit(self.allocator);
+        self.allocator.destroy(self);
+    }
+
+    /// Lease the tenant's ORM, opening and migrating its database on first use
+    /// Fails with error.InvalidTenant for a malformed key, with
+    /// error.UnknownTenant when the tenant has no database file (and
+    /// `create_missing` is off), and with error.PoolExhausted when `max_open`
+    /// tenants stay in use for longer than `acquire_timeout_ms`.
+    pub fn acquire(self: *TenantPool, tenant_key: []const u8) !Lease {
+        if (!self.isValidKey(tenant_key)) return error.InvalidTenant;
+
+        const deadline = std.time.nanoTimestamp() + @as(i128, self.options.acquire_timeout_ms) * std.time.ns_per_ms;
+
+        self.mutex.lock();
+        while (true) {
+            if (self.entries.get(tenant_key)) |entry| {
+                if (entry.state == .ready) {
+                    entry.leases += 1;
+                    self.moveToFront(entry);
+                    self.stats_data.hits += 1;
+                    self.mutex.unlock();
+                    return .{ .pool = self, .entry = entry, .orm = &entry.orm };
+                }
+                // Another thread is opening this tenant
+                try self.waitLocked(deadline);
+                continue;
+            }
+
+            if (self.entries.count() < self.options.max_open) break;
+            if (self.evictIdleLocked()) |evicted| {
+                // Close outside the lock; the slot is already free
+                self.mutex.unlock();
+                self.closeEntry(evicted);
+                self.mutex.lock();
+                continue;
+            }
+            try self.waitLocked(deadline);
+        }
+
+        // Reserve the slot, then open without holding the lock
+        const entry = self.allocator.create(Entry) catch |err| {
+            self.mutex.unlock();
+            return err;
+        };
+        entry.* = .{ .key = undefined, .leases = 1 };
+        entry.key = self.allocator.dupe(u8, tenant_key) catch |err| {
+            self.mutex.unlock();
+            self.allocator.destroy(entry);
+            return err;
+        };
+        self.entries.put(self.allocator, entry.key, entry) catch |err| {
+            self.mutex.unlock();
+            self.allocator.free(entry.key);
+            self.allocator.destroy(entry);
+            return err;
+        };
+        self.pushFront(entry);
+        self.mutex.unlock();
+
+        const orm = self.openTenant(entry.key) catch |err| {
+            self.mutex.lock();
+            self.unlink(entry);
+            _ = self.entries.remove(entry.key);
+            self.changed.broadcast();
+            self.mutex.unlock();
+            self.allocator.free(entry.key);
+            self.allocator.destroy(entry);
+            return err;
+        };
+
+        self.mutex.lock();
+        entry.orm = orm;
+        entry.state = .ready;
+        self.stats_data.opens += 1;
+        self.changed.broadcast();
+        self.mutex.unlock();
+        return .{ .pool = self, .entry = entry, .orm = &entry.orm };
+    }
+
+    /// Close a tenant's database now if it is idle; returns whether it was closed
+    pub fn close(self: *TenantPool, tenant_key: []const u8) bool {
+        self.mutex.lock();
+        const entry = self.entries.get(tenant_key) orelse {
+            self.mutex.unlock();
+            return false;
+        };
+        if (entry.state != .ready or entry.leases > 0) {
+            self.mutex.unlock();
+            return false;
+        }
+        self.unlink(entry);
+        _ = self.entries.remove(entry.key);
+        self.changed.broadcast();
+        self.mutex.unlock();
+
+        self.closeEntry(entry);
+        return true;
+    }
+
+    pub fn stats(self: *TenantPool) TenantPoolStats {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        var result = self.stats_data;
+        result.open = self.entries.count();
+        var it = self.entries.valueIterator();
+        while (it.next()) |entry| {
+            if (entry.*.leases > 0) result.in_use += 1;
+        }
+        return result;
+    }
+
+    /// Database path for a tenant key (caller frees)
+    pub fn pathFor(self: *TenantPool, allocator: std.mem.Allocator, tenant_key: []const u8) ![]u8 {
+        return std.mem.replaceOwned(u8, allocator, self.options.path_template, "{tenant}", tenant_key);
+    }
+
+    fn isValidKey(self: *TenantPool, tenant_key: []const u8) bool {
+        if (tenant_key.len == 0 or tenant_key.len > self.options.max_key_len) return false;
+        for (tenant_key) |char| {
+            if (!std.ascii.isLower(char) and !std.ascii.isDigit(char) and char != '-' and char != '_') return false;
+        }
+        return true;
+    }
+
+    fn openTenant(self: *TenantPool, tenant_key: []const u8) !ORM {
+        const path = try self.pathFor(self.allocator, tenant_key);
+        defer self.allocator.free(path);
+
+        const create = self.options.create_missing;
+        if (!create) {
+            std.fs.cwd().access(path, .{}) catch |err| {
+                return if (err == error.FileNotFound) error.UnknownTenant else err;
+            };
+        } else if (std.fs.path.dirname(path)) |dir| {
+            std.fs.cwd().makePath(dir) catch |err| {
+                std.debug.print("[ORM Error] Failed to create directory for tenant '{s}'\n", .{tenant_key});
+                std.debug.print("  Path: {s}\n", .{dir});
+                std.debug.print("  Error: {}\n", .{err});
+                return err;
+            };
+        }
+
+        // No-create as well, in case the file is removed between the check and the open
+        var open_options = self.options.open_options;
+        open_options.create = create;
+        var orm = if (self.options.wal) |wal_options| blk: {
+            var options = wal_options;
+            options.writer_options.create = create;
+            break :blk ORM.initWal(try wal.WalDatabase.open(path, self.allocator, options), self.allocator);
+        } else ORM.init(try Database.openWithOptions(path, self.allocator, open_options), self.allocator);
+        errdefer orm.close();
+
+        if (self.options.migrations.len > 0) {
+            orm.runMigrations(self.options.migrations) catch |err| {
+                std.debug.print("[ORM Error] Migrations failed for tenant '{s}'\n", .{tenant_key});
+                std.debug.print("  Path: {s}\n", .{path});
+                std.debug.print("  Error: {}\n", .{err});
+                return err;
+            };
+        }
+        return orm;
+    }
+
+    fn releaseEntry(self: *TenantPool, entry: *Entry) void {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        entry.leases -= 1;
+        if (entry.leases == 0) self.changed.broadcast();
+    }
+
+    /// Unlink the least recently used idle tenant; the caller closes it
+    fn evictIdleLocked(self: *TenantPool) ?*Entry {
+        var candidate = self.tail;
+        while (candidate) |entry| : (candidate = entry.prev) {
+            if (entry.state == .ready and entry.leases == 0) {
+                self.unlink(entry);
+                _ = self.entries.remove(entry.key);
+                self.stats_data.evictions += 1;
+                return entry;
+            }
+        }
+        return null;
+    }
+
+    fn closeEntry(self: *TenantPool, entry: *Entry) void {
+        entry.orm.close();
+        self.allocator.free(entry.key);
+        self.allocator.destroy(entry);
+    }
+
+    fn waitLocked(self: *TenantPool, deadline: i128) !void {
+        const remaining = deadline - std.time.nanoTimestamp();
+        if (remaining <= 0) {
+            self.mutex.unlock();
+            return error.PoolExhausted;
+        }
+        self.changed.timedWait(&self.mutex, @intCast(remaining)) catch {};
+    }
+
+    fn pushFront(self: *TenantPool, entry: *Entry) void {
+        entry.prev = null;
+        entry.next = self.head;
+        if (self.head) |head| head.prev = entry;
+        self.head = entry;
+        if (self.tail == null) self.tail = entry;
+    }
+
+    fn unlink(self: *TenantPool, entry: *Entry) void {
+        if (entry.prev) |prev| prev.next = entry.next else self.head = entry.next;
+        if (entry.next) |next| next.prev = entry.prev else self.tail = entry.prev;
+        entry.prev = null;
+        entry.next = null;
+    }
+
+    fn moveToFront(self: *TenantPool, entry: *Entry) void {
+        if (self.head == entry) return;
+        self.unlink(entry);
+        self.pushFront(entry);
+    }
+};
+
+test "TenantPool opens one migrated database per tenant and evicts idle ones" {
+    const allocator = std.testing.allocator;
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const dir = try tmp.dir.realpathAlloc(allocator, ".");
+    defer allocator.free(dir);
+    const template = try std.fmt.allocPrint(allocator, "{s}/{{tenant}}.db", .{dir});
+    defer allocator.free(template);
+
+    const migrations = [_]Migration{
+        Migration.init(1, "create_notes", "CREATE TABLE notes (id INTEGER PRIMARY KEY, body TEXT)", "DROP TABLE notes"),
+    };
+    const pool = try TenantPool.init(allocator, .{
+        .path_template = template,
+        .max_open = 1,
+        .acquire_timeout_ms = 10,
+        .migrations = &migrations,
+        .create_missing = true,
+    });
+    defer pool.deinit();
+
+    try std.testing.expectError(error.InvalidTenant, pool.acquire("../etc"));
+    try std.testing.expectError(error.InvalidTenant, pool.acquire("Acme"));
+
+    const acme = try pool.acquire("acme");
+    try acme.orm.execute("INSERT INTO notes (body) VALUES ('acme only')");
+
+    // The only slot is leased, so a second tenant cannot be opened
+    try std.testing.expectError(error.PoolExhausted, pool.acquire("globex"));
+    acme.release();
+
+    // Releasing lets the idle tenant be evicted for the next one
+    const globex = try pool.acquire("globex");
+    var result = try globex.orm.query("SELECT COUNT(*) FROM notes");
+    const row = (try result.step()).?;
+    try std.testing.expectEqual(@as(i64, 0), row.getInt64(0));
+    result.deinit();
+    globex.release();
+
+    // Reopening acme finds its data on disk
+    const again = try pool.acquire("acme");
+    defer again.release();
+    var notes = try again.orm.query("SELECT body FROM notes");
+    defer notes.deinit();
+    try std.testing.expectEqualStrings("acme only", (try notes.step()).?.getText(0).?);
+
+    const stats = pool.stats();
+    try std.testing.expectEqual(@as(u64, 3), stats.opens);
+    try std.testing.expectEqual(@as(u64, 2), stats.evictions);
+    try std.testing.expectEqual(@as(usize, 1), stats.open);
+
+    // Without create_missing only provisioned tenants open
+    const strict = try TenantPool.init(allocator, .{ .path_template = template });
+    defer strict.deinit();
+    try std.testing.expectError(error.UnknownTenant, strict.acquire("initech"));
+    try std.testing.expectError(error.FileNotFound, tmp.dir.access("initech.db", .{}));
+    const provisioned = try strict.acquire("acme");
+    provisioned.release();
+}
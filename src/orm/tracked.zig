@@ -0,0 +1,97 @@
+const std = @import("std");
+const ModelSql = @import("model_sql.zig").ModelSql;
+
+/// A model value paired with the snapshot it was loaded from
+/// `dirtyMask()` compares the two field by field, so `ORM.saveTracked` writes
+/// only the columns that actually changed. Strings are compared by content.
+/// The snapshot shares string memory with the loaded value, so keep the
+/// loading allocator (e.g. the request arena) alive while tracking.
+///
+/// Example:
+/// ```zig
+/// var todo = (try orm.findTracked(Todo, id, request.arena.allocator())) orelse return notFound();
+/// todo.value.completed = !todo.value.completed;
+/// _ = try orm.saveTracked(Todo, &todo); // UPDATE Todo SET completed = ? WHERE id = ?
+/// ```
+pub fn Tracked(comptime T: type) type {
+    const fields = std.meta.fields(T);
+
+    return struct {
+        const Self = @This();
+        pub const FieldMask = ModelSql(T).FieldMask;
+
+        value: T,
+        original: T,
+
+        pub fn init(value: T) Self {
+            return .{ .value = value, .original = value };
+        }
+
+        /// Fields whose value differs from the snapshot, `id` excluded
+        pub fn dirtyMask(self: Self) FieldMask {
+            var mask = FieldMask.initEmpty();
+            inline for (fields, 0..) |field, i| {
+                if (comptime !std.mem.eql(u8, field.name, "id")) {
+                    if (!fieldEql(@field(self.value, field.name), @field(self.original, field.name))) mask.set(i);
+                }
+            }
+            return mask;
+        }
+
+        pub fn isDirty(self: Self) bool {
+            return self.dirtyMask().count() > 0;
+        }
+
+        /// Whether the named field differs from the snapshot
+        pub fn isFieldDirty(self: Self, comptime name: []const u8) bool {
+            return !fieldEql(@field(self.value, name), @field(self.original, name));
+        }
+
+        /// Accept the current value as the new snapshot (after a successful save)
+        pub fn markClean(self: *Self) void {
+            self.original = self.value;
+        }
+    };
+}
+
+fn fieldEql(a: anytype, b: @TypeOf(a)) bool {
+    const V = @TypeOf(a);
+    return switch (@typeInfo(V)) {
+        .optional => if (a) |inner_a| (if (b) |inner_b| fieldEql(inner_a, inner_b) else false) else b == null,
+        .pointer => |ptr_info| if (ptr_info.size == .slice and ptr_info.child == u8)
+            std.mem.eql(u8, a, b)
+        else
+            std.meta.eql(a, b),
+        else => std.meta.eql(a, b),
+    };
+}
+
+test "Tracked reports only changed fields" {
+    const Todo = struct {
+        id: i64,
+        title: []const u8,
+        completed: bool,
+        due: ?i64,
+        notes: ?[]const u8,
+    };
+
+    var todo = Tracked(Todo).init(.{ .id = 7, .title = "write docs", .completed = false, .due = null, .notes = "draft" });
+    try std.testing.expect(!todo.isDirty());
+
+    // Same content in a different buffer is not a change
+    var buffer = "write docs".*;
+    todo.value.title = &buffer;
+    try std.testing.expect(!todo.isDirty());
+
+    todo.value.completed = true;
+    todo.value.notes = null;
+    const mask = todo.dirtyMask();
+    try std.testing.expectEqual(@as(usize, 2), mask.count());
+    try std.testing.expect(mask.isSet(2));
+    try std.testing.expect(mask.isSet(4));
+    try std.testing.expect(todo.isFieldDirty("completed"));
+    try std.testing.expect(!todo.isFieldDirty("due"));
+
+    todo.markClean();
+    try std.testing.expect(!todo.isDirty());
+}
@@ -0,0 +1,214 @@
+const std = @import("std");
+const database = @import("database.zig");
+const Database = database.Database;
+const ConnectionPool = database.ConnectionPool;
+
+/// SQLite PRAGMAs applied to every connection opened in WAL mode
+pub const PragmaProfile = struct {
+    pub const Synchronous = enum { off, normal, full, extra };
+    pub const TempStore = enum { default, file, memory };
+
+    /// NORMAL is durable across application crashes in WAL mode and only
+    /// risks the last transactions on power loss
+    synchronous: Synchronous = .normal,
+    /// Bytes of the database file to memory-map (0 disables mmap)
+    mmap_size: u64 = 256 * 1024 * 1024,
+    /// Page cache size per connection in KiB
+    cache_size_kib: u32 = 64 * 1024,
+    /// How long a connection waits on a lock before returning SQLITE_BUSY
+    busy_timeout_ms: u32 = 5000,
+    temp_store: TempStore = .memory,
+
+    /// Render the profile as a PRAGMA script
+    ///
+    /// Example:
+    /// ```zig
+    /// const sql = try (PragmaProfile{}).toSql(allocator);
+    /// defer allocator.free(sql);
+    /// // "PRAGMA synchronous = NORMAL; PRAGMA mmap_size = 268435456; ..."
+    /// ```
+    pub fn toSql(self: PragmaProfile, allocator: std.mem.Allocator) ![:0]u8 {
+        return std.fmt.allocPrintSentinel(
+            allocator,
+            "PRAGMA synchronous = {s}; PRAGMA mmap_size = {d}; PRAGMA cache_size = -{d}; PRAGMA busy_timeout = {d}; PRAGMA temp_store = {s};",
+            .{
+                upperName(self.synchronous),
+                self.mmap_size,
+                self.cache_size_kib,
+                self.busy_timeout_ms,
+                upperName(self.temp_store),
+            },
+            0,
+        );
+    }
+
+    fn upperName(value: anytype) []const u8 {
+        return switch (value) {
+            inline else => |tag| comptime blk: {
+                const name = @tagName(tag);
+                var buf: [name.len]u8 = undefined;
+                _ = std.ascii.upperString(&buf, name);
+                const final = buf;
+                break :blk &final;
+            },
+        };
+    }
+};
+
+pub const WalOptions = struct {
+    /// Number of read-only connections (default: one per CPU core)
+    reader_count: ?usize = null,
+    /// How long a reader acquire waits before error.PoolExhausted
+    reader_acquire_timeout_ms: u64 = 5000,
+    /// Close reader connections idle for longer than this (0 = keep open)
+    reader_idle_timeout_ms: u64 = 0,
+    /// Options for the writer connection
+    writer_options: database.OpenOptions = .{},
+    profile: PragmaProfile = .{},
+};
+
+/// WAL-mode database with a pool of read-only connections and one writer
+/// In WAL mode readers never block the writer and the writer never blocks
+/// readers, so queries scale across cores while writes serialize on a single
+/// connection (guarded by `writer_mutex`).
+///
+/// Reads on a reader connection do not see writes from a transaction that is
+/// still open on the writer.
+///
+/// Example:
+/// ```zig
+/// const wal = try WalDatabase.open("app.db", allocator, .{ .reader_count = 4 });
+/// defer wal.deinit();
+///
+/// var orm = ORM.initWal(wal, allocator);
+/// ```
+pub const WalDatabase = struct {
+    writer: Database,
+    writer_mutex: std.Thread.Mutex = .{},
+    readers: ConnectionPool,
+    allocator: std.mem.Allocator,
+
+    pub fn open(path: []const u8, allocator: std.mem.Allocator, options: WalOptions) !*WalDatabase {
+        if (std.mem.eql(u8, path, ":memory:")) {
+            std.debug.print("[Database Error] WAL mode requires a database file, not :memory:\n", .{});
+            return error.InvalidArgument;
+        }
+
+        const self = try allocator.create(WalDatabase);
+        errdefer allocator.destroy(self);
+
+        const pragmas = try options.profile.toSql(allocator);
+        defer allocator.free(pragmas);
+
+        var writer = try Database.openWithOptions(path, allocator, options.writer_options);
+        errdefer writer.close();
+
+        // journal_mode is persistent in the file, so readers opened afterwards use WAL too
+        {
+            var result = try writer.query("PRAGMA journal_mode = WAL");
+            defer result.deinit();
+            const row = result.nextRow() orelse return error.DatabaseError;
+            const mode = row.getText(0) orelse "";
+            if (!std.ascii.eqlIgnoreCase(mode, "wal")) {
+                std.debug.print("[Database Error] Failed to enable WAL mode (journal_mode = {s})\n", .{mode});
+                return error.DatabaseError;
+            }
+        }
+        try writer.execute(pragmas);
+
+        const reader_sql = try std.fmt.allocPrintSentinel(allocator, "{s} PRAGMA query_only = 1;", .{pragmas}, 0);
+        defer allocator.free(reader_sql);
+
+        const reader_count = options.reader_count orelse (std.Thread.getCpuCount() catch 4);
+        const readers = try ConnectionPool.init(path, .{
+            .max_connections = @max(reader_count, 1),
+            .idle_timeout_ms = options.reader_idle_timeout_ms,
+            .acquire_timeout_ms = options.reader_acquire_timeout_ms,
+            .read_only = true,
+            .init_sql = reader_sql,
+        }, allocator);
+
+        self.* = WalDatabase{
+            .writer = writer,
+            .readers = readers,
+            .allocator = allocator,
+        };
+        return self;
+    }
+
+    /// Borrow a read-only connection; return it with releaseReader()
+    pub fn acquireReader(self: *WalDatabase) !Database {
+        return self.readers.acquire();
+    }
+
+    pub fn releaseReader(self: *WalDatabase, db: Database) void {
+        self.readers.release(db);
+    }
+
+    /// Take exclusive use of the writer connection
+    ///
+    /// Example:
+    /// ```zig
+    /// const writer = wal.lockWriter();
+    /// defer wal.unlockWriter();
+    /// try writer.execute("DELETE FROM sessions WHERE expires_at < 0");
+    /// ```
+    pub fn lockWriter(self: *WalDatabase) *Database {
+        self.writer_mutex.lock();
+        return &self.writer;
+    }
+
+    pub fn unlockWriter(self: *WalDatabase) void {
+        self.writer_mutex.unlock();
+    }
+
+    /// Close readers and the writer and free the WalDatabase
+    pub fn deinit(self: *WalDatabase) void {
+        self.readers.deinit();
+        self.writer.close();
+        self.allocator.destroy(self);
+    }
+};
+
+test "PragmaProfile toSql" {
+    const allocator = std.testing.allocator;
+
+    const sql = try (PragmaProfile{ .synchronous = .full, .mmap_size = 0, .temp_store = .file }).toSql(allocator);
+    defer allocator.free(sql);
+
+    try std.testing.expect(std.mem.indexOf(u8, sql, "PRAGMA synchronous = FULL;") != null);
+    try std.testing.expect(std.mem.indexOf(u8, sql, "PRAGMA mmap_size = 0;") != null);
+    try std.testing.expect(std.mem.indexOf(u8, sql, "PRAGMA cache_size = -65536;") != null);
+    try std.testing.expect(std.mem.indexOf(u8, sql, "PRAGMA temp_store = FILE;") != null);
+}
+
+test "WalDatabase routes reads to read-only connections" {
+    const allocator = std.testing.allocator;
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const dir_path = try tmp.dir.realpathAlloc(allocator, ".");
+    defer allocator.free(dir_path);
+    const db_path = try std.fs.path.join(allocator, &.{ dir_path, "wal_test.db" });
+    defer allocator.free(db_path);
+
+    const wal = try WalDatabase.open(db_path, allocator, .{ .reader_count = 2 });
+    defer wal.deinit();
+
+    {
+        const writer = wal.lockWriter();
+        defer wal.unlockWriter();
+        try writer.execute("CREATE TABLE items (id INTEGER PRIMARY KEY, name TEXT)");
+        try writer.execute("INSERT INTO items (name) VALUES ('a')");
+    }
+
+    var reader = try wal.acquireReader();
+    defer wal.releaseReader(reader);
+
+    var result = try reader.query("SELECT COUNT(*) FROM items");
+    defer result.deinit();
+    try std.testing.expectEqual(@as(i64, 1), result.nextRow().?.getInt64(0));
+
+    // Readers are opened read-only
+    try std.testing.expectError(error.QueryFailed, reader.execute("INSERT INTO items (name) VALUES ('b')"));
+}
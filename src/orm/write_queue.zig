@@ -0,0 +1,493 @@
+const std = @import("std");
+const Database = @import("database.zig").Database;
+const ORM = @import("orm.zig").ORM;
+const ModelSql = @import("model_sql.zig").ModelSql;
+
+pub const WriteQueueOptions = struct {
+    /// Maximum number of operations committed in one transaction
+    max_batch_size: usize = 256,
+    /// How long the writer waits for more operations after the first one
+    /// arrives before committing (0 = commit whatever is queued right away)
+    max_latency_us: u64 = 1000,
+};
+
+pub const WriteQueueStats = struct {
+    batches: u64 = 0,
+    operations: u64 = 0,
+    failed_operations: u64 = 0,
+    largest_batch: usize = 0,
+    queued: usize = 0,
+
+    /// Average number of operations per committed batch
+    pub fn averageBatchSize(self: WriteQueueStats) f64 {
+        if (self.batches == 0) return 0.0;
+        return @as(f64, @floatFromInt(self.operations)) / @as(f64, @floatFromInt(self.batches));
+    }
+
+    /// Write the stats in Prometheus text format
+    ///
+    /// Example output:
+    /// ```
+    /// db_write_queue_batches_total 42
+    /// db_write_queue_queued 3
+    /// ```
+    pub fn writePrometheus(self: WriteQueueStats, writer: anytype) !void {
+        try writer.print("db_write_queue_batches_total {d}\n", .{self.batches});
+        try writer.print("db_write_queue_operations_total {d}\n", .{self.operations});
+        try writer.print("db_write_queue_failed_operations_total {d}\n", .{self.failed_operations});
+        try writer.print("db_write_queue_largest_batch {d}\n", .{self.largest_batch});
+        try writer.print("db_write_queue_queued {d}\n", .{self.queued});
+    }
+};
+
+/// A queued write and its completion future
+/// The node lives in the submitter's memory (usually its stack frame) and must
+/// stay valid until wait() returns.
+pub const WriteOp = struct {
+    run: *const fn (op: *WriteOp, orm: *ORM) anyerror!void,
+    next: ?*WriteOp = null,
+    err: ?anyerror = null,
+    done: std.Thread.ResetEvent = .{},
+
+    /// Block until the batch containing this operation has committed
+    /// Returns the operation's own error, or the COMMIT error if the batch failed.
+    pub fn wait(self: *WriteOp) !void {
+        self.done.wait();
+        if (self.err) |err| return err;
+    }
+
+    /// Whether the operation has completed (successfully or not)
+    pub fn isDone(self: *WriteOp) bool {
+        return self.done.isSet();
+    }
+};
+
+/// Group-commit write queue
+/// Request threads submit writes, and a dedicated writer thread drains the
+/// queue in batches. Each batch runs inside a single BEGIN ... COMMIT, which
+/// costs one WAL fsync no matter how many writes it holds. Every operation
+/// runs in its own SAVEPOINT, so one failed write does not roll back the
+/// others in its batch.
+///
+/// Example:
+/// ```zig
+/// try orm.enableWriteQueue(.{ .max_batch_size = 128, .max_latency_us = 2000 });
+/// try orm.update(Todo, todo); // blocks until the batch commits
+///
+/// // Or submit without blocking and wait later
+/// var op = WriteQueue.UpdateOp(Todo).init(todo);
+/// try orm.write_queue.?.submit(&op.op);
+/// try op.op.wait();
+/// ```
+pub const WriteQueue = struct {
+    allocator: std.mem.Allocator,
+    options: WriteQueueOptions,
+    /// ORM used by the writer thread; it runs operations directly on the connection
+    writer_orm: ORM,
+    /// Held for the whole batch; other writers on the same connection take it too
+    writer_lock: *std.Thread.Mutex,
+    own_lock: std.Thread.Mutex = .{},
+
+    mutex: std.Thread.Mutex = .{},
+    not_empty: std.Thread.Condition = .{},
+    head: ?*WriteOp = null,
+    tail: ?*WriteOp = null,
+    len: usize = 0,
+    closed: bool = false,
+    stats_data: WriteQueueStats = .{},
+    thread: ?std.Thread = null,
+
+    /// Start a write queue on `db`
+    /// `writer_lock` serializes batches with other writers on the same connection;
+    /// pass null to use a lock owned by the queue.
+    pub fn init(allocator: std.mem.Allocator, db: Database, writer_lock: ?*std.Thread.Mutex, options: WriteQueueOptions) !*WriteQueue {
+        if (options.max_batch_size == 0) {
+            std.debug.print("[ORM Error] WriteQueue max_batch_size must be greater than 0\n", .{});
+            return error.InvalidArgument;
+        }
+
+        const self = try allocator.create(WriteQueue);
+        errdefer allocator.destroy(self);
+
+        self.* = WriteQueue{
+            .allocator = allocator,
+            .options = options,
+            .writer_orm = ORM.init(db, allocator),
+            .writer_lock = undefined,
+        };
+        self.writer_lock = writer_lock orelse &self.own_lock;
+        self.thread = try std.Thread.spawn(.{}, writerMain, .{self});
+        return self;
+    }
+
+    /// Commit everything still queued, stop the writer thread and free the queue
+    /// Does not close the connection.
+    pub fn deinit(self: *WriteQueue) void {
+        self.mutex.lock();
+        self.closed = true;
+        self.not_empty.signal();
+        self.mutex.unlock();
+
+        if (self.thread) |thread| thread.join();
+        self.allocator.destroy(self);
+    }
+
+    /// Queue an operation; call `op.wait()` for the result
+    pub fn submit(self: *WriteQueue, op: *WriteOp) !void {
+        op.next = null;
+        op.err = null;
+        op.done.reset();
+
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        if (self.closed) return error.WriteQueueClosed;
+
+        if (self.tail) |tail| {
+            tail.next = op;
+        } else {
+            self.head = op;
+        }
+        self.tail = op;
+        self.len += 1;
+        self.not_empty.signal();
+    }
+
+    pub fn create(self: *WriteQueue, comptime T: type, instance: T) !void {
+        var op = CreateOp(T).init(instance);
+        try self.submit(&op.op);
+        try op.op.wait();
+    }
+
+    pub fn createMany(self: *WriteQueue, comptime T: type, items: []const T) !void {
+        var op = CreateManyOp(T).init(items);
+        try self.submit(&op.op);
+        try op.op.wait();
+    }
+
+    /// Queued createMany() that writes the generated IDs into `ids` (one per item)
+    pub fn createManyReturningIds(self: *WriteQueue, comptime T: type, items: []const T, ids: []i64) !void {
+        var op = CreateManyReturningIdsOp(T).init(items, ids);
+        try self.submit(&op.op);
+        try op.op.wait();
+    }
+
+    pub fn update(self: *WriteQueue, comptime T: type, instance: T) !void {
+        var op = UpdateOp(T).init(instance);
+        try self.submit(&op.op);
+        try op.op.wait();
+    }
+
+    pub fn updateFields(self: *WriteQueue, comptime T: type, instance: T, mask: ModelSql(T).FieldMask) !void {
+        var op = UpdateFieldsOp(T).init(instance, mask);
+        try self.submit(&op.op);
+        try op.op.wait();
+    }
+
+    pub fn delete(self: *WriteQueue, comptime T: type, id: i64) !void {
+        var op = DeleteOp(T).init(id);
+        try self.submit(&op.op);
+        try op.op.wait();
+    }
+
+    pub fn stats(self: *WriteQueue) WriteQueueStats {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        var result = self.stats_data;
+        result.queued = self.len;
+        return result;
+    }
+
+    pub fn CreateOp(comptime T: type) type {
+        return struct {
+            const Self = @This();
+            op: WriteOp = .{ .run = run },
+            instance: T,
+
+            pub fn init(instance: T) Self {
+                return .{ .instance = instance };
+            }
+
+            fn run(op: *WriteOp, orm: *ORM) anyerror!void {
+                const self: *Self = @fieldParentPtr("op", op);
+                try orm.create(T, self.instance);
+            }
+        };
+    }
+
+    pub fn CreateManyOp(comptime T: type) type {
+        return struct {
+            const Self = @This();
+            op: WriteOp = .{ .run = run },
+            items: []const T,
+
+            pub fn init(items: []const T) Self {
+                return .{ .items = items };
+            }
+
+            fn run(op: *WriteOp, orm: *ORM) anyerror!void {
+                const self: *Self = @fieldParentPtr("op", op);
+                try orm.createMany(T, self.items);
+            }
+        };
+    }
+
+    pub fn CreateManyReturningIdsOp(comptime T: type) type {
+        return struct {
+            const Self = @This();
+            op: WriteOp = .{ .run = run },
+            items: []const T,
+            ids: []i64,
+
+            pub fn init(items: []const T, ids: []i64) Self {
+                std.debug.assert(ids.len == items.len);
+                return .{ .items = items, .ids = ids };
+            }
+
+            fn run(op: *WriteOp, orm: *ORM) anyerror!void {
+                const self: *Self = @fieldParentPtr("op", op);
+                const ids = try orm.createManyReturningIds(T, self.items);
+                defer orm.allocator.free(ids);
+                @memcpy(self.ids, ids);
+            }
+        };
+    }
+
+    pub fn UpdateOp(comptime T: type) type {
+        return struct {
+            const Self = @This();
+            op: WriteOp = .{ .run = run },
+            instance: T,
+
+            pub fn init(instance: T) Self {
+                return .{ .instance = instance };
+            }
+
+            fn run(op: *WriteOp, orm: *ORM) anyerror!void {
+                const self: *Self = @fieldParentPtr("op", op);
+                try orm.update(T, self.instance);
+            }
+        };
+    }
+
+    pub fn UpdateFieldsOp(comptime T: type) type {
+        return struct {
+            const Self = @This();
+            op: WriteOp = .{ .run = run },
+            instance: T,
+            mask: ModelSql(T).FieldMask,
+
+            pub fn init(instance: T, mask: ModelSql(T).FieldMask) Self {
+                return .{ .instance = instance, .mask = mask };
+            }
+
+            fn run(op: *WriteOp, orm: *ORM) anyerror!void {
+                const self: *Self = @fieldParentPtr("op", op);
+                try orm.updateFields(T, self.instance, self.mask);
+            }
+        };
+    }
+
+    pub fn DeleteOp(comptime T: type) type {
+        return struct {
+            const Self = @This();
+            op: WriteOp = .{ .run = run },
+            id: i64,
+
+            pub fn init(id: i64) Self {
+                return .{ .id = id };
+            }
+
+            fn run(op: *WriteOp, orm: *ORM) anyerror!void {
+                const self: *Self = @fieldParentPtr("op", op);
+                try orm.delete(T, self.id);
+            }
+        };
+    }
+
+    fn writerMain(self: *WriteQueue) void {
+        while (true) {
+            const batch = self.nextBatch() orelse return;
+            self.runBatch(batch);
+        }
+    }
+
+    /// Wait for work, give later submitters up to max_latency_us to join the
+    /// batch, then detach up to max_batch_size operations
+    /// Returns null once the queue is closed and drained.
+    fn nextBatch(self: *WriteQueue) ?*WriteOp {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        while (self.head == null) {
+            if (self.closed) return null;
+            self.not_empty.wait(&self.mutex);
+        }
+
+        if (self.options.max_latency_us > 0 and !self.closed) {
+            const deadline_ns = self.options.max_latency_us * std.time.ns_per_us;
+            var timer = std.time.Timer.start() catch null;
+            while (self.len < self.options.max_batch_size and !self.closed) {
+                const elapsed = if (timer) |*t| t.read() else deadline_ns;
+                if (elapsed >= deadline_ns) break;
+                self.not_empty.timedWait(&self.mutex, deadline_ns - elapsed) catch break;
+            }
+        }
+
+        const first = self.head.?;
+        var last = first;
+        var count: usize = 1;
+        while (count < self.options.max_batch_size) : (count += 1) {
+            last = last.next orelse break;
+        }
+
+        self.head = last.next;
+        if (self.head == null) self.tail = null;
+        last.next = null;
+        self.len -= count;
+        return first;
+    }
+
+    fn runBatch(self: *WriteQueue, batch: *WriteOp) void {
+        var count: usize = 0;
+        var failed: usize = 0;
+
+        {
+            self.writer_lock.lock();
+            defer self.writer_lock.unlock();
+
+            const db = &self.writer_orm.db;
+            var commit_err: ?anyerror = null;
+
+            if (db.execute("BEGIN IMMEDIATE")) |_| {
+                var it: ?*WriteOp = batch;
+                while (it) |op| : (it = op.next) {
+                    self.runOne(op);
+                }
+
+                db.execute("COMMIT") catch |err| {
+                    db.execute("ROLLBACK") catch {};
+                    commit_err = err;
+                };
+            } else |err| {
+                commit_err = err;
+            }
+
+            var it: ?*WriteOp = batch;
+            while (it) |op| : (it = op.next) {
+                count += 1;
+                if (op.err == null) op.err = commit_err;
+                if (op.err != null) failed += 1;
+            }
+        }
+
+        self.mutex.lock();
+        self.stats_data.batches += 1;
+        self.stats_data.operations += count;
+        self.stats_data.failed_operations += failed;
+        self.stats_data.largest_batch = @max(self.stats_data.largest_batch, count);
+        self.mutex.unlock();
+
+        // Read `next` before waking the submitter: the node may be freed right after set()
+        var it: ?*WriteOp = batch;
+        while (it) |op| {
+            it = op.next;
+            op.done.set();
+        }
+    }
+
+    fn runOne(self: *WriteQueue, op: *WriteOp) void {
+        const db = &self.writer_orm.db;
+
+        db.execute("SAVEPOINT e12_write_queue_op") catch |err| {
+            op.err = err;
+            return;
+        };
+
+        if (op.run(op, &self.writer_orm)) |_| {
+            db.execute("RELEASE e12_write_queue_op") catch |err| {
+                op.err = err;
+            };
+        } else |err| {
+            op.err = err;
+            db.execute("ROLLBACK TO e12_write_queue_op") catch {};
+            db.execute("RELEASE e12_write_queue_op") catch {};
+        }
+    }
+};
+
+test "WriteQueue commits concurrent writes in batches" {
+    const allocator = std.testing.allocator;
+
+    const Counter = struct {
+        id: i64,
+        value: i64,
+    };
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+    try db.execute("CREATE TABLE counter (id INTEGER PRIMARY KEY, value INTEGER)");
+
+    const queue = try WriteQueue.init(allocator, db, null, .{ .max_batch_size = 16, .max_latency_us = 5000 });
+
+    const thread_count = 8;
+    const writes_per_thread = 25;
+
+    const Worker = struct {
+        fn run(q: *WriteQueue, base: i64) void {
+            var i: i64 = 0;
+            while (i < writes_per_thread) : (i += 1) {
+                q.create(Counter, .{ .id = base + i + 1, .value = i }) catch unreachable;
+            }
+        }
+    };
+
+    var threads: [thread_count]std.Thread = undefined;
+    for (&threads, 0..) |*thread, t| {
+        thread.* = try std.Thread.spawn(.{}, Worker.run, .{ queue, @as(i64, @intCast(t * writes_per_thread)) });
+    }
+    for (threads) |thread| thread.join();
+
+    const stats = queue.stats();
+    queue.deinit();
+
+    try std.testing.expectEqual(@as(u64, thread_count * writes_per_thread), stats.operations);
+    try std.testing.expect(stats.batches < stats.operations);
+    try std.testing.expect(stats.largest_batch <= 16);
+
+    var result = try db.query("SELECT COUNT(*) FROM counter");
+    defer result.deinit();
+    try std.testing.expectEqual(@as(i64, thread_count * writes_per_thread), result.nextRow().?.getInt64(0));
+}
+
+test "WriteQueue isolates a failing operation within its batch" {
+    const allocator = std.testing.allocator;
+
+    const Item = struct {
+        id: i64,
+        name: []const u8,
+    };
+
+    var db = try Database.open(":memory:", allocator);
+    defer db.close();
+    try db.execute("CREATE TABLE item (id INTEGER PRIMARY KEY, name TEXT NOT NULL UNIQUE)");
+
+    const queue = try WriteQueue.init(allocator, db, null, .{ .max_latency_us = 20_000 });
+    defer queue.deinit();
+
+    var first = WriteQueue.CreateOp(Item).init(.{ .id = 0, .name = "a" });
+    var duplicate = WriteQueue.CreateOp(Item).init(.{ .id = 0, .name = "a" });
+    var third = WriteQueue.CreateOp(Item).init(.{ .id = 0, .name = "b" });
+    try queue.submit(&first.op);
+    try queue.submit(&duplicate.op);
+    try queue.submit(&third.op);
+
+    try first.op.wait();
+    try std.testing.expectError(error.QueryFailed, duplicate.op.wait());
+    try third.op.wait();
+
+    var result = try db.query("SELECT COUNT(*) FROM item");
+    defer result.deinit();
+    try std.testing.expectEqual(@as(i64, 2), result.nextRow().?.getInt64(0));
+}
@@ -5,19 +5,154 @@ const Request = @import("request.zig").Request;
 pub const PaginationMeta = struct {
     page: u32,
     limit: u32,
-    total: u32,
-    total_pages: u32,
+    /// Null when the total was not counted (`?count=none`)
+    total: ?u32,
+    total_pages: ?u32,
+    /// True when `total` comes from ANALYZE statistics (`?count=estimate`)
+    total_estimated: bool = false,
+};
+
+/// How a paginated listing computes its total
+/// - `exact`: COUNT of the filtered rows (the default)
+/// - `estimate`: approximate count from ANALYZE statistics, no table scan
+/// - `none`: no total at all, for clients that only show "next page"
+pub const CountMode = enum {
+    none,
+    exact,
+    estimate,
+
+    pub fn parse(value: []const u8) ?CountMode {
+        return std.meta.stringToEnum(CountMode, value);
+    }
+};
+
+/// Pagination metadata for keyset (cursor) responses
+/// `next_cursor` is null on the last page.
+pub const CursorMeta = struct {
+    limit: u32,
+    has_more: bool,
+    next_cursor: ?[]const u8,
+};
+
+/// Opaque keyset pagination cursor
+/// Holds the sort key and id of the last row of a page, so the next page is
+/// `WHERE (sort_field, id) > (sort_value, last_id)` instead of an OFFSET that
+/// has to walk every skipped row. Encoded as unpadded base64url of
+/// `<last_id>:<a|d>:<sort_field>:<sort_value>`.
+///
+/// Example:
+/// ```zig
+/// const cursor = try Cursor.fromItem(Todo, last_todo, "created_at", false, allocator);
+/// const token = try cursor.encode(allocator);
+/// // next request: GET /api/todos?cursor=<token>
+/// ```
+pub const Cursor = struct {
+    sort_field: []const u8,
+    ascending: bool,
+    sort_value: []const u8,
+    last_id: i64,
+
+    pub fn encode(self: Cursor, allocator: std.mem.Allocator) ![]u8 {
+        const payload = try std.fmt.allocPrint(allocator, "{d}:{s}:{s}:{s}", .{
+            self.last_id,
+            if (self.ascending) "a" else "d",
+            self.sort_field,
+            self.sort_value,
+        });
+        defer allocator.free(payload);
+
+        const encoder = std.base64.url_safe_no_pad.Encoder;
+        const token = try allocator.alloc(u8, encoder.calcSize(payload.len));
+        _ = encoder.encode(token, payload);
+        return token;
+    }
+
+    /// Decode a token produced by encode()
+    /// The returned slices point into one allocation owned by `allocator`
+    /// (use an arena). Returns error.InvalidCursor for malformed tokens.
+    pub fn decode(allocator: std.mem.Allocator, token: []const u8) !Cursor {
+        const decoder = std.base64.url_safe_no_pad.Decoder;
+        const size = decoder.calcSizeForSlice(token) catch return error.InvalidCursor;
+        const payload = try allocator.alloc(u8, size);
+        decoder.decode(payload, token) catch return error.InvalidCursor;
+
+        var parts = std.mem.splitScalar(u8, payload, ':');
+        const id_text = parts.next() orelse return error.InvalidCursor;
+        const direction = parts.next() orelse return error.InvalidCursor;
+        const sort_field = parts.next() orelse return error.InvalidCursor;
+        // The value may contain ':' itself, but the separator before it is required
+        if (parts.index == null) return error.InvalidCursor;
+        const sort_value = parts.rest();
+
+        const last_id = std.fmt.parseInt(i64, id_text, 10) catch return error.InvalidCursor;
+        const ascending = if (std.mem.eql(u8, direction, "a"))
+            true
+        else if (std.mem.eql(u8, direction, "d"))
+            false
+        else
+            return error.InvalidCursor;
+        if (sort_field.len == 0) return error.InvalidCursor;
+
+        return Cursor{
+            .sort_field = sort_field,
+            .ascending = ascending,
+            .sort_value = sort_value,
+            .last_id = last_id,
+        };
+    }
+
+    /// Build the cursor pointing after `item` for a runtime sort field name
+    /// Returns error.InvalidFieldName when T has no such field and
+    /// error.NullSortKey when the sort field is a null optional.
+    pub fn fromItem(comptime T: type, item: T, sort_field: []const u8, ascending: bool, allocator: std.mem.Allocator) !Cursor {
+        if (!@hasField(T, "id")) @compileError("Cursor pagination requires an 'id' field on " ++ @typeName(T));
+
+        inline for (std.meta.fields(T)) |field| {
+            if (std.mem.eql(u8, field.name, sort_field)) {
+                return Cursor{
+                    .sort_field = sort_field,
+                    .ascending = ascending,
+                    .sort_value = try keyText(allocator, @field(item, field.name)),
+                    .last_id = @intCast(item.id),
+                };
+            }
+        }
+        return error.InvalidFieldName;
+    }
+
+    /// Render a field value the way SQLite compares it against the column
+    fn keyText(allocator: std.mem.Allocator, value: anytype) ![]const u8 {
+        const V = @TypeOf(value);
+        return switch (@typeInfo(V)) {
+            .int, .comptime_int, .float, .comptime_float => std.fmt.allocPrint(allocator, "{d}", .{value}),
+            .bool => allocator.dupe(u8, if (value) "1" else "0"),
+            .@"enum" => std.fmt.allocPrint(allocator, "{d}", .{@intFromEnum(value)}),
+            .optional => if (value) |inner| keyText(allocator, inner) else error.NullSortKey,
+            .pointer => allocator.dupe(u8, value),
+            else => @compileError("Unsupported sort key type: " ++ @typeName(V)),
+        };
+    }
 };
 
 /// Pagination helper for parsing and generating pagination info
 pub const Pagination = struct {
+    pub const Mode = enum { offset, cursor };
+
     page: u32,
     limit: u32,
     offset: u32,
+    /// `.cursor` when the request carried `?cursor=` (empty for the first page)
+    mode: Mode = .offset,
+    /// Decoded cursor; null on the first page of a cursor listing
+    cursor: ?Cursor = null,
+    /// Requested `?count=` mode; null when the request did not choose one
+    count: ?CountMode = null,
     
     /// Create pagination from request query parameters
     /// Defaults: page=1, limit=20
     /// Validates: page >= 1, limit between 1 and 100
+    /// A `cursor` parameter switches to keyset mode and `page` is ignored;
+    /// the cursor is decoded into the request arena.
     /// 
     /// Example:
     /// ```zig
@@ -27,6 +162,10 @@ pub const Pagination = struct {
     pub fn fromRequest(req: *Request) !Pagination {
         const page = (req.queryParamTyped(u32, "page") catch null) orelse 1;
         const limit = (req.queryParamTyped(u32, "limit") catch null) orelse 20;
+        const count: ?CountMode = if (try req.query("count")) |value|
+            CountMode.parse(value) orelse return error.InvalidArgument
+        else
+            null;
         
         // Validate page
         if (page < 1) {
@@ -38,12 +177,28 @@ pub const Pagination = struct {
             return error.InvalidArgument;
         }
         
+        if (try req.query("cursor")) |token| {
+            const cursor = if (token.len == 0)
+                null
+            else
+                Cursor.decode(req.arena.allocator(), token) catch return error.InvalidArgument;
+            return Pagination{
+                .page = 1,
+                .limit = limit,
+                .offset = 0,
+                .mode = .cursor,
+                .cursor = cursor,
+                .count = count,
+            };
+        }
+        
         const offset = (page - 1) * limit;
         
         return Pagination{
             .page = page,
             .limit = limit,
             .offset = offset,
+            .count = count,
         };
     }
     
@@ -67,6 +222,23 @@ pub const Pagination = struct {
             .total_pages = total_pages,
         };
     }
+    
+    /// Pagination metadata with an approximate total (`?count=estimate`)
+    pub fn toEstimatedResponse(self: Pagination, estimated_total: u32) PaginationMeta {
+        var meta = self.toResponse(estimated_total);
+        meta.total_estimated = true;
+        return meta;
+    }
+    
+    /// Pagination metadata without a total (`?count=none`)
+    pub fn toResponseWithoutTotal(self: Pagination) PaginationMeta {
+        return PaginationMeta{
+            .page = self.page,
+            .limit = self.limit,
+            .total = null,
+            .total_pages = null,
+        };
+    }
 };
 
 // Tests
@@ -174,3 +346,101 @@ test "Pagination toResponse with zero total" {
     try std.testing.expectEqual(meta.total_pages, 0);
 }
 
+
+test "Cursor encode and decode round trip" {
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+    const allocator = arena.allocator();
+
+    const cursor = Cursor{
+        .sort_field = "title",
+        .ascending = false,
+        .sort_value = "a:b c",
+        .last_id = 42,
+    };
+    const token = try cursor.encode(allocator);
+    try std.testing.expect(std.mem.indexOfAny(u8, token, "+/=:") == null);
+
+    const decoded = try Cursor.decode(allocator, token);
+    try std.testing.expectEqualStrings("title", decoded.sort_field);
+    try std.testing.expectEqual(false, decoded.ascending);
+    try std.testing.expectEqualStrings("a:b c", decoded.sort_value);
+    try std.testing.expectEqual(@as(i64, 42), decoded.last_id);
+
+    try std.testing.expectError(error.InvalidCursor, Cursor.decode(allocator, "not a cursor!"));
+    try std.testing.expectError(error.InvalidCursor, Cursor.decode(allocator, "MTphOnRpdGxl")); // "1:a:title"
+}
+
+test "Cursor fromItem" {
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+    const allocator = arena.allocator();
+
+    const Todo = struct {
+        id: i64,
+        title: []const u8,
+        priority: i32,
+        due: ?i64,
+    };
+    const todo = Todo{ .id = 7, .title = "ship", .priority = 3, .due = null };
+
+    const by_priority = try Cursor.fromItem(Todo, todo, "priority", true, allocator);
+    try std.testing.expectEqualStrings("3", by_priority.sort_value);
+    try std.testing.expectEqual(@as(i64, 7), by_priority.last_id);
+
+    const by_title = try Cursor.fromItem(Todo, todo, "title", true, allocator);
+    try std.testing.expectEqualStrings("ship", by_title.sort_value);
+
+    try std.testing.expectError(error.NullSortKey, Cursor.fromItem(Todo, todo, "due", true, allocator));
+    try std.testing.expectError(error.InvalidFieldName, Cursor.fromItem(Todo, todo, "missing", true, allocator));
+}
+
+test "Pagination fromRequest with cursor" {
+    const ziggurat = @import("ziggurat");
+    const headers = std.StringHashMap([]const u8).init(std.testing.allocator);
+    const user_data = std.StringHashMap([]const u8).init(std.testing.allocator);
+    var ziggurat_req = ziggurat.request.Request{
+        .path = "/api/todos?cursor=&limit=5",
+        .method = .GET,
+        .body = "",
+        .headers = headers,
+        .allocator = std.testing.allocator,
+        .user_data = user_data,
+    };
+    var req = Request.fromZiggurat(&ziggurat_req, std.testing.allocator);
+    defer req.deinit();
+
+    const pagination = try Pagination.fromRequest(&req);
+    try std.testing.expectEqual(Pagination.Mode.cursor, pagination.mode);
+    try std.testing.expect(pagination.cursor == null);
+    try std.testing.expectEqual(@as(u32, 5), pagination.limit);
+}
+
+test "Pagination count modes" {
+    const ziggurat = @import("ziggurat");
+    const headers = std.StringHashMap([]const u8).init(std.testing.allocator);
+    const user_data = std.StringHashMap([]const u8).init(std.testing.allocator);
+    var ziggurat_req = ziggurat.request.Request{
+        .path = "/api/todos?page=2&limit=10&count=estimate",
+        .method = .GET,
+        .body = "",
+        .headers = headers,
+        .allocator = std.testing.allocator,
+        .user_data = user_data,
+    };
+    var req = Request.fromZiggurat(&ziggurat_req, std.testing.allocator);
+    defer req.deinit();
+
+    const pagination = try Pagination.fromRequest(&req);
+    try std.testing.expectEqual(@as(?CountMode, .estimate), pagination.count);
+
+    const estimated = pagination.toEstimatedResponse(95);
+    try std.testing.expect(estimated.total_estimated);
+    try std.testing.expectEqual(@as(?u32, 10), estimated.total_pages);
+
+    const uncounted = pagination.toResponseWithoutTotal();
+    try std.testing.expect(uncounted.total == null);
+    try std.testing.expect(uncounted.total_pages == null);
+
+    try std.testing.expect(CountMode.parse("sometimes") == null);
+}
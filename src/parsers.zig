@@ -107,6 +107,11 @@ pub const BodyParser = struct {
         return Json.deserialize(T, body, allocator);
     }
 
+    /// Parse a JSON array body into a slice of structs
+    pub fn jsonArray(comptime T: type, body: []const u8, allocator: std.mem.Allocator) ![]T {
+        return Json.deserializeArray(T, body, allocator);
+    }
+
     /// Parse JSON body into a struct, returning null on error
     pub fn jsonOptional(comptime T: type, body: []const u8, allocator: std.mem.Allocator) ?T {
         return json(T, body, allocator) catch null;
@@ -223,6 +223,22 @@ pub const Request = struct {
         return parsers.BodyParser.json(T, self.body(), self.arena.allocator());
     }
 
+    /// Parse request body as a JSON array of objects
+    /// The slice is allocated in the request arena
+    ///
+    /// Example:
+    /// ```zig
+    /// const todos = try req.jsonBodyArray(Todo);
+    /// ```
+    pub fn jsonBodyArray(self: *Request, comptime T: type) ![]T {
+        const MAX_BODY_SIZE = 10 * 1024 * 1024;
+        if (self.body().len > MAX_BODY_SIZE) {
+            std.debug.print("[Request Error] JSON body exceeds maximum size ({d} bytes)\n", .{MAX_BODY_SIZE});
+            return error.InvalidArgument;
+        }
+        return parsers.BodyParser.jsonArray(T, self.body(), self.arena.allocator());
+    }
+
     /// Parse request body as JSON (alias for jsonBody)
     /// Returns an error if parsing fails
     ///
@@ -500,6 +516,19 @@ pub const Request = struct {
         try cache_instance.set(key, cache_body, ttl_ms, content_type);
     }
 
+    /// Store a value in the cache with invalidation tags
+    /// Entries tagged with table names are dropped by `ResponseCache.followChanges()`
+    /// when those tables change.
+    ///
+    /// Example:
+    /// ```zig
+    /// try req.cacheSetTagged("todos:user:1", body, 60000, "application/json", &.{"todos"});
+    /// ```
+    pub fn cacheSetTagged(self: *Request, key: []const u8, cache_body: []const u8, ttl_ms: ?u64, content_type: []const u8, tags: []const []const u8) !void {
+        const cache_instance = self.cache() orelse return;
+        try cache_instance.setTagged(key, cache_body, ttl_ms, content_type, tags);
+    }
+
     /// Invalidate a cache entry
     ///
     /// Example:
@@ -689,6 +689,45 @@ pub const Response = struct {
         return resp.withContentType(content_type);
     }
 
+    /// Response body written incrementally, straight into persistent memory
+    /// Producers such as `ORM.exportCsv` append to the final body as they go, so
+    /// a large export is never held as a row list, a JSON string or a second
+    /// copy. ziggurat sends complete bodies, so the body is finished before the
+    /// response is returned.
+    ///
+    /// Example:
+    /// ```zig
+    /// var body = Response.BodyWriter{};
+    /// _ = orm.exportCsv(sql, body.writer(), .{}) catch {
+    ///     body.discard();
+    ///     return Response.serverError("Export failed");
+    /// };
+    /// return body.finish("text/csv; charset=utf-8");
+    /// ```
+    pub const BodyWriter = struct {
+        buffer: std.ArrayListUnmanaged(u8) = .{},
+
+        pub fn writer(self: *BodyWriter) std.ArrayListUnmanaged(u8).Writer {
+            return self.buffer.writer(persistent_allocator);
+        }
+
+        /// Drop a partially written body
+        pub fn discard(self: *BodyWriter) void {
+            self.buffer.deinit(persistent_allocator);
+        }
+
+        /// Hand the written bytes to a response without copying them
+        pub fn finish(self: *BodyWriter, content_type: []const u8) Response {
+            const body = self.buffer.items;
+            self.buffer = .{};
+            const resp = Response{
+                .inner = ziggurat.response.Response.text(body),
+                ._persistent_body = body,
+            };
+            return resp.withContentType(content_type);
+        }
+    };
+
     /// Get the response body content
     /// Returns the body string if available
     ///
@@ -845,6 +884,15 @@ test "Response download creates correct response" {
     _ = resp;
 }
 
+test "Response BodyWriter hands its bytes to the response" {
+    var body = Response.BodyWriter{};
+    try body.writer().writeAll("id,name\r\n");
+    try body.writer().print("{d},{s}\r\n", .{ 1, "Ann" });
+    const resp = body.finish("text/csv");
+    try std.testing.expectEqualStrings("id,name\r\n1,Ann\r\n", resp.getBody());
+    try std.testing.expectEqual(@as(usize, 0), body.buffer.items.len);
+}
+
 test "Response stream creates correct response" {
     const resp = Response.stream("text/plain", "stream data");
     _ = resp;
@@ -10,8 +10,12 @@ const ValidationErrors = validation.ValidationErrors;
 const pagination_mod = @import("pagination.zig");
 const Pagination = pagination_mod.Pagination;
 const PaginationMeta = pagination_mod.PaginationMeta;
+const CursorMeta = pagination_mod.CursorMeta;
+const Cursor = pagination_mod.Cursor;
+const CountMode = pagination_mod.CountMode;
 const json_mod = @import("json.zig");
 const model_utils = @import("orm/model.zig");
+const ModelSql = @import("orm/model_sql.zig").ModelSql;
 const openapi = @import("openapi.zig");
 
 const allocator = std.heap.page_allocator;
@@ -43,11 +47,40 @@ pub fn RestApiConfig(comptime Model: type) type {
         /// Optional cache TTL in milliseconds
         cache_ttl_ms: ?u32 = null,
         /// Enable pagination (default: true)
+        /// `?page=N` uses OFFSET; `?cursor=` (empty for the first page, then the
+        /// previous response's `meta.next_cursor`) uses keyset pagination
         enable_pagination: bool = true,
+        /// Total computed for list responses when the request has no `?count=`
+        /// (`.exact`, `.estimate` from ANALYZE statistics for unfiltered lists, or `.none`)
+        default_count: CountMode = .exact,
+        /// Cache exact totals per filter set for this long (null = no caching)
+        /// Entries are dropped by this resource's create/update/delete handlers;
+        /// writes made outside restApi are only picked up when the TTL expires.
+        count_cache_ttl_ms: ?u32 = null,
         /// Enable filtering via ?filter=field:value (default: true)
         enable_filtering: bool = true,
         /// Enable sorting via ?sort=field:asc|desc (default: true)
         enable_sorting: bool = true,
+        /// Fields accepted by ?filter= (null = any model field)
+        filterable_fields: ?[]const []const u8 = null,
+        /// Fields accepted by ?sort= (null = any model field)
+        sortable_fields: ?[]const []const u8 = null,
+        /// Create indexes at registration: the model's declared `indexes`, then
+        /// one per filterable or sortable field unless an index already starts
+        /// with its columns. Led by `user_id` when results are scoped per user.
+        auto_index: bool = true,
+        /// Answer GET /prefix with every matching row as CSV when the request sends
+        /// `Accept: text/csv` (or TSV for `text/tab-separated-values`). Filters,
+        /// sort and per-user scoping apply; pagination and the list cache do not.
+        enable_csv_export: bool = false,
+        /// Serialize GET /prefix pages inside SQLite with json_group_array(json_object(...))
+        /// Rows are never decoded into structs or re-serialized in Zig. Floats use
+        /// SQLite's number formatting. Cursor pages keep the regular path.
+        sqlite_json_lists: bool = false,
+        /// Enable POST /prefix/bulk for inserting a JSON array in one transaction (default: true)
+        enable_bulk_create: bool = true,
+        /// Maximum number of records accepted by the bulk endpoint
+        max_bulk_items: usize = 1000,
         /// Optional hook called before creating a record
         /// Note: Hooks are not currently supported due to Zig type system limitations
         /// This field is reserved for future use
@@ -71,12 +104,31 @@ pub fn RestApiConfig(comptime Model: type) type {
     };
 }
 
+/// Check that `name` is a field of T and, when an allow-list is given, in it
+fn isAllowedField(comptime T: type, name: []const u8, allowed: ?[]const []const u8) bool {
+    var is_field = false;
+    inline for (std.meta.fields(T)) |field| {
+        if (std.mem.eql(u8, field.name, name)) {
+            is_field = true;
+            break;
+        }
+    }
+    if (!is_field) return false;
+
+    const list = allowed orelse return true;
+    for (list) |entry| {
+        if (std.mem.eql(u8, entry, name)) return true;
+    }
+    return false;
+}
+
 /// Parse filter query parameters into QueryBuilder where clauses
 /// Format: ?filter=field1:value1&filter=field2:value2
 fn parseFilters(
     comptime T: type,
     builder: *QueryBuilder,
     request: *Request,
+    allowed: ?[]const []const u8,
 ) !void {
     const filter_params = try request.queryParams();
     var filter_iter = filter_params.iterator();
@@ -90,16 +142,7 @@ fn parseFilters(
         const field_name = filter_value[0..colon_pos];
         const field_value = filter_value[colon_pos + 1 ..];
 
-        // Validate field name exists in struct (runtime check)
-        var field_valid = false;
-        inline for (std.meta.fields(T)) |field| {
-            if (std.mem.eql(u8, field.name, field_name)) {
-                field_valid = true;
-                break;
-            }
-        }
-
-        if (!field_valid) {
+        if (!isAllowedField(T, field_name, allowed)) {
             return error.InvalidFieldName;
         }
 
@@ -114,6 +157,7 @@ fn parseSort(
     comptime T: type,
     builder: *QueryBuilder,
     request: *Request,
+    allowed: ?[]const []const u8,
 ) !void {
     const sort_param = try request.query("sort");
     const sort_value = sort_param orelse return;
@@ -123,16 +167,7 @@ fn parseSort(
     const field_name = sort_value[0..colon_pos];
     const direction = sort_value[colon_pos + 1 ..];
 
-    // Validate field name exists in struct (runtime check)
-    var field_valid = false;
-    inline for (std.meta.fields(T)) |field| {
-        if (std.mem.eql(u8, field.name, field_name)) {
-            field_valid = true;
-            break;
-        }
-    }
-
-    if (!field_valid) {
+    if (!isAllowedField(T, field_name, allowed)) {
         return error.InvalidFieldName;
     }
 
@@ -190,10 +225,59 @@ fn buildListCacheKey(
     const page = (request.queryParamTyped(u32, "page") catch null) orelse 1;
     const limit = (request.queryParamTyped(u32, "limit") catch null) orelse 20;
     try writer.print(":page:{d}:limit:{d}", .{ page, limit });
+    if (try request.query("cursor")) |cursor| {
+        try writer.print(":cursor:{s}", .{cursor});
+    }
+    if (try request.query("count")) |count| {
+        try writer.print(":count:{s}", .{count});
+    }
 
     return try key_buf.toOwnedSlice(arena);
 }
 
+/// Build cache key for a list total: user and filters only, since sort and
+/// page do not change the count
+fn buildCountCacheKey(prefix: []const u8, request: *Request, user_id: ?i64) ![]const u8 {
+    const arena = request.arena.allocator();
+
+    var key_buf = std.ArrayListUnmanaged(u8){};
+    defer key_buf.deinit(arena);
+    const writer = key_buf.writer(arena);
+
+    try writer.print("{s}:count:", .{prefix});
+    if (user_id) |uid| {
+        try writer.print(":user:{d}", .{uid});
+    }
+
+    const filter_params = try request.queryParams();
+    var filter_iter = filter_params.iterator();
+    while (filter_iter.next()) |entry| {
+        if (std.mem.eql(u8, entry.key_ptr.*, "filter")) {
+            try writer.print(":filter:{s}", .{entry.value_ptr.*});
+        }
+    }
+
+    return try key_buf.toOwnedSlice(arena);
+}
+
+/// Drop every cached total for a resource after a write
+fn invalidateCountCache(prefix: []const u8, request: *Request) void {
+    const key_prefix = std.fmt.allocPrint(request.arena.allocator(), "{s}:count:", .{prefix}) catch return;
+    request.cacheInvalidatePrefix(key_prefix);
+}
+
+/// Run `SELECT COUNT(*)` with the list query's filters
+fn countRows(orm: *ORM, builder: *QueryBuilder) !i64 {
+    const count_sql = try builder.buildCount();
+    defer builder.allocator.free(count_sql);
+
+    var count_result = try orm.query(count_sql);
+    defer count_result.deinit();
+
+    const count_row = count_result.nextRow() orelse return error.QueryFailed;
+    return count_row.getInt64(0);
+}
+
 /// Build cache key for show endpoint
 fn buildShowCacheKey(prefix: []const u8, id: i64, user_id: ?i64) ![]const u8 {
     if (user_id) |uid| {
@@ -211,6 +295,100 @@ fn PaginatedResponse(comptime T: type) type {
     };
 }
 
+/// Keyset-paginated response structure
+fn CursorPaginatedResponse(comptime T: type) type {
+    return struct {
+        data: []const T,
+        meta: CursorMeta,
+    };
+}
+
+/// Store a serialized list response in the cache (best-effort)
+/// Entries are tagged with the table so a change feed can drop them on any write.
+fn cacheListResponse(
+    comptime Body: type,
+    body: Body,
+    prefix: []const u8,
+    table_name: []const u8,
+    request: *Request,
+    user_id: ?i64,
+    ttl: u32,
+    orm_allocator: std.mem.Allocator,
+) void {
+    const json = json_mod.Json.serialize(Body, body, orm_allocator) catch return;
+    defer orm_allocator.free(json);
+    cacheListBody(json, prefix, table_name, request, user_id, ttl);
+}
+
+/// Store an already serialized list response in the cache (best-effort)
+fn cacheListBody(
+    json: []const u8,
+    prefix: []const u8,
+    table_name: []const u8,
+    request: *Request,
+    user_id: ?i64,
+    ttl: u32,
+) void {
+    const cache_key = buildListCacheKey(prefix, request, user_id) catch null;
+    if (cache_key) |key| {
+        // Note: key is allocated with request.arena.allocator(), so no manual free needed
+        const persistent_json = std.heap.page_allocator.dupe(u8, json) catch null;
+        if (persistent_json) |pj| {
+            // Cache set is best-effort - log but don't fail request if caching fails
+            request.cacheSetTagged(key, pj, ttl, "application/json", &.{table_name}) catch |err| {
+                std.debug.print("[REST API] Warning: Failed to cache response: {}\n", .{err});
+            };
+        }
+    }
+}
+
+const ExportFormat = enum { csv, tsv };
+
+/// CSV/TSV requested through the Accept header, if any
+fn exportFormat(request: *Request) ?ExportFormat {
+    const accept = request.header("Accept") orelse return null;
+    if (std.mem.indexOf(u8, accept, "text/csv") != null) return .csv;
+    if (std.mem.indexOf(u8, accept, "text/tab-separated-values") != null) return .tsv;
+    return null;
+}
+
+/// Stream every row of the filtered list query into a CSV/TSV body
+/// Only model fields are selected, matching what the JSON list exposes.
+fn handleExport(
+    comptime T: type,
+    table_name: []const u8,
+    config: RestApiConfig(T),
+    builder: *QueryBuilder,
+    format: ExportFormat,
+) Response {
+    const columns = comptime blk: {
+        const fields = std.meta.fields(T);
+        var names: [fields.len][]const u8 = undefined;
+        for (fields, 0..) |field, i| names[i] = field.name;
+        const final_names = names;
+        break :blk final_names;
+    };
+    _ = builder.select(&columns);
+
+    const sql = builder.build() catch {
+        return Response.serverError("Failed to build query");
+    };
+    defer config.orm.allocator.free(sql);
+
+    const options: orm_mod.CsvOptions = if (format == .tsv) orm_mod.CsvOptions.tsv else .{};
+    var body = Response.BodyWriter{};
+    _ = config.orm.exportCsv(sql, body.writer(), options) catch {
+        body.discard();
+        return Response.serverError("Failed to export rows");
+    };
+
+    const extension = if (format == .tsv) "tsv" else "csv";
+    var disposition_buf: [256]u8 = undefined;
+    const disposition = std.fmt.bufPrint(&disposition_buf, "attachment; filename=\"{s}.{s}\"", .{ table_name, extension }) catch "attachment";
+    const content_type = if (format == .tsv) "text/tab-separated-values; charset=utf-8" else "text/csv; charset=utf-8";
+    return body.finish(content_type).withHeader("Content-Disposition", disposition);
+}
+
 /// Handler for GET /resource (list endpoint)
 fn handleList(
     comptime T: type,
@@ -226,8 +404,10 @@ fn handleList(
         };
     }
 
+    const export_format: ?ExportFormat = if (config.enable_csv_export) exportFormat(request) else null;
+
     // Check cache
-    if (config.cache_ttl_ms) |_| {
+    if (config.cache_ttl_ms != null and export_format == null) {
         const cache_key = buildListCacheKey(prefix, request, if (user) |u| u.id else null) catch null;
         if (cache_key) |key| {
             // Note: key is allocated with request.arena.allocator(), so no manual free needed
@@ -286,7 +466,7 @@ fn handleList(
 
     // Add filters from query parameters
     if (config.enable_filtering) {
-        parseFilters(T, &builder, request) catch |err| {
+        parseFilters(T, &builder, request, config.filterable_fields) catch |err| {
             if (err == error.InvalidFieldName) {
                 return Response.errorResponse("Invalid filter field name", 400);
             }
@@ -296,7 +476,7 @@ fn handleList(
 
     // Add sort
     if (config.enable_sorting) {
-        parseSort(T, &builder, request) catch |err| {
+        parseSort(T, &builder, request, config.sortable_fields) catch |err| {
             if (err == error.InvalidFieldName) {
                 return Response.errorResponse("Invalid sort field name", 400);
             }
@@ -306,163 +486,217 @@ fn handleList(
         };
     }
 
+    if (export_format) |format| {
+        return handleExport(T, table_name, config, &builder, format);
+    }
+
+    if (pagination.mode == .cursor) {
+        if (comptime !@hasField(T, "id")) {
+            return Response.errorResponse("Cursor pagination requires an id field", 400);
+        } else {
+            return handleCursorList(T, prefix, config, request, &builder, pagination, user);
+        }
+    }
+
     // Add pagination
     _ = builder.limit(pagination.limit).offset(pagination.offset);
 
+    var count_mode = pagination.count orelse config.default_count;
+    // Table statistics know nothing of filters or per-user scoping, so a
+    // filtered list reports no total rather than the whole table's
+    if (count_mode == .estimate and builder.where_clauses.items.len > 0) count_mode = .none;
+    const user_id: ?i64 = if (user) |u| u.id else null;
+    const arena = request.arena.allocator();
+
+    // Exact totals: a cached total for this filter set, else COUNT(*) OVER ()
+    // in the page query itself instead of a second COUNT statement
+    var total: ?i64 = null;
+    var count_cache_key: ?[]const u8 = null;
+    if (count_mode == .exact and config.count_cache_ttl_ms != null) {
+        count_cache_key = buildCountCacheKey(prefix, request, user_id) catch null;
+        if (count_cache_key) |key| {
+            if (request.cacheGet(key) catch null) |entry| {
+                total = std.fmt.parseInt(i64, entry.body, 10) catch null;
+            }
+        }
+    }
+    const window_count = count_mode == .exact and total == null;
+    if (window_count) {
+        _ = builder.select(&.{ "*", "COUNT(*) OVER () AS e12_total" });
+    }
+
     // Build and execute query
     const sql = builder.build() catch {
         return Response.serverError("Failed to build query");
     };
     defer config.orm.allocator.free(sql);
 
-    var query_result = config.orm.query(sql) catch {
-        return Response.serverError("Failed to execute query");
-    };
-    defer query_result.deinit();
+    // Rows and their strings live in the request arena and are freed with the request
+    var items = std.ArrayListUnmanaged(T){};
+    var data_json: ?[]const u8 = null;
+    if (config.sqlite_json_lists) {
+        // SQLite emits the data array as text; no row is decoded into T
+        const order_by = builder.buildOrderBy() catch {
+            return Response.serverError("Failed to build query");
+        };
+        defer if (order_by) |terms| config.orm.allocator.free(terms);
+        const page = config.orm.queryJsonArray(T, sql, .{
+            .order_by = order_by,
+            .total_column = if (window_count) "e12_total" else null,
+        }, arena) catch {
+            return Response.serverError("Failed to execute query");
+        };
+        if (window_count) total = page.total;
+        data_json = page.json;
+    } else {
+        var query_result = config.orm.query(sql) catch {
+            return Response.serverError("Failed to execute query");
+        };
+        defer query_result.deinit();
 
-    var items = query_result.toArrayList(T) catch {
-        return Response.serverError("Failed to deserialize results");
-    };
-    defer {
-        for (items.items) |item| {
-            inline for (std.meta.fields(T)) |field| {
-                const field_type = @TypeOf(@field(item, field.name));
-                if (@typeInfo(field_type) == .pointer) {
-                    const ptr_info = @typeInfo(field_type).pointer;
-                    if (ptr_info.size == .slice and ptr_info.child == u8) {
-                        config.orm.allocator.free(@field(item, field.name));
-                    }
-                } else if (@typeInfo(field_type) == .optional) {
-                    const opt_info = @typeInfo(field_type).optional;
-                    if (@typeInfo(opt_info.child) == .pointer) {
-                        const ptr_info = @typeInfo(opt_info.child).pointer;
-                        if (ptr_info.size == .slice and ptr_info.child == u8) {
-                            if (@field(item, field.name)) |val| {
-                                config.orm.allocator.free(val);
-                            }
-                        }
-                    }
-                }
-            }
+        if (window_count) {
+            const page = query_result.toArrayListWithTotal(T, arena) catch {
+                return Response.serverError("Failed to deserialize results");
+            };
+            total = page.total;
+            items = page.items;
+        } else {
+            items = query_result.toArrayListAlloc(T, arena) catch {
+                return Response.serverError("Failed to deserialize results");
+            };
         }
-        items.deinit(config.orm.allocator);
     }
 
-    // Get total count for pagination
-    var count_builder = QueryBuilder.init(config.orm.allocator, table_name);
-    defer count_builder.deinit();
-
-    // Automatically filter by user_id if authenticator is present and model has user_id field
-    if (user) |authenticated_user| {
-        var has_user_id_field = false;
-        inline for (std.meta.fields(T)) |field| {
-            if (std.mem.eql(u8, field.name, "user_id")) {
-                has_user_id_field = true;
-                break;
+    if (window_count) {
+        // A page past the end has no rows to carry the window total
+        if (total == null) {
+            total = if (pagination.offset == 0) 0 else countRows(config.orm, &builder) catch {
+                return Response.serverError("Failed to execute count query");
+            };
+        }
+        if (count_cache_key) |key| {
+            const text = std.fmt.allocPrint(arena, "{d}", .{total.?}) catch null;
+            if (text) |t| {
+                // Count caching is best-effort - log but don't fail the request
+                request.cacheSetTagged(key, t, config.count_cache_ttl_ms.?, "text/plain", &.{table_name}) catch |err| {
+                    std.debug.print("[REST API] Warning: Failed to cache count: {}\n", .{err});
+                };
             }
         }
-        if (has_user_id_field) {
-            // Add user_id filter automatically to ensure count matches filtered results
-            // Use request arena allocator so string persists until count_builder.build() is called
-            const user_id_str = std.fmt.allocPrint(request.arena.allocator(), "{d}", .{authenticated_user.id}) catch {
-                return Response.serverError("Failed to format user_id filter for count");
+    }
+
+    // Totals that do not fit the u32 meta field are omitted rather than truncated
+    const meta = switch (count_mode) {
+        .exact => if (std.math.cast(u32, total.?)) |exact| pagination.toResponse(exact) else pagination.toResponseWithoutTotal(),
+        .none => pagination.toResponseWithoutTotal(),
+        .estimate => blk: {
+            const estimate = config.orm.estimateCount(table_name, &.{}) catch {
+                break :blk pagination.toResponseWithoutTotal();
             };
-            _ = count_builder.whereEq("user_id", user_id_str);
+            const estimated = std.math.cast(u32, estimate) orelse break :blk pagination.toResponseWithoutTotal();
+            break :blk pagination.toEstimatedResponse(estimated);
+        },
+    };
+
+    if (data_json) |data| {
+        const meta_json = json_mod.Json.serialize(PaginationMeta, meta, arena) catch {
+            return Response.serverError("Failed to serialize response");
+        };
+        const body = std.mem.concat(arena, u8, &.{ "{\"data\":", data, ",\"meta\":", meta_json, "}" }) catch {
+            return Response.serverError("Failed to serialize response");
+        };
+        if (config.cache_ttl_ms) |ttl| {
+            cacheListBody(body, prefix, table_name, request, user_id, ttl);
         }
+        return Response.json(body).withHeader("X-Cache", "MISS");
     }
 
-    if (config.enable_filtering) {
-        // Parse filters for count query - ignore errors as filtering is optional
-        // If parsing fails, count query will proceed without filters
-        parseFilters(T, &count_builder, request) catch |err| {
-            std.debug.print("[REST API] Warning: Failed to parse filters for count query: {}\n", .{err});
-        };
+    // Create paginated response
+    const paginated = PaginatedResponse(T){
+        .data = items.items,
+        .meta = meta,
+    };
+
+    const response = Response.jsonFrom(PaginatedResponse(T), paginated, config.orm.allocator);
+
+    // Cache the response
+    if (config.cache_ttl_ms) |ttl| {
+        cacheListResponse(PaginatedResponse(T), paginated, prefix, table_name, request, if (user) |u| u.id else null, ttl, config.orm.allocator);
     }
 
-    // Build COUNT query
-    var count_sql_buf = std.ArrayListUnmanaged(u8){};
-    defer count_sql_buf.deinit(config.orm.allocator);
+    return response.withHeader("X-Cache", "MISS");
+}
 
-    count_sql_buf.writer(config.orm.allocator).print("SELECT COUNT(*) as count FROM {s}", .{table_name}) catch {
-        return Response.serverError("Failed to build count query");
-    };
+/// Keyset branch of handleList
+/// Pages with `(sort, id) > (last sort, last id)` instead of OFFSET and skips
+/// the COUNT(*), so page 10,000 costs the same index seek as page 1. One extra
+/// row is fetched to tell whether a next page exists. Rows whose sort column
+/// is NULL cannot be paged past.
+fn handleCursorList(
+    comptime T: type,
+    prefix: []const u8,
+    config: RestApiConfig(T),
+    request: *Request,
+    builder: *QueryBuilder,
+    pagination: Pagination,
+    user: ?AuthUser,
+) Response {
+    const sort_field = builder.order_by_field orelse "id";
+    const ascending = builder.order_ascending;
+    _ = builder.orderByKeyset(sort_field, ascending);
 
-    // Add WHERE clause if filters exist
-    if (count_builder.where_clauses.items.len > 0) {
-        count_sql_buf.writer(config.orm.allocator).print(" WHERE ", .{}) catch {
-            return Response.serverError("Failed to build count query");
-        };
-        for (count_builder.where_clauses.items, 0..) |clause, i| {
-            if (i > 0) count_sql_buf.writer(config.orm.allocator).print(" AND ", .{}) catch {
-                return Response.serverError("Failed to build count query");
-            };
-            var escaped_value = std.ArrayListUnmanaged(u8){};
-            defer escaped_value.deinit(config.orm.allocator);
-            for (clause.value) |char| {
-                if (char == '\'') {
-                    // Escaping SQL single quotes - best effort, log if allocation fails
-                    escaped_value.append(config.orm.allocator, '\'') catch {
-                        std.debug.print("[REST API] Warning: Failed to escape SQL value, skipping character\n", .{});
-                        continue;
-                    };
-                    escaped_value.append(config.orm.allocator, '\'') catch {
-                        std.debug.print("[REST API] Warning: Failed to escape SQL value, skipping character\n", .{});
-                        continue;
-                    };
-                } else {
-                    escaped_value.append(config.orm.allocator, char) catch {
-                        std.debug.print("[REST API] Warning: Failed to escape SQL value, skipping character\n", .{});
-                        continue;
-                    };
-                }
-            }
-            count_sql_buf.writer(config.orm.allocator).print("{s} {s} '{s}'", .{ clause.field, clause.operator, escaped_value.items }) catch {
-                return Response.serverError("Failed to build count query");
-            };
+    if (pagination.cursor) |cursor| {
+        if (!std.mem.eql(u8, cursor.sort_field, sort_field) or cursor.ascending != ascending) {
+            return Response.errorResponse("Cursor does not match the requested sort", 400);
         }
+        _ = builder.after(cursor.sort_value, cursor.last_id);
     }
+    _ = builder.limit(pagination.limit + 1);
 
-    const count_sql = count_sql_buf.toOwnedSlice(config.orm.allocator) catch {
-        return Response.serverError("Failed to allocate count query");
+    const sql = builder.build() catch {
+        return Response.serverError("Failed to build query");
     };
-    defer config.orm.allocator.free(count_sql);
+    defer config.orm.allocator.free(sql);
 
-    var count_result = config.orm.query(count_sql) catch {
-        return Response.serverError("Failed to execute count query");
+    var query_result = config.orm.query(sql) catch {
+        return Response.serverError("Failed to execute query");
     };
-    defer count_result.deinit();
+    defer query_result.deinit();
 
-    const count_row = count_result.nextRow() orelse {
-        return Response.serverError("Failed to get count");
+    const arena = request.arena.allocator();
+    var items = query_result.toArrayListAlloc(T, arena) catch {
+        return Response.serverError("Failed to deserialize results");
     };
-    const total = count_row.getInt64(0);
 
-    // Create paginated response
-    const meta = pagination.toResponse(@intCast(total));
-    const paginated = PaginatedResponse(T){
+    const has_more = items.items.len > pagination.limit;
+    var next_cursor: ?[]const u8 = null;
+    if (has_more) {
+        items.shrinkRetainingCapacity(pagination.limit);
+        const last = items.items[items.items.len - 1];
+        const cursor = Cursor.fromItem(T, last, sort_field, ascending, arena) catch |err| {
+            if (err == error.NullSortKey) {
+                return Response.errorResponse("Cannot paginate past a null sort value", 400);
+            }
+            return Response.serverError("Failed to build cursor");
+        };
+        next_cursor = cursor.encode(arena) catch {
+            return Response.serverError("Failed to encode cursor");
+        };
+    }
+
+    const paginated = CursorPaginatedResponse(T){
         .data = items.items,
-        .meta = meta,
+        .meta = CursorMeta{
+            .limit = pagination.limit,
+            .has_more = has_more,
+            .next_cursor = next_cursor,
+        },
     };
 
-    const response = Response.jsonFrom(PaginatedResponse(T), paginated, config.orm.allocator);
+    const response = Response.jsonFrom(CursorPaginatedResponse(T), paginated, config.orm.allocator);
 
-    // Cache the response
     if (config.cache_ttl_ms) |ttl| {
-        const cache_key = buildListCacheKey(prefix, request, if (user) |u| u.id else null) catch null;
-        if (cache_key) |key| {
-            // Note: key is allocated with request.arena.allocator(), so no manual free needed
-            const json = json_mod.Json.serialize(PaginatedResponse(T), paginated, config.orm.allocator) catch null;
-            if (json) |j| {
-                defer config.orm.allocator.free(j);
-                const persistent_json = std.heap.page_allocator.dupe(u8, j) catch null;
-                if (persistent_json) |pj| {
-                    // Cache set is best-effort - log but don't fail request if caching fails
-                    request.cacheSet(key, pj, ttl, "application/json") catch |err| {
-                        std.debug.print("[REST API] Warning: Failed to cache response: {}\n", .{err});
-                    };
-                }
-            }
-        }
+        cacheListResponse(CursorPaginatedResponse(T), paginated, prefix, builder.table_name, request, if (user) |u| u.id else null, ttl, config.orm.allocator);
     }
 
     return response.withHeader("X-Cache", "MISS");
@@ -502,34 +736,13 @@ fn handleShow(
     }
 
     // Find record
-    const found = config.orm.find(T, id) catch {
+    const found = config.orm.findAlloc(T, id, request.arena.allocator()) catch {
         return Response.serverError("Failed to fetch record");
     };
 
     const record = found orelse {
         return Response.notFound("Record not found");
     };
-    defer {
-        inline for (std.meta.fields(T)) |field| {
-            const field_type = @TypeOf(@field(record, field.name));
-            if (@typeInfo(field_type) == .pointer) {
-                const ptr_info = @typeInfo(field_type).pointer;
-                if (ptr_info.size == .slice and ptr_info.child == u8) {
-                    config.orm.allocator.free(@field(record, field.name));
-                }
-            } else if (@typeInfo(field_type) == .optional) {
-                const opt_info = @typeInfo(field_type).optional;
-                if (@typeInfo(opt_info.child) == .pointer) {
-                    const ptr_info = @typeInfo(opt_info.child).pointer;
-                    if (ptr_info.size == .slice and ptr_info.child == u8) {
-                        if (@field(record, field.name)) |val| {
-                            config.orm.allocator.free(val);
-                        }
-                    }
-                }
-            }
-        }
-    }
 
     // Check authorization
     if (config.authorization) |authz_fn| {
@@ -554,7 +767,7 @@ fn handleShow(
                 const persistent_json = std.heap.page_allocator.dupe(u8, j) catch null;
                 if (persistent_json) |pj| {
                     // Cache set is best-effort - log but don't fail request if caching fails
-                    request.cacheSet(key, pj, ttl, "application/json") catch |err| {
+                    request.cacheSetTagged(key, pj, ttl, "application/json", &.{ModelSql(T).table_name}) catch |err| {
                         std.debug.print("[REST API] Warning: Failed to cache response: {}\n", .{err});
                     };
                 }
@@ -632,6 +845,7 @@ fn handleCreate(
     config.orm.create(T, model_to_create) catch {
         return Response.serverError("Failed to create record");
     };
+    invalidateCountCache(prefix, request);
 
     // Invalidate cache
     if (config.cache_ttl_ms) |_| {
@@ -647,6 +861,94 @@ fn handleCreate(
     return response.withStatus(201);
 }
 
+/// Handler for POST /resource/bulk (bulk create endpoint)
+/// Accepts a JSON array, validates every item, then inserts them all in a
+/// single transaction. Responds with the created records including their ids.
+fn handleBulkCreate(
+    comptime T: type,
+    prefix: []const u8,
+    config: RestApiConfig(T),
+    request: *Request,
+) Response {
+    // Check authentication
+    var user: ?AuthUser = null;
+    if (config.authenticator) |auth_fn| {
+        user = auth_fn(request) catch {
+            return Response.errorResponse("Authentication required", 401);
+        };
+    }
+
+    // Parse JSON array body (allocated in the request arena)
+    const records = request.jsonBodyArray(T) catch {
+        return Response.errorResponse("Invalid JSON: expected an array of objects", 400);
+    };
+
+    if (records.len == 0) {
+        return Response.errorResponse("Bulk create requires at least one record", 400);
+    }
+    if (records.len > config.max_bulk_items) {
+        return Response.errorResponse("Too many records in bulk create request", 413);
+    }
+
+    // Validate every record before touching the database
+    for (records) |record| {
+        var validation_errors = config.validator(request, record) catch {
+            return Response.serverError("Validation error");
+        };
+        defer validation_errors.deinit();
+
+        if (!validation_errors.isEmpty()) {
+            return Response.validationError(&validation_errors);
+        }
+    }
+
+    // Apply the same defaults as handleCreate
+    const now = std.time.milliTimestamp();
+    for (records) |*record| {
+        inline for (std.meta.fields(T)) |field| {
+            if (comptime std.mem.eql(u8, field.name, "user_id")) {
+                if (user) |authenticated_user| {
+                    @field(record.*, "user_id") = authenticated_user.id;
+                }
+            }
+            if (comptime std.mem.eql(u8, field.name, "created_at")) {
+                @field(record.*, "created_at") = now;
+            }
+            if (comptime std.mem.eql(u8, field.name, "updated_at")) {
+                @field(record.*, "updated_at") = now;
+            }
+            if (comptime std.mem.eql(u8, field.name, "id")) {
+                @field(record.*, "id") = 0;
+            }
+        }
+    }
+
+    const ids = config.orm.createManyReturningIds(T, records) catch {
+        return Response.serverError("Failed to create records");
+    };
+    defer config.orm.allocator.free(ids);
+    invalidateCountCache(prefix, request);
+
+    if (@hasField(T, "id")) {
+        for (records, ids) |*record, id| {
+            @field(record.*, "id") = id;
+        }
+    }
+
+    // Invalidate cache
+    if (config.cache_ttl_ms) |_| {
+        const cache_key = buildListCacheKey(prefix, request, if (user) |u| u.id else null) catch null;
+        if (cache_key) |key| {
+            request.cacheInvalidate(key);
+        }
+    }
+
+    const json_str = json_mod.Json.serializeArray(T, records, request.arena.allocator()) catch {
+        return Response.serverError("Failed to serialize response");
+    };
+    return Response.json(json_str).withStatus(201);
+}
+
 /// Handler for PUT /resource/:id (update endpoint)
 fn handleUpdate(
     comptime T: type,
@@ -668,34 +970,13 @@ fn handleUpdate(
     };
 
     // Find existing record
-    const existing = config.orm.find(T, id) catch {
+    const existing = config.orm.findAlloc(T, id, request.arena.allocator()) catch {
         return Response.serverError("Failed to fetch record");
     };
 
     const existing_record = existing orelse {
         return Response.notFound("Record not found");
     };
-    defer {
-        inline for (std.meta.fields(T)) |field| {
-            const field_type = @TypeOf(@field(existing_record, field.name));
-            if (@typeInfo(field_type) == .pointer) {
-                const ptr_info = @typeInfo(field_type).pointer;
-                if (ptr_info.size == .slice and ptr_info.child == u8) {
-                    config.orm.allocator.free(@field(existing_record, field.name));
-                }
-            } else if (@typeInfo(field_type) == .optional) {
-                const opt_info = @typeInfo(field_type).optional;
-                if (@typeInfo(opt_info.child) == .pointer) {
-                    const ptr_info = @typeInfo(opt_info.child).pointer;
-                    if (ptr_info.size == .slice and ptr_info.child == u8) {
-                        if (@field(existing_record, field.name)) |val| {
-                            config.orm.allocator.free(val);
-                        }
-                    }
-                }
-            }
-        }
-    }
 
     // Check authorization
     if (config.authorization) |authz_fn| {
@@ -785,6 +1066,7 @@ fn handleUpdate(
     config.orm.update(T, model_to_update) catch {
         return Response.serverError("Failed to update record");
     };
+    invalidateCountCache(prefix, request);
 
     // Invalidate cache
     if (config.cache_ttl_ms) |_| {
@@ -806,6 +1088,110 @@ fn handleUpdate(
     return response;
 }
 
+/// Handler for PATCH /resource/:id (partial update endpoint)
+/// Only the keys present in the body are applied, so a key can set a field to
+/// 0, "" or null. The record is tracked from load to save and only columns whose
+/// value changed are written; a body that changes nothing writes nothing.
+fn handlePatch(
+    comptime T: type,
+    prefix: []const u8,
+    config: RestApiConfig(T),
+    request: *Request,
+) Response {
+    // Check authentication
+    var user: ?AuthUser = null;
+    if (config.authenticator) |auth_fn| {
+        user = auth_fn(request) catch {
+            return Response.errorResponse("Authentication required", 401);
+        };
+    }
+
+    // Get ID from route params
+    const id = request.paramTyped(i64, "id") catch {
+        return Response.errorResponse("Invalid ID", 400);
+    };
+
+    // Find existing record and start tracking it
+    const existing = config.orm.findTracked(T, id, request.arena.allocator()) catch {
+        return Response.serverError("Failed to fetch record");
+    };
+
+    var record = existing orelse {
+        return Response.notFound("Record not found");
+    };
+
+    // Check authorization
+    if (config.authorization) |authz_fn| {
+        const allowed = authz_fn(request, record.value) catch {
+            return Response.errorResponse("Authorization failed", 403);
+        };
+        if (!allowed) {
+            return Response.errorResponse("Access denied", 403);
+        }
+    }
+
+    // Typed values come from the usual parser; the generic parse tells which keys were sent
+    const parsed = request.jsonBody(T) catch {
+        return Response.errorResponse("Invalid JSON", 400);
+    };
+    const present = std.json.parseFromSliceLeaky(std.json.Value, request.arena.allocator(), request.body(), .{}) catch {
+        return Response.errorResponse("Invalid JSON", 400);
+    };
+    if (present != .object) {
+        return Response.errorResponse("Request body must be a JSON object", 400);
+    }
+
+    inline for (std.meta.fields(T)) |field| {
+        // Skip managed fields - these are set automatically
+        const is_managed_field = comptime std.mem.eql(u8, field.name, "id") or
+            std.mem.eql(u8, field.name, "created_at") or
+            std.mem.eql(u8, field.name, "updated_at") or
+            std.mem.eql(u8, field.name, "user_id");
+        if (!is_managed_field and present.object.contains(field.name)) {
+            @field(record.value, field.name) = @field(parsed, field.name);
+        }
+    }
+
+    if (!record.isDirty()) {
+        return Response.jsonFrom(T, record.value, config.orm.allocator);
+    }
+
+    // Validate
+    var validation_errors = config.validator(request, record.value) catch {
+        return Response.serverError("Validation error");
+    };
+    defer validation_errors.deinit();
+
+    if (!validation_errors.isEmpty()) {
+        return Response.validationError(&validation_errors);
+    }
+
+    // Update timestamp if model has updated_at field
+    if (@hasField(T, "updated_at")) {
+        @field(record.value, "updated_at") = std.time.milliTimestamp();
+    }
+
+    _ = config.orm.saveTracked(T, &record) catch {
+        return Response.serverError("Failed to update record");
+    };
+    invalidateCountCache(prefix, request);
+
+    // Invalidate cache
+    if (config.cache_ttl_ms) |_| {
+        const cache_key = buildListCacheKey(prefix, request, if (user) |u| u.id else null) catch null;
+        if (cache_key) |key| {
+            request.cacheInvalidate(key);
+        }
+        const show_cache_key = buildShowCacheKey(prefix, id, if (user) |u| u.id else null) catch null;
+        if (show_cache_key) |key| {
+            defer allocator.free(key); // buildShowCacheKey uses allocator (page_allocator)
+            request.cacheInvalidate(key);
+        }
+    }
+
+    return Response.jsonFrom(T, record.value, config.orm.allocator);
+}
+
 /// Handler for DELETE /resource/:id (delete endpoint)
 fn handleDelete(
     comptime T: type,
@@ -827,34 +1213,13 @@ fn handleDelete(
     };
 
     // Find existing record
-    const existing = config.orm.find(T, id) catch {
+    const existing = config.orm.findAlloc(T, id, request.arena.allocator()) catch {
         return Response.serverError("Failed to fetch record");
     };
 
     const existing_record = existing orelse {
         return Response.notFound("Record not found");
     };
-    defer {
-        inline for (std.meta.fields(T)) |field| {
-            const field_type = @TypeOf(@field(existing_record, field.name));
-            if (@typeInfo(field_type) == .pointer) {
-                const ptr_info = @typeInfo(field_type).pointer;
-                if (ptr_info.size == .slice and ptr_info.child == u8) {
-                    config.orm.allocator.free(@field(existing_record, field.name));
-                }
-            } else if (@typeInfo(field_type) == .optional) {
-                const opt_info = @typeInfo(field_type).optional;
-                if (@typeInfo(opt_info.child) == .pointer) {
-                    const ptr_info = @typeInfo(opt_info.child).pointer;
-                    if (ptr_info.size == .slice and ptr_info.child == u8) {
-                        if (@field(existing_record, field.name)) |val| {
-                            config.orm.allocator.free(val);
-                        }
-                    }
-                }
-            }
-        }
-    }
 
     // Check authorization
     if (config.authorization) |authz_fn| {
@@ -871,6 +1236,7 @@ fn handleDelete(
     config.orm.delete(T, id) catch {
         return Response.serverError("Failed to delete record");
     };
+    invalidateCountCache(prefix, request);
 
     // Invalidate cache
     if (config.cache_ttl_ms) |_| {
@@ -903,8 +1269,90 @@ fn initRestApiConfigs() void {
     }
 }
 
+/// Create the indexes list queries on this resource rely on
+/// Failures are logged and skipped so a bad index never blocks startup.
+fn ensureListIndexes(comptime Model: type, config: RestApiConfig(Model)) void {
+    const table = comptime model_utils.comptimeTableName(Model);
+
+    config.orm.syncIndexes(Model) catch |err| {
+        std.debug.print("[REST API] Warning: Failed to create declared indexes for '{s}': {}\n", .{ table, err });
+    };
+
+    // Authenticated lists always filter on user_id, so it leads every index.
+    // Index entries end with the rowid, so `id` never needs its own column.
+    const scoped = config.authenticator != null and @hasField(Model, "user_id");
+    var candidates: [64]ListIndex = undefined;
+    var count: usize = 0;
+    if (scoped) {
+        candidates[count] = ListIndex.of(&.{"user_id"});
+        count += 1;
+    }
+    for ([_]?[]const []const u8{ config.filterable_fields, config.sortable_fields }) |maybe_fields| {
+        const fields = maybe_fields orelse continue;
+        for (fields) |field| {
+            if (std.mem.eql(u8, field, "id") or (scoped and std.mem.eql(u8, field, "user_id"))) continue;
+            if (count == candidates.len) break;
+            candidates[count] = if (scoped) ListIndex.of(&.{ "user_id", field }) else ListIndex.of(&.{field});
+            count += 1;
+        }
+    }
+
+    // An index whose columns lead a longer one (or an existing index) adds nothing
+    for (candidates[0..count], 0..) |candidate, i| {
+        const redundant = for (candidates[0..count], 0..) |other, j| {
+            if (i == j) continue;
+            if (candidate.isPrefixOf(other) and (candidate.len < other.len or j < i)) break true;
+        } else false;
+        if (redundant) continue;
+        if (config.orm.hasIndexPrefix(table, candidate.columns()) catch false) continue;
+        ensureListIndex(Model, config, candidate.columns());
+    }
+}
+
+/// Columns of one index ensureListIndexes may create (at most `user_id` and a field)
+const ListIndex = struct {
+    buffer: [2][]const u8 = undefined,
+    len: usize = 0,
+
+    fn of(columns: []const []const u8) ListIndex {
+        var index = ListIndex{};
+        for (columns) |column| {
+            index.buffer[index.len] = column;
+            index.len += 1;
+        }
+        return index;
+    }
+
+    fn columns(self: *const ListIndex) []const []const u8 {
+        return self.buffer[0..self.len];
+    }
+
+    fn isPrefixOf(self: ListIndex, other: ListIndex) bool {
+        if (self.len > other.len) return false;
+        for (self.buffer[0..self.len], other.buffer[0..self.len]) |a, b| {
+            if (!std.mem.eql(u8, a, b)) return false;
+        }
+        return true;
+    }
+};
+
+fn ensureListIndex(comptime Model: type, config: RestApiConfig(Model), columns: []const []const u8) void {
+    const table = comptime model_utils.comptimeTableName(Model);
+    for (columns) |column| {
+        if (!isAllowedField(Model, column, null)) {
+            std.debug.print("[REST API] Warning: Cannot index unknown field '{s}' on '{s}'\n", .{ column, table });
+            return;
+        }
+    }
+    config.orm.ensureIndex(.{ .table = table, .columns = columns }) catch |err| {
+        std.debug.print("[REST API] Warning: Failed to create index on '{s}': {}\n", .{ table, err });
+    };
+}
+
 /// Register RESTful API endpoints for a model
-/// Generates: GET /prefix, GET /prefix/:id, POST /prefix, PUT /prefix/:id, DELETE /prefix/:id
+/// Generates: GET /prefix, GET /prefix/:id, POST /prefix, POST /prefix/bulk, PUT /prefix/:id, PATCH /prefix/:id, DELETE /prefix/:id
+/// PATCH is dispatched through POST until the server routes it; send
+/// `POST /prefix/:id` with `X-HTTP-Method-Override: PATCH` (see Engine12.patch).
 pub fn restApi(
     app: *@import("engine12.zig").Engine12,
     comptime prefix: []const u8,
@@ -922,6 +1370,8 @@ pub fn restApi(
         // Ignore error (generator init failed?)
     }
 
+    if (config.auto_index) ensureListIndexes(Model, config);
+
     // Store config in global registry (allocate on heap so it persists)
     const config_ptr = try allocator.create(RestApiConfig(Model));
     config_ptr.* = config;
@@ -976,6 +1426,24 @@ pub fn restApi(
         }
     }.handler);
 
+    // Register POST /prefix/bulk (bulk create)
+    if (config.enable_bulk_create) {
+        const bulk_path = comptime prefix ++ "/bulk";
+        try app.post(bulk_path, struct {
+            const model_type = Model;
+            const api_prefix = prefix;
+            fn handler(req: *Request) Response {
+                rest_api_configs_mutex.lock();
+                defer rest_api_configs_mutex.unlock();
+                const config_ptr_opt = rest_api_configs.get(api_prefix) orelse {
+                    return Response.serverError("REST API config not found");
+                };
+                const api_config = @as(*const RestApiConfig(model_type), @ptrCast(@alignCast(config_ptr_opt))).*;
+                return handleBulkCreate(model_type, api_prefix, api_config, req);
+            }
+        }.handler);
+    }
+
     // Register PUT /prefix/:id (update)
     const update_path = comptime prefix ++ "/:id";
     try app.put(update_path, struct {
@@ -992,6 +1460,22 @@ pub fn restApi(
         }
     }.handler);
 
+    // Register PATCH /prefix/:id (partial update)
+    const patch_path = comptime prefix ++ "/:id";
+    try app.patch(patch_path, struct {
+        const model_type = Model;
+        const api_prefix = prefix;
+        fn handler(req: *Request) Response {
+            rest_api_configs_mutex.lock();
+            defer rest_api_configs_mutex.unlock();
+            const config_ptr_opt = rest_api_configs.get(api_prefix) orelse {
+                return Response.serverError("REST API config not found");
+            };
+            const api_config = @as(*const RestApiConfig(model_type), @ptrCast(@alignCast(config_ptr_opt))).*;
+            return handlePatch(model_type, api_prefix, api_config, req);
+        }
+    }.handler);
+
     // Register DELETE /prefix/:id (delete)
     const delete_path = comptime prefix ++ "/:id";
     try app.delete(delete_path, struct {
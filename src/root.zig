@@ -13,6 +13,7 @@ pub const rate_limit = @import("rate_limit.zig");
 pub const body_size_limit = @import("body_size_limit.zig");
 pub const csrf = @import("csrf.zig");
 pub const cache = @import("cache.zig");
+pub const tenant = @import("tenant.zig");
 pub const router = @import("router.zig");
 pub const templates = @import("templates/template.zig");
 pub const templates_simple = @import("templates/simple.zig");
@@ -56,6 +57,10 @@ pub const OutputFormat = dev_tools.OutputFormat;
 pub const ResponseCache = cache.ResponseCache;
 pub const CacheEntry = cache.CacheEntry;
 
+// Re-export tenant routing types
+pub const TenantRouter = tenant.TenantRouter;
+pub const TenantSource = tenant.TenantSource;
+
 // Re-export JSON utilities
 pub const Json = json.Json;
 
@@ -0,0 +1,202 @@
+const std = @import("std");
+const Request = @import("request.zig").Request;
+const orm_mod = @import("orm/orm.zig");
+const TenantPool = orm_mod.TenantPool;
+const TenantPoolOptions = orm_mod.TenantPoolOptions;
+const jwt = @import("valve/builtin/jwt.zig");
+
+/// Where the tenant key of a request comes from
+pub const TenantSource = union(enum) {
+    /// A request header, e.g. "X-Tenant-ID"
+    /// The client picks the value, so it can name any tenant; only use this
+    /// behind a proxy that sets the header, or check access in the handler.
+    header: []const u8,
+    /// The label of the Host header just below `base_domain` ("acme" for
+    /// acme.example.com with base_domain "example.com"), lowercased. IP-literal
+    /// hosts and hosts outside the base domain name no tenant.
+    subdomain: struct {
+        base_domain: []const u8,
+    },
+    /// A claim of the HS256 bearer token, checked against `secret`
+    /// Tokens without an integer `exp` claim name no tenant.
+    jwt_claim: struct {
+        claim: []const u8 = "tenant",
+        secret: []const u8,
+    },
+    /// Any other lookup; strings must outlive the request (e.g. the request arena)
+    custom: *const fn (*Request) ?[]const u8,
+};
+
+/// Routes each request to its tenant's own SQLite database
+/// The key comes from `source` and selects a database in a `TenantPool`, which
+/// keeps an LRU of open tenants, opens and migrates a tenant on first use,
+/// and keeps each tenant's connection and statement cache separate.
+///
+/// Example:
+/// ```zig
+/// var tenants = try TenantRouter.init(allocator, .{ .header = "X-Tenant-ID" }, .{
+///     .path_template = "data/{tenant}.db",
+///     .max_open = 256,
+///     .migrations = &migrations,
+/// });
+/// defer tenants.deinit();
+///
+/// fn handleTodos(request: *Request) Response {
+///     var tenant = tenants.acquire(request) catch return Response.errorResponse("Unknown tenant", 400);
+///     defer tenant.release();
+///     const todos = tenant.orm.findAll(Todo) catch return Response.serverError("Query failed");
+///     ...
+/// }
+/// ```
+pub const TenantRouter = struct {
+    pool: *TenantPool,
+    source: TenantSource,
+
+    pub fn init(allocator: std.mem.Allocator, source: TenantSource, options: TenantPoolOptions) !TenantRouter {
+        return .{ .pool = try TenantPool.init(allocator, options), .source = source };
+    }
+
+    pub fn deinit(self: *TenantRouter) void {
+        self.pool.deinit();
+    }
+
+    /// The request's tenant key, or null when the request does not name one
+    /// Also stored in the request context as "tenant".
+    pub fn tenantKey(self: *TenantRouter, request: *Request) ?[]const u8 {
+        const tenant_key = switch (self.source) {
+            .header => |name| request.header(name),
+            .subdomain => |config| subdomainOf(request.arena.allocator(), request.header("Host") orelse return null, config.base_domain),
+            .jwt_claim => |config| jwtClaim(request, config.claim, config.secret),
+            .custom => |lookup| lookup(request),
+        } orelse return null;
+
+        request.set("tenant", tenant_key) catch {};
+        return tenant_key;
+    }
+
+    /// Lease the request's tenant ORM; call `release` before the handler returns
+    /// Fails with error.MissingTenant when the request names no tenant.
+    pub fn acquire(self: *TenantRouter, request: *Request) !TenantPool.Lease {
+        const tenant_key = self.tenantKey(request) orelse return error.MissingTenant;
+        return self.pool.acquire(tenant_key);
+    }
+};
+
+/// Host names are case-insensitive, so the label is lowercased into `allocator`
+/// and ACME.example.com and acme.example.com map to the same tenant file
+fn subdomainOf(allocator: std.mem.Allocator, host: []const u8, base_domain: []const u8) ?[]const u8 {
+    // IPv6 literals: "[::1]:8080", or bare "::1"
+    if (std.mem.startsWith(u8, host, "[") or std.mem.count(u8, host, ":") > 1) return null;
+    var hostname = if (std.mem.lastIndexOfScalar(u8, host, ':')) |colon| host[0..colon] else host;
+    hostname = std.mem.trimRight(u8, hostname, ".");
+    if (std.net.Address.parseIp4(hostname, 0)) |_| return null else |_| {}
+
+    // The host must have at least one more label than the base domain
+    const base = std.mem.trim(u8, base_domain, ".");
+    if (base.len == 0 or hostname.len <= base.len + 1) return null;
+    const suffix_start = hostname.len - base.len;
+    if (hostname[suffix_start - 1] != '.' or !std.ascii.eqlIgnoreCase(hostname[suffix_start..], base)) return null;
+
+    const below = hostname[0 .. suffix_start - 1];
+    const label = if (std.mem.lastIndexOfScalar(u8, below, '.')) |dot| below[dot + 1 ..] else below;
+    if (label.len == 0) return null;
+    return std.ascii.allocLowerString(allocator, label) catch null;
+}
+
+fn jwtClaim(request: *Request, claim: []const u8, secret: []const u8) ?[]const u8 {
+    const auth_header = request.header("Authorization") orelse return null;
+    if (!std.mem.startsWith(u8, auth_header, "Bearer ")) return null;
+
+    const arena = request.arena.allocator();
+    const payload = jwt.verifiedPayload(auth_header["Bearer ".len..], secret, arena) catch return null;
+    const claims = std.json.parseFromSliceLeaky(std.json.Value, arena, payload, .{}) catch return null;
+    if (claims != .object) return null;
+
+    // A token without an expiry would name its tenant forever
+    const exp = claims.object.get("exp") orelse return null;
+    if (exp != .integer or exp.integer < std.time.timestamp()) return null;
+    return switch (claims.object.get(claim) orelse return null) {
+        .string => |value| value,
+        .integer => |value| std.fmt.allocPrint(arena, "{d}", .{value}) catch null,
+        else => null,
+    };
+}
+
+fn createTestRequest(headers: std.StringHashMap([]const u8)) @import("ziggurat").request.Request {
+    return .{
+        .path = "/todos",
+        .method = .GET,
+        .body = "",
+        .headers = headers,
+        .allocator = std.testing.allocator,
+        .user_data = std.StringHashMap([]const u8).init(std.testing.allocator),
+    };
+}
+
+/// Bearer header for an arbitrary HS256 payload (jwt.encode always sets `exp`)
+fn testBearer(allocator: std.mem.Allocator, payload: []const u8, secret: []const u8) ![]u8 {
+    const encoder = std.base64.url_safe_no_pad.Encoder;
+    var header_buf: [64]u8 = undefined;
+    var payload_buf: [256]u8 = undefined;
+    const message = try std.fmt.allocPrint(allocator, "{s}.{s}", .{
+        encoder.encode(&header_buf, "{\"alg\":\"HS256\",\"typ\":\"JWT\"}"),
+        encoder.encode(&payload_buf, payload),
+    });
+    defer allocator.free(message);
+
+    var signature: [32]u8 = undefined;
+    std.crypto.auth.hmac.sha2.HmacSha256.create(&signature, message, secret);
+    var signature_buf: [64]u8 = undefined;
+    return std.fmt.allocPrint(allocator, "Bearer {s}.{s}", .{ message, encoder.encode(&signature_buf, &signature) });
+}
+
+test "TenantRouter resolves tenant keys from headers, subdomains and JWT claims" {
+    const allocator = std.testing.allocator;
+
+    var headers = std.StringHashMap([]const u8).init(allocator);
+    defer headers.deinit();
+    try headers.put("X-Tenant-ID", "acme");
+    try headers.put("Host", "globex.example.com:8080");
+
+    const token = try jwt.encode(.{ .user_id = 7, .username = "ann", .exp = std.time.timestamp() + 60 }, "secret", allocator);
+    defer allocator.free(token);
+    const bearer = try std.fmt.allocPrint(allocator, "Bearer {s}", .{token});
+    defer allocator.free(bearer);
+    try headers.put("Authorization", bearer);
+
+    var ziggurat_req = createTestRequest(headers);
+    var req = Request.fromZiggurat(&ziggurat_req, allocator);
+    defer req.deinit();
+
+    var by_header = TenantRouter{ .pool = undefined, .source = .{ .header = "X-Tenant-ID" } };
+    try std.testing.expectEqualStrings("acme", by_header.tenantKey(&req).?);
+    try std.testing.expectEqualStrings("acme", req.get("tenant").?);
+
+    var by_host = TenantRouter{ .pool = undefined, .source = .{ .subdomain = .{ .base_domain = "example.com" } } };
+    try std.testing.expectEqualStrings("globex", by_host.tenantKey(&req).?);
+
+    var by_claim = TenantRouter{ .pool = undefined, .source = .{ .jwt_claim = .{ .claim = "user_id", .secret = "secret" } } };
+    try std.testing.expectEqualStrings("7", by_claim.tenantKey(&req).?);
+
+    var wrong_secret = TenantRouter{ .pool = undefined, .source = .{ .jwt_claim = .{ .claim = "user_id", .secret = "other" } } };
+    try std.testing.expect(wrong_secret.tenantKey(&req) == null);
+
+    // Tokens that never expire are not accepted
+    const forever = try testBearer(allocator, "{\"user_id\":7}", "secret");
+    defer allocator.free(forever);
+    try ziggurat_req.headers.put("Authorization", forever);
+    try std.testing.expect(by_claim.tenantKey(&req) == null);
+
+    var arena_state = std.heap.ArenaAllocator.init(allocator);
+    defer arena_state.deinit();
+    const arena = arena_state.allocator();
+    try std.testing.expectEqualStrings("acme", subdomainOf(arena, "api.ACME.Example.COM.", "example.com").?);
+    try std.testing.expectEqualStrings("acme", subdomainOf(arena, "acme.localhost:8080", "localhost").?);
+    try std.testing.expect(subdomainOf(arena, "localhost:8080", "localhost") == null);
+    try std.testing.expect(subdomainOf(arena, "example.com", "example.com") == null);
+    try std.testing.expect(subdomainOf(arena, "acme.example.org", "example.com") == null);
+    try std.testing.expect(subdomainOf(arena, "acmeexample.com", "example.com") == null);
+    try std.testing.expect(subdomainOf(arena, "10.0.0.1", "0.1") == null);
+    try std.testing.expect(subdomainOf(arena, "127.0.0.1:8080", "0.1") == null);
+    try std.testing.expect(subdomainOf(arena, "[::1]:8080", "example.com") == null);
+}
@@ -13,6 +13,7 @@ const Model = orm.Model;
 const ModelWithORM = orm.ModelWithORM;
 const Migration = @import("../../orm/migration.zig").Migration;
 const SqlEscape = orm.SqlEscape;
+const EntityCacheOptions = orm.EntityCacheOptions;
 const jwt = @import("jwt.zig");
 const Claims = jwt.Claims;
 const password = @import("password.zig");
@@ -55,6 +56,10 @@ pub const BasicAuthConfig = struct {
     user_table_name: []const u8 = "users",
     /// ORM instance (required)
     orm: *ORM,
+    /// Cache user rows looked up on every authenticated request
+    /// (null = always read from the database). `table_name` is taken from
+    /// `user_table_name`.
+    user_cache: ?EntityCacheOptions = null,
 };
 
 /// Production-ready JWT-based authentication valve
@@ -135,6 +140,40 @@ pub const BasicAuthValve = struct {
 
         // Run migration to create users table
         try self.runMigration(ctx.allocator);
+
+        if (self.config.user_cache) |options| {
+            // Keyed by the configured table, which loadUser reads directly
+            _ = try self.config.orm.enableTableCache(self.config.user_table_name, options);
+        }
+    }
+
+    /// Load a user by id, through the ORM's entity cache when enabled
+    /// Strings are allocated in `allocator`.
+    fn loadUser(self: *Self, id: i64, allocator: std.mem.Allocator) !?User {
+        const table_name = self.config.user_table_name;
+        const cache = self.config.orm.entity_cache;
+
+        var cache_generation: ?u64 = null;
+        if (cache) |c| {
+            if (try c.get(User, table_name, id, allocator)) |cached| return cached;
+            cache_generation = c.generation(table_name);
+        }
+
+        // Use raw SQL with configured table name instead of ModelWithORM
+        // because ModelWithORM uses inferTableName which returns "user" but table is "users"
+        const sql = try std.fmt.allocPrint(allocator, "SELECT * FROM {s} WHERE id = {d}", .{ table_name, id });
+        defer allocator.free(sql);
+
+        // Through the ORM's reader path (a WAL reader, or the writer under its
+        // lock) so the row cannot be read mid-write and then cached
+        var result = try self.config.orm.query(sql);
+        defer result.deinit();
+
+        // Decode the single row straight into `allocator`
+        var it = try result.iterator(User);
+        const user = try it.nextAlloc(allocator) orelse return null;
+        if (cache) |c| c.put(User, table_name, id, user, cache_generation);
+        return user;
     }
 
     /// Run database migration to create users table
@@ -247,17 +286,10 @@ pub const BasicAuthValve = struct {
         };
         defer check_result.deinit();
 
-        var all_users = check_result.toArrayList(User) catch {
+        // Allocated in the request arena, freed with the request
+        const all_users = check_result.toArrayListAlloc(User, allocator) catch {
             return Response.serverError("Failed to parse user data");
         };
-        defer {
-            for (all_users.items) |user| {
-                self.config.orm.allocator.free(user.username);
-                self.config.orm.allocator.free(user.email);
-                self.config.orm.allocator.free(user.password_hash);
-            }
-            all_users.deinit(self.config.orm.allocator);
-        }
 
         for (all_users.items) |user| {
             if (std.mem.eql(u8, user.username, username)) {
@@ -369,17 +401,10 @@ pub const BasicAuthValve = struct {
         };
         defer find_result.deinit();
 
-        var all_users = find_result.toArrayList(User) catch {
+        // Allocated in the request arena, so matched strings stay valid for the whole request
+        const all_users = find_result.toArrayListAlloc(User, allocator) catch {
             return Response.serverError("Failed to parse user data");
         };
-        defer {
-            for (all_users.items) |user| {
-                self.config.orm.allocator.free(user.username);
-                self.config.orm.allocator.free(user.email);
-                self.config.orm.allocator.free(user.password_hash);
-            }
-            all_users.deinit(self.config.orm.allocator);
-        }
 
         var found_user: ?User = null;
         var found_user_index: ?usize = null;
@@ -395,20 +420,10 @@ pub const BasicAuthValve = struct {
             return Response.errorResponse("Invalid username or password", 401);
         };
 
-        // Copy user data we need before all_users is freed
         const user_id = user.id;
-        const user_username = allocator.dupe(u8, user.username) catch {
-            return Response.serverError("Failed to allocate username");
-        };
-        defer allocator.free(user_username);
-        const user_email = allocator.dupe(u8, user.email) catch {
-            return Response.serverError("Failed to allocate email");
-        };
-        defer allocator.free(user_email);
-        const user_password_hash = allocator.dupe(u8, user.password_hash) catch {
-            return Response.serverError("Failed to allocate password hash");
-        };
-        defer allocator.free(user_password_hash);
+        const user_username = user.username;
+        const user_email = user.email;
+        const user_password_hash = user.password_hash;
 
         // Verify password
         const password_valid = password.verify(pwd, user_password_hash);
@@ -502,35 +517,10 @@ pub const BasicAuthValve = struct {
         };
         defer allocator.free(claims.username);
 
-        // Find user using raw SQL with configured table name
-        // (ModelWithORM uses inferTableName which returns "user" but table is "users")
-        const sql = std.fmt.allocPrint(
-            allocator,
-            "SELECT * FROM {s} WHERE id = {d}",
-            .{ self.config.user_table_name, claims.user_id },
-        ) catch {
-            return Response.serverError("Failed to allocate SQL");
-        };
-        defer allocator.free(sql);
-
-        var result = self.config.orm.db.query(sql) catch {
+        // Allocated in the request arena, freed with the request
+        const user = (self.loadUser(claims.user_id, allocator) catch {
             return Response.serverError("Failed to query user");
-        };
-        defer result.deinit();
-
-        var users = result.toArrayList(User) catch {
-            return Response.serverError("Failed to parse user data");
-        };
-        defer {
-            for (users.items) |u| {
-                self.config.orm.allocator.free(u.username);
-                self.config.orm.allocator.free(u.email);
-                self.config.orm.allocator.free(u.password_hash);
-            }
-            users.deinit(self.config.orm.allocator);
-        }
-
-        const user = if (users.items.len > 0) users.items[0] else {
+        }) orelse {
             return Response.errorResponse("User not found", 404);
         };
 
@@ -578,45 +568,8 @@ pub const BasicAuthValve = struct {
         };
         defer allocator.free(claims.username);
 
-        // Use raw SQL with configured table name instead of ModelWithORM
-        // because ModelWithORM uses inferTableName which returns "user" but table is "users"
-        const sql = try std.fmt.allocPrint(
-            allocator,
-            "SELECT * FROM {s} WHERE id = {d}",
-            .{ self.config.user_table_name, claims.user_id },
-        );
-        defer allocator.free(sql);
-
-        var result = self.config.orm.db.query(sql) catch {
-            return null;
-        };
-        defer result.deinit();
-
-        var users = result.toArrayList(User) catch {
-            return null;
-        };
-        defer {
-            for (users.items) |user| {
-                self.config.orm.allocator.free(user.username);
-                self.config.orm.allocator.free(user.email);
-                self.config.orm.allocator.free(user.password_hash);
-            }
-            users.deinit(self.config.orm.allocator);
-        }
-
-        if (users.items.len > 0) {
-            const user = users.items[0];
-            // Copy strings to ORM allocator (caller will free them)
-            return User{
-                .id = user.id,
-                .username = try self.config.orm.allocator.dupe(u8, user.username),
-                .email = try self.config.orm.allocator.dupe(u8, user.email),
-                .password_hash = try self.config.orm.allocator.dupe(u8, user.password_hash),
-                .created_at = user.created_at,
-            };
-        }
-
-        return null;
+        // Strings go to the ORM allocator (caller will free them)
+        return self.loadUser(claims.user_id, self.config.orm.allocator) catch null;
     }
 
     /// Require authentication or return error response
@@ -159,6 +159,44 @@ pub fn encode(claims: Claims, secret: []const u8, allocator: std.mem.Allocator)
 /// defer allocator.free(claims.username);
 /// ```
 pub fn decode(token: []const u8, secret: []const u8, allocator: std.mem.Allocator) !Claims {
+    // Decode payload
+    const payload_json = try verifiedPayload(token, secret, allocator);
+    defer allocator.free(payload_json);
+
+    // Parse JSON to extract claims using custom JSON parser
+    const claims_data = json_module.Json.deserialize(Claims, payload_json, allocator) catch {
+        return JwtError.InvalidToken;
+    };
+    defer allocator.free(claims_data.username);
+
+    // Check expiration
+    const now = std.time.timestamp();
+    if (claims_data.exp < now) {
+        return JwtError.ExpiredToken;
+    }
+
+    // Copy username to allocated memory (deserialize already allocates it, but we need to own it)
+    const username = try allocator.dupe(u8, claims_data.username);
+    const user_id = claims_data.user_id;
+    const exp = claims_data.exp;
+
+    return Claims{
+        .user_id = user_id,
+        .username = username,
+        .exp = exp,
+    };
+}
+
+/// Verify a token's HS256 signature and return its decoded payload JSON
+/// For reading claims other than `Claims`; expiration is not checked here.
+/// The caller frees the returned slice.
+///
+/// Example:
+/// ```zig
+/// const payload = try jwt.verifiedPayload(token, "secret-key", allocator);
+/// defer allocator.free(payload);
+/// ```
+pub fn verifiedPayload(token: []const u8, secret: []const u8, allocator: std.mem.Allocator) ![]const u8 {
     // Split token into parts
     var parts = std.mem.splitSequence(u8, token, ".");
     const header_b64 = parts.next() orelse return JwtError.InvalidToken;
@@ -188,32 +226,7 @@ pub fn decode(token: []const u8, secret: []const u8, allocator: std.mem.Allocato
         return JwtError.InvalidSignature;
     }
 
-    // Decode payload
-    const payload_json = try base64urlDecode(payload_b64, allocator);
-    defer allocator.free(payload_json);
-
-    // Parse JSON to extract claims using custom JSON parser
-    const claims_data = json_module.Json.deserialize(Claims, payload_json, allocator) catch {
-        return JwtError.InvalidToken;
-    };
-    defer allocator.free(claims_data.username);
-
-    // Check expiration
-    const now = std.time.timestamp();
-    if (claims_data.exp < now) {
-        return JwtError.ExpiredToken;
-    }
-
-    // Copy username to allocated memory (deserialize already allocates it, but we need to own it)
-    const username = try allocator.dupe(u8, claims_data.username);
-    const user_id = claims_data.user_id;
-    const exp = claims_data.exp;
-
-    return Claims{
-        .user_id = user_id,
-        .username = username,
-        .exp = exp,
-    };
+    return base64urlDecode(payload_b64, allocator);
 }
 
 // Tests
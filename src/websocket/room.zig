@@ -1,6 +1,7 @@
 const std = @import("std");
 const connection = @import("connection.zig");
 const WebSocketConnection = connection.WebSocketConnection;
+const change_feed = @import("../orm/change_feed.zig");
 
 /// WebSocket room for broadcasting to groups of connections
 pub const WebSocketRoom = struct {
@@ -144,6 +145,32 @@ pub const WebSocketRoom = struct {
         try self.broadcast(json_str);
     }
 
+    /// Broadcast every committed change batch to the room as JSON
+    /// Each message is one transaction's changes, for example
+    /// `{"seq":42,"changes":[{"table":"todos","op":"update","rowid":7}]}`.
+    /// Empty rooms skip serialization.
+    ///
+    /// Example:
+    /// ```zig
+    /// const feed = try orm.enableChangeFeed(.{});
+    /// try room.followChanges(feed);
+    /// ```
+    pub fn followChanges(self: *WebSocketRoom, feed: *change_feed.ChangeFeed) !void {
+        try feed.subscribe(onChanges, self);
+    }
+
+    fn onChanges(context: ?*anyopaque, batch: *const change_feed.ChangeBatch) void {
+        const self: *WebSocketRoom = @ptrCast(@alignCast(context.?));
+        if (self.isEmpty()) return;
+
+        var message = std.ArrayListUnmanaged(u8){};
+        defer message.deinit(self.allocator);
+        batch.writeJson(message.writer(self.allocator)) catch return;
+        self.broadcast(message.items) catch |err| {
+            std.debug.print("[WebSocketRoom] Error broadcasting changes: {}\n", .{err});
+        };
+    }
+
     /// Add a connection to the room
     pub fn join(self: *WebSocketRoom, conn: *WebSocketConnection) !void {
         self.mutex.lock();
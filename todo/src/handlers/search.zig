@@ -37,60 +37,22 @@ pub fn handleSearchTodos(request: *Request) Response {
     };
     const user = ctx.user.?; // Safe because require_auth = true
 
-    // NOTE: QueryBuilder Limitation
-    // The engine12 QueryBuilder doesn't currently support OR conditions in WHERE clauses.
-    // For this search functionality that needs to search across multiple columns (title, description, tags)
-    // with OR conditions, we use raw SQL instead.
-    //
-    // Example of QueryBuilder usage for simpler queries (without OR):
-    // ```zig
-    // var query = QueryBuilder.init(orm.db, "Todo");
-    // query.where("completed", "=", "0");
-    // query.orderBy("created_at", "DESC");
-    // query.limit(10);
-    // const result = query.execute();
-    // ```
-    //
-    // For OR conditions or complex queries, raw SQL is the current approach.
-
-    // Use ORM's escapeLike method for safe SQL LIKE pattern escaping
-    const escaped_query = orm.escapeLike(search_query, request.arena.allocator()) catch {
-        return ctx.serverError("Failed to escape query");
-    };
-
-    // Build search query - search in title, description, and tags, filtered by user_id
-    const search_pattern = std.fmt.allocPrint(request.arena.allocator(), "%{s}%", .{escaped_query}) catch {
-        return ctx.serverError("Failed to format search query");
-    };
-    const sql = std.fmt.allocPrint(request.arena.allocator(),
-        \\SELECT id, user_id, title, description, completed, priority, due_date, tags, created_at, updated_at FROM todos WHERE 
-        \\  user_id = {d} AND (
-        \\    title LIKE '{s}' OR 
-        \\    description LIKE '{s}' OR 
-        \\    tags LIKE '{s}'
-        \\  )
-        \\ORDER BY created_at DESC
-    , .{ user.id, search_pattern, search_pattern, search_pattern }) catch {
-        return ctx.serverError("Failed to build search query");
-    };
-
-    var result = orm.db.query(sql) catch {
+    // Full-text search over title, description and tags through the todos_fts
+    // index (created from Todo.search_fields when the REST API is registered),
+    // best matches first, restricted to the current user's todos
+    const arena = request.arena.allocator();
+    const hits = orm.searchAlloc(Todo, search_query, .{
+        .limit = 100,
+        .filters = &.{.{ .column = "user_id", .value = .{ .int = user.id } }},
+    }, arena) catch {
         return ctx.serverError("Failed to search todos");
     };
-    defer result.deinit();
 
-    var todos = result.toArrayList(Todo) catch {
+    var todos = std.ArrayListUnmanaged(Todo){};
+    todos.ensureTotalCapacity(arena, hits.items.len) catch {
         return ctx.serverError("Failed to parse search results");
     };
-    defer {
-        for (todos.items) |todo| {
-            allocator.free(todo.title);
-            allocator.free(todo.description);
-            allocator.free(todo.priority);
-            allocator.free(todo.tags);
-        }
-        todos.deinit(allocator);
-    }
+    for (hits.items) |hit| todos.appendAssumeCapacity(hit.item);
 
     return TodoModel.toResponseList(todos, allocator)
         .withHeader("Cache-Control", "no-cache, no-store, must-revalidate")
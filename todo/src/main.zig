@@ -490,6 +490,10 @@ pub fn createApp() !E12.Engine12 {
         .enable_pagination = true,
         .enable_filtering = true,
         .enable_sorting = true,
+        // Each listed field gets a (user_id, field) index at startup unless
+        // the declared Todo.indexes already start with those columns
+        .filterable_fields = &.{ "completed", "priority" },
+        .sortable_fields = &.{ "created_at", "updated_at", "due_date", "priority", "title" },
         .cache_ttl_ms = 30000, // 30 seconds
         // Note: Hooks are not currently supported due to Zig type system limitations
         // User_id and timestamps should be set in the validator or by modifying the model before calling restApi
@@ -13,6 +13,15 @@ pub const Todo = struct {
     tags: []u8,
     created_at: i64,
     updated_at: i64,
+
+    /// Created by restApi at startup through E12.orm.ORM.syncIndexes
+    pub const indexes = .{
+        .{ "user_id", "created_at" },
+        .{ "user_id", "due_date" },
+    };
+
+    /// Full-text index (todos_fts) used by /api/todos/search
+    pub const search_fields = .{ "title", "description", "tags" };
 };
 
 /// Input struct for JSON parsing (matches what parseTodoFromJson returned)
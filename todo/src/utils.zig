@@ -7,18 +7,12 @@ const TodoStats = models.TodoStats;
 
 const allocator = std.heap.page_allocator;
 
+/// Todos owned by one user; SQL is built at comptime and cached once prepared
+const TodosByUser = E12.orm.CompiledQuery(Todo, .{ .where = E12.orm.compiled_query.eq("user_id") });
+
 /// Get all todos for a user
 pub fn getAllTodos(orm: *ORM, user_id: i64) !std.ArrayListUnmanaged(Todo) {
-    // Filter todos by user_id using raw SQL
-    // IMPORTANT: Column order must match Todo struct field order:
-    // id, user_id, title, description, completed, priority, due_date, tags, created_at, updated_at
-    const sql = try std.fmt.allocPrint(orm.allocator, "SELECT id, user_id, title, description, completed, priority, due_date, tags, created_at, updated_at FROM todos WHERE user_id = {d}", .{user_id});
-    defer orm.allocator.free(sql);
-
-    var query_result = try orm.db.query(sql);
-    defer query_result.deinit();
-
-    return try query_result.toArrayList(Todo);
+    return orm.fetch(TodosByUser, .{user_id}, allocator);
 }
 
 /// Get statistics for a user's todos